@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Concurrency/Mutex.h>
+#include <FileSystem/FilePath.h>
+
+namespace DAVA
+{
+/**
+    Cook and load time counters of collision meshes.
+*/
+struct PhysicsCookingStats
+{
+    uint32 cookedCount = 0; //!< number of meshes cooked by PhysX
+    uint32 loadedCount = 0; //!< number of meshes loaded from disk cache
+    int64 cookTimeUs = 0; //!< total time spent in cooking, summed over all threads
+    int64 loadTimeUs = 0; //!< total time spent in loading from disk cache, summed over all threads
+};
+
+/**
+    Disk cache of cooked PhysX mesh streams.
+
+    Entries are keyed by content hash of mesh vertices and indices, mesh type and cooking
+    parameters, so the same geometry from different scenes shares one entry and any change
+    of source data or cooking settings leads to a new entry. Thread safe.
+*/
+class PhysicsCookingCache final
+{
+public:
+    enum class MeshType : uint8
+    {
+        TriangleMesh,
+        ConvexHull
+    };
+
+    /** Create cache in `directory`, `cookingParams` are opaque cooking settings mixed into every key */
+    PhysicsCookingCache(const FilePath& directory, const Vector<uint8>& cookingParams);
+
+    const FilePath& GetDirectory() const;
+
+    String GetKey(MeshType type, const void* vertices, uint32 verticesSize, const void* indices, uint32 indicesSize) const;
+
+    bool Load(const String& key, Vector<uint8>& stream) const;
+    void Save(const String& key, const Vector<uint8>& stream) const;
+    void Remove(const String& key) const;
+
+    PhysicsCookingStats GetStats() const;
+    void ResetStats();
+    void AddCookTime(int64 timeUs);
+    void AddLoadTime(int64 timeUs);
+
+private:
+    FilePath GetEntryPath(const String& key) const;
+
+    FilePath directory;
+    Vector<uint8> cookingParams;
+
+    mutable Mutex statsMutex;
+    PhysicsCookingStats stats;
+};
+
+inline const FilePath& PhysicsCookingCache::GetDirectory() const
+{
+    return directory;
+}
+} // namespace DAVA
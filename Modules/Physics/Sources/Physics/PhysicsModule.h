@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Physics/PhysicsConfigs.h"
+#include "Physics/PhysicsCookingCache.h"
 
 #include <ModuleManager/IModule.h>
 #include <ModuleManager/ModuleManager.h>
@@ -23,6 +24,7 @@ class PxMaterial;
 class PxSimulationEventCallback;
 class PxDefaultCpuDispatcher;
 class PxAllocatorCallback;
+class PxBase;
 }
 
 namespace DAVA
@@ -58,6 +60,17 @@ public:
     physx::PxShape* CreateConvexHullShape(Vector<PolygonGroup*>&& polygons, const Vector3& scale, const FastName& materialName, PhysicsGeometryCache* cache) const;
     physx::PxShape* CreateHeightField(Landscape* landscape, const FastName& materialName, Matrix4& localPose) const;
 
+    /**
+        Create triangle meshes and convex hulls for all polygon sets which are missing in `cache`.
+        Meshes are taken from disk cooking cache or cooked in parallel on worker threads,
+        so following CreateMeshShape/CreateConvexHullShape calls get them from `cache`.
+        Every polygon set should be sorted and contain unique groups.
+    */
+    void CookMeshes(const Vector<Vector<PolygonGroup*>>& triangleMeshes, const Vector<Vector<PolygonGroup*>>& convexHulls, PhysicsGeometryCache* cache) const;
+
+    /** Disk cache of cooked meshes, nullptr if disabled with empty "physics.cookingCacheDirectory" option */
+    PhysicsCookingCache* GetCookingCache() const;
+
     physx::PxMaterial* GetMaterial(const FastName& materialName) const;
     Vector<FastName> GetMaterialNames() const;
     void ReleaseMaterials();
@@ -73,10 +86,15 @@ private:
     void LazyLoadMaterials() const;
     void LoadMaterials();
 
+    bool CookMesh(const Vector<PolygonGroup*>& polygons, PhysicsCookingCache::MeshType type, bool loadFromCache, Vector<uint8>& stream, bool& loadedFromCache) const;
+    physx::PxBase* CreateMeshFromStream(PhysicsCookingCache::MeshType type, const Vector<uint8>& stream) const;
+    physx::PxBase* CreateMesh(const Vector<PolygonGroup*>& polygons, PhysicsCookingCache::MeshType type, const Vector<uint8>* cookedStream, bool loadedFromCache) const;
+
 private:
     physx::PxFoundation* foundation = nullptr;
     physx::PxPhysics* physics = nullptr;
     physx::PxCooking* cooking = nullptr;
+    PhysicsCookingCache* cookingCache = nullptr;
 
     mutable physx::PxDefaultCpuDispatcher* cpuDispatcher = nullptr;
     physx::PxMaterial* defaultMaterial = nullptr;
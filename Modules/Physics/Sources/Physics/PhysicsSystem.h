@@ -2,11 +2,14 @@
 
 #include <Entity/SceneSystem.h>
 #include <Math/Vector.h>
+#include <Math/Quaternion.h>
 #include <Base/BaseTypes.h>
 
 #include <physx/PxQueryReport.h>
+#include <physx/geometry/PxGeometryHelpers.h>
 #include <physx/PxSimulationEventCallback.h>
 #include <physx/PxForceMode.h>
+#include <PxShared/foundation/PxTransform.h>
 
 namespace physx
 {
@@ -28,6 +31,20 @@ class PhysicsGeometryCache;
 class PhysicsVehiclesSubsystem;
 class CharacterControllerComponent;
 
+/**
+    Result of scene query scheduled with PhysicsSystem::ScheduleRaycast, ScheduleSweep or ScheduleOverlap.
+    `position`, `normal` and `distance` are not filled for overlaps.
+*/
+struct PhysicsQueryResult
+{
+    PhysicsComponent* body = nullptr;
+    CollisionShapeComponent* shape = nullptr;
+    Vector3 position;
+    Vector3 normal;
+    float32 distance = 0.0f;
+    bool hasHit = false;
+};
+
 class PhysicsSystem final : public SceneSystem
 {
 public:
@@ -55,6 +72,23 @@ public:
     void ScheduleUpdate(CharacterControllerComponent* component);
 
     bool Raycast(const Vector3& origin, const Vector3& direction, float32 distance, physx::PxRaycastCallback& callback);
+
+    /**
+        Batched scene queries.
+        Queries are queued during the frame and executed together in the next Process call after simulation results
+        are fetched, or explicitly with ExecuteScheduledQueries. Large batches are split across worker threads.
+        Every Schedule* method returns index of query result in GetQueryResults() array after execution.
+        Raycasts and sweeps with zero direction are skipped and always report no hit.
+    */
+    uint32 ScheduleRaycast(const Vector3& origin, const Vector3& direction, float32 distance);
+    uint32 ScheduleSweep(const physx::PxGeometry& geometry, const Vector3& position, const Quaternion& orientation, const Vector3& direction, float32 distance);
+    uint32 ScheduleOverlap(const physx::PxGeometry& geometry, const Vector3& position, const Quaternion& orientation);
+    uint32 GetScheduledQueriesCount() const;
+    void ExecuteScheduledQueries();
+
+    /** Results of last executed batch, valid until next execution */
+    const Vector<PhysicsQueryResult>& GetQueryResults() const;
+
     void AddForce(DynamicBodyComponent* component, const Vector3& force, physx::PxForceMode::Enum mode);
 
     PhysicsVehiclesSubsystem* GetVehiclesSystem();
@@ -70,6 +104,7 @@ private:
 
     void ReleaseShape(CollisionShapeComponent* component);
     physx::PxShape* CreateShape(CollisionShapeComponent* component, PhysicsModule* physics);
+    void CookPendingMeshes(PhysicsModule* physics);
 
     void SyncTransformToPhysx();
     void SyncEntityTransformToPhysx(Entity* entity);
@@ -78,6 +113,8 @@ private:
 
     void MoveCharacterControllers(float32 timeElapsed);
 
+    void ExecuteQueries(uint32 begin, uint32 end);
+
 private:
     class SimulationEventCallback : public physx::PxSimulationEventCallback
     {
@@ -131,6 +168,28 @@ private:
     };
 
     Vector<PendingForce> forces;
+
+    struct ScheduledQuery
+    {
+        enum class QueryType : uint8
+        {
+            Raycast,
+            Sweep,
+            Overlap,
+            Skipped
+        };
+
+        QueryType type = QueryType::Raycast;
+        physx::PxGeometryHolder geometry;
+        physx::PxTransform pose;
+        physx::PxVec3 direction;
+        float32 distance = 0.0f;
+    };
+
+    Vector<ScheduledQuery> scheduledQueries;
+    Vector<ScheduledQuery> executingQueries;
+    Vector<PhysicsQueryResult> queryResults;
+
     SimulationEventCallback simulationEventCallback;
 
     bool drawDebugInfo = false;
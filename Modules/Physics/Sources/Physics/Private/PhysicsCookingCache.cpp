@@ -0,0 +1,121 @@
+#include "Physics/PhysicsCookingCache.h"
+
+#include <Base/ScopedPtr.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Thread.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Utils/MD5.h>
+#include <Utils/StringFormat.h>
+
+namespace DAVA
+{
+namespace PhysicsCookingCacheDetail
+{
+// increase to drop all entries cooked by previous versions
+const uint32 CACHE_VERSION = 1;
+}
+
+PhysicsCookingCache::PhysicsCookingCache(const FilePath& directory_, const Vector<uint8>& cookingParams_)
+    : directory(directory_)
+    , cookingParams(cookingParams_)
+{
+    DVASSERT(directory.IsDirectoryPathname());
+    FileSystem::Instance()->CreateDirectory(directory, true);
+}
+
+String PhysicsCookingCache::GetKey(MeshType type, const void* vertices, uint32 verticesSize, const void* indices, uint32 indicesSize) const
+{
+    uint32 header[] = { PhysicsCookingCacheDetail::CACHE_VERSION, static_cast<uint32>(type), verticesSize, indicesSize };
+
+    MD5 md5;
+    md5.Init();
+    md5.Update(reinterpret_cast<const uint8*>(header), sizeof(header));
+    if (cookingParams.empty() == false)
+    {
+        md5.Update(cookingParams.data(), static_cast<uint32>(cookingParams.size()));
+    }
+    if (verticesSize > 0)
+    {
+        md5.Update(static_cast<const uint8*>(vertices), verticesSize);
+    }
+    if (indicesSize > 0)
+    {
+        md5.Update(static_cast<const uint8*>(indices), indicesSize);
+    }
+    md5.Final();
+
+    return MD5::HashToString(md5.GetDigest());
+}
+
+bool PhysicsCookingCache::Load(const String& key, Vector<uint8>& stream) const
+{
+    FilePath path = GetEntryPath(key);
+    if (FileSystem::Instance()->IsFile(path) == false)
+    {
+        return false;
+    }
+
+    return FileSystem::Instance()->ReadFileContents(path, stream) && stream.empty() == false;
+}
+
+void PhysicsCookingCache::Save(const String& key, const Vector<uint8>& stream) const
+{
+    // write to unique temporary file first, so that readers never see partially written entry
+    FilePath path = GetEntryPath(key);
+    FilePath tempPath = directory + Format("%s.%llu.tmp", key.c_str(), static_cast<unsigned long long>(Thread::GetCurrentIdAsUInt64()));
+
+    ScopedPtr<File> file(File::Create(tempPath, File::CREATE | File::WRITE));
+    if (file.get() == nullptr)
+    {
+        Logger::Warning("[PhysicsCookingCache] Can't create %s", tempPath.GetAbsolutePathname().c_str());
+        return;
+    }
+
+    uint32 written = file->Write(stream.data(), static_cast<uint32>(stream.size()));
+    file.reset();
+
+    if (written != stream.size() || FileSystem::Instance()->MoveFile(tempPath, path, true) == false)
+    {
+        Logger::Warning("[PhysicsCookingCache] Can't write %s", path.GetAbsolutePathname().c_str());
+        FileSystem::Instance()->DeleteFile(tempPath);
+    }
+}
+
+void PhysicsCookingCache::Remove(const String& key) const
+{
+    FileSystem::Instance()->DeleteFile(GetEntryPath(key));
+}
+
+PhysicsCookingStats PhysicsCookingCache::GetStats() const
+{
+    LockGuard<Mutex> lock(statsMutex);
+    return stats;
+}
+
+void PhysicsCookingCache::ResetStats()
+{
+    LockGuard<Mutex> lock(statsMutex);
+    stats = PhysicsCookingStats();
+}
+
+void PhysicsCookingCache::AddCookTime(int64 timeUs)
+{
+    LockGuard<Mutex> lock(statsMutex);
+    stats.cookedCount += 1;
+    stats.cookTimeUs += timeUs;
+}
+
+void PhysicsCookingCache::AddLoadTime(int64 timeUs)
+{
+    LockGuard<Mutex> lock(statsMutex);
+    stats.loadedCount += 1;
+    stats.loadTimeUs += timeUs;
+}
+
+FilePath PhysicsCookingCache::GetEntryPath(const String& key) const
+{
+    return directory + (key + ".pxcooked");
+}
+} // namespace DAVA
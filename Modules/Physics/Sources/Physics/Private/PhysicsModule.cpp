@@ -18,12 +18,15 @@
 #include "Physics/PhysicsGeometryCache.h"
 #include "Physics/Private/PhysicsMath.h"
 
+#include <Concurrency/Semaphore.h>
 #include <Engine/Engine.h>
 #include <Engine/EngineContext.h>
+#include <Job/JobManager.h>
 #include <Entity/ComponentManager.h>
 #include <FileSystem/YamlParser.h>
 #include <FileSystem/YamlNode.h>
 #include <FileSystem/FileSystem.h>
+#include <FileSystem/KeyedArchive.h>
 #include <Logger/Logger.h>
 #include <Render/3D/PolygonGroup.h>
 #include <Render/Highlevel/Landscape.h>
@@ -31,6 +34,7 @@
 #include <MemoryManager/MemoryManager.h>
 #include <Reflection/ReflectionRegistrator.h>
 #include <Math/MathConstants.h>
+#include <Time/SystemTimer.h>
 
 #include <physx/PxPhysicsAPI.h>
 #include <PxShared/pvd/PxPvd.h>
@@ -114,6 +118,40 @@ void BuildPhysxMeshInfo(const Vector<PolygonGroup*>& polygons, Vector<physx::PxV
         indexOffset = static_cast<uint32>(vertices.size());
     }
 }
+
+template <typename T>
+void AppendBytes(Vector<uint8>& bytes, const T& value)
+{
+    const uint8* begin = reinterpret_cast<const uint8*>(&value);
+    bytes.insert(bytes.end(), begin, begin + sizeof(T));
+}
+
+Vector<uint8> SerializeCookingParams(const physx::PxCookingParams& params)
+{
+    Vector<uint8> bytes;
+    AppendBytes(bytes, static_cast<uint32>(PX_PHYSICS_VERSION));
+    AppendBytes(bytes, params.areaTestEpsilon);
+    AppendBytes(bytes, params.planeTolerance);
+    AppendBytes(bytes, static_cast<uint32>(params.convexMeshCookingType));
+    AppendBytes(bytes, static_cast<uint8>(params.suppressTriangleMeshRemapTable));
+    AppendBytes(bytes, static_cast<uint8>(params.buildTriangleAdjacencies));
+    AppendBytes(bytes, static_cast<uint8>(params.buildGPUData));
+    AppendBytes(bytes, params.scale.length);
+    AppendBytes(bytes, params.scale.speed);
+    AppendBytes(bytes, static_cast<uint32>(params.meshPreprocessParams));
+    AppendBytes(bytes, params.meshWeldTolerance);
+    AppendBytes(bytes, static_cast<uint32>(params.midphaseDesc.getType()));
+    return bytes;
+}
+
+struct CookingTask
+{
+    const Vector<PolygonGroup*>* polygons = nullptr;
+    PhysicsCookingCache::MeshType type = PhysicsCookingCache::MeshType::TriangleMesh;
+    Vector<uint8> stream;
+    bool cooked = false;
+    bool loadedFromCache = false;
+};
 }
 
 class PhysicsModule::PhysicsAllocator : public physx::PxAllocatorCallback
@@ -218,6 +256,19 @@ void PhysicsModule::Init()
     cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, cookingParams);
     DVASSERT(cooking);
 
+    String cookingCacheDirectory = "~doc:/PhysicsCookingCache/";
+    Engine* engine = Engine::Instance();
+    if (engine != nullptr && engine->GetOptions() != nullptr)
+    {
+        cookingCacheDirectory = engine->GetOptions()->GetString("physics.cookingCacheDirectory", cookingCacheDirectory);
+    }
+    if (cookingCacheDirectory.empty() == false)
+    {
+        FilePath cookingCachePath(cookingCacheDirectory);
+        cookingCachePath.MakeDirectoryPathname();
+        cookingCache = new PhysicsCookingCache(cookingCachePath, PhysicsModuleDetail::SerializeCookingParams(cookingParams));
+    }
+
     PxInitVehicleSDK(*physics);
     PxVehicleSetBasisVectors(PxVec3(0.0f, 0.0f, 1.0f), PxVec3(1.0f, 0.0f, 0.0f));
     PxVehicleSetUpdateMode(PxVehicleUpdateMode::eVELOCITY_CHANGE);
@@ -257,6 +308,7 @@ void PhysicsModule::Shutdown()
         cpuDispatcher->release();
     }
 
+    SafeDelete(cookingCache);
     cooking->release();
     physics->release();
     PhysicsModuleDetail::ReleasePvd(); // PxPvd should be released between PxPhysics and PxFoundation
@@ -347,30 +399,11 @@ physx::PxShape* PhysicsModule::CreateMeshShape(Vector<PolygonGroup*>&& polygons,
     PxBase* mesh = cache->GetTriangleMeshEntry(polygons);
     if (mesh == nullptr)
     {
-        Vector<PxVec3> vertices;
-        Vector<PxU32> indices;
-        PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
-
-        PxTriangleMeshDesc desc;
-        desc.points.count = static_cast<PxU32>(vertices.size());
-        desc.points.stride = sizeof(PxVec3);
-        desc.points.data = vertices.data();
-        desc.triangles.count = static_cast<PxU32>(indices.size() / 3);
-        desc.triangles.stride = 3 * sizeof(PxU32);
-        desc.triangles.data = indices.data();
-        desc.flags = PxMeshFlags(0);
-
-        physx::PxTriangleMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
-        if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+        mesh = CreateMesh(polygons, PhysicsCookingCache::MeshType::TriangleMesh, nullptr, false);
+        if (mesh == nullptr)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
             return nullptr;
         }
-
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
-        mesh = physics->createTriangleMesh(inputStream);
-        DVASSERT(mesh != nullptr);
         cache->AddEntry(polygons, mesh);
     }
     PxTriangleMesh* triangleMesh = mesh->is<PxTriangleMesh>();
@@ -394,10 +427,162 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
     PxBase* mesh = cache->GetConvexHullEntry(polygons);
     if (mesh == nullptr)
     {
-        Vector<PxVec3> vertices;
-        Vector<PxU32> indices;
-        PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
+        mesh = CreateMesh(polygons, PhysicsCookingCache::MeshType::ConvexHull, nullptr, false);
+        if (mesh == nullptr)
+        {
+            return nullptr;
+        }
+        cache->AddEntry(polygons, mesh);
+    }
+
+    PxConvexMesh* convexMesh = mesh->is<PxConvexMesh>();
+    DVASSERT(convexMesh != nullptr);
+    PxMeshScale pxScale(PxVec3(scale.x, scale.y, scale.z), PxQuat(PxIdentity));
+    PxConvexMeshGeometry geometry(convexMesh, pxScale);
+    PxShape* shape = physics->createShape(geometry, *GetMaterial(materialName), true);
+
+    return shape;
+}
+
+void PhysicsModule::CookMeshes(const Vector<Vector<PolygonGroup*>>& triangleMeshes, const Vector<Vector<PolygonGroup*>>& convexHulls, PhysicsGeometryCache* cache) const
+{
+    using namespace PhysicsModuleDetail;
+
+    DVASSERT(cache != nullptr);
+
+    Vector<CookingTask> tasks;
+    tasks.reserve(triangleMeshes.size() + convexHulls.size());
+    for (const Vector<PolygonGroup*>& polygons : triangleMeshes)
+    {
+        if (cache->GetTriangleMeshEntry(polygons) == nullptr)
+        {
+            tasks.emplace_back();
+            tasks.back().polygons = &polygons;
+            tasks.back().type = PhysicsCookingCache::MeshType::TriangleMesh;
+        }
+    }
+    for (const Vector<PolygonGroup*>& polygons : convexHulls)
+    {
+        if (cache->GetConvexHullEntry(polygons) == nullptr)
+        {
+            tasks.emplace_back();
+            tasks.back().polygons = &polygons;
+            tasks.back().type = PhysicsCookingCache::MeshType::ConvexHull;
+        }
+    }
+
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    // Cooking and cache reading are thread safe, PhysX objects are created on calling thread
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr && tasks.size() > 1 && jobManager->GetWorkersCount() > 0)
+    {
+        // one job per worker cooks a range of meshes, so number of queued jobs doesn't depend on number of meshes;
+        // wait for own jobs only, so that unrelated worker jobs don't stall cooking
+        size_t jobsCount = std::min(tasks.size(), static_cast<size_t>(jobManager->GetWorkersCount()));
+        size_t rangeSize = (tasks.size() + jobsCount - 1) / jobsCount;
+        Semaphore cooked;
+        for (size_t begin = 0; begin < tasks.size(); begin += rangeSize)
+        {
+            size_t end = std::min(begin + rangeSize, tasks.size());
+            jobManager->CreateWorkerJob([this, &tasks, begin, end, &cooked]() {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    CookingTask& task = tasks[i];
+                    task.cooked = CookMesh(*task.polygons, task.type, true, task.stream, task.loadedFromCache);
+                }
+                cooked.Post();
+            });
+        }
+        for (size_t begin = 0; begin < tasks.size(); begin += rangeSize)
+        {
+            cooked.Wait();
+        }
+    }
+    else
+    {
+        for (CookingTask& task : tasks)
+        {
+            task.cooked = CookMesh(*task.polygons, task.type, true, task.stream, task.loadedFromCache);
+        }
+    }
+
+    for (CookingTask& task : tasks)
+    {
+        if (task.cooked == false)
+        {
+            continue;
+        }
+
+        // the same polygons set can be requested several times
+        physx::PxBase* mesh = (task.type == PhysicsCookingCache::MeshType::TriangleMesh) ? cache->GetTriangleMeshEntry(*task.polygons) : cache->GetConvexHullEntry(*task.polygons);
+        if (mesh == nullptr)
+        {
+            mesh = CreateMesh(*task.polygons, task.type, &task.stream, task.loadedFromCache);
+            if (mesh != nullptr)
+            {
+                cache->AddEntry(*task.polygons, mesh);
+            }
+        }
+    }
+}
 
+PhysicsCookingCache* PhysicsModule::GetCookingCache() const
+{
+    return cookingCache;
+}
+
+bool PhysicsModule::CookMesh(const Vector<PolygonGroup*>& polygons, PhysicsCookingCache::MeshType type, bool loadFromCache, Vector<uint8>& stream, bool& loadedFromCache) const
+{
+    using namespace physx;
+
+    loadedFromCache = false;
+
+    Vector<PxVec3> vertices;
+    Vector<PxU32> indices;
+    PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
+
+    String key;
+    if (cookingCache != nullptr)
+    {
+        key = cookingCache->GetKey(type, vertices.data(), static_cast<uint32>(vertices.size() * sizeof(PxVec3)), indices.data(), static_cast<uint32>(indices.size() * sizeof(PxU32)));
+        if (loadFromCache == true)
+        {
+            int64 loadStart = SystemTimer::GetUs();
+            if (cookingCache->Load(key, stream) == true)
+            {
+                cookingCache->AddLoadTime(SystemTimer::GetUs() - loadStart);
+                loadedFromCache = true;
+                return true;
+            }
+        }
+    }
+
+    int64 cookStart = SystemTimer::GetUs();
+    PxDefaultMemoryOutputStream outStream;
+    if (type == PhysicsCookingCache::MeshType::TriangleMesh)
+    {
+        PxTriangleMeshDesc desc;
+        desc.points.count = static_cast<PxU32>(vertices.size());
+        desc.points.stride = sizeof(PxVec3);
+        desc.points.data = vertices.data();
+        desc.triangles.count = static_cast<PxU32>(indices.size() / 3);
+        desc.triangles.stride = 3 * sizeof(PxU32);
+        desc.triangles.data = indices.data();
+        desc.flags = PxMeshFlags(0);
+
+        PxTriangleMeshCookingResult::Enum condition;
+        if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+        {
+            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+            return false;
+        }
+    }
+    else
+    {
         PxConvexMeshDesc desc;
         desc.points.count = static_cast<PxU32>(vertices.size());
         desc.points.stride = sizeof(PxVec3);
@@ -408,26 +593,62 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
         desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
 
         PxConvexMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
         if (cooking->cookConvexMesh(desc, outStream, &condition) == false)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
-            return nullptr;
+            Logger::Error("[Physics::CreateConvexHullShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+            return false;
         }
+    }
 
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
-        mesh = physics->createConvexMesh(inputStream);
-        DVASSERT(mesh != nullptr);
-        cache->AddEntry(polygons, mesh);
+    stream.assign(outStream.getData(), outStream.getData() + outStream.getSize());
+
+    if (cookingCache != nullptr)
+    {
+        cookingCache->AddCookTime(SystemTimer::GetUs() - cookStart);
+        cookingCache->Save(key, stream);
     }
 
-    PxConvexMesh* convexMesh = mesh->is<PxConvexMesh>();
-    DVASSERT(convexMesh != nullptr);
-    PxMeshScale pxScale(PxVec3(scale.x, scale.y, scale.z), PxQuat(PxIdentity));
-    PxConvexMeshGeometry geometry(convexMesh, pxScale);
-    PxShape* shape = physics->createShape(geometry, *GetMaterial(materialName), true);
+    return true;
+}
 
-    return shape;
+physx::PxBase* PhysicsModule::CreateMeshFromStream(PhysicsCookingCache::MeshType type, const Vector<uint8>& stream) const
+{
+    physx::PxDefaultMemoryInputData inputStream(const_cast<physx::PxU8*>(stream.data()), static_cast<physx::PxU32>(stream.size()));
+    if (type == PhysicsCookingCache::MeshType::TriangleMesh)
+    {
+        return physics->createTriangleMesh(inputStream);
+    }
+    return physics->createConvexMesh(inputStream);
+}
+
+physx::PxBase* PhysicsModule::CreateMesh(const Vector<PolygonGroup*>& polygons, PhysicsCookingCache::MeshType type, const Vector<uint8>* cookedStream, bool loadedFromCache) const
+{
+    Vector<uint8> stream;
+    if (cookedStream == nullptr)
+    {
+        if (CookMesh(polygons, type, true, stream, loadedFromCache) == false)
+        {
+            return nullptr;
+        }
+        cookedStream = &stream;
+    }
+
+    physx::PxBase* mesh = CreateMeshFromStream(type, *cookedStream);
+    if (mesh == nullptr && loadedFromCache == true)
+    {
+        // cache entry is corrupted or was written by incompatible PhysX build, cook it again and overwrite
+        Logger::Warning("[PhysicsModule] Cooked mesh from %s can't be loaded, cooking it again", cookingCache->GetDirectory().GetAbsolutePathname().c_str());
+
+        Vector<uint8> recookedStream;
+        bool unused = false;
+        if (CookMesh(polygons, type, false, recookedStream, unused) == true)
+        {
+            mesh = CreateMeshFromStream(type, recookedStream);
+        }
+    }
+
+    DVASSERT(mesh != nullptr);
+    return mesh;
 }
 
 physx::PxShape* PhysicsModule::CreateHeightField(Landscape* landscape, const FastName& materialName, Matrix4& localPose) const
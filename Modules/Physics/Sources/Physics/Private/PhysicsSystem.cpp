@@ -29,6 +29,7 @@
 #include <Entity/Component.h>
 
 #include <Base/Type.h>
+#include <Concurrency/Semaphore.h>
 #include <Engine/Engine.h>
 #include <Engine/EngineContext.h>
 #include <ModuleManager/ModuleManager.h>
@@ -44,6 +45,9 @@
 #include <Render/RenderHelper.h>
 #include <FileSystem/KeyedArchive.h>
 #include <Utils/Utils.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+#include <Job/JobManager.h>
 
 #include <physx/PxScene.h>
 #include <physx/PxRigidActor.h>
@@ -58,6 +62,18 @@ namespace DAVA
 {
 namespace PhysicsSystemDetail
 {
+// zero direction can't be normalized, such queries are skipped
+bool NormalizeQueryDirection(const Vector3& direction, physx::PxVec3& result)
+{
+    float32 length = direction.Length();
+    if (length < EPSILON)
+    {
+        return false;
+    }
+    result = PhysicsMath::Vector3ToPxVec3(direction / length);
+    return true;
+}
+
 template <typename T>
 void EraseComponent(T* component, Vector<T*>& pendingComponents, Vector<T*>& components)
 {
@@ -167,6 +183,22 @@ PhysicsComponent* GetParentPhysicsComponent(Entity* entity)
 }
 
 const uint32 DEFAULT_SIMULATION_BLOCK_SIZE = 16 * 1024 * 512;
+const uint32 QUERIES_PER_JOB = 256;
+
+void FillQueryResult(const physx::PxActorShape& hit, PhysicsQueryResult& result)
+{
+    result.hasHit = true;
+    result.body = PhysicsComponent::GetComponent(hit.actor);
+    result.shape = CollisionShapeComponent::GetComponent(hit.shape);
+}
+
+void FillQueryResult(const physx::PxLocationHit& hit, PhysicsQueryResult& result)
+{
+    FillQueryResult(static_cast<const physx::PxActorShape&>(hit), result);
+    result.position = PhysicsMath::PxVec3ToVector3(hit.position);
+    result.normal = PhysicsMath::PxVec3ToVector3(hit.normal);
+    result.distance = hit.distance;
+}
 } // namespace
 
 physx::PxFilterFlags FilterShader(physx::PxFilterObjectAttributes attributes0,
@@ -298,6 +330,8 @@ PhysicsSystem::PhysicsSystem(Scene* scene)
     : SceneSystem(scene)
     , simulationEventCallback(scene->collisionSingleComponent)
 {
+    SetCustomRegistration(true);
+
     Engine* engine = Engine::Instance();
     uint32 threadCount = 2;
     Vector3 gravity(0.0, 0.0, -9.81f);
@@ -612,9 +646,11 @@ void PhysicsSystem::Process(float32 timeElapsed)
         if (isSimulationEnabled == false)
         {
             SyncTransformToPhysx();
+            ExecuteScheduledQueries();
         }
         else
         {
+            ExecuteScheduledQueries();
             ApplyForces();
             DrawDebugInfo();
 
@@ -784,6 +820,7 @@ void PhysicsSystem::InitNewObjects()
     }
     pendingAddPhysicsComponents.clear();
 
+    CookPendingMeshes(physics);
     for (CollisionShapeComponent* component : pendingAddCollisionComponents)
     {
         physx::PxShape* shape = CreateShape(component, physics);
@@ -908,6 +945,69 @@ void PhysicsSystem::AttachShapesRecursively(Entity* entity, PhysicsComponent* bo
     }
 }
 
+void PhysicsSystem::CookPendingMeshes(PhysicsModule* physics)
+{
+    using namespace PhysicsSystemDetail;
+
+    Vector<Vector<PolygonGroup*>> triangleMeshes;
+    Vector<Vector<PolygonGroup*>> convexHulls;
+    for (CollisionShapeComponent* component : pendingAddCollisionComponents)
+    {
+        const Type* componentType = component->GetType();
+        bool isMesh = componentType->Is<MeshShapeComponent>();
+        if (isMesh == false && componentType->Is<ConvexHullShapeComponent>() == false)
+        {
+            continue;
+        }
+
+        Vector<PolygonGroup*> groups;
+        AccumulateMeshInfo(component->GetEntity(), groups);
+        if (groups.empty())
+        {
+            continue;
+        }
+
+        std::sort(groups.begin(), groups.end());
+        groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+
+        Vector<Vector<PolygonGroup*>>& target = isMesh ? triangleMeshes : convexHulls;
+        if (std::find(target.begin(), target.end(), groups) == target.end())
+        {
+            target.push_back(std::move(groups));
+        }
+    }
+
+    // single mesh is cooked on demand in CreateShape
+    if (triangleMeshes.size() + convexHulls.size() < 2)
+    {
+        return;
+    }
+
+    PhysicsCookingCache* cookingCache = physics->GetCookingCache();
+    PhysicsCookingStats statsBefore;
+    if (cookingCache != nullptr)
+    {
+        statsBefore = cookingCache->GetStats();
+    }
+
+    int64 startTime = SystemTimer::GetMs();
+    physics->CookMeshes(triangleMeshes, convexHulls, geometryCache);
+
+    if (cookingCache != nullptr)
+    {
+        PhysicsCookingStats stats = cookingCache->GetStats();
+        uint32 cookedCount = stats.cookedCount - statsBefore.cookedCount;
+        uint32 loadedCount = stats.loadedCount - statsBefore.loadedCount;
+        if (cookedCount + loadedCount > 0)
+        {
+            Logger::Info("[PhysicsSystem] Collision meshes prepared in %lld ms: %u cooked (%lld ms), %u loaded from cache (%lld ms)",
+                         SystemTimer::GetMs() - startTime,
+                         cookedCount, (stats.cookTimeUs - statsBefore.cookTimeUs) / 1000,
+                         loadedCount, (stats.loadTimeUs - statsBefore.loadTimeUs) / 1000);
+        }
+    }
+}
+
 physx::PxShape* PhysicsSystem::CreateShape(CollisionShapeComponent* component, PhysicsModule* physics)
 {
     using namespace PhysicsSystemDetail;
@@ -1135,6 +1235,151 @@ bool PhysicsSystem::Raycast(const Vector3& origin, const Vector3& direction, flo
                                  static_cast<PxReal>(distance), callback);
 }
 
+uint32 PhysicsSystem::ScheduleRaycast(const Vector3& origin, const Vector3& direction, float32 distance)
+{
+    ScheduledQuery query;
+    query.type = ScheduledQuery::QueryType::Raycast;
+    query.pose = physx::PxTransform(PhysicsMath::Vector3ToPxVec3(origin));
+    query.distance = distance;
+    if (!PhysicsSystemDetail::NormalizeQueryDirection(direction, query.direction))
+    {
+        query.type = ScheduledQuery::QueryType::Skipped;
+    }
+
+    scheduledQueries.push_back(query);
+    return static_cast<uint32>(scheduledQueries.size() - 1);
+}
+
+uint32 PhysicsSystem::ScheduleSweep(const physx::PxGeometry& geometry, const Vector3& position, const Quaternion& orientation, const Vector3& direction, float32 distance)
+{
+    ScheduledQuery query;
+    query.type = ScheduledQuery::QueryType::Sweep;
+    query.geometry.storeAny(geometry);
+    query.pose = physx::PxTransform(PhysicsMath::Vector3ToPxVec3(position), PhysicsMath::QuaternionToPxQuat(orientation));
+    query.distance = distance;
+    if (!PhysicsSystemDetail::NormalizeQueryDirection(direction, query.direction))
+    {
+        query.type = ScheduledQuery::QueryType::Skipped;
+    }
+
+    scheduledQueries.push_back(query);
+    return static_cast<uint32>(scheduledQueries.size() - 1);
+}
+
+uint32 PhysicsSystem::ScheduleOverlap(const physx::PxGeometry& geometry, const Vector3& position, const Quaternion& orientation)
+{
+    ScheduledQuery query;
+    query.type = ScheduledQuery::QueryType::Overlap;
+    query.geometry.storeAny(geometry);
+    query.pose = physx::PxTransform(PhysicsMath::Vector3ToPxVec3(position), PhysicsMath::QuaternionToPxQuat(orientation));
+
+    scheduledQueries.push_back(query);
+    return static_cast<uint32>(scheduledQueries.size() - 1);
+}
+
+uint32 PhysicsSystem::GetScheduledQueriesCount() const
+{
+    return static_cast<uint32>(scheduledQueries.size());
+}
+
+void PhysicsSystem::ExecuteScheduledQueries()
+{
+    executingQueries.swap(scheduledQueries);
+    scheduledQueries.clear();
+
+    uint32 queriesCount = static_cast<uint32>(executingQueries.size());
+    queryResults.clear();
+    queryResults.resize(queriesCount);
+    if (queriesCount == 0)
+    {
+        return;
+    }
+
+    // Scene queries are read-only and can be performed concurrently while scene is not modified
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr && queriesCount > PhysicsSystemDetail::QUERIES_PER_JOB && jobManager->GetWorkersCount() > 0)
+    {
+        // wait for own jobs only, so that unrelated worker jobs don't stall the frame
+        Semaphore executed;
+        uint32 jobsCount = 0;
+        uint32 begin = 0;
+        for (; begin + PhysicsSystemDetail::QUERIES_PER_JOB < queriesCount; begin += PhysicsSystemDetail::QUERIES_PER_JOB)
+        {
+            uint32 end = begin + PhysicsSystemDetail::QUERIES_PER_JOB;
+            jobManager->CreateWorkerJob([this, begin, end, &executed]() {
+                ExecuteQueries(begin, end);
+                executed.Post();
+            });
+            ++jobsCount;
+        }
+        ExecuteQueries(begin, queriesCount);
+        for (uint32 i = 0; i < jobsCount; ++i)
+        {
+            executed.Wait();
+        }
+    }
+    else
+    {
+        ExecuteQueries(0, queriesCount);
+    }
+
+    executingQueries.clear();
+}
+
+const Vector<PhysicsQueryResult>& PhysicsSystem::GetQueryResults() const
+{
+    return queryResults;
+}
+
+void PhysicsSystem::ExecuteQueries(uint32 begin, uint32 end)
+{
+    using namespace physx;
+
+    for (uint32 i = begin; i < end; ++i)
+    {
+        const ScheduledQuery& query = executingQueries[i];
+        PhysicsQueryResult& result = queryResults[i];
+
+        switch (query.type)
+        {
+        case ScheduledQuery::QueryType::Raycast:
+        {
+            PxRaycastBuffer hitBuffer;
+            if (physicsScene->raycast(query.pose.p, query.direction, static_cast<PxReal>(query.distance), hitBuffer) && hitBuffer.hasBlock)
+            {
+                PhysicsSystemDetail::FillQueryResult(hitBuffer.block, result);
+            }
+            break;
+        }
+        case ScheduledQuery::QueryType::Sweep:
+        {
+            PxSweepBuffer hitBuffer;
+            if (physicsScene->sweep(query.geometry.any(), query.pose, query.direction, static_cast<PxReal>(query.distance), hitBuffer) && hitBuffer.hasBlock)
+            {
+                PhysicsSystemDetail::FillQueryResult(hitBuffer.block, result);
+            }
+            break;
+        }
+        case ScheduledQuery::QueryType::Overlap:
+        {
+            // overlaps have no order, so any touching shape is reported
+            PxOverlapBuffer hitBuffer;
+            PxQueryFilterData filterData(PxQueryFlag::eDYNAMIC | PxQueryFlag::eSTATIC | PxQueryFlag::eANY_HIT);
+            if (physicsScene->overlap(query.geometry.any(), query.pose, hitBuffer, filterData) && hitBuffer.hasBlock)
+            {
+                PhysicsSystemDetail::FillQueryResult(hitBuffer.block, result);
+            }
+            break;
+        }
+        case ScheduledQuery::QueryType::Skipped:
+            break;
+        default:
+            DVASSERT(false);
+            break;
+        }
+    }
+}
+
 PhysicsVehiclesSubsystem* PhysicsSystem::GetVehiclesSystem()
 {
     return vehiclesSubsystem;
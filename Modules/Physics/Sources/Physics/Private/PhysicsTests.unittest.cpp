@@ -4,6 +4,8 @@
 #include "Physics/DynamicBodyComponent.h"
 #include "Physics/CollisionShapeComponent.h"
 #include "Physics/BoxShapeComponent.h"
+#include "Physics/PhysicsCookingCache.h"
+#include "Physics/PhysicsGeometryCache.h"
 #include "Physics/Private/PhysicsSystemPrivate.h"
 
 #include <Engine/Engine.h>
@@ -11,11 +13,18 @@
 #include <Scene3D/Components/TransformComponent.h>
 #include <Entity/Component.h>
 #include <Concurrency/Thread.h>
+#include <FileSystem/FileSystem.h>
+#include <Job/JobManager.h>
+#include <Render/Highlevel/GeometryGenerator.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
 
 #include <physx/PxScene.h>
 #include <physx/PxActor.h>
 #include <physx/PxRigidStatic.h>
 #include <physx/PxRigidDynamic.h>
+#include <physx/geometry/PxSphereGeometry.h>
+#include <physx/geometry/PxBoxGeometry.h>
 #include <PxShared/foundation/PxFlags.h>
 
 using namespace DAVA;
@@ -271,4 +280,197 @@ DAVA_TESTCLASS (PhysicsTest)
             TEST_VERIFY(objectHit == false);
         }
     }
+    DAVA_TEST (BatchedQueriesTest)
+    {
+        using namespace PhysicsTestDetils;
+        SceneInfo info = CreateScene();
+        Matrix4 localTransform = Matrix4::MakeTranslation(Vector3(90.0f, 0.0f, 0.0f));
+        info.entity->GetComponent<TransformComponent>()->SetLocalTransform(&localTransform);
+
+        StaticBodyComponent* bodyComponent = AttachComponent<StaticBodyComponent>(info);
+        BoxShapeComponent* boxComponent = AttachComponent<BoxShapeComponent>(info);
+        boxComponent->SetHalfSize(Vector3(5.0f, 5.0f, 5.0f));
+        info.scene->transformSystem->Process(0.0f);
+        Frame(info);
+
+        PhysicsSystem* system = info.scene->physicsSystem;
+        uint32 raycastHit = system->ScheduleRaycast(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f), std::numeric_limits<float32>::max());
+        uint32 raycastMiss = system->ScheduleRaycast(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f), 75.0f);
+        uint32 sweepHit = system->ScheduleSweep(physx::PxSphereGeometry(1.0f), Vector3(90.0f, 90.0f, 0.0f), Quaternion(), Vector3(0.0f, -1.0f, 0.0f), 100.0f);
+        uint32 overlapHit = system->ScheduleOverlap(physx::PxBoxGeometry(1.0f, 1.0f, 1.0f), Vector3(94.0f, 0.0f, 0.0f), Quaternion());
+        uint32 overlapMiss = system->ScheduleOverlap(physx::PxBoxGeometry(1.0f, 1.0f, 1.0f), Vector3(0.0f, 0.0f, 0.0f), Quaternion());
+        uint32 raycastZeroDirection = system->ScheduleRaycast(Vector3(85.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f), 100.0f);
+        TEST_VERIFY(system->GetScheduledQueriesCount() == 6);
+
+        system->ExecuteScheduledQueries();
+        TEST_VERIFY(system->GetScheduledQueriesCount() == 0);
+
+        const Vector<PhysicsQueryResult>& results = system->GetQueryResults();
+        TEST_VERIFY(results.size() == 6);
+
+        TEST_VERIFY(results[raycastHit].hasHit == true);
+        TEST_VERIFY(results[raycastHit].body == bodyComponent);
+        TEST_VERIFY(results[raycastHit].shape == boxComponent);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(results[raycastHit].distance, 85.0f, 0.01f));
+
+        TEST_VERIFY(results[raycastMiss].hasHit == false);
+
+        TEST_VERIFY(results[sweepHit].hasHit == true);
+        TEST_VERIFY(results[sweepHit].shape == boxComponent);
+
+        TEST_VERIFY(results[overlapHit].hasHit == true);
+        TEST_VERIFY(results[overlapHit].body == bodyComponent);
+
+        TEST_VERIFY(results[overlapMiss].hasHit == false);
+
+        TEST_VERIFY(results[raycastZeroDirection].hasHit == false);
+    }
+
+    DAVA_TEST (BatchedQueriesBenchmark)
+    {
+        using namespace PhysicsTestDetils;
+        SceneInfo info = CreateScene();
+
+        const int32 gridSize = 16;
+        for (int32 x = 0; x < gridSize; ++x)
+        {
+            for (int32 y = 0; y < gridSize; ++y)
+            {
+                ScopedPtr<Entity> entity(new Entity());
+                Matrix4 localTransform = Matrix4::MakeTranslation(Vector3(x * 10.0f, y * 10.0f, 0.0f));
+                entity->GetComponent<TransformComponent>()->SetLocalTransform(&localTransform);
+                entity->AddComponent(new StaticBodyComponent());
+                BoxShapeComponent* box = new BoxShapeComponent();
+                box->SetHalfSize(Vector3(2.0f, 2.0f, 2.0f));
+                entity->AddComponent(box);
+                info.scene->AddNode(entity);
+            }
+        }
+        info.scene->transformSystem->Process(0.0f);
+        Frame(info);
+
+        PhysicsSystem* system = info.scene->physicsSystem;
+        const uint32 queriesCount = 10000;
+        auto getOrigin = [gridSize](uint32 i) {
+            return Vector3(static_cast<float32>(i % gridSize) * 10.0f, static_cast<float32>((i / gridSize) % gridSize) * 10.0f, 50.0f);
+        };
+
+        uint32 syncHits = 0;
+        int64 syncStart = SystemTimer::GetUs();
+        for (uint32 i = 0; i < queriesCount; ++i)
+        {
+            physx::PxRaycastBuffer hitBuffer;
+            if (system->Raycast(getOrigin(i), Vector3(0.0f, 0.0f, -1.0f), 100.0f, hitBuffer))
+            {
+                ++syncHits;
+            }
+        }
+        int64 syncTime = std::max(SystemTimer::GetUs() - syncStart, int64(1));
+
+        int64 batchStart = SystemTimer::GetUs();
+        for (uint32 i = 0; i < queriesCount; ++i)
+        {
+            system->ScheduleRaycast(getOrigin(i), Vector3(0.0f, 0.0f, -1.0f), 100.0f);
+        }
+        system->ExecuteScheduledQueries();
+        int64 batchTime = std::max(SystemTimer::GetUs() - batchStart, int64(1));
+
+        uint32 batchHits = 0;
+        for (const PhysicsQueryResult& result : system->GetQueryResults())
+        {
+            batchHits += result.hasHit ? 1 : 0;
+        }
+        TEST_VERIFY(batchHits == syncHits);
+        TEST_VERIFY(batchHits == queriesCount);
+
+        Logger::Info("[PhysicsTest] Raycasts per ms: single %.1f, batched %.1f",
+                     queriesCount * 1000.0 / syncTime, queriesCount * 1000.0 / batchTime);
+    }
+
+    DAVA_TEST (CookingCacheTest)
+    {
+        FilePath directory("~doc:/PhysicsCookingCacheTest/");
+        FileSystem::Instance()->DeleteDirectory(directory, true);
+
+        const Vector<uint8> params = { 1, 2, 3 };
+        PhysicsCookingCache cache(directory, params);
+
+        const float32 vertices[] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+        const uint32 indices[] = { 0, 1, 2 };
+        String key = cache.GetKey(PhysicsCookingCache::MeshType::TriangleMesh, vertices, sizeof(vertices), indices, sizeof(indices));
+
+        // miss
+        Vector<uint8> stream;
+        TEST_VERIFY(cache.Load(key, stream) == false);
+
+        // hit
+        const Vector<uint8> cookedStream = { 10, 20, 30, 40 };
+        cache.Save(key, cookedStream);
+        TEST_VERIFY(cache.Load(key, stream) == true);
+        TEST_VERIFY(stream == cookedStream);
+
+        // invalidation by mesh type, source data and cooking parameters
+        TEST_VERIFY(cache.GetKey(PhysicsCookingCache::MeshType::ConvexHull, vertices, sizeof(vertices), indices, sizeof(indices)) != key);
+        const uint32 otherIndices[] = { 0, 2, 1 };
+        TEST_VERIFY(cache.GetKey(PhysicsCookingCache::MeshType::TriangleMesh, vertices, sizeof(vertices), otherIndices, sizeof(otherIndices)) != key);
+        PhysicsCookingCache otherParamsCache(directory, { 1, 2, 4 });
+        String otherParamsKey = otherParamsCache.GetKey(PhysicsCookingCache::MeshType::TriangleMesh, vertices, sizeof(vertices), indices, sizeof(indices));
+        TEST_VERIFY(otherParamsKey != key);
+        TEST_VERIFY(otherParamsCache.Load(otherParamsKey, stream) == false);
+
+        cache.Remove(key);
+        TEST_VERIFY(cache.Load(key, stream) == false);
+
+        FileSystem::Instance()->DeleteDirectory(directory, true);
+    }
+
+    DAVA_TEST (CookMeshesTest)
+    {
+        PhysicsModule* physicsModule = GetEngineContext()->moduleManager->GetModule<PhysicsModule>();
+        PhysicsCookingCache* cookingCache = physicsModule->GetCookingCache();
+
+        // more meshes than workers, so that every cooking job processes several of them
+        const uint32 meshesCount = 2 * GetEngineContext()->jobManager->GetWorkersCount() + 3;
+        Vector<PolygonGroup*> geometries;
+        Vector<Vector<PolygonGroup*>> triangleMeshes;
+        for (uint32 i = 0; i < meshesCount; ++i)
+        {
+            float32 size = 1.0f + 0.01f * static_cast<float32>(i);
+            geometries.push_back(GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(size, size, size)), Map<FastName, float32>()));
+            triangleMeshes.push_back({ geometries.back() });
+        }
+
+        if (cookingCache != nullptr)
+        {
+            cookingCache->ResetStats();
+        }
+        {
+            PhysicsGeometryCache geometryCache;
+            physicsModule->CookMeshes(triangleMeshes, triangleMeshes, &geometryCache);
+            for (const Vector<PolygonGroup*>& polygons : triangleMeshes)
+            {
+                TEST_VERIFY(geometryCache.GetTriangleMeshEntry(polygons) != nullptr);
+                TEST_VERIFY(geometryCache.GetConvexHullEntry(polygons) != nullptr);
+            }
+        }
+
+        if (cookingCache != nullptr)
+        {
+            PhysicsCookingStats stats = cookingCache->GetStats();
+            TEST_VERIFY(stats.cookedCount + stats.loadedCount == 2 * meshesCount);
+
+            // meshes cooked above are loaded from disk cache
+            cookingCache->ResetStats();
+            PhysicsGeometryCache geometryCache;
+            physicsModule->CookMeshes(triangleMeshes, triangleMeshes, &geometryCache);
+            stats = cookingCache->GetStats();
+            TEST_VERIFY(stats.cookedCount == 0);
+            TEST_VERIFY(stats.loadedCount == 2 * meshesCount);
+        }
+
+        for (PolygonGroup* geometry : geometries)
+        {
+            SafeRelease(geometry);
+        }
+    }
 };
@@ -15,6 +15,7 @@ namespace DAVA
 WASDPhysicsControllerSystem::WASDPhysicsControllerSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
 }
 
 void WASDPhysicsControllerSystem::RegisterEntity(Entity* e)
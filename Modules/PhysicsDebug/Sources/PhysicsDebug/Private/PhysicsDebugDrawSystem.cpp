@@ -548,6 +548,8 @@ uint32 PhysicsDebugDrawSystem::vertexLayoutId = static_cast<uint32>(-1);
 PhysicsDebugDrawSystem::PhysicsDebugDrawSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
+
     if (vertexLayoutId == static_cast<uint32>(-1))
     {
         rhi::VertexLayout vertexLayout;
@@ -69,6 +69,10 @@ public:
     static const String Tag;
     static const String TagList;
 
+    static const String Manifest;
+
+    static const String Api;
+
     static const String MakeNameForGPU(eGPUFamily gpuFamily);
 };
 
@@ -63,6 +63,10 @@ const String OptionName::Count("-count");
 const String OptionName::Tag("-tag");
 const String OptionName::TagList("-taglist");
 
+const String OptionName::Manifest("-manifest");
+
+const String OptionName::Api("-api");
+
 const String OptionName::MakeNameForGPU(eGPUFamily gpuFamily)
 {
     return ("-" + GPUFamilyDescriptor::GetGPUName(gpuFamily));
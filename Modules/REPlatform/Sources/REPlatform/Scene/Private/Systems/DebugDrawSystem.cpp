@@ -31,6 +31,8 @@ const float32 DebugDrawSystem::HANGING_OBJECTS_DEFAULT_HEIGHT = 0.001f;
 DebugDrawSystem::DebugDrawSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
+
     drawComponentFunctionsMap[Type::Instance<SoundComponent>()] = MakeFunction(this, &DebugDrawSystem::DrawSoundNode);
     drawComponentFunctionsMap[Type::Instance<WindComponent>()] = MakeFunction(this, &DebugDrawSystem::DrawWindNode);
     drawComponentFunctionsMap[Type::Instance<GeoDecalComponent>()] = MakeFunction(this, &DebugDrawSystem::DrawDecals);
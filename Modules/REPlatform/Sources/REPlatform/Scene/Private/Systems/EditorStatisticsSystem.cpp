@@ -146,6 +146,8 @@ EditorStatisticsSystem::EditorStatisticsSystem(Scene* scene)
     : SceneSystem(scene)
     , binder(new FieldBinder(Deprecated::GetAccessor()))
 {
+    SetCustomRegistration(true);
+
     triangles.resize(eEditorMode::MODE_COUNT);
     for (uint32 m = 0; m < eEditorMode::MODE_COUNT; ++m)
     {
@@ -48,6 +48,8 @@ VisibilityCheckSystem::VisibilityCheckSystem(Scene* scene)
     : SceneSystem(scene)
     , debugMaterial(new NMaterial())
 {
+    SetCustomRegistration(true);
+
     renderer.SetDelegate(this);
     debugMaterial->SetFXName(FastName("~res:/ResourceEditor/LandscapeEditor/Materials/Distance.Debug2D.material"));
     debugMaterial->PreBuildMaterial(PASS_FORWARD);
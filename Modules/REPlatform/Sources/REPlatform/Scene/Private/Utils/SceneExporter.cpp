@@ -6,12 +6,15 @@
 #include <TArc/Utils/RhiEmptyFrame.h>
 #include <AssetCache/AssetCacheClient.h>
 
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Semaphore.h>
 #include <Engine/Engine.h>
 #include <Engine/EngineContext.h>
 #include <FileSystem/FileList.h>
 #include <FileSystem/FilePath.h>
 #include <FileSystem/FileSystem.h>
 #include <Functional/Function.h>
+#include <Job/JobManager.h>
 #include <Logger/Logger.h>
 #include <Particles/ParticleEmitter.h>
 #include <Particles/ParticleLayer.h>
@@ -19,6 +22,9 @@
 #include <Render/GPUFamilyDescriptor.h>
 #include <Render/Highlevel/Heightmap.h>
 #include <Render/Highlevel/Landscape.h>
+#include <Render/Highlevel/RenderBatch.h>
+#include <Render/Highlevel/RenderObject.h>
+#include <Render/3D/MeshUtils.h>
 #include <Render/Image/ImageSystem.h>
 #include <Render/TextureDescriptor.h>
 #include <Scene3D/Components/ComponentHelpers.h>
@@ -34,14 +40,17 @@
 #include <Reflection/ReflectedTypeDB.h>
 
 #include <algorithm>
+#include <atomic>
 
 namespace DAVA
 {
 namespace SceneExporterCache
 {
-const uint32 EXPORTER_VERSION = 1;
+const uint32 EXPORTER_VERSION = 2;
 const uint32 LINKS_PARSER_VERSION = 2;
 const String LINKS_NAME = "links.txt";
+const String MANIFEST_NAME = "manifest.txt";
+const String MANIFEST_LINKS_FOLDER = "links/";
 
 void CalculateSceneKey(const FilePath& scenePathname, const String& sceneLink, AssetCache::CacheItemKey& key, uint32 optimize)
 {
@@ -287,6 +296,56 @@ void PrepareSceneToExport(Scene* scene, bool removeCustomProperties)
     }
 }
 
+void OptimizeMeshes(Scene* scene)
+{
+    using namespace DAVA;
+
+    Vector<Entity*> entities;
+    scene->GetChildNodes(entities);
+
+    // group can be optimized only if all batches draw it entirely
+    Map<PolygonGroup*, FastName> polygonGroups; // group -> name of first entity using it
+    Set<PolygonGroup*> partiallyDrawnGroups;
+    for (Entity* entity : entities)
+    {
+        RenderObject* ro = GetRenderObject(entity);
+        if (ro == nullptr)
+        {
+            continue;
+        }
+
+        for (uint32 i = 0, count = ro->GetRenderBatchCount(); i < count; ++i)
+        {
+            RenderBatch* batch = ro->GetRenderBatch(i);
+            PolygonGroup* pg = batch->GetPolygonGroup();
+            if (pg != nullptr)
+            {
+                polygonGroups.emplace(pg, entity->GetName());
+                // zero index count means that batch draws whole polygon group
+                if (batch->startIndex != 0 || (batch->indexCount != 0 && batch->indexCount < static_cast<uint32>(pg->GetIndexCount())))
+                {
+                    partiallyDrawnGroups.insert(pg);
+                }
+            }
+        }
+    }
+
+    for (const auto& entry : polygonGroups)
+    {
+        PolygonGroup* pg = entry.first;
+        if (partiallyDrawnGroups.count(pg) > 0)
+        {
+            continue;
+        }
+
+        MeshUtils::MeshOptimizationStats stats = MeshUtils::OptimizeMesh(pg);
+        pg->BuildBuffers();
+
+        Logger::Info("Mesh of %s: %u vertices x %u bytes, %u triangles, ACMR %.3f -> %.3f",
+                     entry.second.c_str(), stats.vertexCount, stats.vertexSize, stats.triangleCount, stats.acmrBefore, stats.acmrAfter);
+    }
+}
+
 void CollectHeightmapPathname(Scene* scene, const FilePath& dataSourceFolder, SceneExporter::ExportedObjectCollection& exportedObjects)
 {
     Landscape* landscape = FindLandscape(scene);
@@ -404,6 +463,53 @@ void RemoveDuplicates(SceneExporter::ExportedObjectCollection& exportedObjects)
     exportedObjects.erase(std::unique(exportedObjects.begin(), exportedObjects.end()), exportedObjects.end());
 }
 
+// files written by texture export for every GPU of output, as pathnames in data source folder
+void CollectTextureOutputPathnames(const DAVA::TextureDescriptor& descriptor, const SceneExporter::Params::Output& output, DAVA::Vector<DAVA::FilePath>& pathnames)
+{
+    using namespace DAVA;
+
+    bool shouldSplitHDTextures = (output.useHDTextures && descriptor.dataSettings.GetGenerateMipMaps());
+    for (eGPUFamily gpu : output.exportForGPUs)
+    {
+        if (gpu == eGPUFamily::GPU_ORIGIN)
+        {
+            if (descriptor.IsCubeMap())
+            {
+                Vector<FilePath> faceNames;
+                descriptor.GetFacePathnames(faceNames);
+                for (const FilePath& faceName : faceNames)
+                {
+                    if (faceName.IsEmpty() == false)
+                    {
+                        pathnames.push_back(faceName);
+                    }
+                }
+            }
+            else
+            {
+                pathnames.push_back(descriptor.GetSourceTexturePathname());
+            }
+        }
+        else if (GPUFamilyDescriptor::IsGPUForDevice(gpu))
+        {
+            if (shouldSplitHDTextures)
+            {
+                // hd mips may be skipped for small textures, but remaining mips are always saved into the last file
+                Vector<FilePath> pathnamesForGPU;
+                descriptor.CreateLoadPathnamesForGPU(gpu, pathnamesForGPU);
+                if (pathnamesForGPU.empty() == false)
+                {
+                    pathnames.push_back(pathnamesForGPU.back());
+                }
+            }
+            else
+            {
+                pathnames.push_back(descriptor.CreateMultiMipPathnameForGPU(gpu));
+            }
+        }
+    }
+}
+
 } //namespace SceneExporterDetails
 
 SceneExporter::~SceneExporter() = default;
@@ -414,6 +520,7 @@ void SceneExporter::SetExportingParams(const SceneExporter::Params& exportingPar
 
     DVASSERT(exportingParams.outputs.empty() == false);
     DVASSERT(exportingParams.dataSourceFolder.IsDirectoryPathname());
+    DVASSERT(exportingParams.manifestFolder.IsEmpty() || exportingParams.manifestFolder.IsDirectoryPathname());
 
     for (const Params::Output& output : exportingParams.outputs)
     {
@@ -747,7 +854,15 @@ bool SceneExporter::ExportDescriptor(TextureDescriptor& descriptor, const Params
 
                 if (exportFailed.count(gpu) == 0)
                 {
-                    SceneExporterLocal::CompressNotActualTexture(gpu, output.quality, descriptor);
+                    if (descriptor.IsCubeMap())
+                    { // textures are exported in parallel, but cubemap faces are converted via shared temporary folder
+                        LockGuard<Mutex> lock(cubemapConversionMutex);
+                        SceneExporterLocal::CompressNotActualTexture(gpu, output.quality, descriptor);
+                    }
+                    else
+                    {
+                        SceneExporterLocal::CompressNotActualTexture(gpu, output.quality, descriptor);
+                    }
                 }
             }
             else if (gpu != eGPUFamily::GPU_ORIGIN)
@@ -1010,8 +1125,10 @@ bool SceneExporter::ExportObjects(const ExportedObjectCollection& exportedObject
 
     // divide objects into different collections
     bool exportIsOk = PrepareData(exportedObjects);
+    LoadManifest();
 
     //export scenes only. Add textures, heightmaps to objectsToExport
+    //scenes are exported on main thread, because loading of scene requires render
     const ExportedObjectCollection& scenes = objectsToExport[eExportedObjectType::OBJECT_SCENE];
     for (uint32 i = 0; i < static_cast<uint32>(scenes.size()); ++i)
     {
@@ -1022,7 +1139,7 @@ bool SceneExporter::ExportObjects(const ExportedObjectCollection& exportedObject
         if (alreadyExportedScenes.count(fullScenePath) == 0)
         {
             alreadyExportedScenes.insert(fullScenePath);
-            exportIsOk = ExportSceneObject(scenes[i]) && exportIsOk;
+            exportIsOk = ExportSceneObjectIncremental(scenes[i]) && exportIsOk;
         }
     }
 
@@ -1042,7 +1159,7 @@ bool SceneExporter::ExportObjects(const ExportedObjectCollection& exportedObject
                 CreateFoldersStructure(sceneObject);
 
                 //create folders structure
-                exportIsOk = ExportSceneObject(sceneObject) & exportIsOk;
+                exportIsOk = ExportSceneObjectIncremental(sceneObject) & exportIsOk;
             }
         }
     }
@@ -1051,17 +1168,351 @@ bool SceneExporter::ExportObjects(const ExportedObjectCollection& exportedObject
     for (int32 i = eExportedObjectType::OBJECT_SCENE + 1; i < eExportedObjectType::OBJECT_COUNT; ++i)
     {
         SceneExporterDetails::RemoveDuplicates(objectsToExport[i]);
-        for (const ExportedObject& object : objectsToExport[i])
+        exportIsOk = ExportObjectsParallel(objectsToExport[i], exporters[i]) && exportIsOk;
+    }
+
+    SaveManifest();
+    return exportIsOk;
+}
+
+bool SceneExporter::ExportSceneObjectIncremental(const ExportedObject& object)
+{
+    using namespace DAVA;
+
+    if (exportingParams.manifestFolder.IsEmpty())
+    {
+        return ExportSceneObject(object);
+    }
+
+    // object can be a reference into objectsToExport, that will be modified by export
+    ExportedObject sceneObject = object;
+    String hash = CalculateObjectHash(sceneObject);
+    FilePath linksPathname = GetManifestLinksPathname(sceneObject);
+
+    if (IsObjectUpToDate(sceneObject, hash))
+    {
+        Vector<ExportedObjectCollection> links;
+        if (SceneExporterDetails::LoadExportedObjects(linksPathname, links))
+        {
+            Logger::Info("%s is up to date", sceneObject.relativePathname.c_str());
+            for (size_t i = 0; i < links.size(); ++i)
+            {
+                objectsToExport[i].insert(objectsToExport[i].end(), links[i].begin(), links[i].end());
+            }
+            return true;
+        }
+    }
+
+    Vector<size_t> sizesBeforeExport(objectsToExport.size());
+    for (size_t i = 0; i < objectsToExport.size(); ++i)
+    {
+        sizesBeforeExport[i] = objectsToExport[i].size();
+    }
+
+    bool sceneExported = ExportSceneObject(sceneObject);
+    if (sceneExported)
+    {
+        Vector<ExportedObjectCollection> links(objectsToExport.size());
+        for (size_t i = 0; i < objectsToExport.size(); ++i)
+        {
+            links[i].assign(objectsToExport[i].begin() + sizesBeforeExport[i], objectsToExport[i].end());
+        }
+
+        GetEngineContext()->fileSystem->CreateDirectory(linksPathname.GetDirectory(), true);
+        if (SceneExporterDetails::SaveExportedObjects(linksPathname, links))
+        {
+            MarkObjectExported(sceneObject, hash);
+        }
+    }
+
+    return sceneExported;
+}
+
+bool SceneExporter::ExportObjectsParallel(const ExportedObjectCollection& objects, const Function<bool(const ExportedObject&)>& exporter)
+{
+    using namespace DAVA;
+
+    // folders cache is not thread safe, so create all folders before export
+    for (const ExportedObject& object : objects)
+    {
+        DVASSERT(object.type != eExportedObjectType::OBJECT_SCENE);
+        CreateFoldersStructure(object);
+    }
+
+    bool useManifest = (exportingParams.manifestFolder.IsEmpty() == false);
+    std::atomic<bool> exportIsOk(true);
+    std::atomic<uint32> skippedCount(0);
+
+    auto exportObject = [&](const ExportedObject& object)
+    {
+        String hash;
+        if (useManifest)
+        {
+            hash = CalculateObjectHash(object);
+            if (IsObjectUpToDate(object, hash))
+            {
+                ++skippedCount;
+                return;
+            }
+        }
+
+        if (exporter(object))
+        {
+            if (useManifest)
+            {
+                MarkObjectExported(object, hash);
+            }
+        }
+        else
         {
-            DVASSERT(object.type != eExportedObjectType::OBJECT_SCENE);
-            CreateFoldersStructure(object);
-            exportIsOk = exporters[i](object) && exportIsOk;
+            exportIsOk = false;
+        }
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr && jobManager->GetWorkersCount() > 0 && objects.size() > 1)
+    {
+        // one job per worker takes next objects until all are exported, so number of queued jobs doesn't depend on number of objects;
+        // wait for own jobs only, so that unrelated worker jobs don't stall export
+        uint32 jobsCount = std::min(jobManager->GetWorkersCount(), static_cast<uint32>(objects.size()));
+        std::atomic<size_t> nextObject(0);
+        Semaphore exported;
+        for (uint32 i = 0; i < jobsCount; ++i)
+        {
+            jobManager->CreateWorkerJob([&exportObject, &objects, &nextObject, &exported]() {
+                for (size_t index = nextObject++; index < objects.size(); index = nextObject++)
+                {
+                    exportObject(objects[index]);
+                }
+                exported.Post();
+            });
+        }
+        for (uint32 i = 0; i < jobsCount; ++i)
+        {
+            exported.Wait();
+        }
+    }
+    else
+    {
+        for (const ExportedObject& object : objects)
+        {
+            exportObject(object);
         }
     }
 
+    if (useManifest && objects.empty() == false)
+    {
+        Logger::Info("Exported %u objects, %u objects are up to date", static_cast<uint32>(objects.size()) - skippedCount.load(), skippedCount.load());
+    }
+
     return exportIsOk;
 }
 
+String SceneExporter::CalculateObjectHash(const ExportedObject& object) const
+{
+    using namespace DAVA;
+
+    FilePath sourcePathname = exportingParams.dataSourceFolder + object.relativePathname;
+
+    String params = Format("ExporterVersion: %u", SceneExporterCache::EXPORTER_VERSION);
+    params += Format("SceneFileVersion: %d", SCENE_FILE_CURRENT_VERSION);
+    params += Format("Object: %d,%s", object.type, object.relativePathname.c_str());
+    params += Format("Tag: %s", exportingParams.filenamesTag.c_str());
+    params += Format("Optimized: %u", static_cast<uint32>(exportingParams.optimizeOnExport));
+    for (const Params::Output& output : exportingParams.outputs)
+    {
+        params += Format("Output: %s,%d,%u", output.dataFolder.GetAbsolutePathname().c_str(), output.quality, static_cast<uint32>(output.useHDTextures));
+        for (eGPUFamily gpu : output.exportForGPUs)
+        {
+            params += Format("GPU: %d", gpu);
+        }
+    }
+
+    Vector<FilePath> sources;
+    if (object.type == eExportedObjectType::OBJECT_TEXTURE)
+    {
+        FilePath descriptorPathname = sourcePathname;
+        if (exportingParams.filenamesTag.empty() == false)
+        {
+            FilePath taggedPathname = sourcePathname;
+            taggedPathname.ReplaceBasename(sourcePathname.GetBasename() + exportingParams.filenamesTag);
+            if (GetEngineContext()->fileSystem->Exists(taggedPathname))
+            {
+                descriptorPathname = taggedPathname;
+            }
+        }
+
+        sources.push_back(descriptorPathname);
+
+        std::unique_ptr<TextureDescriptor> descriptor(TextureDescriptor::CreateFromFile(descriptorPathname));
+        if (descriptor)
+        {
+            if (descriptor->IsCubeMap())
+            {
+                descriptor->GetFacePathnames(sources);
+                sources.insert(sources.begin(), descriptorPathname);
+            }
+            else
+            {
+                sources.push_back(descriptor->GetSourceTexturePathname());
+            }
+
+            // compressed files are copied to output as is
+            for (const Params::Output& output : exportingParams.outputs)
+            {
+                for (eGPUFamily gpu : output.exportForGPUs)
+                {
+                    if (GPUFamilyDescriptor::IsGPUForDevice(gpu))
+                    {
+                        sources.push_back(descriptor->CreateMultiMipPathnameForGPU(gpu));
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        sources.push_back(sourcePathname);
+        if (object.type == eExportedObjectType::OBJECT_SLOT_CONFIG && exportingParams.filenamesTag.empty() == false)
+        {
+            FilePath taggedPathname = sourcePathname;
+            taggedPathname.ReplaceBasename(sourcePathname.GetBasename() + exportingParams.filenamesTag);
+            sources.push_back(taggedPathname);
+        }
+    }
+
+    MD5 md5;
+    md5.Init();
+    md5.Update(reinterpret_cast<const uint8*>(params.data()), static_cast<uint32>(params.size()));
+    for (const FilePath& source : sources)
+    {
+        MD5::MD5Digest fileDigest;
+        if (source.IsEmpty() == false && GetEngineContext()->fileSystem->IsFile(source))
+        {
+            MD5::ForFile(source, fileDigest);
+        }
+        md5.Update(fileDigest.digest.data(), static_cast<uint32>(fileDigest.digest.size()));
+    }
+    md5.Final();
+
+    return MD5::HashToString(md5.GetDigest());
+}
+
+bool SceneExporter::IsObjectUpToDate(const ExportedObject& object, const String& hash)
+{
+    using namespace DAVA;
+
+    {
+        LockGuard<Mutex> lock(manifestMutex);
+        auto found = manifest.find(Format("%d,%s", object.type, object.relativePathname.c_str()));
+        if (found == manifest.end() || found->second != hash)
+        {
+            return false;
+        }
+    }
+
+    FileSystem* fileSystem = GetEngineContext()->fileSystem;
+    for (const Params::Output& output : exportingParams.outputs)
+    {
+        if (fileSystem->Exists(output.dataFolder + object.relativePathname) == false)
+        {
+            return false;
+        }
+    }
+
+    // texture descriptor is exported along with images for every GPU
+    if (object.type == eExportedObjectType::OBJECT_TEXTURE)
+    {
+        std::unique_ptr<TextureDescriptor> descriptor(TextureDescriptor::CreateFromFile(exportingParams.dataSourceFolder + object.relativePathname));
+        if (!descriptor)
+        {
+            return false;
+        }
+
+        for (const Params::Output& output : exportingParams.outputs)
+        {
+            Vector<FilePath> pathnames;
+            SceneExporterDetails::CollectTextureOutputPathnames(*descriptor, output, pathnames);
+            for (const FilePath& pathname : pathnames)
+            {
+                if (fileSystem->Exists(output.dataFolder + pathname.GetRelativePathname(exportingParams.dataSourceFolder)) == false)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void SceneExporter::MarkObjectExported(const ExportedObject& object, const String& hash)
+{
+    using namespace DAVA;
+
+    LockGuard<Mutex> lock(manifestMutex);
+    manifest[Format("%d,%s", object.type, object.relativePathname.c_str())] = hash;
+}
+
+void SceneExporter::LoadManifest()
+{
+    using namespace DAVA;
+
+    manifest.clear();
+    if (exportingParams.manifestFolder.IsEmpty())
+    {
+        return;
+    }
+
+    FilePath manifestPathname = exportingParams.manifestFolder + SceneExporterCache::MANIFEST_NAME;
+    ScopedPtr<File> manifestFile(File::Create(manifestPathname, File::OPEN | File::READ));
+    if (!manifestFile)
+    {
+        return;
+    }
+
+    while (manifestFile->IsEof() == false)
+    {
+        // line format is "hash,type,relativePathname"
+        String line = manifestFile->ReadLine();
+        auto dividerPos = line.find(',');
+        if (dividerPos != String::npos)
+        {
+            manifest[line.substr(dividerPos + 1)] = line.substr(0, dividerPos);
+        }
+    }
+}
+
+void SceneExporter::SaveManifest()
+{
+    using namespace DAVA;
+
+    if (exportingParams.manifestFolder.IsEmpty())
+    {
+        return;
+    }
+
+    GetEngineContext()->fileSystem->CreateDirectory(exportingParams.manifestFolder, true);
+
+    FilePath manifestPathname = exportingParams.manifestFolder + SceneExporterCache::MANIFEST_NAME;
+    ScopedPtr<File> manifestFile(File::Create(manifestPathname, File::CREATE | File::WRITE));
+    if (!manifestFile)
+    {
+        Logger::Error("Cannot open manifest file: %s", manifestPathname.GetAbsolutePathname().c_str());
+        return;
+    }
+
+    for (const auto& entry : manifest)
+    {
+        manifestFile->WriteLine(entry.second + "," + entry.first);
+    }
+}
+
+FilePath SceneExporter::GetManifestLinksPathname(const ExportedObject& object) const
+{
+    return exportingParams.manifestFolder + (SceneExporterCache::MANIFEST_LINKS_FOLDER + object.relativePathname + ".links");
+}
+
 bool SceneExporter::PrepareData(const ExportedObjectCollection& exportedObjects)
 {
     objectsToExport.clear();
@@ -1177,6 +1628,10 @@ const Array<SceneExporter::ExportedObjectDesc, SceneExporter::OBJECT_COUNT>& Sce
 void SceneExporter::CollectObjects(Scene* scene, Vector<ExportedObjectCollection>& exportedObjects)
 {
     SceneExporterDetails::PrepareSceneToExport(scene, exportingParams.optimizeOnExport);
+    if (exportingParams.optimizeOnExport)
+    {
+        SceneExporterDetails::OptimizeMeshes(scene);
+    }
 
     SceneExporterDetails::CollectHeightmapPathname(scene, exportingParams.dataSourceFolder, exportedObjects[eExportedObjectType::OBJECT_HEIGHTMAP]); //must be first
     SceneExporterDetails::CollectTextureDescriptors(scene, exportingParams.dataSourceFolder, exportedObjects[eExportedObjectType::OBJECT_TEXTURE]);
@@ -3,6 +3,8 @@
 #include <TextureCompression/TextureConverter.h>
 #include <AssetCache/AssetCache.h>
 
+#include <Concurrency/Mutex.h>
+#include <Functional/Function.h>
 #include <Utils/StringFormat.h>
 
 namespace DAVA
@@ -77,6 +79,10 @@ public:
         String filenamesTag;
 
         bool optimizeOnExport = false;
+
+        // folder for manifest of exported objects. Objects with unchanged sources and params are not exported again.
+        // Incremental export is disabled if folder is empty
+        FilePath manifestFolder;
     };
 
     SceneExporter() = default;
@@ -96,6 +102,16 @@ private:
     bool ExportSlotObject(const ExportedObject& object);
     bool CopyObject(const ExportedObject& object);
 
+    bool ExportSceneObjectIncremental(const ExportedObject& object);
+    bool ExportObjectsParallel(const ExportedObjectCollection& objects, const Function<bool(const ExportedObject&)>& exporter);
+
+    String CalculateObjectHash(const ExportedObject& object) const;
+    bool IsObjectUpToDate(const ExportedObject& object, const String& hash);
+    void MarkObjectExported(const ExportedObject& object, const String& hash);
+    void LoadManifest();
+    void SaveManifest();
+    FilePath GetManifestLinksPathname(const ExportedObject& object) const;
+
     bool ExportSceneFileInternal(const FilePath& scenePathname, const FilePath& outScenePathname, Vector<ExportedObjectCollection>& exportedObjects); //without cache
     bool ExportDescriptor(TextureDescriptor& descriptor, const Params::Output& output);
     bool SplitCompressedFile(const TextureDescriptor& descriptor, eGPUFamily gpu, const Params::Output& output) const;
@@ -114,6 +130,10 @@ private:
     Set<FilePath> alreadyExportedScenes;
 
     UnorderedSet<String> cachedFoldersForCreation;
+
+    UnorderedMap<String, String> manifest; // type and path of object -> hash of its sources and export params
+    Mutex manifestMutex;
+    Mutex cubemapConversionMutex; // PVR converter uses shared temporary files for cubemaps
 };
 
 bool operator==(const SceneExporter::ExportedObject& left, const SceneExporter::ExportedObject& right);
@@ -16,12 +16,16 @@
 #include <Compression/ZipCompressor.h>
 #include <Platform/DeviceInfo.h>
 #include <Time/DateTime.h>
+#include <Time/SystemTimer.h>
 #include <Logger/Logger.h>
 #include <Engine/Engine.h>
 #include <Job/JobManager.h>
+#include <Concurrency/Semaphore.h>
+#include <Functional/Function.h>
 
 #include <sqlite_modern_cpp.h>
 #include <algorithm>
+#include <numeric>
 
 ENUM_DECLARE(DAVA::Compressor::Type)
 {
@@ -116,18 +120,57 @@ Vector<uint8> SpliceFileNames(const Vector<CollectedFile>& collectedFiles)
     return sortedNamesOriginal;
 }
 
+// Run `job` for every index on worker jobs and wait for them. Only own jobs are waited for,
+// and no more than 1000 of them are queued at once (job manager holds 1024 jobs max).
+void RunWorkerJobs(size_t jobsCount, const Function<void(size_t)>& job)
+{
+    const size_t maxQueuedJobs = 1000;
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    DVASSERT(jobManager != nullptr);
+
+    Semaphore finished;
+    for (size_t first = 0; first < jobsCount; first += maxQueuedJobs)
+    {
+        size_t last = std::min(first + maxQueuedJobs, jobsCount);
+        for (size_t index = first; index < last; ++index)
+        {
+            jobManager->CreateWorkerJob([&job, &finished, index]()
+                                        {
+                                            job(index);
+                                            finished.Post();
+                                        });
+        }
+        for (size_t index = first; index < last; ++index)
+        {
+            finished.Wait();
+        }
+    }
+}
+
 MD5::MD5Digest CalculateSourcesMD5(const Vector<CollectedFile>& collectedFiles)
 {
+    // digests of files are calculated in parallel and combined in order of files
+    Vector<MD5::MD5Digest> fileDigests(collectedFiles.size());
+
+    RunWorkerJobs(collectedFiles.size(), [&](size_t fileIndex)
+                  {
+                      if (!collectedFiles[fileIndex].absPath.IsEmpty())
+                      {
+                          MD5::ForFile(collectedFiles[fileIndex].absPath, fileDigests[fileIndex]);
+                      }
+                  });
+
     MD5 md5;
     md5.Init();
-    for (const CollectedFile& collectedFile : collectedFiles)
+    for (size_t fileIndex = 0; fileIndex < collectedFiles.size(); ++fileIndex)
     {
+        const CollectedFile& collectedFile = collectedFiles[fileIndex];
         md5.Update(reinterpret_cast<const uint8*>(collectedFile.archivePath.data()), static_cast<uint32>(collectedFile.archivePath.size()));
 
         if (!collectedFile.absPath.IsEmpty())
         {
-            MD5::MD5Digest fileDigest;
-            MD5::ForFile(collectedFile.absPath, fileDigest);
+            const MD5::MD5Digest& fileDigest = fileDigests[fileIndex];
             md5.Update(fileDigest.digest.data(), static_cast<uint32>(fileDigest.digest.size()));
         }
     }
@@ -442,12 +485,43 @@ const Compressor* GetCompressor(Compressor::Type compressorType)
     }
 }
 
-bool Pack(const Vector<CollectedFile>& collectedFiles,
-          const DAVA::Compressor::Type compressionType,
-          const FilePath& metaDb,
-          File* outputFile,
-          bool dummyFileData)
+bool CompressBuffer(const Compressor* compressor, Compressor::Type compressionType, Vector<uint8>& origBuffer, Vector<uint8>& useBuffer, Compressor::Type& useCompression)
 {
+    if (compressor != nullptr)
+    {
+        Vector<uint8> compressedBuffer;
+        if (!compressor->Compress(origBuffer, compressedBuffer))
+        {
+            return false;
+        }
+
+        if (compressedBuffer.size() < origBuffer.size())
+        {
+            useBuffer = std::move(compressedBuffer);
+            useCompression = compressionType;
+            return true;
+        }
+    }
+
+    // compression is disabled or useless
+    useBuffer = std::move(origBuffer);
+    useCompression = Compressor::Type::None;
+    return true;
+}
+
+void SetPackedData(PackFormat::FileTableEntry& fileEntry, const Vector<uint8>& useBuffer, uint32 useBufferCrc32, Compressor::Type useCompression)
+{
+    fileEntry.startPosition = 0; // later fill this field
+    fileEntry.compressedSize = static_cast<uint32>(useBuffer.size());
+    fileEntry.compressedCrc32 = useBufferCrc32;
+    fileEntry.type = useCompression;
+}
+
+bool Pack(const Vector<CollectedFile>& collectedFiles, const Params& params, File* outputFile)
+{
+    const Compressor::Type compressionType = params.compressionType;
+    const FilePath& metaDb = params.metaDbPath;
+
     // validate input params
     if (collectedFiles.empty())
     {
@@ -498,133 +572,194 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     packFile.filesTable.data.files.resize(numOfFiles);
     Vector<Vector<uint8>> useBuffers;
     useBuffers.resize(numOfFiles);
+    Vector<uint8> solidCandidates(numOfFiles, 0); // not Vector<bool>, flags are written from different jobs
 
     FileSystem* fs = FileSystem::Instance();
-    JobManager* jobManager = GetEngineContext()->jobManager;
-    DVASSERT(jobManager != nullptr);
 
     std::atomic<uint32> countLoadedFiles{ 0 };
 
-    for (uint32 fileIndex = 0; fileIndex < numOfFiles; ++fileIndex)
-    {
-        jobManager->CreateWorkerJob([&, fileIndex]()
-                                    {
-                                        const CollectedFile& collectedFile = collectedFiles[fileIndex];
-                                        PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
-
-                                        Vector<uint8> origFileBuffer;
-                                        Vector<uint8> compressedFileBuffer;
+    RunWorkerJobs(numOfFiles, [&](size_t index)
+                  {
+                      uint32 fileIndex = static_cast<uint32>(index);
+                      const CollectedFile& collectedFile = collectedFiles[fileIndex];
+                      PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
+
+                      Vector<uint8> origFileBuffer;
+
+                      if (params.dummyFileData)
+                      {
+                          origFileBuffer.resize(1);
+                          origFileBuffer[0] = 0;
+                      }
+                      else if (!fs->ReadFileContents(collectedFile.absPath, origFileBuffer))
+                      {
+                          Logger::Error("Can't read contents of: ", collectedFile.absPath.GetAbsolutePathname().c_str());
+                          return;
+                      }
+
+                      fileEntry.originalSize = static_cast<uint32>(origFileBuffer.size());
+                      fileEntry.originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
+                      if (!meta)
+                      {
+                          fileEntry.metaIndex = 0; // do it or your crc32 randomly change on same files
+                      }
+                      else
+                      {
+                          // we have PackArchive with vector of FileInfo's
+                          // from PackArchive we can get fileIndex
+                          // with fileIndex from PackMetaData we can get packIndex
+                          // and later use metaIndex(packIndex) directly from FileInfo
+                          // files table example
+                          //|--------------------------------------|
+                          //|file_path(sorted)----------|pack_index|
+                          //|3d/gfx/uber_file.pvr       |         0|
+                          //|--------------------------------------|
+                          // packs table example
+                          //|--------------------------------------|
+                          //|pack_index|pack_name-----|pack_dep----|
+                          //|         0|group_pack_1  |group_pack_0|
+                          //|--------------------------------------|
+                          // so packIndex(metaIndex) is duplicated in FileInfo's for now.
+                          fileEntry.metaIndex = meta->GetPackIndexForFile(fileIndex);
+                      }
+
+                      bool useCompressor = (compressor != nullptr && !params.dummyFileData && !origFileBuffer.empty());
+                      if (useCompressor && params.solidBlockSize > 0 && origFileBuffer.size() < params.solidFileMaxSize)
+                      {
+                          // small file will be compressed later together with neighbour files
+                          solidCandidates[fileIndex] = 1;
+                          useBuffers[fileIndex] = std::move(origFileBuffer);
+                          ++countLoadedFiles;
+                          return;
+                      }
+
+                      Vector<uint8> useBuffer;
+                      Compressor::Type useCompression = Compressor::Type::None;
+                      if (!CompressBuffer(useCompressor ? compressor : nullptr, compressionType, origFileBuffer, useBuffer, useCompression))
+                      {
+                          Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
+                          return;
+                      }
+
+                      SetPackedData(fileEntry, useBuffer, CRC32::ForBuffer(useBuffer.data(), useBuffer.size()), useCompression);
+                      useBuffers[fileIndex] = std::move(useBuffer);
+                      ++countLoadedFiles;
+                  });
 
-                                        bool useCompressedBuffer = (compressionType != Compressor::Type::None);
-                                        Compressor::Type useCompression = compressionType;
-
-                                        if (dummyFileData)
-                                        {
-                                            origFileBuffer.resize(1);
-                                            origFileBuffer[0] = 0;
+    if (numOfFiles != countLoadedFiles)
+    {
+        return false;
+    }
 
-                                            useCompressedBuffer = false;
-                                            useCompression = Compressor::Type::None;
-                                        }
-                                        else
-                                        {
-                                            if (!fs->ReadFileContents(collectedFile.absPath, origFileBuffer))
-                                            {
-                                                Logger::Error("Can't read contents of: ", collectedFile.absPath.GetAbsolutePathname().c_str());
-                                                return;
-                                            }
-
-                                            if (origFileBuffer.empty())
-                                            {
-                                                useCompressedBuffer = false;
-                                                useCompression = Compressor::Type::None;
-                                            }
-
-                                            if (useCompressedBuffer)
-                                            {
-                                                if (!compressor->Compress(origFileBuffer, compressedFileBuffer))
-                                                {
-                                                    Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
-                                                    return;
-                                                }
-
-                                                if (compressedFileBuffer.size() < origFileBuffer.size())
-                                                {
-                                                    useCompressedBuffer = true;
-                                                }
-                                                else
-                                                {
-                                                    useCompressedBuffer = false;
-                                                    useCompression = Compressor::Type::None;
-                                                }
-                                            }
-                                        }
-
-                                        Vector<uint8>& useBuffer = (useCompressedBuffer ? compressedFileBuffer : origFileBuffer);
-
-                                        fileEntry.startPosition = 0; // later fill this field
-                                        fileEntry.originalSize = static_cast<uint32>(origFileBuffer.size());
-                                        fileEntry.compressedSize = static_cast<uint32>(useBuffer.size());
-                                        fileEntry.type = useCompression;
-                                        fileEntry.compressedCrc32 = CRC32::ForBuffer(useBuffer.data(), useBuffer.size());
-                                        fileEntry.originalCrc32 = CRC32::ForBuffer(origFileBuffer.data(), origFileBuffer.size());
-                                        if (!meta)
-                                        {
-                                            fileEntry.metaIndex = 0; // do it or your crc32 randomly change on same files
-                                        }
-                                        else
-                                        {
-                                            // we have PackArchive with vector of FileInfo's
-                                            // from PackArchive we can get fileIndex
-                                            // with fileIndex from PackMetaData we can get packIndex
-                                            // and later use metaIndex(packIndex) directly from FileInfo
-                                            // files table example
-                                            //|--------------------------------------|
-                                            //|file_path(sorted)----------|pack_index|
-                                            //|3d/gfx/uber_file.pvr       |         0|
-                                            //|--------------------------------------|
-                                            // packs table example
-                                            //|--------------------------------------|
-                                            //|pack_index|pack_name-----|pack_dep----|
-                                            //|         0|group_pack_1  |group_pack_0|
-                                            //|--------------------------------------|
-                                            // so packIndex(metaIndex) is duplicated in FileInfo's for now.
-                                            fileEntry.metaIndex = meta->GetPackIndexForFile(fileIndex);
-                                        }
-                                        useBuffers[fileIndex] = std::move(useBuffer);
-                                        ++countLoadedFiles;
-                                    });
-
-        //HACK wait jobs executed (internaly 1024 max jobs)
-        if (fileIndex > 0 && fileIndex % 1000 == 0)
-        {
-            jobManager->WaitWorkerJobs();
+    // group neighbour small files into solid blocks, block with single file is packed as usual file.
+    // Files of different packs are never grouped, so that every pack can still be extracted on its own
+    const Vector<PackFormat::FileTableEntry>& fileEntries = packFile.filesTable.data.files;
+    Vector<PackFormat::SolidBlockEntry> solidRuns;
+    for (uint32 fileIndex = 0; fileIndex < numOfFiles;)
+    {
+        if (solidCandidates[fileIndex] == 0)
+        {
+            ++fileIndex;
+            continue;
         }
-    } // end for fileIndex
-
-    jobManager->WaitWorkerJobs();
 
-    if (numOfFiles != countLoadedFiles)
+        PackFormat::SolidBlockEntry run = { fileIndex, 0 };
+        size_t runSize = 0;
+        while (fileIndex < numOfFiles && solidCandidates[fileIndex] != 0 && runSize < params.solidBlockSize
+               && fileEntries[fileIndex].metaIndex == fileEntries[run.firstFile].metaIndex)
+        {
+            runSize += useBuffers[fileIndex].size();
+            ++run.numFiles;
+            ++fileIndex;
+        }
+        solidRuns.push_back(run);
+    }
+
+    Vector<Vector<uint8>> runBuffers;
+    runBuffers.resize(solidRuns.size());
+    std::atomic<uint32> countCompressedRuns{ 0 };
+
+    RunWorkerJobs(solidRuns.size(), [&](size_t runIndex)
+                  {
+                      const PackFormat::SolidBlockEntry& run = solidRuns[runIndex];
+
+                      Vector<uint8> origRunBuffer;
+                      for (uint32 fileIndex = run.firstFile; fileIndex < run.firstFile + run.numFiles; ++fileIndex)
+                      {
+                          origRunBuffer.insert(origRunBuffer.end(), useBuffers[fileIndex].begin(), useBuffers[fileIndex].end());
+                          Vector<uint8>().swap(useBuffers[fileIndex]); // free memory
+                      }
+
+                      Vector<uint8> runBuffer;
+                      Compressor::Type useCompression = Compressor::Type::None;
+                      if (!CompressBuffer(compressor, compressionType, origRunBuffer, runBuffer, useCompression))
+                      {
+                          Logger::Error("Can't compress solid block of: %s", collectedFiles[run.firstFile].absPath.GetAbsolutePathname().c_str());
+                          return;
+                      }
+
+                      uint32 runBufferCrc32 = CRC32::ForBuffer(runBuffer.data(), runBuffer.size());
+                      for (uint32 fileIndex = run.firstFile; fileIndex < run.firstFile + run.numFiles; ++fileIndex)
+                      {
+                          SetPackedData(packFile.filesTable.data.files[fileIndex], runBuffer, runBufferCrc32, useCompression);
+                      }
+                      runBuffers[runIndex] = std::move(runBuffer);
+                      ++countCompressedRuns;
+                  });
+
+    if (solidRuns.size() != countCompressedRuns)
     {
         return false;
     }
 
     // write all compressed content to output file and set startPosition fileEntry
-    for (size_t fileIndex = 0, dataOffset = 0; fileIndex < numOfFiles; ++fileIndex)
+    for (size_t fileIndex = 0, runIndex = 0, dataOffset = 0; fileIndex < numOfFiles;)
     {
-        PackFormat::FileTableEntry& fileEntry = packFile.filesTable.data.files[fileIndex];
-        fileEntry.startPosition = dataOffset;
+        const Vector<uint8>* useBuffer = &useBuffers[fileIndex];
+        uint32 numFilesInBuffer = 1;
+        if (runIndex < solidRuns.size() && solidRuns[runIndex].firstFile == fileIndex)
+        {
+            useBuffer = &runBuffers[runIndex];
+            numFilesInBuffer = solidRuns[runIndex].numFiles;
+            ++runIndex;
+        }
 
-        const Vector<uint8>& useBuffer = useBuffers[fileIndex];
-        if (!WriteRawData(outputFile, useBuffer))
+        for (uint32 i = 0; i < numFilesInBuffer; ++i)
+        {
+            packFile.filesTable.data.files[fileIndex + i].startPosition = dataOffset;
+        }
+
+        if (!WriteRawData(outputFile, *useBuffer))
         {
             Logger::Error("can't write buffer to output file");
             return false;
         }
-        dataOffset += useBuffer.size();
+        dataOffset += useBuffer->size();
+        fileIndex += numFilesInBuffer;
     }
     useBuffers.clear();
     useBuffers.shrink_to_fit(); // free memory
+    runBuffers.clear();
+    runBuffers.shrink_to_fit();
+
+    PackFormat::PackFile::FooterBlock& footerBlock = packFile.footer;
+
+    Vector<PackFormat::SolidBlockEntry>& solidBlocks = packFile.solidBlocks.blocks;
+    std::copy_if(solidRuns.begin(), solidRuns.end(), std::back_inserter(solidBlocks), [](const PackFormat::SolidBlockEntry& run) { return run.numFiles > 1; });
+    if (!solidBlocks.empty())
+    {
+        const uint32 solidBlocksSize = static_cast<uint32>(solidBlocks.size() * sizeof(PackFormat::SolidBlockEntry));
+        if (outputFile->Write(solidBlocks.data(), solidBlocksSize) != solidBlocksSize)
+        {
+            Logger::Error("Can't write solid blocks table");
+            return false;
+        }
+
+        footerBlock.solidBlocksSize = solidBlocksSize;
+        footerBlock.solidBlocksCrc32 = CRC32::ForBuffer(solidBlocks.data(), solidBlocksSize);
+
+        Logger::Info("%u files are packed into %u solid blocks", std::accumulate(solidBlocks.begin(), solidBlocks.end(), 0u, [](uint32 sum, const PackFormat::SolidBlockEntry& block) { return sum + block.numFiles; }), static_cast<uint32>(solidBlocks.size()));
+    }
 
     Vector<uint8> metaBytes;
     if (meta)
@@ -636,7 +771,6 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
         }
     }
 
-    PackFormat::PackFile::FooterBlock& footerBlock = packFile.footer;
     PackFormat::PackFile::FilesTableBlock::Names& namesBlock = packFile.filesTable.names;
     PackFormat::PackFile::FilesTableBlock::FilesData& filesDataBlock = packFile.filesTable.data;
 
@@ -718,8 +852,9 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     return true;
 }
 
-bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type compressionType, const FilePath& archivePath, const FilePath& metaDb, bool dummyFileData)
+bool Pack(const Vector<CollectedFile>& collectedFiles, const Params& params)
 {
+    const FilePath& archivePath = params.archivePath;
     ScopedPtr<File> outputFile(File::Create(archivePath, File::CREATE | File::WRITE));
     if (!outputFile)
     {
@@ -727,7 +862,7 @@ bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type co
         return false;
     }
 
-    if (!Pack(collectedFiles, compressionType, metaDb, outputFile, dummyFileData))
+    if (!Pack(collectedFiles, params, outputFile))
     {
         outputFile.reset();
         if (!FileSystem::Instance()->DeleteFile(archivePath))
@@ -756,8 +891,13 @@ bool CreateArchive(const Params& params)
         return false;
     }
 
-    if (Pack(collectedFiles, params.compressionType, params.archivePath, params.metaDbPath, params.dummyFileData))
+    int64 startTime = SystemTimer::GetMs();
+    if (Pack(collectedFiles, params))
     {
+        uint64 archiveSize = 0;
+        FileSystem::Instance()->GetFileSize(params.archivePath, archiveSize);
+        Logger::Info("%s is packed in %lld ms: %u files, %llu bytes", params.archivePath.GetAbsolutePathname().c_str(),
+                     static_cast<long long>(SystemTimer::GetMs() - startTime), static_cast<uint32>(collectedFiles.size()), static_cast<unsigned long long>(archiveSize));
         return true;
     }
 
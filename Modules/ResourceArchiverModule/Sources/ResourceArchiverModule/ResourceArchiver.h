@@ -14,6 +14,12 @@ struct Params
     FilePath baseDirPath;
     FilePath metaDbPath;
     bool dummyFileData = false;
+
+    // small neighbour files are compressed together into shared solid blocks of this original size.
+    // Blocks never mix files of different packs from metaDbPath.
+    // Archives with solid blocks are meant for local use: such files can't be downloaded one by one. 0 - disabled
+    uint32 solidBlockSize = 0;
+    uint32 solidFileMaxSize = 64 * 1024; // only files smaller than this are packed into solid blocks
 };
 
 bool CreateArchive(const Params& params);
@@ -0,0 +1,51 @@
+#include "TexturePacker/Private/ParallelTasks.h"
+
+#include <Base/RefPtr.h>
+#include <Concurrency/Thread.h>
+
+#include <atomic>
+
+namespace DAVA
+{
+namespace TexturePackerDetails
+{
+void RunInParallel(uint32 tasksCount, uint32 threadsCount, const Function<void(uint32)>& task)
+{
+    threadsCount = std::min(threadsCount, tasksCount);
+    if (threadsCount <= 1)
+    {
+        for (uint32 i = 0; i < tasksCount; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<uint32> nextTask = { 0 };
+    auto worker = [&nextTask, tasksCount, &task]()
+    {
+        for (uint32 i = nextTask++; i < tasksCount; i = nextTask++)
+        {
+            task(i);
+        }
+    };
+
+    Vector<RefPtr<Thread>> threads;
+    threads.reserve(threadsCount - 1);
+    for (uint32 i = 1; i < threadsCount; ++i)
+    {
+        RefPtr<Thread> thread(Thread::Create(worker));
+        thread->SetName("TexturePacker worker");
+        thread->Start();
+        threads.push_back(thread);
+    }
+
+    worker();
+
+    for (RefPtr<Thread>& thread : threads)
+    {
+        thread->Join();
+    }
+}
+} // namespace TexturePackerDetails
+} // namespace DAVA
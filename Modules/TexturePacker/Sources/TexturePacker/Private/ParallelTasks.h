@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Functional/Function.h>
+
+namespace DAVA
+{
+namespace TexturePackerDetails
+{
+/**
+    Run `task` for every index in [0, tasksCount) on up to `threadsCount` threads.
+    Calling thread takes part in execution, so `threadsCount` <= 1 means serial execution in order.
+    Function returns when all tasks are finished.
+*/
+void RunInParallel(uint32 tasksCount, uint32 threadsCount, const Function<void(uint32)>& task);
+} // namespace TexturePackerDetails
+} // namespace DAVA
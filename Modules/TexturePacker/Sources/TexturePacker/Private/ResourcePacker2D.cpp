@@ -1,6 +1,7 @@
 #include "TexturePacker/ResourcePacker2D.h"
 #include "TexturePacker/DefinitionFile.h"
 #include "TexturePacker/TexturePacker.h"
+#include "TexturePacker/Private/ParallelTasks.h"
 
 #include <CommandLine/CommandLineParser.h>
 #include <Engine/Engine.h>
@@ -25,6 +26,8 @@ const String ResourcePacker2D::INTERNAL_LIBPSD_VERSION = "0.0.1";
 
 namespace ResourcePacker2DDetails
 {
+const uint32 REPORTED_DIRECTORIES_COUNT = 10;
+
 List<FilePath> ReadIgnoresList(const FilePath& ignoresListPath, const FilePath& baseDir)
 {
     List<FilePath> result;
@@ -191,6 +194,7 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
 
     requestedGPUs = forGPUs;
     outputDirModified = false;
+    packTimes.clear();
 
     gfxDirName = inputGfxDirectory.GetLastDirectoryName();
     std::transform(gfxDirName.begin(), gfxDirName.end(), gfxDirName.begin(), ::tolower);
@@ -231,6 +235,8 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
 
     // Put latest md5 after convertation
     RecalculateDirMD5(outputGfxDirectory, processDirectoryPath + gfxDirName + ".md5", true);
+
+    LogPackTimes();
 }
 
 void ResourcePacker2D::RecalculateMD5ForOutputDir()
@@ -375,7 +381,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         return;
     }
 
-    uint64 packTime = SystemTimer::GetMs();
+    const uint64 startTime = SystemTimer::GetMs();
 
     String inputRelativePath = inputDir.GetRelativePathname(rootDirectory);
     FilePath processDir = rootDirectory + GetProcessFolderName() + inputRelativePath;
@@ -558,40 +564,62 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
                 }
 
-                DefinitionFile::Collection definitionFileList;
+                Vector<PickedFile*> definitionSourceList;
                 Vector<PickedFile*> justCopyList;
-                definitionFileList.reserve(pickedFiles.size());
                 for (PickedFile& file : pickedFiles)
                 {
-                    if (cancelled)
-                    {
-                        break;
-                    }
-
-                    DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
-
-                    bool shouldAcceptFile = false;
-
-                    FilePath path = fileList->GetPathname(file.index);
-                    if (CompareCaseInsensitive(file.ext, ".psd") == 0)
-                    {
-                        shouldAcceptFile = defFile->LoadPSD(path, processDir, maxTextureSize,
-                                                            withAlpha, useLayerNames, verbose, file.outBasename);
-                    }
-                    else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
+                    if (CompareCaseInsensitive(file.ext, ".psd") == 0
+                        || CompareCaseInsensitive(file.ext, ".pngdef") == 0
+                        || TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
                     {
-                        shouldAcceptFile = defFile->LoadPNGDef(path, processDir, file.outBasename);
-                    }
-                    else if (TextureDescriptor::IsSupportedTextureExtension(file.ext) == true)
-                    {
-                        shouldAcceptFile = defFile->LoadImage(path, processDir, file.outBasename);
+                        definitionSourceList.push_back(&file);
                     }
                     else
                     {
                         justCopyList.push_back(&file);
                     }
+                }
 
-                    if (shouldAcceptFile)
+                // every source is loaded into its own slot, so order of definitions doesn't depend on threads count
+                DefinitionFile::Collection loadedFileList(definitionSourceList.size());
+                TexturePackerDetails::RunInParallel(static_cast<uint32>(definitionSourceList.size()), threadsCount, [&](uint32 index)
+                                                    {
+                                                        if (cancelled)
+                                                        {
+                                                            return;
+                                                        }
+
+                                                        const PickedFile& file = *definitionSourceList[index];
+                                                        DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
+
+                                                        bool shouldAcceptFile = false;
+
+                                                        FilePath path = fileList->GetPathname(file.index);
+                                                        if (CompareCaseInsensitive(file.ext, ".psd") == 0)
+                                                        {
+                                                            shouldAcceptFile = defFile->LoadPSD(path, processDir, maxTextureSize,
+                                                                                                withAlpha, useLayerNames, verbose, file.outBasename);
+                                                        }
+                                                        else if (CompareCaseInsensitive(file.ext, ".pngdef") == 0)
+                                                        {
+                                                            shouldAcceptFile = defFile->LoadPNGDef(path, processDir, file.outBasename);
+                                                        }
+                                                        else
+                                                        {
+                                                            shouldAcceptFile = defFile->LoadImage(path, processDir, file.outBasename);
+                                                        }
+
+                                                        if (shouldAcceptFile)
+                                                        {
+                                                            loadedFileList[index] = defFile;
+                                                        }
+                                                    });
+
+                DefinitionFile::Collection definitionFileList;
+                definitionFileList.reserve(loadedFileList.size());
+                for (const DefinitionFile::Pointer& defFile : loadedFileList)
+                {
+                    if (defFile)
                     {
                         definitionFileList.push_back(defFile);
                     }
@@ -620,6 +648,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     packer.SetTexturesMargin(marginInPixels);
                     packer.SetAlgorithms(packAlgorithms);
                     packer.SetTexturePostfix(texturePostfix);
+                    packer.SetThreadsCount(threadsCount);
 
                     if (CommandLineParser::Instance()->IsFlagSet("--split"))
                     {
@@ -647,7 +676,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     }
                 }
 
-                packTime = SystemTimer::GetMs() - packTime;
+                uint64 packTime = SystemTimer::GetMs() - startTime;
 
                 if (Engine::Instance()->IsConsoleMode())
                 {
@@ -672,6 +701,8 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         Logger::Info("[%s] - unchanged", inputDir.GetAbsolutePathname().c_str());
     }
 
+    packTimes.push_back({ inputDir, SystemTimer::GetMs() - startTime });
+
     const auto& flagsToPass = CommandLineParser::Instance()->IsFlagSet("--recursive") ? currentFlags : passedFlags;
 
     for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
@@ -723,6 +754,11 @@ void DAVA::ResourcePacker2D::SetAllTags(const Vector<String>& tags)
     allTags = tags;
 }
 
+void ResourcePacker2D::SetThreadsCount(uint32 threadsCount_)
+{
+    threadsCount = std::max(threadsCount_, 1u);
+}
+
 void ResourcePacker2D::SetIgnoresFile(const String& ignoresPath)
 {
     ignoresListPath = ignoresPath;
@@ -826,12 +862,47 @@ const Set<String>& ResourcePacker2D::GetErrors() const
     return errors;
 }
 
+const Vector<ResourcePacker2D::DirectoryPackTime>& ResourcePacker2D::GetPackTimes() const
+{
+    return packTimes;
+}
+
 void ResourcePacker2D::AddError(const String& errorMsg)
 {
     Logger::Error(errorMsg.c_str());
     errors.insert(errorMsg);
 }
 
+void ResourcePacker2D::LogPackTimes() const
+{
+    using namespace ResourcePacker2DDetails;
+
+    if (packTimes.empty())
+    {
+        return;
+    }
+
+    Vector<DirectoryPackTime> sortedTimes = packTimes;
+    std::stable_sort(sortedTimes.begin(), sortedTimes.end(), [](const DirectoryPackTime& l, const DirectoryPackTime& r)
+                     {
+                         return l.timeMs > r.timeMs;
+                     });
+
+    uint64 totalTime = 0;
+    for (const DirectoryPackTime& packTime : sortedTimes)
+    {
+        totalTime += packTime.timeMs;
+    }
+
+    Logger::Info("[Packing time: %u directories, %.2lf secs, %u threads]", static_cast<uint32>(sortedTimes.size()), static_cast<float64>(totalTime) / 1000.0, threadsCount);
+
+    size_t reportedCount = std::min(sortedTimes.size(), static_cast<size_t>(REPORTED_DIRECTORIES_COUNT));
+    for (size_t i = 0; i < reportedCount; ++i)
+    {
+        Logger::Info("    %.2lf secs - %s", static_cast<float64>(sortedTimes[i].timeMs) / 1000.0, sortedTimes[i].directory.GetAbsolutePathname().c_str());
+    }
+}
+
 bool ResourcePacker2D::IsUsingCache() const
 {
 #ifdef __DAVAENGINE_WIN_UAP__
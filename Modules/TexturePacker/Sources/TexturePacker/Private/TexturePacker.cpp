@@ -4,8 +4,10 @@
 #include "TexturePacker/DefinitionFile.h"
 #include "TextureCompression/TextureConverter.h"
 #include "TexturePacker/FramePathHelper.h"
+#include "TexturePacker/Private/ParallelTasks.h"
 
 #include <CommandLine/CommandLineParser.h>
+#include <Concurrency/LockGuard.h>
 #include <Render/TextureDescriptor.h>
 #include <Render/GPUFamilyDescriptor.h>
 #include <Render/PixelFormatDescriptor.h>
@@ -70,10 +72,13 @@ void TexturePacker::PackToTexturesSeparate(const FilePath& outputPath, const Def
 {
     Logger::FrameworkDebug("Packing to separate textures");
 
-    for (const DefinitionFile::Pointer& defFile : defsList)
-    {
-        PackToMultipleTextures(outputPath, defFile->filename.GetBasename().c_str(), { defFile }, forGPUs);
-    }
+    // every definition file has its own sheets, so they are packed and exported independently
+    Vector<ImageExportKeys> imageExportKeys = GetExportKeys(forGPUs);
+    TexturePackerDetails::RunInParallel(static_cast<uint32>(defsList.size()), threadsCount, [&](uint32 index)
+                                        {
+                                            const DefinitionFile::Pointer& defFile = defsList[index];
+                                            PackSheets(outputPath, defFile->filename.GetBasename().c_str(), { defFile }, imageExportKeys, 1);
+                                        });
 }
 
 void TexturePacker::PackToTextures(const FilePath& outputPath, const DefinitionFile::Collection& defsList, const Vector<eGPUFamily>& forGPUs)
@@ -84,12 +89,17 @@ void TexturePacker::PackToTextures(const FilePath& outputPath, const DefinitionF
 void TexturePacker::PackToMultipleTextures(const FilePath& outputPath, const char* basename, const DefinitionFile::Collection& defList, const Vector<eGPUFamily>& forGPUs)
 {
     Vector<ImageExportKeys> imageExportKeys = GetExportKeys(forGPUs);
+    PackSheets(outputPath, basename, defList, imageExportKeys, threadsCount);
+}
+
+void TexturePacker::PackSheets(const FilePath& outputPath, const char* basename, const DefinitionFile::Collection& defList, const Vector<ImageExportKeys>& imageExportKeys, uint32 exportThreadsCount)
+{
     std::unique_ptr<RectanglePacker::PackTask> packTask = CreatePackTask(defList, imageExportKeys);
     std::unique_ptr<const RectanglePacker::PackResult> packResult = rectanglePacker.Pack(*packTask);
     if (packResult->Success())
     {
         DVASSERT(packResult->resultIndexedSprites.size() == defList.size());
-        SaveResultSheets(outputPath, basename, *packResult, imageExportKeys);
+        SaveResultSheets(outputPath, basename, *packResult, imageExportKeys, exportThreadsCount);
     }
     else
     {
@@ -111,7 +121,7 @@ std::unique_ptr<RectanglePacker::PackTask> TexturePacker::CreatePackTask(const D
     return packTask;
 }
 
-void TexturePacker::SaveResultSheets(const FilePath& outputPath, const char* basename, const RectanglePacker::PackResult& packResult, const Vector<ImageExportKeys>& imageExportKeys)
+void TexturePacker::SaveResultSheets(const FilePath& outputPath, const char* basename, const RectanglePacker::PackResult& packResult, const Vector<ImageExportKeys>& imageExportKeys, uint32 exportThreadsCount)
 {
     Logger::FrameworkDebug("* Writing %d final texture(s)", static_cast<int32>(packResult.resultSheets.size()));
 
@@ -148,12 +158,13 @@ void TexturePacker::SaveResultSheets(const FilePath& outputPath, const char* bas
         }
     }
 
-    for (uint32 imageNum = 0; imageNum < finalImages.size(); ++imageNum)
-    {
-        String textureName = MakeTextureName(basename, imageNum);
-        FilePath texturePathWithoutExtension = outputPath + textureName;
-        ExportImage(finalImages[imageNum], imageExportKeys, texturePathWithoutExtension);
-    }
+    // sheets are written to different files, so they can be converted simultaneously
+    TexturePackerDetails::RunInParallel(static_cast<uint32>(finalImages.size()), exportThreadsCount, [&](uint32 imageNum)
+                                        {
+                                            String textureName = MakeTextureName(basename, imageNum);
+                                            FilePath texturePathWithoutExtension = outputPath + textureName;
+                                            ExportImage(finalImages[imageNum], imageExportKeys, texturePathWithoutExtension);
+                                        });
 
     for (const RectanglePacker::SpriteIndexedData& spriteIndexedData : packResult.resultIndexedSprites)
     {
@@ -643,6 +654,8 @@ void TexturePacker::SetConvertQuality(TextureConverter::eConvertQuality _quality
 void TexturePacker::AddError(const String& errorMsg)
 {
     Logger::Error(errorMsg.c_str());
+
+    LockGuard<Mutex> lock(errorsMutex);
     errors.insert(errorMsg);
 }
 
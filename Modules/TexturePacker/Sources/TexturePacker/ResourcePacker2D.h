@@ -23,6 +23,12 @@ class ResourcePacker2D
     static const String INTERNAL_LIBPSD_VERSION;
 
 public:
+    struct DirectoryPackTime
+    {
+        FilePath directory;
+        uint64 timeMs = 0; // time spent on directory itself, without subdirectories
+    };
+
     void InitFolders(const FilePath& inputPath, const FilePath& outputPath);
     bool RecalculateDirMD5(const FilePath& pathname, const FilePath& md5file, bool isRecursive) const;
     void RecalculateMD5ForOutputDir();
@@ -39,10 +45,13 @@ public:
     void SetTag(const String& tag);
     void SetAllTags(const Vector<String>& tags);
     void SetIgnoresFile(const String& ignoresPath);
+    // number of threads used to load sources and convert sheets inside of one directory, 1 means serial packing
+    void SetThreadsCount(uint32 threadsCount);
 
     void PackResources(const Vector<eGPUFamily>& forGPUs);
 
     const Set<String>& GetErrors() const;
+    const Vector<DirectoryPackTime>& GetPackTimes() const;
 
 private:
     bool RecalculateParamsMD5(const String& params, const FilePath& md5file) const;
@@ -56,6 +65,7 @@ private:
     static String GetProcessFolderName();
 
     void AddError(const String& errorMsg);
+    void LogPackTimes() const;
 
     void PackRecursively(const FilePath& inputPath, const FilePath& outputPath, const Vector<PackingAlgorithm>& packAlgorithms, const Vector<String>& flags = Vector<String>());
 
@@ -86,8 +96,10 @@ private:
     FilePath ignoresListPath;
     List<FilePath> ignoredFiles;
     Vector<String> allTags;
+    uint32 threadsCount = 1;
 
     Set<String> errors;
+    Vector<DirectoryPackTime> packTimes;
 
     std::atomic<bool> cancelled = { false };
 };
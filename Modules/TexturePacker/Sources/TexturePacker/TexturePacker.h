@@ -6,6 +6,7 @@
 #include "Math/RectanglePacker/RectanglePacker.h"
 
 #include <Base/BaseTypes.h>
+#include <Concurrency/Mutex.h>
 #include <Functional/Function.h>
 #include <Render/RenderBase.h>
 #include <Render/Texture.h>
@@ -50,6 +51,8 @@ public:
 
     void SetConvertQuality(TextureConverter::eConvertQuality quality);
     void SetTexturePostfix(const String& postfix);
+    // number of threads used to write and convert result sheets, 1 means serial export
+    void SetThreadsCount(uint32 threadsCount);
 
     // Proxy setters
     void SetUseOnlySquareTextures(bool value = true);
@@ -79,7 +82,8 @@ private:
     bool CheckFrameSize(const Size2i& spriteSize, const Size2i& frameSize);
 
     std::unique_ptr<RectanglePacker::PackTask> CreatePackTask(const DefinitionFile::Collection& defList, const Vector<ImageExportKeys>& imageExportKeys);
-    void SaveResultSheets(const FilePath& outputPath, const char* basename, const RectanglePacker::PackResult& packResult, const Vector<ImageExportKeys>& imageExportKeys);
+    void PackSheets(const FilePath& outputPath, const char* basename, const DefinitionFile::Collection& defList, const Vector<ImageExportKeys>& imageExportKeys, uint32 exportThreadsCount);
+    void SaveResultSheets(const FilePath& outputPath, const char* basename, const RectanglePacker::PackResult& packResult, const Vector<ImageExportKeys>& imageExportKeys, uint32 exportThreadsCount);
 
     bool WriteDefinition(const std::unique_ptr<SpritesheetLayout>& sheet, const FilePath& outputPath, const String& textureName, const DefinitionFile& defFile);
     bool WriteMultipleDefinition(const RectanglePacker::SpriteIndexedData& spriteIndexedData, const DefinitionFile& defFile, const FilePath& outputPath, const char* textureBasename);
@@ -94,7 +98,9 @@ private:
     TextureConverter::eConvertQuality quality;
 
     String texturePostfix;
+    uint32 threadsCount = 1;
 
+    Mutex errorsMutex;
     Set<String> errors;
     void AddError(const String& errorMsg);
     void AddErrors(const Set<String>& errors_);
@@ -122,4 +128,8 @@ inline void TexturePacker::SetTexturesMargin(uint32 value)
 {
     rectanglePacker.SetTexturesMargin(value);
 }
+inline void TexturePacker::SetThreadsCount(uint32 value)
+{
+    threadsCount = std::max(value, 1u);
+}
 };
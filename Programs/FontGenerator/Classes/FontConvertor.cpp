@@ -1,11 +1,12 @@
 #include "FontConvertor.h"
 #include "TtfFont.h"
 
-#include "BinPacker/BinPacker.hpp"
 #include "LodePng/lodepng.h"
 
+#include <Math/RectanglePacker/Spritesheet.h>
 #include <Utils/UTF8Utils.h>
 
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <iomanip>
@@ -738,7 +739,7 @@ bool FontConvertor::GeneratePackedList(int32 fontSize, int32 textureSize)
 {
     chars.clear();
 
-    Vector<int32> rectInfo;
+    Vector<std::pair<uint32, Size2i>> glyphSizes;
     auto renderMode = params.output == TYPE_DISTANCE_FIELD ? FT_RENDER_MODE_MONO : FT_RENDER_MODE_NORMAL;
 
     auto oldSize = font->GetSize();
@@ -816,30 +817,32 @@ bool FontConvertor::GeneratePackedList(int32 fontSize, int32 textureSize)
 
                 chars[charDesc.id] = charDesc;
 
-                rectInfo.push_back(charDesc.width);
-                rectInfo.push_back(charDesc.height);
+                glyphSizes.emplace_back(charDesc.id, Size2i(charDesc.width, charDesc.height));
             }
         }
     }
 
     font->SetSize(oldSize);
 
-    BinPacker bp;
-    Vector<Vector<int32>> packedInfo;
-    bp.Pack(rectInfo, packedInfo, textureSize, false);
+    // Largest glyphs go first, as maxrects packs them denser in this order
+    std::stable_sort(glyphSizes.begin(), glyphSizes.end(), [](const std::pair<uint32, Size2i>& l, const std::pair<uint32, Size2i>& r) {
+        return l.second.dx * l.second.dy > r.second.dx * r.second.dy;
+    });
 
-    if (packedInfo.size() == 1)
+    std::unique_ptr<SpritesheetLayout> layout = SpritesheetLayout::Create(textureSize, textureSize, false, 0, PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT);
+    for (const std::pair<uint32, Size2i>& glyph : glyphSizes)
     {
-        auto cnt = packedInfo[0].size();
-        for (auto i = 0U; i < cnt; i += 4)
+        if (!layout->AddSprite(glyph.second, &glyph))
         {
-            //	index, x, y, rotated
-            auto index = charGlyphPairs[packedInfo[0][i]].first;
-            chars[index].x = packedInfo[0][i + 1];
-            chars[index].y = packedInfo[0][i + 2];
+            return false;
         }
-        return true;
     }
 
-    return false;
+    for (const std::pair<uint32, Size2i>& glyph : glyphSizes)
+    {
+        const SpriteBoundsRect* bounds = layout->GetSpriteBoundsRect(&glyph);
+        chars[glyph.first].x = bounds->spriteRect.x;
+        chars[glyph.first].y = bounds->spriteRect.y;
+    }
+    return true;
 }
@@ -24,6 +24,7 @@ private:
     DAVA::String compressionStr;
     DAVA::Compressor::Type compressionType;
     bool dummyFileData = false;
+    DAVA::uint32 solidBlockSize = 0;
     DAVA::String packFileName;
     DAVA::String baseDir;
     DAVA::String metaDbPath;
@@ -13,6 +13,7 @@ const DAVA::String Compression = "-compression";
 const DAVA::String BaseDir = "-basedir";
 const DAVA::String MetaDbFile = "-metadb";
 const DAVA::String DummyFileData = "-dummyFileData";
+const DAVA::String SolidBlockSize = "-solidBlockSize";
 }
 
 ArchivePackTool::ArchivePackTool()
@@ -24,6 +25,7 @@ ArchivePackTool::ArchivePackTool()
     options.AddOption(OptionNames::BaseDir, VariantType(String("")), "source base directory");
     options.AddOption(OptionNames::MetaDbFile, VariantType(String("")), "sqlite db with metadata");
     options.AddOption(OptionNames::DummyFileData, VariantType(false), "write dummy single-byte files instead of actual file data, useful if you are interested in pack footer only");
+    options.AddOption(OptionNames::SolidBlockSize, VariantType(static_cast<uint32>(0)), "size in KB of solid blocks with small files packed together, 0 - default, solid blocks are disabled. Don't use for packs downloaded file by file");
     options.AddArgument("packfile");
 }
 
@@ -41,6 +43,7 @@ bool ArchivePackTool::ConvertOptionsToParamsInternal()
     compressionType = static_cast<Compressor::Type>(type);
 
     dummyFileData = options.GetOption(OptionNames::DummyFileData).AsBool();
+    solidBlockSize = options.GetOption(OptionNames::SolidBlockSize).AsUInt32() * 1024;
 
     baseDir = options.GetOption(OptionNames::BaseDir).AsString();
     if (baseDir.empty())
@@ -75,6 +78,7 @@ int ArchivePackTool::ProcessInternal()
     params.baseDirPath = (baseDir.empty() ? FileSystem::Instance()->GetCurrentWorkingDirectory() : baseDir);
     params.metaDbPath = metaDbPath;
     params.dummyFileData = dummyFileData;
+    params.solidBlockSize = solidBlockSize;
 
     if (!CreateArchive(params))
     {
@@ -5,9 +5,11 @@
 #include <FileSystem/FileList.h>
 #include <FileSystem/Private/PackArchive.h>
 #include <Job/JobManager.h>
+#include <Concurrency/Semaphore.h>
 #include <Engine/Engine.h>
 #include <Compression/LZ4Compressor.h>
 #include <Compression/ZipCompressor.h>
+#include <Utils/CRC32.h>
 
 #include "ResultCodes.h"
 
@@ -16,6 +18,13 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
                       const DAVA::String& relativeFilePath,
                       const bool extractInDvplFormat);
 
+static int UnpackSolidFile(DAVA::PackArchive& packArchive,
+                           const DAVA::String& relativeFilePath,
+                           const bool extractInDvplFormat);
+
+static int CreateDirectoryForFile(const DAVA::FilePath& fullPath);
+static int WriteContent(const DAVA::FilePath& fullPath, const DAVA::Vector<DAVA::uint8>& content);
+
 ArchiveUnpackTool::ArchiveUnpackTool()
     : CommandLineTool("unpack")
 {
@@ -90,10 +99,20 @@ int ArchiveUnpackTool::ProcessInternal()
 
         std::atomic<int> countExtractedFiles(0);
 
+        // wait for own jobs only, no more than 1000 jobs are queued at once (internaly 1024 max jobs)
+        Semaphore extracted;
+        uint32 queuedJobs = 0;
+
         const auto& fileInfoBase = packArchive.GetFilesInfo();
 
         for (size_t i = 0; i < packFile.filesTable.data.files.size(); ++i)
         {
+            if (packArchive.IsFileInSolidBlock(static_cast<uint32>(i)))
+            {
+                // files of solid blocks are extracted later from archive object, it unpacks every block once
+                continue;
+            }
+
             jobManager->CreateWorkerJob([&, i]()
                                         {
                                             const auto& fileInfoFromArchive = packFile.filesTable.data.files[i];
@@ -107,16 +126,38 @@ int ArchiveUnpackTool::ProcessInternal()
                                             {
                                                 Logger::Error("failed extract file: %s, from archive: %s", fileInfo.relativeFilePath.c_str(), packFilename.GetAbsolutePathname().c_str());
                                             }
+                                            extracted.Post();
                                         });
 
-            if (i > 0 && i % 1000 == 0)
+            if (++queuedJobs == 1000)
             {
-                //HACK wait jobs executed (internaly 1024 max jobs)
-                jobManager->WaitWorkerJobs();
+                for (; queuedJobs > 0; --queuedJobs)
+                {
+                    extracted.Wait();
+                }
             }
         }
 
-        jobManager->WaitWorkerJobs();
+        for (; queuedJobs > 0; --queuedJobs)
+        {
+            extracted.Wait();
+        }
+
+        for (size_t i = 0; i < packFile.filesTable.data.files.size(); ++i)
+        {
+            if (packArchive.IsFileInSolidBlock(static_cast<uint32>(i)))
+            {
+                const auto& fileInfo = fileInfoBase[i];
+                if (UnpackSolidFile(packArchive, fileInfo.relativeFilePath, extractInDvplFormat) == OK)
+                {
+                    ++countExtractedFiles;
+                }
+                else
+                {
+                    Logger::Error("failed extract file: %s, from archive: %s", fileInfo.relativeFilePath.c_str(), packFilename.GetAbsolutePathname().c_str());
+                }
+            }
+        }
 
         if (countExtractedFiles != packFile.filesTable.data.files.size())
         {
@@ -158,16 +199,10 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
     }
 
     FilePath fullPath(relativeFilePath);
-    FilePath dirPath = fullPath.GetDirectory();
-    FileSystem* const fs = GetEngineContext()->fileSystem;
-    if (!fs->Exists(dirPath))
+    const int dirResult = CreateDirectoryForFile(fullPath);
+    if (dirResult != OK)
     {
-        const FileSystem::eCreateDirectoryResult result = fs->CreateDirectory(dirPath, true);
-        if (FileSystem::DIRECTORY_CANT_CREATE == result && !fs->Exists(dirPath)) // in multithreading work we have to dowble check directory exist
-        {
-            Logger::Error("Can't create unpack path dir %s", dirPath.GetAbsolutePathname().c_str());
-            return ERROR_CANT_CREATE_DIR;
-        }
+        return dirResult;
     }
 
     if (extractInDvplFormat)
@@ -239,6 +274,70 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
         return ERROR_CANT_EXTRACT_FILE;
     }
 
+    return WriteContent(fullPath, content);
+}
+
+static int UnpackSolidFile(DAVA::PackArchive& packArchive,
+                           const DAVA::String& relativeFilePath,
+                           const bool extractInDvplFormat)
+{
+    using namespace DAVA;
+
+    Vector<uint8> content;
+    if (!packArchive.LoadFile(relativeFilePath, content))
+    {
+        return ERROR_CANT_EXTRACT_FILE;
+    }
+
+    FilePath fullPath(relativeFilePath);
+    const int dirResult = CreateDirectoryForFile(fullPath);
+    if (dirResult != OK)
+    {
+        return dirResult;
+    }
+
+    if (extractInDvplFormat)
+    {
+        // dvpl keeps single file, so content of solid block is saved uncompressed
+        PackFormat::LitePack::Footer liteFooter;
+        liteFooter.type = Compressor::Type::None;
+        liteFooter.crc32Compressed = CRC32::ForBuffer(content.data(), content.size());
+        liteFooter.sizeCompressed = static_cast<uint32>(content.size());
+        liteFooter.sizeUncompressed = static_cast<uint32>(content.size());
+        liteFooter.packMarkerLite = PackFormat::FILE_MARKER_LITE;
+
+        const uint8* footerBytes = reinterpret_cast<const uint8*>(&liteFooter);
+        content.insert(content.end(), footerBytes, footerBytes + sizeof(liteFooter));
+
+        fullPath += ".dvpl";
+    }
+
+    return WriteContent(fullPath, content);
+}
+
+static int CreateDirectoryForFile(const DAVA::FilePath& fullPath)
+{
+    using namespace DAVA;
+
+    FilePath dirPath = fullPath.GetDirectory();
+    FileSystem* const fs = GetEngineContext()->fileSystem;
+    if (!fs->Exists(dirPath))
+    {
+        const FileSystem::eCreateDirectoryResult result = fs->CreateDirectory(dirPath, true);
+        if (FileSystem::DIRECTORY_CANT_CREATE == result && !fs->Exists(dirPath)) // in multithreading work we have to dowble check directory exist
+        {
+            Logger::Error("Can't create unpack path dir %s", dirPath.GetAbsolutePathname().c_str());
+            return ERROR_CANT_CREATE_DIR;
+        }
+    }
+
+    return OK;
+}
+
+static int WriteContent(const DAVA::FilePath& fullPath, const DAVA::Vector<DAVA::uint8>& content)
+{
+    using namespace DAVA;
+
     if (!fullPath.IsDirectoryPathname())
     {
         ScopedPtr<File> file(File::Create(fullPath, File::CREATE | File::WRITE));
@@ -230,6 +230,7 @@ SceneExporterTool::SceneExporterTool(const DAVA::Vector<DAVA::String>& commandLi
     options.AddOption(OptionName::HDTextures, VariantType(false), "Use 0-mip level as texture.hd.ext");
 
     options.AddOption(OptionName::Tag, VariantType(String("")), "Tag for filenames, example: .china. Will export texture.china.tex instead of texture.tex");
+    options.AddOption(OptionName::Manifest, VariantType(String("")), "Absolute Path for folder with manifest of exported objects. Enables incremental export: unchanged objects are not exported again");
 
     options.AddOption(OptionName::UseAssetCache, VariantType(useAssetCache), "Enables using AssetCache for scene");
     options.AddOption(OptionName::AssetCacheIP, VariantType(AssetCache::GetLocalHost()), "ip of adress of Asset Cache Server");
@@ -317,6 +318,12 @@ bool SceneExporterTool::PostInitInternal()
     const bool saveNormals = options.GetOption(OptionName::SaveNormals).AsBool();
     exportingParams.optimizeOnExport = !saveNormals;
 
+    exportingParams.manifestFolder = options.GetOption(OptionName::Manifest).AsString();
+    if (exportingParams.manifestFolder.IsEmpty() == false)
+    {
+        exportingParams.manifestFolder.MakeDirectoryPathname();
+    }
+
     useAssetCache = options.GetOption(OptionName::UseAssetCache).AsBool();
     if (useAssetCache)
     {
@@ -442,6 +449,7 @@ void SceneExporterTool::ShowHelpInternal()
     DAVA::Logger::Info("\t-sceneexporter -scene -indir /Users/SmokeTest/DataSource/3d/ -outdir /Users/SmokeTest/Data/3d/ -processfilelist /Users/files.txt -gpu adreno");
     DAVA::Logger::Info("\t-sceneexporter -texture -indir /Users/SmokeTest/DataSource/3d/ -outdir /Users/SmokeTest/Data/3d/ -processfilelist /Users/files.txt -gpu adreno,PowerVR_iOS -useCache -ip 127.0.0.1");
     DAVA::Logger::Info("\t-sceneexporter -texture -indir /Users/SmokeTest/DataSource/3d/ -output /Users/config.yaml -processfilelist /Users/files.txt -useCache -ip 127.0.0.1");
+    DAVA::Logger::Info("\t-sceneexporter -scene -indir /Users/SmokeTest/DataSource/3d/ -output /Users/config.yaml -processdir Maps/ -manifest /Users/SmokeTest/ExportManifest/");
 }
 
 DECL_TARC_MODULE(SceneExporterTool);
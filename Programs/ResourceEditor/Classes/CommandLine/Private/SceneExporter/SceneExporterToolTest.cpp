@@ -12,8 +12,10 @@
 #include <FileSystem/YamlEmitter.h>
 #include <FileSystem/FilePath.h>
 #include <FileSystem/FileList.h>
+#include <FileSystem/FileSystem.h>
 #include <Render/GPUFamilyDescriptor.h>
 #include <Render/TextureDescriptor.h>
+#include <Utils/StringFormat.h>
 #include <Entity/ComponentManager.h>
 #include <Engine/Engine.h>
 
@@ -289,6 +291,71 @@ DAVA_TARC_TESTCLASS(SceneExporterToolTest)
         CommandLineModuleTestUtils::ClearTestFolder(SETestDetail::projectStr);
     }
 
+    DAVA_TEST (ExportManyTexturesTest)
+    {
+        using namespace DAVA;
+
+        std::unique_ptr<CommandLineModuleTestUtils::TextureLoadingGuard> guard = CommandLineModuleTestUtils::CreateTextureGuard({ eGPUFamily::GPU_ORIGIN });
+        CommandLineModuleTestUtils::CreateProjectInfrastructure(SETestDetail::projectStr);
+        CommandLineModuleTestUtils::SceneBuilder::CreateFullScene(SETestDetail::scenePathnameStr, SETestDetail::projectStr);
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+
+        FilePath dataPath = SETestDetail::projectStr + "Data/3d/";
+        FilePath dataSourcePath = SETestDetail::projectStr + "DataSource/3d/";
+        FilePath manifestPath = SETestDetail::projectStr + "Manifest/";
+
+        // more textures than worker queue holds at once
+        const uint32 texturesCount = 1100;
+        FilePath texturePathname = FindTexturePathname(dataSourcePath);
+        std::unique_ptr<TextureDescriptor> descriptor(TextureDescriptor::CreateFromFile(texturePathname));
+        TEST_VERIFY(descriptor != nullptr);
+        FilePath sourceImagePathname = descriptor->GetSourceTexturePathname();
+
+        FilePath texturesFolder = dataSourcePath + "ManyTextures/";
+        fs->CreateDirectory(texturesFolder, true);
+        Vector<String> textureRelativePathnames;
+        for (uint32 i = 0; i < texturesCount; ++i)
+        {
+            FilePath copyPathname = texturesFolder + Format("texture_%u.tex", i);
+            FilePath copyImagePathname = FilePath::CreateWithNewExtension(copyPathname, sourceImagePathname.GetExtension());
+            TEST_VERIFY(fs->CopyFile(texturePathname, copyPathname, true));
+            TEST_VERIFY(fs->CopyFile(sourceImagePathname, copyImagePathname, true));
+            textureRelativePathnames.push_back(copyPathname.GetRelativePathname(dataSourcePath));
+        }
+
+        Vector<String> cmdLine =
+        {
+          "ResourceEditor",
+          "-sceneexporter",
+          "-texture",
+          "-indir",
+          dataSourcePath.GetAbsolutePathname(),
+          "-outdir",
+          dataPath.GetAbsolutePathname(),
+          "-processdir",
+          "ManyTextures/",
+          "-gpu",
+          "origin",
+          "-manifest",
+          manifestPath.GetAbsolutePathname()
+        };
+
+        // second export finds all textures up to date
+        for (uint32 pass = 0; pass < 2; ++pass)
+        {
+            std::unique_ptr<CommandLineModule> tool = std::make_unique<SceneExporterTool>(cmdLine);
+            DAVA::ConsoleModuleTestExecution::ExecuteModule(tool.get());
+
+            for (const String& textureRelativePathname : textureRelativePathnames)
+            {
+                TEST_VERIFY(fs->Exists(dataPath + textureRelativePathname));
+            }
+        }
+
+        CommandLineModuleTestUtils::ClearTestFolder(SETestDetail::projectStr);
+    }
+
     DAVA_TEST (ExportFileListTest)
     {
         using namespace DAVA;
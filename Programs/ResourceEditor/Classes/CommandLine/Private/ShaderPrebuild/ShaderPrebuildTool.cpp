@@ -0,0 +1,159 @@
+#include "Classes/CommandLine/ShaderPrebuildTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+#include <REPlatform/CommandLine/SceneConsoleHelper.h>
+#include <REPlatform/Scene/SceneHelper.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Base/ScopedPtr.h>
+#include <FileSystem/File.h>
+#include <Logger/Logger.h>
+#include <Render/Material/NMaterial.h>
+#include <Render/RHI/rhi_ShaderSource.h>
+#include <Render/ShaderCache.h>
+#include <Scene3D/Scene.h>
+#include <Utils/StringUtils.h>
+
+namespace ShaderPrebuildToolDetails
+{
+using namespace DAVA;
+
+const std::pair<const char*, rhi::Api> apiNames[] = {
+    { "gles2", rhi::RHI_GLES2 },
+    { "metal", rhi::RHI_METAL },
+    { "dx9", rhi::RHI_DX9 },
+    { "dx11", rhi::RHI_DX11 }
+};
+
+Vector<FilePath> ReadScenesListFile(const FilePath& listFilePath)
+{
+    Vector<FilePath> scenes;
+    ScopedPtr<File> listFile(File::Create(listFilePath, File::OPEN | File::READ));
+    if (listFile)
+    {
+        while (!listFile->IsEof())
+        {
+            String str = StringUtils::Trim(listFile->ReadLine());
+            if (!str.empty())
+            {
+                scenes.push_back(str);
+            }
+        }
+    }
+    else
+    {
+        Logger::Error("Can't open scenes listfile %s", listFilePath.GetAbsolutePathname().c_str());
+    }
+
+    return scenes;
+}
+}
+
+ShaderPrebuildTool::ShaderPrebuildTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-shaderprebuild")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Full pathname to scene file *.sc2");
+    options.AddOption(OptionName::ProcessFileList, VariantType(String("")), "Path to file with the list of scenes");
+    options.AddOption(OptionName::OutFile, VariantType(String("")), "Path to shader source cache file, existing cache is updated");
+    options.AddOption(OptionName::Api, VariantType(String("gles2")), "Target rendering api: gles2, metal, dx9, dx11");
+    options.AddOption(OptionName::QualityConfig, VariantType(String("")), "Full path for quality.yaml file");
+}
+
+bool ShaderPrebuildTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    FilePath scenePath = options.GetOption(OptionName::ProcessFile).AsString();
+    FilePath scenesListPath = options.GetOption(OptionName::ProcessFileList).AsString();
+    if (scenePath.IsEmpty() == scenesListPath.IsEmpty())
+    {
+        Logger::Error("Either '%s' or '%s' param should be specified", OptionName::ProcessFile.c_str(), OptionName::ProcessFileList.c_str());
+        return false;
+    }
+
+    scenePathes = scenePath.IsEmpty() ? ShaderPrebuildToolDetails::ReadScenesListFile(scenesListPath) : Vector<FilePath>{ scenePath };
+    if (scenePathes.empty())
+    {
+        Logger::Error("List of scenes is empty");
+        return false;
+    }
+
+    outFile = options.GetOption(OptionName::OutFile).AsString();
+    if (outFile.IsEmpty())
+    {
+        Logger::Error("Path to shader source cache is not specified");
+        return false;
+    }
+
+    String apiName = options.GetOption(OptionName::Api).AsString();
+    auto apiIt = std::find_if(std::begin(ShaderPrebuildToolDetails::apiNames), std::end(ShaderPrebuildToolDetails::apiNames), [&apiName](const std::pair<const char*, rhi::Api>& name) {
+        return apiName == name.first;
+    });
+    if (apiIt == std::end(ShaderPrebuildToolDetails::apiNames))
+    {
+        Logger::Error("Unknown rendering api: '%s'", apiName.c_str());
+        return false;
+    }
+    api = apiIt->second;
+
+    bool qualityInitialized = SceneConsoleHelper::InitializeQualitySystem(options, scenePathes.front());
+    if (!qualityInitialized)
+    {
+        Logger::Error("Cannot create path to quality.yaml from %s", scenePathes.front().GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult ShaderPrebuildTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    rhi::ShaderSourceCache::Load(outFile.GetAbsolutePathname().c_str(), api);
+
+    Vector<ShaderDescriptorCache::ShaderVariant> variants;
+    for (const FilePath& scenePath : scenePathes)
+    {
+        ScopedPtr<Scene> scene(new Scene);
+        if (scene->LoadScene(scenePath) != SceneFileV2::ERROR_NO_ERROR)
+        {
+            Logger::Error("Can't open scene '%s'", scenePath.GetAbsolutePathname().c_str());
+            continue;
+        }
+
+        Set<NMaterial*> materials;
+        SceneHelper::BuildMaterialList(scene, materials);
+        for (NMaterial* material : materials)
+        {
+            material->CollectShaderVariants(variants);
+        }
+    }
+
+    uint32 builtCount = ShaderDescriptorCache::BuildShaderSources(variants, api);
+    Logger::Info("Translated %u shader variants of %u scenes", builtCount, static_cast<uint32>(scenePathes.size()));
+
+    rhi::ShaderSourceCache::Save(outFile.GetAbsolutePathname().c_str(), api);
+    rhi::ShaderSourceCache::Clear();
+
+    return eFrameResult::FINISHED;
+}
+
+void ShaderPrebuildTool::BeforeDestroyedInternal()
+{
+    DAVA::SceneConsoleHelper::FlushRHI();
+}
+
+void ShaderPrebuildTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-shaderprebuild -processfile /Users/SmokeTest/DataSource/3d/Maps/scene.sc2 -outfile /Users/SmokeTest/ShaderSource.bin -api gles2 -qualitycfgpath Users/SmokeTest/Data/quality.yaml");
+    DAVA::Logger::Info("\t-shaderprebuild -processfilelist /Users/SmokeTest/scenes.txt -outfile /Users/SmokeTest/ShaderSource.bin -api metal");
+}
+
+DECL_TARC_MODULE(ShaderPrebuildTool);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+#include <Reflection/ReflectionRegistrator.h>
+#include <Render/RHI/rhi_Type.h>
+
+class ShaderPrebuildTool : public DAVA::CommandLineModule
+{
+public:
+    ShaderPrebuildTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void BeforeDestroyedInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::Vector<DAVA::FilePath> scenePathes;
+    DAVA::FilePath outFile;
+    rhi::Api api = rhi::RHI_GLES2;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(ShaderPrebuildTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<ShaderPrebuildTool>::Begin()[DAVA::M::CommandName("-shaderprebuild")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
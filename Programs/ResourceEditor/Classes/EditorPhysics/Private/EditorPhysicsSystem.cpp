@@ -16,6 +16,8 @@
 EditorPhysicsSystem::EditorPhysicsSystem(DAVA::Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
+
     scene->physicsSystem->SetDebugDrawEnabled(true);
     scene->physicsSystem->SetSimulationEnabled(false);
 }
@@ -153,6 +153,7 @@ DAVA::int32 CalcParticleElementsDepth(DAVA::ParticleEffectComponent* component,
 SceneTreeSystem::SceneTreeSystem(DAVA::Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
 }
 
 void SceneTreeSystem::RegisterEntity(DAVA::Entity* entity)
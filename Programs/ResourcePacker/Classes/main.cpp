@@ -8,6 +8,7 @@
 #include <Render/GPUFamilyDescriptor.h>
 #include <Logger/Logger.h>
 #include <Logger/TeamcityOutput.h>
+#include <Platform/DeviceInfo.h>
 #include <Debug/DVAssertDefaultHandlers.h>
 #include <Time/SystemTimer.h>
 #include <Utils/Utils.h>
@@ -32,6 +33,7 @@ void PrintUsage()
     printf("\t-t - asset cache timeout\n");
     printf("\t-postifx - trailing part of texture name\n");
     printf("\t-output - output folder for .../Project/Data/Gfx/\n");
+    printf("\t-threads - number of threads to load and convert sprites of one folder, 0 - number of CPU cores\n");
 
     printf("\n");
     printf("ResourcePacker [src_dir] - will pack resources from src_dir\n");
@@ -138,6 +140,16 @@ void ProcessRecourcePacker(Engine& e)
     resourcePacker.SetTag(CommandLineParser::GetCommandParam("-tag"));
     resourcePacker.SetIgnoresFile(CommandLineParser::GetCommandParam("-ignore"));
 
+    if (CommandLineParser::CommandIsFound(String("-threads")))
+    {
+        int32 threadsCount = atoi(CommandLineParser::GetCommandParam("-threads").c_str());
+        if (threadsCount <= 0)
+        {
+            threadsCount = DeviceInfo::GetCpuCount();
+        }
+        resourcePacker.SetThreadsCount(static_cast<uint32>(threadsCount));
+    }
+
     if (CommandLineParser::CommandIsFound(String("-md5mode")))
     {
         resourcePacker.RecalculateMD5ForOutputDir();
@@ -70,6 +70,7 @@ int Process(Engine& e)
 
     writeOptions.AddOption("-a", DAVA::VariantType(false), "Append patch to existing file.");
     writeOptions.AddOption("-nc", DAVA::VariantType(false), "Generate uncompressed patch.");
+    writeOptions.AddOption("-blocks", DAVA::VariantType(false), "Generate LZ4 compressed patch by blocks in parallel. Needs less memory and time, but patch can be larger.");
     writeOptions.AddOption("-v", DAVA::VariantType(false), "Verbose output.");
     writeOptions.AddOption("-bo", DAVA::VariantType(DAVA::String("")), "Original file base dir.");
     writeOptions.AddOption("-bn", DAVA::VariantType(DAVA::String("")), "New file base dir.");
@@ -123,6 +124,10 @@ int Process(Engine& e)
                 {
                     bsType = BS_PLAIN;
                 }
+                else if (writeOptions.GetOption("-blocks").AsBool())
+                {
+                    bsType = BS_LZ4_BLOCKS;
+                }
 
                 DAVA::FilePath origPath = writeOptions.GetArgument("OriginalFile");
                 DAVA::FilePath newPath = writeOptions.GetArgument("NewFile");
@@ -367,7 +372,7 @@ int DAVAMain(Vector<String> cmdLine)
     Assert::AddHandler(Assert::DefaultDebuggerBreakHandler);
 
     Engine e;
-    e.Init(eEngineRunMode::CONSOLE_MODE, {}, nullptr);
+    e.Init(eEngineRunMode::CONSOLE_MODE, { "JobManager" }, nullptr);
     e.update.Connect([&e](float32)
                      {
                          int retCode = Process(e);
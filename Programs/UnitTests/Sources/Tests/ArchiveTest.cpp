@@ -3,7 +3,10 @@
 #include <FileSystem/Private/ZipArchive.h>
 #include <FileSystem/FileSystem.h>
 #include <Logger/Logger.h>
+#include <ResourceArchiverModule/ResourceArchiver.h>
+#include <Utils/StringFormat.h>
 
+#include <sqlite_modern_cpp.h>
 #include <cstring>
 
 using namespace DAVA;
@@ -96,4 +99,105 @@ DAVA_TESTCLASS (ArchiveTest)
             TEST_VERIFY(false && "can't open zip file");
         }
     }
+
+    DAVA_TEST (TestSolidBlocks)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        FileSystem* fs = FileSystem::Instance();
+        FilePath baseDir("~doc:/ArchiveTest/Solid/");
+        FilePath dataDir = baseDir + "Data/";
+        fs->DeleteDirectory(baseDir, true);
+        fs->CreateDirectory(dataDir + "configs/", true);
+
+        // many tiny similar configs go to solid blocks, big file is compressed separately
+        Map<String, String> contents;
+        for (int32 i = 0; i < 100; ++i)
+        {
+            contents[Format("configs/config%03d.yaml", i)] = Format("item:\n    name: item%d\n    size: [%d, %d]\n    visible: true\n", i, i * 2, i * 3);
+        }
+        String& bigContent = contents["big.txt"];
+        for (int32 i = 0; i < 20000; ++i)
+        {
+            bigContent += Format("%d;", i);
+        }
+
+        FilePath metaDbPath = baseDir + "meta.db";
+        try
+        {
+            sqlite::database db(metaDbPath.GetAbsolutePathname());
+            db << "CREATE TABLE files(path TEXT PRIMARY KEY, pack_index INTEGER NOT NULL);";
+            db << "CREATE TABLE packs(name TEXT UNIQUE, dependency TEXT NOT NULL);";
+            db << "INSERT INTO packs VALUES (?, ?);" << "base" << "";
+            db << "INSERT INTO packs VALUES (?, ?);" << "extra" << "";
+            for (const auto& entry : contents)
+            {
+                // second half of configs goes to another pack, solid blocks mustn't mix them
+                int32 packIndex = (entry.first >= "configs/config050.yaml") ? 1 : 0;
+                db << "INSERT INTO files VALUES (?, ?);" << entry.first << packIndex;
+
+                ScopedPtr<File> file(File::Create(dataDir + entry.first, File::CREATE | File::WRITE));
+                file->WriteString(entry.second, false);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("%s", ex.what());
+            TEST_VERIFY(false && "can't create meta db");
+            return;
+        }
+
+        ResourceArchiver::Params params;
+        params.baseDirPath = dataDir;
+        params.metaDbPath = metaDbPath;
+
+        params.archivePath = baseDir + "files.dvpk";
+        TEST_VERIFY(ResourceArchiver::CreateArchive(params));
+
+        FilePath solidArchivePath = baseDir + "solid.dvpk";
+        params.archivePath = solidArchivePath;
+        params.solidBlockSize = 1024;
+        TEST_VERIFY(ResourceArchiver::CreateArchive(params));
+
+        uint64 filesArchiveSize = 0;
+        uint64 solidArchiveSize = 0;
+        TEST_VERIFY(fs->GetFileSize(baseDir + "files.dvpk", filesArchiveSize));
+        TEST_VERIFY(fs->GetFileSize(solidArchivePath, solidArchiveSize));
+        TEST_VERIFY(solidArchiveSize < filesArchiveSize);
+        Logger::Info("archive size: %llu bytes, with solid blocks: %llu bytes", static_cast<unsigned long long>(filesArchiveSize), static_cast<unsigned long long>(solidArchiveSize));
+
+        try
+        {
+            RefPtr<File> fileDvpk(File::Create(solidArchivePath, File::OPEN | File::READ));
+            PackArchive archive(fileDvpk, solidArchivePath);
+
+            TEST_VERIFY(archive.GetPackFile().solidBlocks.blocks.size() > 1);
+            TEST_VERIFY(archive.IsFileInSolidBlock(archive.GetFileIndex("configs/config000.yaml")));
+            TEST_VERIFY(!archive.IsFileInSolidBlock(archive.GetFileIndex("big.txt")));
+            TEST_VERIFY(archive.HasMeta());
+
+            const PackFormat::PackFile& packFile = archive.GetPackFile();
+            for (const PackFormat::SolidBlockEntry& block : packFile.solidBlocks.blocks)
+            {
+                for (uint32 i = 1; i < block.numFiles; ++i)
+                {
+                    TEST_VERIFY(packFile.filesTable.data.files[block.firstFile + i].metaIndex == packFile.filesTable.data.files[block.firstFile].metaIndex);
+                }
+            }
+
+            for (const auto& entry : contents)
+            {
+                Vector<uint8> fileFromArchive;
+                TEST_VERIFY(archive.LoadFile(entry.first, fileFromArchive));
+                TEST_VERIFY(String(fileFromArchive.begin(), fileFromArchive.end()) == entry.second);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("%s", ex.what());
+            TEST_VERIFY(false && "can't open archive with solid blocks");
+        }
+
+        fs->DeleteDirectory(baseDir, true);
+#endif // __DAVAENGINE_IPHONE__
+    }
 };
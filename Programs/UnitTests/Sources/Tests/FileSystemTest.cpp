@@ -2,6 +2,7 @@
 #include "UnitTests/UnitTests.h"
 #include "Compression/LZ4Compressor.h"
 #include "FileSystem/Private/PackFormatSpec.h"
+#include "FileSystem/FileAPIHelper.h"
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FileSystemDelegate.h"
 #include "Utils/CRC32.h"
@@ -604,6 +605,87 @@ DAVA_TESTCLASS (FileSystemTest)
         }
     }
 
+    DAVA_TEST (FileIndexTest)
+    {
+        FileSystem* fs = FileSystem::Instance();
+
+        FilePath resDir = tempDir + "FileIndexTest/";
+        FilePath subDir = resDir + "Sub/";
+
+        { // create test data
+            FileSystem::eCreateDirectoryResult res = fs->CreateDirectory(subDir, true);
+            TEST_VERIFY(res == FileSystem::eCreateDirectoryResult::DIRECTORY_CREATED)
+            for (const FilePath& path : { resDir + "file.name", resDir + "file.tag.name", subDir + "nested.txt" })
+            {
+                ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+                file->WriteLine(path.GetFilename());
+            }
+            FilePath::AddResourcesFolder(resDir);
+        }
+
+        TEST_VERIFY(fs->BuildFileIndex());
+        TEST_VERIFY(fs->IsFileIndexBuilt());
+
+        { // test code
+            auto testFile = [](const FilePath& path, const String& checkedLine)
+            {
+                ScopedPtr<File> file(File::Create(path, File::OPEN | File::READ));
+                TEST_VERIFY(file);
+                if (file)
+                {
+                    TEST_VERIFY(file->GetFilename() == path);
+                    TEST_VERIFY(file->ReadLine() == checkedLine);
+                }
+            };
+
+            testFile("~res:/file.name", "file.name");
+            testFile("~res:/Sub/nested.txt", "nested.txt");
+            testFile(resDir + "Sub/nested.txt", "nested.txt");
+            TEST_VERIFY(FilePath("~res:/Sub/nested.txt").GetAbsolutePathname() == (subDir + "nested.txt").GetAbsolutePathname());
+
+            String oldTag = fs->GetFilenamesTag();
+            fs->SetFilenamesTag(".tag");
+            testFile("~res:/file.name", "file.tag.name");
+            fs->SetFilenamesTag(oldTag);
+
+            ScopedPtr<File> missing(File::Create("~res:/missing.txt", File::OPEN | File::READ));
+            TEST_VERIFY(missing.get() == nullptr);
+
+            // files written at runtime are visible through index
+            {
+                ScopedPtr<File> file(File::Create(subDir + "runtime.txt", File::CREATE | File::WRITE));
+                file->WriteLine("runtime.txt");
+            }
+            testFile("~res:/Sub/runtime.txt", "runtime.txt");
+
+            // deleted files are not
+            TEST_VERIFY(fs->DeleteFile(subDir + "runtime.txt"));
+            ScopedPtr<File> deleted(File::Create("~res:/Sub/runtime.txt", File::OPEN | File::READ));
+            TEST_VERIFY(deleted.get() == nullptr);
+
+            // files written by external code appear after directory invalidation
+            {
+                String externalPath = (subDir + "external.txt").GetAbsolutePathname();
+                FILE* external = FileAPI::OpenFile(externalPath, "wb");
+                TEST_VERIFY(external != nullptr);
+                if (external != nullptr)
+                {
+                    fputs("external.txt\n", external);
+                    FileAPI::Close(external);
+                }
+            }
+            fs->InvalidateFileIndex(subDir);
+            testFile("~res:/Sub/external.txt", "external.txt");
+            testFile("~res:/Sub/nested.txt", "nested.txt");
+        }
+
+        { // cleanup test data
+            FilePath::RemoveResourcesFolder(resDir);
+            TEST_VERIFY(fs->IsFileIndexBuilt() == false);
+            fs->DeleteDirectory(resDir, true);
+        }
+    }
+
     class HookDelegate : public FileSystemDelegate
     {
     public:
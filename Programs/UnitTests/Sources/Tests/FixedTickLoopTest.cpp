@@ -0,0 +1,70 @@
+#include "UnitTests/UnitTests.h"
+#include "Engine/Private/FixedTickLoop.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FixedTickLoopTest)
+{
+    DAVA_TEST (ScheduleTest)
+    {
+        now = 0;
+        FixedTickStatistics statistics;
+        Private::FixedTickLoop loop(1000, 2, statistics, [this]() { return now; });
+
+        // tick within budget, next tick is on schedule
+        TEST_VERIFY(RunTick(loop, 500) == 1000);
+        now = 1000;
+
+        // long tick falls behind by 4.5 ticks: 2 ticks are caught up, 2 ticks above limit are dropped
+        TEST_VERIFY(RunTick(loop, 5500) == 4000);
+        TEST_VERIFY(statistics.droppedTickCount == 2);
+
+        // overdue ticks run back-to-back until loop is on schedule again
+        TEST_VERIFY(RunTick(loop, 0) == 5000);
+        TEST_VERIFY(RunTick(loop, 0) == 6000);
+        TEST_VERIFY(RunTick(loop, 0) == 7000);
+        TEST_VERIFY(statistics.droppedTickCount == 2);
+
+        TEST_VERIFY(statistics.tickCount == 5);
+        TEST_VERIFY(statistics.overrunTickCount == 1);
+        TEST_VERIFY(statistics.maxTickDurationUs == 5500);
+    }
+
+    DAVA_TEST (CatchupWithoutDropTest)
+    {
+        now = 0;
+        FixedTickStatistics statistics;
+        Private::FixedTickLoop loop(1000, 5, statistics, [this]() { return now; });
+
+        // falling behind by less than catch-up limit drops nothing
+        TEST_VERIFY(RunTick(loop, 4500) == 1000);
+        TEST_VERIFY(statistics.droppedTickCount == 0);
+    }
+
+    DAVA_TEST (HistogramTest)
+    {
+        now = 0;
+        FixedTickStatistics statistics;
+        Private::FixedTickLoop loop(1000, 0, statistics, [this]() { return now; });
+
+        RunTick(loop, 0);
+        RunTick(loop, 1);
+        RunTick(loop, 3);
+        RunTick(loop, 500);
+        RunTick(loop, 511);
+        RunTick(loop, int64(1) << 40);
+
+        TEST_VERIFY(statistics.durationHistogram[0] == 2);
+        TEST_VERIFY(statistics.durationHistogram[1] == 1);
+        TEST_VERIFY(statistics.durationHistogram[8] == 2);
+        TEST_VERIFY(statistics.durationHistogram[FixedTickStatistics::HISTOGRAM_BUCKET_COUNT - 1] == 1);
+        TEST_VERIFY(statistics.tickCount == 6);
+    }
+
+    int64 RunTick(Private::FixedTickLoop & loop, int64 durationUs)
+    {
+        return loop.RunTick([this, durationUs]() { now += durationUs; });
+    }
+
+    int64 now = 0;
+};
@@ -0,0 +1,96 @@
+#include "UnitTests/UnitTests.h"
+#include "Concurrency/Semaphore.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Render/Highlevel/GeoDecalManager.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Material/NMaterial.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (GeoDecalManagerTest)
+{
+    DAVA_TEST (AsyncDecalRetainsSourceDataTest)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 4.0f },
+            { FastName("segments.y"), 4.0f },
+            { FastName("segments.z"), 4.0f }
+        };
+
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), options);
+        NMaterial* material = new NMaterial();
+        RenderObject* object = CreateRenderObject(geometry, material);
+
+        int32 geometryRetainCount = geometry->GetRetainCount();
+        int32 materialRetainCount = material->GetRetainCount();
+        {
+            GeoDecalManager manager;
+            GeoDecalManager::Decal decal = manager.BuildDecalAsync(GeoDecalManager::DecalConfig(), Matrix4::IDENTITY, object);
+            TEST_VERIFY(decal != GeoDecalManager::InvalidDecal);
+            TEST_VERIFY(!manager.IsDecalBuilt(decal));
+
+            // source batch may drop its data while job is running
+            TEST_VERIFY(geometry->GetRetainCount() > geometryRetainCount);
+            TEST_VERIFY(material->GetRetainCount() > materialRetainCount);
+
+            manager.DeleteDecal(decal);
+        }
+        TEST_VERIFY(geometry->GetRetainCount() == geometryRetainCount);
+        TEST_VERIFY(material->GetRetainCount() == materialRetainCount);
+
+        SafeRelease(object);
+        SafeRelease(material);
+        SafeRelease(geometry);
+    }
+
+    DAVA_TEST (DestructorWaitsOnlyForOwnJobsTest)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        if (jobManager->GetWorkersCount() < 2)
+        {
+            return;
+        }
+
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), Map<FastName, float32>());
+        NMaterial* material = new NMaterial();
+        RenderObject* object = CreateRenderObject(geometry, material);
+
+        // unrelated job is released only after manager is destroyed
+        Semaphore unrelatedJobRelease;
+        jobManager->CreateWorkerJob([&unrelatedJobRelease]() {
+            unrelatedJobRelease.Wait();
+        });
+
+        {
+            GeoDecalManager manager;
+            manager.BuildDecalAsync(GeoDecalManager::DecalConfig(), Matrix4::IDENTITY, object);
+            manager.BuildDecalAsync(GeoDecalManager::DecalConfig(), Matrix4::IDENTITY, object);
+        }
+
+        unrelatedJobRelease.Post();
+        jobManager->WaitWorkerJobs();
+
+        SafeRelease(object);
+        SafeRelease(material);
+        SafeRelease(geometry);
+    }
+
+    RenderObject* CreateRenderObject(PolygonGroup * geometry, NMaterial * material)
+    {
+        RenderBatch* batch = new RenderBatch();
+        batch->SetPolygonGroup(geometry);
+        batch->SetMaterial(material);
+
+        RenderObject* object = new RenderObject();
+        object->AddRenderBatch(batch);
+        object->SetWorldTransformPtr(&worldTransform);
+        object->SetInverseTransform(Matrix4::IDENTITY);
+        SafeRelease(batch);
+        return object;
+    }
+
+    Matrix4 worldTransform;
+};
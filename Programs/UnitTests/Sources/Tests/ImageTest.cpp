@@ -4,6 +4,7 @@
 #include "Math/HalfFloat.h"
 #include "Render/Image/Image.h"
 #include "Render/Image/ImageConvert.h"
+#include "Time/SystemTimer.h"
 #include "Utils/StringFormat.h"
 #include "Utils/Random.h"
 
@@ -107,4 +108,93 @@ DAVA_TESTCLASS (ImageTest)
             }
         }
     }
+
+    // Vectorized and banded conversions should give the same result as per-pixel functors
+    DAVA_TEST (ConvertKernelsTest)
+    {
+        // odd sizes leave scalar tails, the largest one is processed by row bands
+        const uint32 sizes[][2] = { { 1, 1 }, { 7, 3 }, { 37, 18 }, { 515, 301 } };
+        for (const auto& size : sizes)
+        {
+            uint32 width = size[0];
+            uint32 height = size[1];
+            Vector<uint8> source = CreateRandomData(width * height * 4);
+
+            Vector<uint8> swapped(source.size());
+            TEST_VERIFY(ImageConvert::ConvertImageDirect(FORMAT_BGRA8888, FORMAT_RGBA8888, source.data(), width, height, width * 4, swapped.data(), width, height, width * 4));
+            Vector<uint8> swappedReference(source.size());
+            ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> swap;
+            swap(source.data(), width, height, width * 4, swappedReference.data());
+            TEST_VERIFY_WITH_MESSAGE(swapped == swappedReference, Format("BGRA8888 -> RGBA8888 %ux%u", width, height));
+
+            Vector<uint8> inPlace = source;
+            ImageConvert::SwapRedBlueChannels(FORMAT_RGBA8888, inPlace.data(), width, height, width * 4);
+            TEST_VERIFY_WITH_MESSAGE(inPlace == swappedReference, Format("in place swap %ux%u", width, height));
+
+            Vector<uint8> packed(width * height * 2);
+            TEST_VERIFY(ImageConvert::ConvertImageDirect(FORMAT_RGBA8888, FORMAT_RGBA4444, source.data(), width, height, width * 4, packed.data(), width, height, width * 2));
+            Vector<uint8> packedReference(packed.size());
+            ConvertDirect<uint32, uint16, ConvertRGBA8888toRGBA4444> pack;
+            pack(source.data(), width, height, width * 4, packedReference.data());
+            TEST_VERIFY_WITH_MESSAGE(packed == packedReference, Format("RGBA8888 -> RGBA4444 %ux%u", width, height));
+
+            uint32 outWidth = Max(width / 2, 1u);
+            uint32 outHeight = Max(height / 2, 1u);
+            Vector<uint8> downscaled(outWidth * outHeight * 4);
+            TEST_VERIFY(ImageConvert::DownscaleTwiceBillinear(FORMAT_RGBA8888, FORMAT_RGBA8888, source.data(), width, height, width * 4, downscaled.data(), outWidth, outHeight, outWidth * 4, false));
+            Vector<uint8> downscaledReference(downscaled.size());
+            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> downscale;
+            downscale(source.data(), width, height, width * 4, downscaledReference.data(), outWidth, outHeight, outWidth * 4);
+            TEST_VERIFY_WITH_MESSAGE(downscaled == downscaledReference, Format("RGBA8888 downscale %ux%u", width, height));
+        }
+    }
+
+    DAVA_TEST (ConvertBenchmarkTest)
+    {
+        for (uint32 size : { 256u, 1024u, 2048u })
+        {
+            ScopedPtr<Image> source(Image::Create(size, size, FORMAT_RGBA8888));
+            Vector<uint8> data = CreateRandomData(source->GetDataSize());
+            Memcpy(source->GetData(), data.data(), data.size());
+            ScopedPtr<Image> bgra(Image::Create(size, size, FORMAT_BGRA8888));
+            Memcpy(bgra->GetData(), data.data(), data.size());
+            ScopedPtr<Image> rgba(Image::Create(size, size, FORMAT_RGBA8888));
+            ScopedPtr<Image> rgba4444(Image::Create(size, size, FORMAT_RGBA4444));
+
+            int64 startTime = SystemTimer::GetMs();
+            TEST_VERIFY(ImageConvert::ConvertImageDirect(bgra, rgba));
+            int64 swapTime = SystemTimer::GetMs() - startTime;
+
+            startTime = SystemTimer::GetMs();
+            TEST_VERIFY(ImageConvert::ConvertImageDirect(source, rgba4444));
+            int64 packTime = SystemTimer::GetMs() - startTime;
+
+            startTime = SystemTimer::GetMs();
+            ScopedPtr<Image> downscaled(ImageConvert::DownscaleTwiceBillinear(source));
+            int64 downscaleTime = SystemTimer::GetMs() - startTime;
+            TEST_VERIFY(downscaled);
+
+            startTime = SystemTimer::GetMs();
+            Vector<Image*> mipmaps = source->CreateMipMapsImages();
+            int64 mipmapsTime = SystemTimer::GetMs() - startTime;
+            TEST_VERIFY(!mipmaps.empty());
+            for (Image* image : mipmaps)
+            {
+                SafeRelease(image);
+            }
+
+            Logger::Info("ImageConvert %ux%u: BGRA8888->RGBA8888 %lld ms, RGBA8888->RGBA4444 %lld ms, downscale %lld ms, mipmaps %lld ms",
+                         size, size, swapTime, packTime, downscaleTime, mipmapsTime);
+        }
+    }
+
+    Vector<uint8> CreateRandomData(size_t size)
+    {
+        Vector<uint8> data(size);
+        for (uint8& byte : data)
+        {
+            byte = static_cast<uint8>(Random::Instance()->Rand(256));
+        }
+        return data;
+    }
 };
@@ -1,5 +1,6 @@
 #include "DAVAEngine.h"
 #include "UnitTests/UnitTests.h"
+#include "Job/JobQueue.h"
 
 using namespace DAVA;
 
@@ -87,6 +88,40 @@ DAVA_TESTCLASS (JobManagerTest)
         // ...
     }
 
+    DAVA_TEST (TestWorkerQueueGrowth)
+    {
+        // jobs pushed over initial capacity while none of them is popped are kept
+        JobQueueWorker queue(4);
+        uint32 executed = 0;
+        for (uint32 i = 0; i < 10; ++i)
+        {
+            queue.Push([&executed]() { ++executed; });
+        }
+
+        // jobs can be pushed after some of them are popped
+        TEST_VERIFY(queue.PopAndExec());
+        for (uint32 i = 0; i < 6; ++i)
+        {
+            queue.Push([&executed]() { ++executed; });
+        }
+
+        while (queue.PopAndExec())
+        {
+        }
+        TEST_VERIFY(executed == 16);
+        TEST_VERIFY(queue.IsEmpty());
+
+        // worker jobs over initial capacity of worker queue are executed
+        const uint32 jobsCount = 5000;
+        Atomic<uint32> workerExecuted(0);
+        for (uint32 i = 0; i < jobsCount; ++i)
+        {
+            GetEngineContext()->jobManager->CreateWorkerJob([&workerExecuted]() { ++workerExecuted; });
+        }
+        GetEngineContext()->jobManager->WaitWorkerJobs();
+        TEST_VERIFY(workerExecuted == jobsCount);
+    }
+
     void ThreadFunc(JobManagerTestData * data)
     {
         for (uint32 i = 0; i < JOBS_COUNT; i++)
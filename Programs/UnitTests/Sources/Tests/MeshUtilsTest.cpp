@@ -0,0 +1,120 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/3D/MeshUtils.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+
+#include <numeric>
+#include <random>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (MeshUtilsTest)
+{
+    DAVA_TEST (OptimizeMeshTest)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 20.0f },
+            { FastName("segments.y"), 20.0f },
+            { FastName("segments.z"), 20.0f }
+        };
+
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), options);
+
+        // shuffle triangles to make cache efficiency of source mesh bad
+        int32 triangleCount = geometry->GetIndexCount() / 3;
+        Vector<int32> order(triangleCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+        Vector<int16> shuffled(geometry->GetIndexCount());
+        for (int32 t = 0; t < triangleCount; ++t)
+        {
+            std::copy_n(geometry->indexArray + order[t] * 3, 3, shuffled.begin() + t * 3);
+        }
+        std::copy(shuffled.begin(), shuffled.end(), geometry->indexArray);
+
+        Set<Array<float32, 9>> trianglesBefore = CollectTriangles(geometry);
+
+        MeshUtils::MeshOptimizationStats stats = MeshUtils::OptimizeMesh(geometry);
+        TEST_VERIFY(stats.triangleCount == static_cast<uint32>(triangleCount));
+        TEST_VERIFY(stats.vertexCount == static_cast<uint32>(geometry->GetVertexCount()));
+        TEST_VERIFY(stats.vertexSize == static_cast<uint32>(geometry->vertexStride));
+        TEST_VERIFY(stats.acmrAfter < stats.acmrBefore);
+        TEST_VERIFY(stats.acmrAfter < 1.0f);
+        TEST_VERIFY(FLOAT_EQUAL(stats.acmrAfter, MeshUtils::CalculateACMR(geometry->indexArray, geometry->GetIndexCount(), geometry->GetVertexCount())));
+
+        // same triangles with same winding, vertices go in order of first use
+        TEST_VERIFY(CollectTriangles(geometry) == trianglesBefore);
+
+        int32 maxIndex = -1;
+        for (int32 i = 0; i < geometry->GetIndexCount(); ++i)
+        {
+            int32 index;
+            geometry->GetIndex(i, index);
+            TEST_VERIFY(index <= maxIndex + 1);
+            maxIndex = std::max(maxIndex, index);
+        }
+
+        SafeRelease(geometry);
+    }
+
+    DAVA_TEST (OptimizeDegenerateMeshTest)
+    {
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), Map<FastName, float32>());
+
+        // collapsed mesh has zero normals in all clusters
+        for (int32 i = 0; i < geometry->GetVertexCount(); ++i)
+        {
+            geometry->SetCoord(i, Vector3(1.0f, 1.0f, 1.0f));
+        }
+
+        int32 indexCount = geometry->GetIndexCount();
+        MeshUtils::MeshOptimizationStats stats = MeshUtils::OptimizeMesh(geometry);
+        TEST_VERIFY(stats.triangleCount == static_cast<uint32>(indexCount / 3));
+        TEST_VERIFY(geometry->GetIndexCount() == indexCount);
+
+        for (int32 i = 0; i < geometry->GetIndexCount(); ++i)
+        {
+            int32 index;
+            geometry->GetIndex(i, index);
+            TEST_VERIFY(index >= 0 && index < geometry->GetVertexCount());
+        }
+
+        SafeRelease(geometry);
+    }
+
+    Set<Array<float32, 9>> CollectTriangles(PolygonGroup * geometry)
+    {
+        Set<Array<float32, 9>> triangles;
+        for (int32 t = 0; t < geometry->GetIndexCount() / 3; ++t)
+        {
+            Array<Vector3, 3> p;
+            for (int32 c = 0; c < 3; ++c)
+            {
+                int32 index;
+                geometry->GetIndex(t * 3 + c, index);
+                geometry->GetCoord(index, p[c]);
+            }
+
+            // rotate to start from the smallest vertex so that winding is kept
+            int32 first = 0;
+            for (int32 c = 1; c < 3; ++c)
+            {
+                if (std::tie(p[c].x, p[c].y, p[c].z) < std::tie(p[first].x, p[first].y, p[first].z))
+                {
+                    first = c;
+                }
+            }
+
+            Array<float32, 9> key;
+            for (int32 c = 0; c < 3; ++c)
+            {
+                const Vector3& v = p[(first + c) % 3];
+                key[c * 3 + 0] = v.x;
+                key[c * 3 + 1] = v.y;
+                key[c * 3 + 2] = v.z;
+            }
+            triangles.insert(key);
+        }
+        return triangles;
+    }
+};
@@ -7,6 +7,7 @@
 #include "Network/NetConfig.h"
 #include "Network/NetService.h"
 #include "Network/NetCore.h"
+#include "Time/SystemTimer.h"
 
 #if !defined(DAVA_NETWORK_DISABLE)
 
@@ -232,6 +233,107 @@ private:
     size_t pendingDelivered = 0; // Parcel index expected to be confirmed as delivered
 };
 
+// Packets of throughput test: mostly small ones, which are coalesced, and some large ones, which are split into frames.
+// Each packet is gathered from its number and a part of shared payload
+struct ThroughputPackets
+{
+    static const uint32 PACKET_COUNT = 4096;
+    static const size_t SMALL_PACKET_SIZE = 60;
+    static const size_t LARGE_PACKET_SIZE = 1024 * 1024;
+
+    ThroughputPackets()
+        : payload(LARGE_PACKET_SIZE)
+    {
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] = static_cast<uint8>(i * 31 + 7);
+        }
+    }
+
+    static size_t PayloadSize(uint32 index)
+    {
+        return index % 128 == 127 ? LARGE_PACKET_SIZE : SMALL_PACKET_SIZE;
+    }
+
+    Vector<uint8> payload;
+};
+
+class TestThroughputServer : public DAVA::Net::NetService
+{
+public:
+    void PacketReceived(const void* packet, size_t length) override
+    {
+        uint32 index = 0;
+        if (length == sizeof(index) + ThroughputPackets::PayloadSize(receivedCount))
+        {
+            Memcpy(&index, packet, sizeof(index));
+            if (index == receivedCount && 0 == Memcmp(packets.payload.data(), static_cast<const uint8*>(packet) + sizeof(index), length - sizeof(index)))
+            {
+                validCount += 1;
+            }
+        }
+        receivedCount += 1;
+        bytesRecieved += length;
+    }
+
+    bool IsTestDone() const
+    {
+        return receivedCount == ThroughputPackets::PACKET_COUNT;
+    }
+
+    uint32 ValidCount() const
+    {
+        return validCount;
+    }
+
+    size_t BytesRecieved() const
+    {
+        return bytesRecieved;
+    }
+
+private:
+    ThroughputPackets packets;
+    uint32 receivedCount = 0;
+    uint32 validCount = 0;
+    size_t bytesRecieved = 0;
+};
+
+class TestThroughputClient : public DAVA::Net::NetService
+{
+public:
+    void ChannelOpen() override
+    {
+        startTime = SystemTimer::GetMs();
+        numbers.resize(ThroughputPackets::PACKET_COUNT);
+        for (uint32 i = 0; i < ThroughputPackets::PACKET_COUNT; ++i)
+        {
+            // Neither number nor payload is copied, so they must live until the packet is sent
+            numbers[i] = i;
+            Buffer buffers[] = {
+                CreateBuffer(&numbers[i]),
+                CreateBuffer(packets.payload.data(), ThroughputPackets::PayloadSize(i))
+            };
+            SendGathered(buffers, 2, [this]() { sentCount += 1; });
+        }
+    }
+
+    bool IsTestDone() const
+    {
+        return sentCount == ThroughputPackets::PACKET_COUNT;
+    }
+
+    int64 StartTime() const
+    {
+        return startTime;
+    }
+
+private:
+    ThroughputPackets packets;
+    Vector<uint32> numbers;
+    uint32 sentCount = 0;
+    int64 startTime = 0;
+};
+
 DAVA_TESTCLASS (NetworkTest)
 {
     //BEGIN_FILES_COVERED_BY_TESTS( )
@@ -244,7 +346,8 @@ DAVA_TESTCLASS (NetworkTest)
 
     enum eServiceTypes
     {
-        SERVICE_ECHO = 1000
+        SERVICE_ECHO = 1000,
+        SERVICE_THROUGHPUT = 1001
     };
 
     enum
@@ -254,11 +357,16 @@ DAVA_TESTCLASS (NetworkTest)
     };
 
     static const uint16 ECHO_PORT = 55101;
+    static const uint16 THROUGHPUT_PORT = 55102;
 
     bool echoTestDone = false;
     TestEchoServer echoServer;
     TestEchoClient echoClient;
 
+    bool throughputTestDone = false;
+    TestThroughputServer throughputServer;
+    TestThroughputClient throughputClient;
+
     NetCore::TrackId serverId = NetCore::INVALID_TRACK_ID;
     NetCore::TrackId clientId = NetCore::INVALID_TRACK_ID;
 
@@ -278,13 +386,26 @@ DAVA_TESTCLASS (NetworkTest)
                 TEST_VERIFY(echoServer.BytesRecieved() == echoClient.BytesRecieved());
             }
         }
+        else if (testName == "TestThroughput")
+        {
+            throughputTestDone = throughputServer.IsTestDone() && throughputClient.IsTestDone();
+            if (throughputTestDone)
+            {
+                TEST_VERIFY(throughputServer.ValidCount() == ThroughputPackets::PACKET_COUNT);
+
+                int64 elapsedMs = Max<int64>(SystemTimer::GetMs() - throughputClient.StartTime(), 1);
+                float64 megabytes = static_cast<float64>(throughputServer.BytesRecieved()) / (1024.0 * 1024.0);
+                Logger::Info("Loopback throughput: %u packets, %.1f MB in %lld ms, %.1f MB/s",
+                             ThroughputPackets::PACKET_COUNT, megabytes, elapsedMs, megabytes * 1000.0 / elapsedMs);
+            }
+        }
 
         TestClass::Update(timeElapsed, testName);
     }
 
     void TearDown(const String& testName) override
     {
-        if (testName == "TestEcho")
+        if (testName == "TestEcho" || testName == "TestThroughput")
         {
             // Check whether DestroyControllerBlocked() really blocks until controller is destroyed
             size_t nactive = NetCore::Instance()->ControllersCount();
@@ -305,6 +426,10 @@ DAVA_TESTCLASS (NetworkTest)
         {
             return echoTestDone;
         }
+        else if (testName == "TestThroughput")
+        {
+            return throughputTestDone;
+        }
         return true;
     }
 
@@ -389,6 +514,30 @@ DAVA_TESTCLASS (NetworkTest)
         clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(ECHO_CLIENT_CONTEXT));
     }
 
+    // Streams packets through loopback connection and logs throughput
+    DAVA_TEST (TestThroughput)
+    {
+        NetCore::Instance()->RegisterService(SERVICE_THROUGHPUT, MakeFunction(this, &NetworkTest::CreateThroughput), MakeFunction(this, &NetworkTest::DeleteEcho));
+
+        NetConfig serverConfig(SERVER_ROLE);
+        serverConfig.AddTransport(TRANSPORT_TCP, Endpoint(THROUGHPUT_PORT));
+        serverConfig.AddService(SERVICE_THROUGHPUT);
+
+        NetConfig clientConfig = serverConfig.Mirror(IPAddress("127.0.0.1"));
+
+        serverId = NetCore::Instance()->CreateController(serverConfig, reinterpret_cast<void*>(ECHO_SERVER_CONTEXT));
+        clientId = NetCore::Instance()->CreateController(clientConfig, reinterpret_cast<void*>(ECHO_CLIENT_CONTEXT));
+    }
+
+    IChannelListener* CreateThroughput(uint32 serviceId, void* context)
+    {
+        if (ECHO_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &throughputServer;
+        else if (ECHO_CLIENT_CONTEXT == reinterpret_cast<intptr_t>(context))
+            return &throughputClient;
+        return nullptr;
+    }
+
     IChannelListener* CreateEcho(uint32 serviceId, void* context)
     {
         if (ECHO_SERVER_CONTEXT == reinterpret_cast<intptr_t>(context))
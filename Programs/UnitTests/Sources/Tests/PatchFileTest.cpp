@@ -0,0 +1,69 @@
+#include <DLC/Patcher/PatchFile.h>
+#include <Engine/Engine.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+
+#include "UnitTests/UnitTests.h"
+
+#include <random>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (PatchFileTest)
+{
+    const FilePath rootDir = "~doc:/TestData/PatchFileTest/";
+    const FilePath origDir = rootDir + "Orig/";
+    const FilePath newDir = rootDir + "New/";
+    const FilePath outputDir = rootDir + "Output/";
+
+    DAVA_TEST (BlocksPatchTest)
+    {
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        fs->DeleteDirectory(rootDir, true);
+        fs->CreateDirectory(origDir, true);
+        fs->CreateDirectory(newDir, true);
+        fs->CreateDirectory(outputDir, true);
+
+        // several blocks of data with insertions, replacements and data appended to the end
+        std::mt19937 random(42);
+        Vector<uint8> origData(5 * 1024 * 1024 + 100);
+        for (uint8& byte : origData)
+        {
+            byte = static_cast<uint8>(random() % 16);
+        }
+
+        Vector<uint8> newData = origData;
+        newData.insert(newData.begin() + 1024 * 1024, 1000, 0xAA);
+        for (size_t i = 0; i < newData.size(); i += 64 * 1024)
+        {
+            newData[i] = static_cast<uint8>(random());
+        }
+        newData.insert(newData.end(), 100 * 1024, 0x55);
+
+        WriteData(origDir + "data.bin", origData);
+        WriteData(newDir + "data.bin", newData);
+
+        FilePath patchPath = rootDir + "patch.dat";
+        {
+            PatchFileWriter writer(patchPath, PatchFileWriter::WRITE, BS_LZ4_BLOCKS);
+            TEST_VERIFY(writer.Write(origDir, origDir + "data.bin", newDir, newDir + "data.bin"));
+        }
+        uint64 patchSize = 0;
+        TEST_VERIFY(fs->GetFileSize(patchPath, patchSize));
+        TEST_VERIFY(patchSize < newData.size() / 4);
+
+        PatchFileReader reader(patchPath);
+        TEST_VERIFY(reader.ReadFirst());
+        TEST_VERIFY(reader.GetCurInfo() != nullptr);
+        TEST_VERIFY(reader.Apply(origDir, FilePath(), outputDir, FilePath()));
+        TEST_VERIFY(reader.GetError() == PatchFileReader::ERROR_NO);
+        TEST_VERIFY(fs->CompareBinaryFiles(newDir + "data.bin", outputDir + "data.bin"));
+    }
+
+    void WriteData(const FilePath& path, const Vector<uint8>& data)
+    {
+        ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+        TEST_VERIFY(file);
+        TEST_VERIFY(file->Write(data.data(), static_cast<uint32>(data.size())) == data.size());
+    }
+};
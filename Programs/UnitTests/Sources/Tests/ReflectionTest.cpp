@@ -6,6 +6,7 @@
 #include <Time/SystemTimer.h>
 #include <Concurrency/Thread.h>
 #include <Reflection/ReflectionRegistrator.h>
+#include <Reflection/ReflectedFieldAccessor.h>
 
 #include "UnitTests/UnitTests.h"
 
@@ -162,6 +163,20 @@ struct DHolder : DAVA::ReflectionBase
     }
 };
 
+struct ConstHolder : DAVA::ReflectionBase
+{
+    const int c = 5;
+    int v = 0;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(ConstHolder)
+    {
+        DAVA::ReflectionRegistrator<ConstHolder>::Begin()
+        .Field("c", &ConstHolder::c)
+        .Field("v", &ConstHolder::v)
+        .End();
+    }
+};
+
 template <typename T>
 struct ValueRange
 {
@@ -771,6 +786,120 @@ DAVA_TESTCLASS (ReflectionTest)
         delete v.back();
     }
 
+    DAVA_TEST (FieldAccessor)
+    {
+        SimpleStruct s;
+        DAVA::ReflectedObject sobj(&s);
+        const DAVA::ReflectedType* stype = sobj.GetReflectedType();
+
+        // accessors are shared per type and path
+        const DAVA::ReflectedFieldAccessor* sa = DAVA::ReflectedFieldAccessor::Get(stype, DAVA::FastName("a"));
+        TEST_VERIFY(sa->IsValid());
+        TEST_VERIFY(sa == DAVA::ReflectedFieldAccessor::Get(stype, DAVA::FastName("a")));
+
+        // plain class member goes through offset
+        TEST_VERIFY(sa->GetValuePtr<int>(sobj) == &s.a);
+        TEST_VERIFY(sa->GetValuePtr<float>(sobj) == nullptr);
+        TEST_VERIFY(sa->SetValueDirect(sobj, 555));
+        TEST_VERIFY(s.a == 555);
+        TEST_VERIFY(sa->GetValue(sobj).Get<int>() == 555);
+        TEST_VERIFY(sa->GetReflection(sobj).GetValue().Get<int>() == 555);
+
+        // offsets are the same for other objects of the same type
+        SimpleStruct s2;
+        TEST_VERIFY(sa->GetValuePtr<int>(DAVA::ReflectedObject(&s2)) == &s2.a);
+
+        // nested fields and fields of base classes
+        DHolder h;
+        DAVA::ReflectedObject hobj(&h);
+        const DAVA::ReflectedFieldAccessor* hda = DAVA::ReflectedFieldAccessor::Get(hobj.GetReflectedType(), DAVA::FastName("d.a"));
+        TEST_VERIFY(hda->GetValuePtr<int>(hobj) == &h.d.a);
+        TEST_VERIFY(hda->SetValue(hobj, DAVA::Any(42)));
+        TEST_VERIFY(h.d.a == 42);
+
+        const DAVA::ReflectedFieldAccessor* hdd = DAVA::ReflectedFieldAccessor::Get(hobj.GetReflectedType(), DAVA::FastName("d.d"));
+        TEST_VERIFY(hdd->SetValueDirect(hobj, DAVA::String("EEE")));
+        TEST_VERIFY(h.d.d == "EEE");
+
+        // getter/setter fields have no storage
+        ReflectionTestClass t;
+        DAVA::ReflectedObject tobj(&t);
+        const DAVA::ReflectedType* ttype = tobj.GetReflectedType();
+
+        const DAVA::ReflectedFieldAccessor* intFn = DAVA::ReflectedFieldAccessor::Get(ttype, DAVA::FastName("IntFn"));
+        TEST_VERIFY(intFn->GetValuePtr<int>(tobj) == nullptr);
+        TEST_VERIFY(intFn->SetValueDirect(tobj, 777));
+        TEST_VERIFY(t.GetIntFn() == 777);
+
+        const DAVA::ReflectedFieldAccessor* intFnConst = DAVA::ReflectedFieldAccessor::Get(ttype, DAVA::FastName("IntFnConst"));
+        TEST_VERIFY(intFnConst->IsReadonly(tobj));
+        TEST_VERIFY(!intFnConst->SetValue(tobj, DAVA::Any(1)));
+        TEST_VERIFY(intFnConst->GetValue(tobj).Get<int>() == 777);
+
+        const DAVA::ReflectedFieldAccessor* ta = DAVA::ReflectedFieldAccessor::Get(ttype, DAVA::FastName("a"));
+        TEST_VERIFY(ta->GetValuePtr<int>(tobj) == &t.a);
+
+        // read-only fields and const objects aren't written through offset
+        ConstHolder c;
+        DAVA::ReflectedObject cobj(&c);
+        const DAVA::ReflectedFieldAccessor* cc = DAVA::ReflectedFieldAccessor::Get(cobj.GetReflectedType(), DAVA::FastName("c"));
+        TEST_VERIFY(cc->IsReadonly(cobj));
+        TEST_VERIFY(cc->GetValuePtr<int>(cobj) == nullptr);
+        TEST_VERIFY(cc->GetValuePtr<const int>(cobj) == nullptr);
+        TEST_VERIFY(!cc->SetValueDirect(cobj, 6));
+        TEST_VERIFY(c.c == 5);
+
+        const ConstHolder* constPtr = &c;
+        DAVA::ReflectedObject constObj(constPtr);
+        const DAVA::ReflectedFieldAccessor* cv = DAVA::ReflectedFieldAccessor::Get(constObj.GetReflectedType(), DAVA::FastName("v"));
+        TEST_VERIFY(cv->GetValuePtr<int>(constObj) == nullptr);
+        TEST_VERIFY(!cv->SetValueDirect(constObj, 6));
+        TEST_VERIFY(c.v == 0);
+        TEST_VERIFY(cv->GetValuePtr<int>(cobj) == &c.v);
+
+        TEST_VERIFY(!DAVA::ReflectedFieldAccessor::Get(ttype, DAVA::FastName("unknown"))->IsValid());
+        TEST_VERIFY(!DAVA::ReflectedFieldAccessor::Get(ttype, DAVA::FastName("s1.unknown"))->IsValid());
+    }
+
+    DAVA_TEST (FieldAccessorBenchmark)
+    {
+// used only for manual performance testing
+// change to `#if 1` to run this test
+#if 0
+        const size_t count = 10000000;
+        SimpleStruct* rtc = new SimpleStruct();
+        DAVA::ReflectedObject obj(rtc);
+        DAVA::FastName fieldname("b");
+
+        DAVA::int64 begin = DAVA::SystemTimer::GetUs();
+        for (size_t i = 0; i < count; ++i)
+        {
+            DAVA::Reflection::Create(obj).GetField(fieldname).SetValueWithCast(DAVA::Any(static_cast<int>(i)));
+        }
+        DAVA::int64 byNameTime = DAVA::SystemTimer::GetUs() - begin;
+
+        const DAVA::ReflectedFieldAccessor* accessor = DAVA::ReflectedFieldAccessor::Get(obj.GetReflectedType(), fieldname);
+        begin = DAVA::SystemTimer::GetUs();
+        for (size_t i = 0; i < count; ++i)
+        {
+            accessor->SetValueWithCast(obj, DAVA::Any(static_cast<int>(i)));
+        }
+        DAVA::int64 accessorTime = DAVA::SystemTimer::GetUs() - begin;
+
+        begin = DAVA::SystemTimer::GetUs();
+        for (size_t i = 0; i < count; ++i)
+        {
+            accessor->SetValueDirect(obj, static_cast<int>(i));
+        }
+        DAVA::int64 directTime = DAVA::SystemTimer::GetUs() - begin;
+
+        DAVA::Logger::Info("Per-property set, ns: GetField %.2f, accessor %.2f, accessor direct %.2f",
+                           byNameTime * 1000.0 / count, accessorTime * 1000.0 / count, directTime * 1000.0 / count);
+
+        delete rtc;
+#endif
+    }
+
     DAVA_TEST (ReflectionByFieldName)
     {
 // used only for manual performance testing
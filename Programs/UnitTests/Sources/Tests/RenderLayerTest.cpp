@@ -0,0 +1,90 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/Light.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderBatchArray.h"
+#include "Render/Highlevel/RenderLayer.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/SkinnedMesh.h"
+#include "Render/Material/NMaterial.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (RenderLayerTest)
+{
+    DAVA_TEST (InstancedGroupTest)
+    {
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), Map<FastName, float32>());
+        PolygonGroup* otherGeometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(2.0f, 2.0f, 2.0f)), Map<FastName, float32>());
+        NMaterial* material = new NMaterial();
+        Camera* camera = new Camera();
+
+        // different lights with equal bound values can share a group
+        Light* light = CreateLight(Vector3(1.0f, 0.0f, 0.0f));
+        Light* sameLight = CreateLight(Vector3(1.0f, 0.0f, 0.0f));
+        Light* otherLight = CreateLight(Vector3(0.0f, 1.0f, 0.0f));
+
+        Vector<RenderObject*> objects;
+        objects.push_back(CreateRenderObject(new RenderObject(), geometry, material, light));
+        objects.push_back(CreateRenderObject(new RenderObject(), geometry, material, sameLight));
+        objects.push_back(CreateRenderObject(new RenderObject(), geometry, material, light));
+        objects.push_back(CreateRenderObject(new RenderObject(), geometry, material, otherLight));
+        objects.push_back(CreateRenderObject(new RenderObject(), otherGeometry, material, otherLight));
+        objects.push_back(CreateRenderObject(new SkinnedMesh(), geometry, material, otherLight));
+        objects.push_back(CreateRenderObject(new SkinnedMesh(), geometry, material, otherLight));
+
+        RenderBatchArray batchArray;
+        for (RenderObject* object : objects)
+        {
+            batchArray.AddRenderBatch(object->GetRenderBatch(0));
+        }
+
+        TEST_VERIFY(RenderLayer::GetInstancedGroupSize(camera, batchArray, 0) == 3);
+        TEST_VERIFY(RenderLayer::GetInstancedGroupSize(camera, batchArray, 1) == 2);
+
+        // other light values and other geometry break the group
+        TEST_VERIFY(RenderLayer::GetInstancedGroupSize(camera, batchArray, 3) == 1);
+        TEST_VERIFY(RenderLayer::GetInstancedGroupSize(camera, batchArray, 4) == 1);
+
+        // objects binding own per-object parameters are drawn as single instances
+        TEST_VERIFY(RenderLayer::GetInstancedGroupSize(camera, batchArray, 5) == 1);
+        TEST_VERIFY(RenderLayer::GetInstancedGroupSize(camera, batchArray, 6) == 1);
+
+        for (RenderObject* object : objects)
+        {
+            SafeRelease(object);
+        }
+        SafeRelease(otherLight);
+        SafeRelease(sameLight);
+        SafeRelease(light);
+        SafeRelease(camera);
+        SafeRelease(material);
+        SafeRelease(otherGeometry);
+        SafeRelease(geometry);
+    }
+
+    Light* CreateLight(const Vector3& position)
+    {
+        Light* light = new Light();
+        light->SetType(Light::TYPE_POINT);
+        light->SetPosition(position);
+        light->SetDiffuseColor(Color::White);
+        return light;
+    }
+
+    RenderObject* CreateRenderObject(RenderObject * object, PolygonGroup * geometry, NMaterial * material, Light * light)
+    {
+        RenderBatch* batch = new RenderBatch();
+        batch->SetPolygonGroup(geometry);
+        batch->SetMaterial(material);
+
+        object->AddRenderBatch(batch);
+        object->SetWorldTransformPtr(&worldTransform);
+        object->SetLight(0, light);
+        SafeRelease(batch);
+        return object;
+    }
+
+    Matrix4 worldTransform;
+};
@@ -203,6 +203,46 @@ DAVA_TESTCLASS (ResourcePackerTest)
 
         TEST_VERIFY(packer.GetErrors().empty() == false); // should contain error about absence of ".china" tag in allTags
     };
+
+    DAVA_TEST (ThreadsTest)
+    {
+        using namespace DAVA;
+
+        ClearWorkingFolders();
+        CopyPsdSources();
+
+        {
+            ScopedPtr<File> flagsFile(File::Create(inputDir + "flags.txt", File::CREATE | File::WRITE));
+            flagsFile->WriteLine("--split");
+        }
+
+        {
+            ResourcePacker2D packer;
+            packer.InitFolders(inputDir, outputDir);
+            packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+
+        FilePath threadsOutputDir = rootDir + "OutputWithThreads/";
+
+        ResourcePacker2D packer;
+        packer.InitFolders(inputDir, threadsOutputDir);
+        packer.SetThreadsCount(4);
+        packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+
+        TEST_VERIFY(packer.GetErrors().empty() == true);
+        TEST_VERIFY(packer.GetPackTimes().size() == 1);
+        TEST_VERIFY(packer.GetPackTimes()[0].directory == inputDir);
+
+        // result of parallel packing should be the same as of serial one
+        for (const String& name : psdBaseNames)
+        {
+            String textureName = name + "0";
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareTextFiles(outputDir + (name + ".txt"), threadsOutputDir + (name + ".txt")) == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareBinaryFiles(outputDir + (textureName + ".png"), threadsOutputDir + (textureName + ".png")) == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareBinaryFiles(outputDir + (textureName + ".tex"), threadsOutputDir + (textureName + ".tex")) == true);
+        }
+    };
 };
 
 #endif
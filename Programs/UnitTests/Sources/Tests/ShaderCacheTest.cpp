@@ -0,0 +1,30 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/RHI/rhi_Public.h"
+#include "Render/ShaderCache.h"
+#include "Time/SystemTimer.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (ShaderCacheTest)
+{
+    DAVA_TEST (BuildManyShaderSourcesTest)
+    {
+        // more variants than worker queue holds at once
+        const uint32 variantsCount = 1100;
+
+        // values are unique for the run, so that variants aren't in cache yet
+        const int32 base = static_cast<int32>(SystemTimer::GetMs() % 1000000) * 2000;
+
+        Vector<ShaderDescriptorCache::ShaderVariant> variants(variantsCount);
+        for (uint32 i = 0; i < variantsCount; ++i)
+        {
+            variants[i].name = FastName("~res:/Materials/Shaders/2d/alpha-fill");
+            variants[i].defines[FastName("SHADER_CACHE_TEST_VARIANT")] = base + static_cast<int32>(i) + 1;
+        }
+
+        TEST_VERIFY(ShaderDescriptorCache::BuildShaderSources(variants, rhi::HostApi()) == variantsCount);
+
+        // all variants are in cache now
+        TEST_VERIFY(ShaderDescriptorCache::BuildShaderSources(variants, rhi::HostApi()) == 0);
+    }
+};
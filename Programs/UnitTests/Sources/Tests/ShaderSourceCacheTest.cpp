@@ -0,0 +1,136 @@
+#include "UnitTests/UnitTests.h"
+#include "Base/Hash.h"
+#include "Base/ScopedPtr.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Functional/Function.h"
+#include "Job/JobManager.h"
+#include "Render/RHI/rhi_Public.h"
+#include "Render/RHI/rhi_ShaderSource.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (ShaderSourceCacheTest)
+{
+    const FilePath SOURCE_PATH = "~res:/Materials/Shaders/2d/alpha-fill-vp.sl";
+    const String CACHE_FILE = "~doc:/ShaderSourceCacheTest.bin";
+    const String HOST_CACHE_FILE = "~doc:/ShaderSourceCacheTest_host.bin";
+    const FastName UID = FastName("ShaderSourceCacheTest: alpha-fill-vp");
+
+    ShaderSourceCacheTest()
+    {
+        // keep sources of running application, cache is restored in destructor
+        rhi::ShaderSourceCache::Save(HOST_CACHE_FILE.c_str());
+    }
+
+    ~ShaderSourceCacheTest()
+    {
+        rhi::ShaderSourceCache::Load(HOST_CACHE_FILE.c_str());
+        FileSystem::Instance()->DeleteFile(CACHE_FILE);
+    }
+
+    DAVA_TEST (SaveLoadTest)
+    {
+        const rhi::ShaderSource* added = AddSource();
+        TEST_VERIFY(added != nullptr);
+        String sourceCode = added->GetSourceCode(rhi::HostApi());
+        rhi::ShaderSourceCache::Save(CACHE_FILE.c_str());
+
+        rhi::ShaderSourceCache::Load(CACHE_FILE.c_str());
+
+        // entry is unpacked on first request
+        const rhi::ShaderSource* loaded = rhi::ShaderSourceCache::Get(UID, srcHash);
+        TEST_VERIFY(loaded != nullptr);
+        TEST_VERIFY(loaded != added);
+        TEST_VERIFY(loaded->GetSourceCode(rhi::HostApi()) == sourceCode);
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(UID, srcHash) == loaded);
+
+        // changed source text isn't taken from cache
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(UID, srcHash + 1) == nullptr);
+    }
+
+    DAVA_TEST (ConcurrentGetTest)
+    {
+        AddSource();
+        rhi::ShaderSourceCache::Save(CACHE_FILE.c_str());
+        rhi::ShaderSourceCache::Load(CACHE_FILE.c_str());
+
+        // entry is unpacked by several threads at once, all of them get the published one
+        const uint32 jobsCount = 16;
+        Array<const rhi::ShaderSource*, jobsCount> results = {};
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        for (uint32 i = 0; i < jobsCount; ++i)
+        {
+            jobManager->CreateWorkerJob([this, &results, i]() {
+                results[i] = rhi::ShaderSourceCache::Get(UID, srcHash);
+            });
+        }
+        jobManager->WaitWorkerJobs();
+
+        const rhi::ShaderSource* published = rhi::ShaderSourceCache::Get(UID, srcHash);
+        TEST_VERIFY(published != nullptr);
+        for (const rhi::ShaderSource* src : results)
+        {
+            TEST_VERIFY(src == published);
+        }
+    }
+
+    DAVA_TEST (HeaderMismatchTest)
+    {
+        AddSource();
+        rhi::ShaderSourceCache::Save(CACHE_FILE.c_str());
+
+        // other format version
+        ModifyCacheFile([](Vector<uint8>& data) { data[0] += 1; });
+        rhi::ShaderSourceCache::Load(CACHE_FILE.c_str());
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(UID, srcHash) == nullptr);
+
+        // other shader compiler
+        AddSource();
+        rhi::ShaderSourceCache::Save(CACHE_FILE.c_str());
+        ModifyCacheFile([](Vector<uint8>& data) { data[2 * sizeof(uint32)] += 1; });
+        rhi::ShaderSourceCache::Load(CACHE_FILE.c_str());
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(UID, srcHash) == nullptr);
+    }
+
+    DAVA_TEST (CorruptedEntryTest)
+    {
+        AddSource();
+        rhi::ShaderSourceCache::Save(CACHE_FILE.c_str());
+
+        // the only entry data is at the end of file
+        ModifyCacheFile([](Vector<uint8>& data) { data.back() += 1; });
+        rhi::ShaderSourceCache::Load(CACHE_FILE.c_str());
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(UID, srcHash) == nullptr);
+
+        // corrupted entry is rebuilt from source text
+        TEST_VERIFY(AddSource() != nullptr);
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(UID, srcHash) != nullptr);
+    }
+
+    const rhi::ShaderSource* AddSource()
+    {
+        rhi::ShaderSourceCache::Clear();
+
+        String text = FileSystem::Instance()->ReadFileContents(SOURCE_PATH);
+        srcHash = HashValue_N(text.c_str(), static_cast<uint32>(text.length()));
+        return rhi::ShaderSourceCache::Add(SOURCE_PATH.GetFrameworkPath().c_str(), UID, rhi::PROG_VERTEX, text.c_str(), std::vector<std::string>());
+    }
+
+    void ModifyCacheFile(const Function<void(Vector<uint8>&)>& modify)
+    {
+        rhi::ShaderSourceCache::Clear();
+
+        Vector<uint8> data;
+        TEST_VERIFY(FileSystem::Instance()->ReadFileContents(CACHE_FILE, data));
+        TEST_VERIFY(!data.empty());
+        modify(data);
+
+        ScopedPtr<File> file(File::Create(CACHE_FILE, File::CREATE | File::WRITE));
+        TEST_VERIFY(file->Write(data.data(), static_cast<uint32>(data.size())) == data.size());
+    }
+
+    uint32 srcHash = 0;
+};
@@ -0,0 +1,314 @@
+#include "DAVAEngine.h"
+
+#include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
+#include "UI/Formula/Private/FormulaProgramCache.h"
+#include "UI/Formula/Private/FormulaException.h"
+
+#include "Reflection/ReflectionRegistrator.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+class FormulaCompilerTestData : public ReflectionBase
+{
+    DAVA_VIRTUAL_REFLECTION(FormulaCompilerTestData);
+
+public:
+    float flVal = 0.5f;
+    bool bVal = false;
+    String strVal = "Hello, world";
+    int intVal = 42;
+    Vector<int> array;
+    Map<String, int> map;
+
+    FormulaCompilerTestData()
+    {
+        array.push_back(10);
+        array.push_back(20);
+        array.push_back(30);
+
+        map["a"] = 11;
+        map["b"] = 22;
+    }
+
+    int sum(int a, int b)
+    {
+        return a + b;
+    }
+
+    String floatToStr(float a)
+    {
+        double var = static_cast<double>(a);
+        return Format("%.3f", var);
+    }
+};
+
+DAVA_VIRTUAL_REFLECTION_IMPL(FormulaCompilerTestData)
+{
+    ReflectionRegistrator<FormulaCompilerTestData>::Begin()
+    .Field("fl", &FormulaCompilerTestData::flVal)
+    .Field("b", &FormulaCompilerTestData::bVal)
+    .Field("str", &FormulaCompilerTestData::strVal)
+    .Field("intVal", &FormulaCompilerTestData::intVal)
+    .Field("array", &FormulaCompilerTestData::array)
+    .Field("map", &FormulaCompilerTestData::map)
+    .Method("sum", &FormulaCompilerTestData::sum)
+    .Method("floatToStr", &FormulaCompilerTestData::floatToStr)
+    .End();
+};
+
+class FormulaCompilerCountingContext : public FormulaReflectionContext
+{
+public:
+    FormulaCompilerCountingContext(const Reflection& ref)
+        : FormulaReflectionContext(ref, std::shared_ptr<FormulaContext>())
+    {
+    }
+
+    Reflection FindReflection(const String& name) const override
+    {
+        ++lookupsCount;
+        return FormulaReflectionContext::FindReflection(name);
+    }
+
+    mutable int32 lookupsCount = 0;
+};
+
+DAVA_TESTCLASS (FormulaCompilerTest)
+{
+    // FormulaVirtualMachine::Calculate
+    DAVA_TEST (CalculateValues)
+    {
+        TEST_VERIFY(Execute("5 + 5") == Any(10));
+        TEST_VERIFY(Execute("7U-9U").Get<uint32>() == static_cast<uint32>(-2));
+        TEST_VERIFY(Execute("1---2") == Any(-1));
+        TEST_VERIFY(FLOAT_EQUAL(Execute("fl * 2").Get<float32>(), 1.0f));
+        TEST_VERIFY(Execute("not b") == Any(true));
+        TEST_VERIFY(Execute("\"Hello,\" + \" world\" = str") == Any(true));
+        TEST_VERIFY(Execute("map.b + intVal") == Any(22 + 42));
+        TEST_VERIFY(Execute("array[1]") == Any(20));
+        TEST_VERIFY(Execute("array[intVal - 40]") == Any(30));
+        TEST_VERIFY(Execute("sum(16, intVal * 2)") == Any(100));
+        TEST_VERIFY(Execute("floatToStr(55)") == Any(String("55.000")));
+    }
+
+    // FormulaVirtualMachine::Calculate
+    DAVA_TEST (CalculateWhen)
+    {
+        TEST_VERIFY(Execute("when true -> 0, 1") == Any(0));
+        TEST_VERIFY(Execute("when 5 = 2 -> 0, 1") == Any(1));
+        TEST_VERIFY(Execute("when b -> 0, intVal > 40 -> 2, 3") == Any(2));
+        TEST_VERIFY(Execute("when intVal = 0 -> 0, false -> 1, intVal") == Any(42));
+    }
+
+    // FormulaCompiler::Compile
+    DAVA_TEST (ConstantFolding)
+    {
+        std::shared_ptr<FormulaProgram> program = Compile("2 * (3 + 4) - 1");
+        TEST_VERIFY(program->GetValueCode().size() == 1);
+        TEST_VERIFY(program->GetValueCode()[0].op == FormulaProgram::OpCode::LoadConst);
+        TEST_VERIFY(Execute("2 * (3 + 4) - 1") == Any(13));
+
+        program = Compile("when 5 = 2 -> intVal, 1 + 1");
+        TEST_VERIFY(program->GetValueCode().size() == 1);
+
+        program = Compile("intVal + 2 * 3");
+        TEST_VERIFY(program->GetValueCode().size() == 4); // find, load, const, add
+
+        // integer division by zero isn't folded, branch with it is never taken
+        program = Compile("1 / 0 + 5 % 0");
+        TEST_VERIFY(program->GetValueCode().size() > 1);
+        TEST_VERIFY(Execute("when intVal > 0 -> 1, 1 / 0") == Any(1));
+    }
+
+    // FormulaVirtualMachine::Calculate
+    DAVA_TEST (ErrorsAsInExecutor)
+    {
+        const char* expressions[] = {
+            "5 + 5L",
+            "\"54354\" - \"543543\"",
+            "not 5",
+            "-true",
+            "map.d",
+            "array[5.5]",
+            "sum(1, 2, 3)",
+            "when 5 -> 1, 2",
+            "fl % 2.5",
+            "1.5 % 2.5"
+        };
+
+        for (const char* str : expressions)
+        {
+            String executorError;
+            String vmError;
+
+            FormulaCompilerTestData data;
+            FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+            std::shared_ptr<FormulaExpression> exp = FormulaParser(str).ParseExpression();
+
+            try
+            {
+                FormulaExecutor(&context).Calculate(exp.get());
+            }
+            catch (const FormulaException& error)
+            {
+                executorError = error.GetFormattedMessage();
+            }
+
+            try
+            {
+                std::shared_ptr<FormulaProgram> program = FormulaCompiler().Compile(exp);
+                FormulaVirtualMachine(&context).Calculate(program.get());
+            }
+            catch (const FormulaException& error)
+            {
+                vmError = error.GetFormattedMessage();
+            }
+
+            TEST_VERIFY(!vmError.empty());
+            TEST_VERIFY(vmError == executorError);
+        }
+    }
+
+    // FormulaVirtualMachine::GetDataReference
+    DAVA_TEST (DataReference)
+    {
+        FormulaCompilerTestData data;
+        FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+
+        Reflection ref = FormulaVirtualMachine(&context).GetDataReference(Compile("intVal").get());
+        TEST_VERIFY(ref.IsValid());
+        ref.SetValue(Any(7));
+        TEST_VERIFY(data.intVal == 7);
+
+        ref = FormulaVirtualMachine(&context).GetDataReference(Compile("array[2]").get());
+        TEST_VERIFY(ref.GetValue() == Any(30));
+
+        try
+        {
+            FormulaVirtualMachine(&context).GetDataReference(Compile("intVal + 1").get());
+            TEST_VERIFY(false);
+        }
+        catch (const FormulaException& error)
+        {
+            TEST_VERIFY(error.GetFormattedMessage() == "[1, 8] Can't get data reference 'intVal + 1'");
+        }
+    }
+
+    // FormulaVirtualMachine::GetDependencies
+    DAVA_TEST (Dependencies)
+    {
+        FormulaCompilerTestData data;
+        FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+
+        const char* expressions[] = {
+            "sum(16, intVal * 2)",
+            "map.b + fl",
+            "b and (array[1] = 1)"
+        };
+
+        for (const char* str : expressions)
+        {
+            std::shared_ptr<FormulaExpression> exp = FormulaParser(str).ParseExpression();
+
+            FormulaExecutor executor(&context);
+            executor.Calculate(exp.get());
+
+            std::shared_ptr<FormulaProgram> program = FormulaCompiler().Compile(exp);
+            FormulaVirtualMachine vm(&context);
+            vm.Calculate(program.get());
+
+            TEST_VERIFY(!vm.GetDependencies().empty());
+            TEST_VERIFY(vm.GetDependencies() == executor.GetDependencies());
+        }
+    }
+
+    // FormulaVirtualMachine::Calculate
+    DAVA_TEST (SharedProgram)
+    {
+        std::shared_ptr<FormulaProgram> program = Compile("intVal * 2 + array[0]");
+
+        // cached fields have to be resolved for every object
+        for (int32 i = 0; i < 3; ++i)
+        {
+            FormulaCompilerTestData data;
+            data.intVal = i;
+            FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+            TEST_VERIFY(FormulaVirtualMachine(&context).Calculate(program.get()) == Any(i * 2 + 10));
+        }
+    }
+
+    // FormulaVirtualMachine::Calculate
+    DAVA_TEST (ResolvedData)
+    {
+        FormulaCompilerTestData data;
+        FormulaCompilerCountingContext context(Reflection::Create(&data));
+        std::shared_ptr<FormulaProgram> program = Compile("intVal + map.a + intVal");
+        FormulaResolvedData resolvedData;
+
+        // repeated name is resolved once
+        TEST_VERIFY(FormulaVirtualMachine(&context, &resolvedData).Calculate(program.get()) == Any(42 + 11 + 42));
+        TEST_VERIFY(context.lookupsCount == 2);
+
+        // data isn't looked up by name again, but its current values are used
+        data.intVal = 1;
+        data.map["a"] = 5;
+        TEST_VERIFY(FormulaVirtualMachine(&context, &resolvedData).Calculate(program.get()) == Any(1 + 5 + 1));
+        TEST_VERIFY(context.lookupsCount == 2);
+
+        // without resolved data every calculation looks data up
+        TEST_VERIFY(FormulaVirtualMachine(&context).Calculate(program.get()) == Any(1 + 5 + 1));
+        TEST_VERIFY(context.lookupsCount == 5);
+
+        // reset resolves data again
+        resolvedData.Reset();
+        TEST_VERIFY(FormulaVirtualMachine(&context, &resolvedData).Calculate(program.get()) == Any(1 + 5 + 1));
+        TEST_VERIFY(context.lookupsCount == 7);
+
+        // so does other context
+        FormulaCompilerTestData otherData;
+        FormulaCompilerCountingContext otherContext(Reflection::Create(&otherData));
+        TEST_VERIFY(FormulaVirtualMachine(&otherContext, &resolvedData).Calculate(program.get()) == Any(42 + 11 + 42));
+        TEST_VERIFY(otherContext.lookupsCount == 2);
+    }
+
+    // FormulaProgramCache::Get
+    DAVA_TEST (Cache)
+    {
+        FormulaProgramCache cache;
+        std::shared_ptr<FormulaProgram> p1 = cache.Get("intVal + 1");
+        std::shared_ptr<FormulaProgram> p2 = cache.Get("intVal + 1");
+        std::shared_ptr<FormulaProgram> p3 = cache.Get("intVal + 2");
+        TEST_VERIFY(p1 == p2);
+        TEST_VERIFY(p1 != p3);
+        TEST_VERIFY(cache.GetSize() == 2);
+
+        try
+        {
+            cache.Get("5 +");
+            TEST_VERIFY(false);
+        }
+        catch (const FormulaException&)
+        {
+            TEST_VERIFY(cache.GetSize() == 2);
+        }
+    }
+
+    std::shared_ptr<FormulaProgram> Compile(const String& str)
+    {
+        FormulaParser parser(str);
+        return FormulaCompiler().Compile(parser.ParseExpression());
+    }
+
+    Any Execute(const String& str)
+    {
+        FormulaCompilerTestData data;
+        FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+        std::shared_ptr<FormulaProgram> program = Compile(str);
+        return FormulaVirtualMachine(&context).Calculate(program.get());
+    }
+};
@@ -0,0 +1,75 @@
+#include "DAVAEngine.h"
+
+#include "UI/UIControlPackageContext.h"
+#include "UI/UIControlSystem.h"
+#include "UI/Styles/UIStyleSheetSystem.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIStyleSheetSystemTest)
+{
+    // UIStyleSheetSystem::DebugControl
+    DAVA_TEST (MatchIndexedStyleSheets)
+    {
+        const char* selectors[] = {
+            ".b", // matches by class
+            "#child", // matches by name
+            ".a .b", // matches by parent
+            ".x .b", // matches by parent only with global class x
+            "UIControl", // matches by control class name
+            ".c", // doesn't match
+            "#root ? .b" // doesn't match, root is a parent, not a grandparent
+        };
+
+        RefPtr<UIControlPackageContext> packageContext(new UIControlPackageContext());
+        Vector<UIStyleSheet*> styleSheets;
+        for (const char* selector : selectors)
+        {
+            RefPtr<UIStyleSheet> styleSheet(new UIStyleSheet());
+            styleSheet->SetSelectorChain(UIStyleSheetSelectorChain(selector));
+            styleSheet->SetPropertyTable(RefPtr<UIStyleSheetPropertyTable>(new UIStyleSheetPropertyTable()).Get());
+            packageContext->AddStyleSheet(UIPriorityStyleSheet(styleSheet.Get(), static_cast<int32>(styleSheets.size())));
+            styleSheets.push_back(styleSheet.Get());
+        }
+
+        RefPtr<UIControl> root(new UIControl());
+        root->SetName("root");
+        root->AddClass(FastName("a"));
+        root->SetPackageContext(packageContext.Get());
+
+        RefPtr<UIControl> child(new UIControl());
+        child->SetName("child");
+        child->AddClass(FastName("b"));
+        root->AddControl(child.Get());
+
+        UIStyleSheetSystem* system = GetEngineContext()->uiControlSystem->GetStyleSheetSystem();
+
+        // twice to check cached results
+        for (int32 i = 0; i < 2; ++i)
+        {
+            TEST_VERIFY(GetMatched(system, child.Get()) == Set<UIStyleSheet*>({ styleSheets[0], styleSheets[1], styleSheets[2], styleSheets[4] }));
+        }
+
+        system->AddGlobalClass(FastName("x"));
+        TEST_VERIFY(GetMatched(system, child.Get()) == Set<UIStyleSheet*>({ styleSheets[0], styleSheets[1], styleSheets[2], styleSheets[3], styleSheets[4] }));
+        system->RemoveGlobalClass(FastName("x"));
+        TEST_VERIFY(GetMatched(system, child.Get()) == Set<UIStyleSheet*>({ styleSheets[0], styleSheets[1], styleSheets[2], styleSheets[4] }));
+
+        child->RemoveClass(FastName("b"));
+        TEST_VERIFY(GetMatched(system, child.Get()) == Set<UIStyleSheet*>({ styleSheets[1], styleSheets[4] }));
+    }
+
+    Set<UIStyleSheet*> GetMatched(UIStyleSheetSystem * system, UIControl * control)
+    {
+        UIStyleSheetProcessDebugData debugData;
+        system->DebugControl(control, &debugData);
+
+        Set<UIStyleSheet*> result;
+        for (const UIPriorityStyleSheet& styleSheet : debugData.styleSheets)
+        {
+            result.insert(styleSheet.GetStyleSheet());
+        }
+        return result;
+    }
+};
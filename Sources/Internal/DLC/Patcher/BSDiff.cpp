@@ -1,11 +1,103 @@
 #include "BSDiff.h"
 #include "ZLibStream.h"
+#include "Base/ScopedPtr.h"
+#include "Concurrency/Semaphore.h"
+#include "Engine/Engine.h"
 #include "FileSystem/File.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "Job/JobManager.h"
+
+#include <lz4/lz4.h>
+#include <lz4/lz4hc.h>
 
 namespace DAVA
 {
+namespace BSDiffDetails
+{
+struct DiffBlock
+{
+    uint32 origOffset = 0;
+    uint32 origLength = 0;
+    uint32 newOffset = 0;
+    uint32 newLength = 0;
+    uint32 diffSize = 0; // size of uncompressed bsdiff stream
+    Vector<uint8> data; // LZ4 compressed bsdiff stream, or uncompressed one if it has size diffSize
+    bool succeeded = false;
+};
+
+// select window of original data around the same relative position as new block has
+void SelectOrigWindow(uint32 origSize, uint32 newSize, DiffBlock& block)
+{
+    const uint32 halfBlockSize = BSDiff::DIFF_BLOCK_SIZE / 2;
+    const uint32 windowSize = std::min(origSize, BSDiff::DIFF_BLOCK_SIZE * 2);
+
+    uint64 center = static_cast<uint64>(block.newOffset) * origSize / newSize;
+    uint64 start = (center > halfBlockSize) ? center - halfBlockSize : 0;
+
+    block.origOffset = static_cast<uint32>(std::min(start, static_cast<uint64>(origSize - windowSize)));
+    block.origLength = windowSize;
+}
+
+void MakeBlockDiff(const char8* origData, const char8* newData, bsdiff_stream diffStream, DiffBlock& block)
+{
+    ScopedPtr<DynamicMemoryFile> diffFile(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    diffStream.type = BS_PLAIN;
+    diffStream.opaque = diffFile.get();
+
+    const uint8_t* origBlock = reinterpret_cast<const uint8_t*>(origData) + block.origOffset;
+    const uint8_t* newBlock = reinterpret_cast<const uint8_t*>(newData) + block.newOffset;
+    if (0 != bsdiff(origBlock, block.origLength, newBlock, block.newLength, &diffStream))
+    {
+        return;
+    }
+
+    const Vector<uint8>& diff = diffFile->GetDataVector();
+    if (diff.size() > LZ4_MAX_INPUT_SIZE)
+    {
+        return;
+    }
+
+    block.diffSize = static_cast<uint32>(diff.size());
+    block.data.resize(static_cast<size_t>(LZ4_compressBound(block.diffSize)));
+
+    int32 compressedSize = LZ4_compressHC(reinterpret_cast<const char*>(diff.data()), reinterpret_cast<char*>(block.data.data()), block.diffSize);
+    if (compressedSize > 0 && static_cast<uint32>(compressedSize) < block.diffSize)
+    {
+        block.data.resize(static_cast<size_t>(compressedSize));
+    }
+    else
+    {
+        block.data = diff;
+    }
+
+    block.succeeded = true;
+}
+
+bool WriteBlock(File* patchFile, const DiffBlock& block)
+{
+    uint32 header[] = { block.origOffset, block.origLength, block.newLength, block.diffSize, static_cast<uint32>(block.data.size()) };
+    if (sizeof(header) != patchFile->Write(header, sizeof(header)))
+    {
+        return false;
+    }
+
+    return block.data.size() == patchFile->Write(block.data.data(), static_cast<uint32>(block.data.size()));
+}
+} // namespace BSDiffDetails
+
 bool BSDiff::Diff(char8* origData, uint32 origSize, char8* newData, uint32 newSize, File* patchFile, BSType type)
 {
+    if (BS_LZ4_BLOCKS == type)
+    {
+        // block patch has its own compression, so zlib stream isn't created
+        uint32 typeToWrite = type;
+        if (NULL == patchFile || sizeof(typeToWrite) != patchFile->Write(&typeToWrite))
+        {
+            return false;
+        }
+        return DiffBlocks(origData, origSize, newData, newSize, patchFile);
+    }
+
     bool ret = false;
     ZLibOStream outStream(patchFile);
 
@@ -87,6 +179,202 @@ bool BSDiff::Patch(char8* origData, uint32 origSize, char8* newData, uint32 newS
     return ret;
 }
 
+BSDiff::PatchResult BSDiff::Patch(char8* origData, uint32 origSize, uint32 newSize, File* patchFile, File* newFile)
+{
+    uint64 patchPos = patchFile->GetPos();
+
+    uint32 typeToRead = -1;
+    if (sizeof(typeToRead) != patchFile->Read(&typeToRead))
+    {
+        return PATCH_CORRUPTED;
+    }
+
+    if (BS_LZ4_BLOCKS == typeToRead)
+    {
+        return PatchBlocks(origData, origSize, newSize, patchFile, newFile);
+    }
+
+    // whole new data is needed for other patch types
+    patchFile->Seek(patchPos, File::SEEK_FROM_START);
+
+    char8* newData = new (std::nothrow) char8[newSize];
+    if (nullptr == newData)
+    {
+        return PATCH_NO_MEMORY;
+    }
+
+    PatchResult result = PATCH_OK;
+    if (!Patch(origData, origSize, newData, newSize, patchFile))
+    {
+        result = PATCH_CORRUPTED;
+    }
+    else if (newSize != newFile->Write(newData, newSize))
+    {
+        result = PATCH_WRITE_ERROR;
+    }
+
+    SafeDeleteArray(newData);
+    return result;
+}
+
+bool BSDiff::DiffBlocks(char8* origData, uint32 origSize, char8* newData, uint32 newSize, File* patchFile)
+{
+    using namespace BSDiffDetails;
+
+    const uint32 blocksCount = (newSize + DIFF_BLOCK_SIZE - 1) / DIFF_BLOCK_SIZE;
+
+    uint32 blocksHeader[] = { DIFF_BLOCK_SIZE, blocksCount };
+    if (sizeof(blocksHeader) != patchFile->Write(blocksHeader, sizeof(blocksHeader)))
+    {
+        return false;
+    }
+
+    bsdiff_stream diffStream;
+    diffStream.free = &BSDiff::BSFree;
+    diffStream.malloc = &BSDiff::BSMalloc;
+    diffStream.write = &BSDiff::BSWrite;
+
+    // blocks are diffed in batches of workers count, so only a few blocks are kept in memory
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 batchSize = (nullptr != jobManager) ? std::max(jobManager->GetWorkersCount(), 1u) : 1;
+
+    Vector<DiffBlock> blocks;
+    for (uint32 firstBlock = 0; firstBlock < blocksCount; firstBlock += batchSize)
+    {
+        blocks.clear();
+        blocks.resize(std::min(batchSize, blocksCount - firstBlock));
+
+        for (uint32 i = 0; i < blocks.size(); ++i)
+        {
+            DiffBlock& block = blocks[i];
+            block.newOffset = (firstBlock + i) * DIFF_BLOCK_SIZE;
+            block.newLength = std::min(DIFF_BLOCK_SIZE, newSize - block.newOffset);
+            SelectOrigWindow(origSize, newSize, block);
+        }
+
+        if (blocks.size() > 1)
+        {
+            // wait for own jobs only, so that unrelated worker jobs don't stall diffing
+            Semaphore diffed;
+            for (DiffBlock& block : blocks)
+            {
+                jobManager->CreateWorkerJob([origData, newData, diffStream, &block, &diffed]() {
+                    MakeBlockDiff(origData, newData, diffStream, block);
+                    diffed.Post();
+                });
+            }
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                diffed.Wait();
+            }
+        }
+        else
+        {
+            MakeBlockDiff(origData, newData, diffStream, blocks[0]);
+        }
+
+        for (const DiffBlock& block : blocks)
+        {
+            if (!block.succeeded || !WriteBlock(patchFile, block))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// This function should be as safe as possible.
+// So we should continue to work event after DVASSERT
+BSDiff::PatchResult BSDiff::PatchBlocks(char8* origData, uint32 origSize, uint32 newSize, File* patchFile, File* newFile)
+{
+    uint32 blocksHeader[2] = {};
+    if (sizeof(blocksHeader) != patchFile->Read(blocksHeader, sizeof(blocksHeader)))
+    {
+        return PATCH_CORRUPTED;
+    }
+
+    const uint32 blockSize = blocksHeader[0];
+    const uint32 blocksCount = blocksHeader[1];
+    if (0 == blockSize || blockSize > LZ4_MAX_INPUT_SIZE || blocksCount != (static_cast<uint64>(newSize) + blockSize - 1) / blockSize)
+    {
+        return PATCH_CORRUPTED;
+    }
+
+    bspatch_stream patchStream;
+    patchStream.read = &BSDiff::BSRead;
+    patchStream.type = BS_PLAIN;
+
+    Vector<uint8> blockData;
+    Vector<uint8> diff;
+    Vector<uint8> newBlock;
+
+    uint32 written = 0;
+    for (uint32 i = 0; i < blocksCount; ++i)
+    {
+        // origOffset, origLength, newLength, diffSize, dataSize
+        uint32 header[5] = {};
+        if (sizeof(header) != patchFile->Read(header, sizeof(header)))
+        {
+            return PATCH_CORRUPTED;
+        }
+
+        const uint32 origOffset = header[0];
+        const uint32 origLength = header[1];
+        const uint32 newLength = header[2];
+        const uint32 diffSize = header[3];
+        const uint32 dataSize = header[4];
+
+        if (static_cast<uint64>(origOffset) + origLength > origSize
+            || newLength > blockSize || newLength > newSize - written
+            || diffSize > LZ4_MAX_INPUT_SIZE || dataSize > diffSize)
+        {
+            return PATCH_CORRUPTED;
+        }
+
+        blockData.resize(dataSize);
+        if (dataSize != patchFile->Read(blockData.data(), dataSize))
+        {
+            return PATCH_CORRUPTED;
+        }
+
+        if (dataSize == diffSize)
+        {
+            diff.swap(blockData);
+        }
+        else
+        {
+            diff.resize(diffSize);
+            int32 decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(blockData.data()), reinterpret_cast<char*>(diff.data()), static_cast<int32>(dataSize), static_cast<int32>(diffSize));
+            if (decompressedSize != static_cast<int32>(diffSize))
+            {
+                return PATCH_CORRUPTED;
+            }
+        }
+
+        newBlock.resize(newLength);
+
+        ScopedPtr<DynamicMemoryFile> diffFile(DynamicMemoryFile::Create(diff.data(), static_cast<int32>(diff.size()), File::OPEN | File::READ));
+        patchStream.opaque = static_cast<File*>(diffFile.get());
+
+        const uint8_t* origBlock = reinterpret_cast<const uint8_t*>(origData) + origOffset;
+        if (0 != bspatch(origBlock, origLength, newBlock.data(), newLength, &patchStream))
+        {
+            return PATCH_CORRUPTED;
+        }
+
+        if (newLength != newFile->Write(newBlock.data(), newLength))
+        {
+            return PATCH_WRITE_ERROR;
+        }
+
+        written += newLength;
+    }
+
+    return (written == newSize) ? PATCH_OK : PATCH_CORRUPTED;
+}
+
 void* BSDiff::BSMalloc(int64_t size)
 {
     return new uint8_t[static_cast<size_t>(size)];
@@ -8,13 +8,33 @@ namespace DAVA
 {
 class File;
 
+// BS_LZ4_BLOCKS splits new data into blocks of DIFF_BLOCK_SIZE bytes and diffs every block
+// against window of original data around the same relative position. Blocks are diffed
+// in parallel on worker jobs, compressed with LZ4 and can be applied one by one, so memory
+// used for generation and applying doesn't depend on file size. Data moved further than
+// window size isn't matched, so such patch can be larger than BS_ZLIB one.
 class BSDiff
 {
 public:
+    enum PatchResult
+    {
+        PATCH_OK = 0,
+        PATCH_CORRUPTED, // patch data can't be read or applied
+        PATCH_NO_MEMORY, // can't allocate memory for new data
+        PATCH_WRITE_ERROR // new data can't be written
+    };
+
+    static const uint32 DIFF_BLOCK_SIZE = 2 * 1024 * 1024;
+
     static bool Diff(char8* origData, uint32 origSize, char8* newData, uint32 newSize, File* patchFile, BSType type);
     static bool Patch(char8* origData, uint32 origSize, char8* newData, uint32 newSize, File* patchFile);
+    // apply patch and write new data into newFile, BS_LZ4_BLOCKS patches are applied block by block
+    static PatchResult Patch(char8* origData, uint32 origSize, uint32 newSize, File* patchFile, File* newFile);
 
 protected:
+    static bool DiffBlocks(char8* origData, uint32 origSize, char8* newData, uint32 newSize, File* patchFile);
+    static PatchResult PatchBlocks(char8* origData, uint32 origSize, uint32 newSize, File* patchFile, File* newFile);
+
     static void* BSMalloc(int64_t size);
     static void BSFree(void* ptr);
     static int BSWrite(struct bsdiff_stream* stream, const void* buffer, int64_t size);
@@ -5,6 +5,7 @@
 #include "Utils/CRC32.h"
 #include "Logger/Logger.h"
 #include "Concurrency/Thread.h"
+#include "Time/SystemTimer.h"
 
 namespace DAVA
 {
@@ -333,6 +334,8 @@ bool PatchFileWriter::SingleWrite(const FilePath& origBase, const FilePath& orig
                 // write patch info
                 ret = patchInfo.Write(patchFile);
 
+                int64 diffTime = SystemTimer::GetMs();
+
                 // write diff, if needed
                 if (ret && needWriteDiff)
                 {
@@ -360,7 +363,8 @@ bool PatchFileWriter::SingleWrite(const FilePath& origBase, const FilePath& orig
 
                 if (ret && verbose)
                 {
-                    printf("\tDone, size: %u bytes\n", patchSize);
+                    diffTime = SystemTimer::GetMs() - diffTime;
+                    printf("\tDone, size: %u bytes, time: %lld ms\n", patchSize, static_cast<long long>(diffTime));
                 }
             }
 
@@ -696,7 +700,6 @@ bool PatchFileReader::Apply(const FilePath& _origBase, const FilePath& _origPath
     else
     {
         char8* origData = nullptr;
-        char8* newData = nullptr;
 
         // if new file should exist after patching
         if (!curInfo.newPath.empty())
@@ -820,50 +823,44 @@ bool PatchFileReader::Apply(const FilePath& _origBase, const FilePath& _origPath
                     {
                         if (curInfo.newSize > 0)
                         {
-                            newData = new (std::nothrow) char8[curInfo.newSize];
-
-                            if (nullptr != newData)
+                            // new data is written into temp file while patch is being applied
+                            BSDiff::PatchResult patchResult = BSDiff::Patch(origData, curInfo.origSize, curInfo.newSize, patchFile, newFile);
+                            if (BSDiff::PATCH_OK == patchResult)
                             {
-                                if (BSDiff::Patch(origData, curInfo.origSize, newData, curInfo.newSize, patchFile))
-                                {
-                                    if (curInfo.newSize != newFile->Write(newData, curInfo.newSize))
-                                    {
-                                        ret = false;
-                                        Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] Can't write data to file %s", newFile->GetFilename().GetAbsolutePathname().c_str());
-                                    }
-                                    else
-                                    {
-                                        if (!newFile->Flush())
-                                        {
-                                            ret = false;
-                                            Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] can't flush newFile. %s", tmpNewPath.GetAbsolutePathname().c_str());
-                                        }
-                                    }
-
-                                    if (!ret)
-                                    {
-                                        lastFileErrno = errno;
-                                        lastErrorDetails.expected.path = tmpNewPath;
-                                        lastErrorDetails.expected.size = curInfo.newSize;
-                                        lastErrorDetails.actual.path = "";
-                                        lastErrorDetails.actual.size = static_cast<uint32>(newFile->GetSize());
-                                        lastError = ERROR_NEW_WRITE;
-                                    }
-                                }
-                                else
+                                if (!newFile->Flush())
                                 {
-                                    lastError = ERROR_CORRUPTED;
                                     ret = false;
-                                    Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] Can't patch %s", origPath.GetAbsolutePathname().c_str());
+                                    Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] can't flush newFile. %s", tmpNewPath.GetAbsolutePathname().c_str());
                                 }
                             }
-                            else
+                            else if (BSDiff::PATCH_WRITE_ERROR == patchResult)
+                            {
+                                ret = false;
+                                Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] Can't write data to file %s", newFile->GetFilename().GetAbsolutePathname().c_str());
+                            }
+                            else if (BSDiff::PATCH_NO_MEMORY == patchResult)
                             {
                                 // can't allocate memory
                                 lastError = ERROR_MEMORY;
                                 ret = false;
                                 Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] Can't allocate %d bytes for new data", curInfo.newSize);
                             }
+                            else
+                            {
+                                lastError = ERROR_CORRUPTED;
+                                ret = false;
+                                Logger::ErrorToFile(logFilePath, "[PatchFileReader::Apply] Can't patch %s", origPath.GetAbsolutePathname().c_str());
+                            }
+
+                            if (!ret && (BSDiff::PATCH_OK == patchResult || BSDiff::PATCH_WRITE_ERROR == patchResult))
+                            {
+                                lastFileErrno = errno;
+                                lastErrorDetails.expected.path = tmpNewPath;
+                                lastErrorDetails.expected.size = curInfo.newSize;
+                                lastErrorDetails.actual.path = "";
+                                lastErrorDetails.actual.size = static_cast<uint32>(newFile->GetSize());
+                                lastError = ERROR_NEW_WRITE;
+                            }
                         }
 
                         newFile->Release();
@@ -971,7 +968,6 @@ bool PatchFileReader::Apply(const FilePath& _origBase, const FilePath& _origPath
             }
 
             SafeDeleteArray(origData);
-            SafeDeleteArray(newData);
         }
         // there should be no new file after patching
         else
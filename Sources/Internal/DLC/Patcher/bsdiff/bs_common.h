@@ -12,7 +12,8 @@ extern "C" { // only need to export C interface if
 typedef enum
 {
     BS_PLAIN,
-    BS_ZLIB
+    BS_ZLIB,
+    BS_LZ4_BLOCKS
 }
 BSType;
 
@@ -952,6 +952,16 @@ void DLCManagerImpl::GetFooter()
                 return;
             }
 
+            // files of solid blocks share compressed data, so they can't be downloaded one by one
+            if (initFooterOnServer.solidBlocksSize != 0)
+            {
+                initErrorMsg = "error: on server bad superpack!!! Superpack with solid blocks can't be used for downloading\n";
+                log << initErrorMsg;
+                Logger::Error("%s", initErrorMsg.c_str());
+                TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
+                return;
+            }
+
             if (!SaveServerFooter())
             {
                 TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
@@ -53,6 +53,12 @@ void DebugOverlayItemRenderStats::Draw()
             AddUIntStat("Packets", stats.packets2d);
         }
 
+        if (ImGui::CollapsingHeader("Auto Instancing"))
+        {
+            AddUIntStat("Batches", stats.instancedBatches);
+            AddUIntStat("Packets", stats.instancedPackets);
+        }
+
         if (ImGui::CollapsingHeader("Fragments Info"))
         {
             for (uint32 i = 0; i < uint32(VisibilityQueryResults::QUERY_INDEX_COUNT); ++i)
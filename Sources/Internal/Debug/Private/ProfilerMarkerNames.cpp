@@ -56,6 +56,7 @@ const char* SCENE_GEODECAL_SYSTEM = "GeoDecalSystem";
 const char* RENDER_PASS_PREPARE_ARRAYS = "RenderPass::PrepareArrays";
 const char* RENDER_PASS_DRAW_LAYERS = "RenderPass::DrawLayers";
 const char* RENDER_PREPARE_LANDSCAPE = "Landscape::Prepare";
+const char* RENDER_GEODECAL_MANAGER_UPDATE = "GeoDecalManager::Update";
 
 //RHI
 const char* RHI_RENDER_LOOP = "rhi::RenderLoop";
@@ -56,6 +56,7 @@ extern const char* SCENE_GEODECAL_SYSTEM;
 extern const char* RENDER_PASS_PREPARE_ARRAYS;
 extern const char* RENDER_PASS_DRAW_LAYERS;
 extern const char* RENDER_PREPARE_LANDSCAPE;
+extern const char* RENDER_GEODECAL_MANAGER_UPDATE;
 
 //RHI
 extern const char* RHI_RENDER_LOOP;
@@ -223,6 +223,15 @@ public:
         | shader_const_buffer_size        |                            | 0              |
 
         For more info on render options ask RHI guys.
+
+        | **Console options**             | Description                                               | Default        |
+        | ------------------------------- | --------------------------------------------------------- | -------------- |
+        | server_tick_rate                | Ticks per second of fixed-tick loop, 0 for free-running   | 0              |
+        | server_max_catchup_ticks        | Ticks the loop may fall behind before they are dropped    | 5              |
+
+        With nonzero `server_tick_rate` console mode runs game loop for dedicated servers: `update` signal is emitted
+        with constant frame delta, loop sleeps until next tick deadline and runs overdue ticks back-to-back under overload.
+        Use `GetFixedTickStatistics` to monitor tick durations.
     
         Other options can be found in description for corresponding module.
     */
@@ -288,6 +297,12 @@ public:
     */
     uint32 GetGlobalFrameIndex() const;
 
+    /**
+        Get statistics of fixed-tick game loop, it's empty unless engine runs in console mode with `server_tick_rate` option.
+    */
+    const FixedTickStatistics& GetFixedTickStatistics() const;
+    void ResetFixedTickStatistics();
+
     /**
         Get parsed command line args, now it is the same as command line passed to DAVAMain function.
         First command line argument is always application name (on android it is app_process).
@@ -138,6 +138,24 @@ enum class eGamepadProfiles : uint32
     EXTENDED, //!< Two shoulder buttons, two triggers, two thumbsticks, directional pad
 };
 
+/**
+    \ingroup engine
+    Statistics of fixed-tick game loop, which is run in console mode if `server_tick_rate` option is set (see `Engine::Init`).
+
+    Tick durations are accumulated into histogram with power of two buckets: bucket `i` counts ticks which took
+    [2^i, 2^(i+1)) microseconds, the last bucket counts all longer ticks too.
+*/
+struct FixedTickStatistics
+{
+    static const uint32 HISTOGRAM_BUCKET_COUNT = 24;
+
+    uint64 tickCount = 0; //!< Number of processed ticks
+    uint64 overrunTickCount = 0; //!< Number of ticks which took longer than tick duration
+    uint64 droppedTickCount = 0; //!< Number of ticks skipped as loop has fallen behind more than it is allowed to catch up
+    int64 maxTickDurationUs = 0; //!< Longest tick duration
+    Array<uint64, HISTOGRAM_BUCKET_COUNT> durationHistogram = {}; //!< Histogram of tick durations
+};
+
 /** Cursor capture modes */
 enum class eCursorCapture : int32
 {
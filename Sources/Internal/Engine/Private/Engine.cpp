@@ -98,6 +98,16 @@ uint32 Engine::GetGlobalFrameIndex() const
     return engineBackend->GetGlobalFrameIndex();
 }
 
+const FixedTickStatistics& Engine::GetFixedTickStatistics() const
+{
+    return engineBackend->GetFixedTickStatistics();
+}
+
+void Engine::ResetFixedTickStatistics()
+{
+    engineBackend->ResetFixedTickStatistics();
+}
+
 const Vector<String>& Engine::GetCommandLine() const
 {
     return engineBackend->GetCommandLine();
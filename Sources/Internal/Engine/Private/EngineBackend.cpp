@@ -6,6 +6,7 @@
 #include "Engine/Private/WindowImpl.h"
 #include "Engine/Private/PlatformCore.h"
 #include "Engine/Private/Dispatcher/MainDispatcher.h"
+#include "Engine/Private/FixedTickLoop.h"
 
 // Please place headers in alphabetic ascending order
 #include "DAVAClassRegistrator.h"
@@ -16,6 +17,7 @@
 #include "Autotesting/AutotestingSystem.h"
 #include "Base/AllocatorFactory.h"
 #include "Base/ObjectFactory.h"
+#include "Concurrency/Thread.h"
 #include "Core/PerformanceSettings.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/DVAssert.h"
@@ -72,6 +74,7 @@
 #endif
 
 #include <cstdlib>
+#include <thread>
 
 namespace DAVA
 {
@@ -88,6 +91,24 @@ void SetEngineContext(EngineContext* context)
     EngineContext** contextPtr = GetEngineContextPtr();
     *contextPtr = context;
 }
+
+namespace EngineBackendDetail
+{
+void SleepUntil(int64 deadlineUs)
+{
+    // Sleep in microseconds and recheck clock as sleep may overshoot or wake early,
+    // only the last short interval, which is below typical sleep accuracy, is yielded
+    const int64 yieldUs = 200;
+    for (int64 remainingUs = deadlineUs - SystemTimer::GetUs(); remainingUs > yieldUs; remainingUs = deadlineUs - SystemTimer::GetUs())
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(remainingUs - yieldUs));
+    }
+    while (SystemTimer::GetUs() < deadlineUs)
+    {
+        Thread::Yield();
+    }
+}
+}
 }
 
 const EngineContext* GetEngineContext()
@@ -324,14 +345,37 @@ void EngineBackend::RunConsole()
         }
     }
 
-    while (!quitConsole)
+    float32 tickRate = options->GetFloat("server_tick_rate", 0.f);
+    if (tickRate > 0.f)
+    {
+        RunConsoleFixedTick(tickRate);
+    }
+    else
     {
-        OnFrameConsole();
+        while (!quitConsole)
+        {
+            OnFrameConsole();
+        }
     }
     OnGameLoopStopped();
     OnEngineCleanup();
 }
 
+void EngineBackend::RunConsoleFixedTick(float32 tickRate)
+{
+    const int64 tickBudgetUs = std::max(static_cast<int64>(1000000.0 / tickRate), int64(1));
+    const float32 tickDelta = static_cast<float32>(tickBudgetUs / 1000000.0);
+
+    Logger::Info("EngineBackend::RunConsoleFixedTick: %.2f ticks per second", tickRate);
+
+    FixedTickLoop loop(tickBudgetUs, options->GetInt32("server_max_catchup_ticks", 5), fixedTickStatistics, &SystemTimer::GetUs);
+    while (!quitConsole)
+    {
+        int64 deadline = loop.RunTick([this, tickDelta]() { OnFrameConsole(tickDelta); });
+        EngineBackendDetail::SleepUntil(deadline);
+    }
+}
+
 void EngineBackend::OnGameLoopStarted()
 {
     Logger::Info("EngineBackend::OnGameLoopStarted: enter");
@@ -394,10 +438,10 @@ void EngineBackend::DoEvents()
     }
 }
 
-void EngineBackend::OnFrameConsole()
+void EngineBackend::OnFrameConsole(float32 fixedFrameDelta)
 {
     SystemTimer::StartFrame();
-    float32 frameDelta = SystemTimer::GetFrameDelta();
+    float32 frameDelta = fixedFrameDelta > 0.f ? fixedFrameDelta : SystemTimer::GetFrameDelta();
     SystemTimer::ComputeRealFrameDelta();
     // TODO: UpdateGlobalTime is deprecated, remove later
     SystemTimer::UpdateGlobalTime(frameDelta);
@@ -42,6 +42,8 @@ public:
     Window* GetPrimaryWindow() const;
     const Vector<Window*>& GetWindows() const;
     uint32 GetGlobalFrameIndex() const;
+    const FixedTickStatistics& GetFixedTickStatistics() const;
+    void ResetFixedTickStatistics();
     int32 GetExitCode() const;
     const Vector<String>& GetCommandLine() const;
     Vector<char*> GetCommandLineAsArgv();
@@ -100,10 +102,11 @@ public:
 
 private:
     void RunConsole();
+    void RunConsoleFixedTick(float32 tickRate);
 
     void DoEvents();
 
-    void OnFrameConsole();
+    void OnFrameConsole(float32 fixedFrameDelta = 0.f);
 
     void BeginFrame();
     void Update(float32 frameDelta);
@@ -159,6 +162,7 @@ private:
 
     RefPtr<KeyedArchive> options;
     uint32 globalFrameIndex = 1;
+    FixedTickStatistics fixedTickStatistics;
 
     bool isRunning = false;
 
@@ -210,6 +214,16 @@ inline uint32 EngineBackend::GetGlobalFrameIndex() const
     return globalFrameIndex;
 }
 
+inline const FixedTickStatistics& EngineBackend::GetFixedTickStatistics() const
+{
+    return fixedTickStatistics;
+}
+
+inline void EngineBackend::ResetFixedTickStatistics()
+{
+    fixedTickStatistics = FixedTickStatistics();
+}
+
 inline int32 EngineBackend::GetExitCode() const
 {
     return exitCode;
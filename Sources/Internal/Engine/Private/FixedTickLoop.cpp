@@ -0,0 +1,53 @@
+#include "Engine/Private/FixedTickLoop.h"
+
+namespace DAVA
+{
+namespace Private
+{
+FixedTickLoop::FixedTickLoop(int64 tickBudgetUs_, int32 maxCatchupTicks, FixedTickStatistics& statistics_, const Function<int64()>& clock_)
+    : clock(clock_)
+    , statistics(statistics_)
+    , tickBudgetUs(std::max(tickBudgetUs_, int64(1)))
+{
+    maxLagUs = tickBudgetUs * std::max(maxCatchupTicks, 0);
+    deadline = clock();
+}
+
+int64 FixedTickLoop::RunTick(const Function<void()>& tick)
+{
+    int64 tickStart = clock();
+    tick();
+    int64 tickEnd = clock();
+    UpdateStatistics(tickEnd - tickStart);
+
+    deadline += tickBudgetUs;
+    int64 lagUs = tickEnd - deadline;
+    if (lagUs > maxLagUs)
+    {
+        // drop only ticks above catch-up limit, the rest are run back-to-back
+        int64 droppedTicks = (lagUs - maxLagUs) / tickBudgetUs;
+        deadline += droppedTicks * tickBudgetUs;
+        statistics.droppedTickCount += droppedTicks;
+    }
+    return deadline;
+}
+
+void FixedTickLoop::UpdateStatistics(int64 tickDurationUs)
+{
+    statistics.tickCount += 1;
+    if (tickDurationUs > tickBudgetUs)
+    {
+        statistics.overrunTickCount += 1;
+    }
+    statistics.maxTickDurationUs = std::max(statistics.maxTickDurationUs, tickDurationUs);
+
+    uint32 bucket = 0;
+    for (int64 d = tickDurationUs >> 1; d > 0 && bucket + 1 < FixedTickStatistics::HISTOGRAM_BUCKET_COUNT; d >>= 1)
+    {
+        bucket += 1;
+    }
+    statistics.durationHistogram[bucket] += 1;
+}
+
+} // namespace Private
+} // namespace DAVA
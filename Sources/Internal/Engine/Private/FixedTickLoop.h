@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Engine/EngineTypes.h"
+#include "Functional/Function.h"
+
+namespace DAVA
+{
+namespace Private
+{
+/**
+    Schedule of fixed-tick console game loop (see `server_tick_rate` option).
+
+    Deadlines follow fixed schedule, so overdue ticks are run back-to-back to catch up, but if loop has fallen
+    behind by more than `maxCatchupTicks` ticks, ticks above that limit are dropped. Tick durations are accumulated
+    into `FixedTickStatistics`. Time is taken from `clock` function, so schedule can be driven by fake clock.
+*/
+class FixedTickLoop final
+{
+public:
+    FixedTickLoop(int64 tickBudgetUs, int32 maxCatchupTicks, FixedTickStatistics& statistics, const Function<int64()>& clock);
+
+    /** Run `tick` and return clock value in microseconds when next tick should start. */
+    int64 RunTick(const Function<void()>& tick);
+
+private:
+    void UpdateStatistics(int64 tickDurationUs);
+
+    Function<int64()> clock;
+    FixedTickStatistics& statistics;
+    int64 tickBudgetUs = 0;
+    int64 maxLagUs = 0;
+    int64 deadline = 0;
+};
+
+} // namespace Private
+} // namespace DAVA
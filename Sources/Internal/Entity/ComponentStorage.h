@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+class Component;
+class Entity;
+class EntityFamily;
+
+/**
+    Archetype-style index of components of scene entities.
+
+    Entities of one EntityFamily form an archetype. For every component type of the family an archetype keeps
+    a dense column of components of its entities, so that systems can walk components of many entities without
+    looking them up entity by entity (see `Query`). Components themselves are still owned by entities, columns
+    hold pointers to the first component of every type. Each scene has its own storage, which is updated
+    when entities are registered in scene and when their components are added or removed.
+
+    Storage must not be modified while it is iterated.
+*/
+class ComponentStorage
+{
+public:
+    static const uint32 INVALID_INDEX = static_cast<uint32>(-1);
+
+    class Archetype
+    {
+    public:
+        EntityFamily* GetFamily() const;
+        const ComponentMask& GetComponentsMask() const;
+
+        uint32 GetEntitiesCount() const;
+        Entity* const* GetEntities() const;
+
+        /** Return dense column of components with `runtimeId`, or nullptr if the archetype has no such components. */
+        Component* const* GetComponents(uint32 runtimeId) const;
+
+    private:
+        friend class ComponentStorage;
+
+        EntityFamily* family = nullptr;
+        ComponentMask mask;
+        Vector<Entity*> entities;
+        Vector<Vector<Component*>> columns;
+        Vector<uint32> componentIndexByColumn;
+        Array<uint8, ComponentMask().size()> columnByRuntimeId;
+    };
+
+    ComponentStorage() = default;
+    ~ComponentStorage();
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    void AddEntity(Entity* entity);
+    void RemoveEntity(Entity* entity);
+
+    /** Move entity to archetype of its current family and refresh its components. Not added entities are ignored. */
+    void UpdateEntity(Entity* entity);
+
+    uint32 GetArchetypesCount() const;
+    const Archetype& GetArchetype(uint32 index) const;
+
+    /** Return index of archetype of `entity`, or INVALID_INDEX if entity isn't added to any storage. */
+    static uint32 GetArchetypeIndex(const Entity* entity);
+
+    /** Return index of `entity` in columns of its archetype. */
+    static uint32 GetArchetypeRow(const Entity* entity);
+
+private:
+    uint32 GetOrCreateArchetype(Entity* entity);
+    void FillRow(Archetype& archetype, uint32 row, Entity* entity);
+
+    Vector<std::unique_ptr<Archetype>> archetypes;
+    UnorderedMap<EntityFamily*, uint32> archetypeByFamily;
+};
+
+inline EntityFamily* ComponentStorage::Archetype::GetFamily() const
+{
+    return family;
+}
+
+inline const ComponentMask& ComponentStorage::Archetype::GetComponentsMask() const
+{
+    return mask;
+}
+
+inline uint32 ComponentStorage::Archetype::GetEntitiesCount() const
+{
+    return static_cast<uint32>(entities.size());
+}
+
+inline Entity* const* ComponentStorage::Archetype::GetEntities() const
+{
+    return entities.data();
+}
+
+inline Component* const* ComponentStorage::Archetype::GetComponents(uint32 runtimeId) const
+{
+    uint8 column = columnByRuntimeId[runtimeId];
+    return column < columns.size() ? columns[column].data() : nullptr;
+}
+
+inline uint32 ComponentStorage::GetArchetypesCount() const
+{
+    return static_cast<uint32>(archetypes.size());
+}
+
+inline const ComponentStorage::Archetype& ComponentStorage::GetArchetype(uint32 index) const
+{
+    return *archetypes[index];
+}
+}
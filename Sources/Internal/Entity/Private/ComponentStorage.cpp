@@ -0,0 +1,159 @@
+#include "Entity/ComponentStorage.h"
+#include "Entity/ComponentUtils.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/EntityFamily.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+namespace ComponentStorageDetail
+{
+const uint8 INVALID_COLUMN = 0xFF;
+}
+
+ComponentStorage::~ComponentStorage()
+{
+    for (std::unique_ptr<Archetype>& archetype : archetypes)
+    {
+        for (Entity* entity : archetype->entities)
+        {
+            entity->componentStorageArchetype = INVALID_INDEX;
+            entity->componentStorageRow = 0;
+        }
+        EntityFamily::Release(archetype->family);
+    }
+}
+
+void ComponentStorage::AddEntity(Entity* entity)
+{
+    DVASSERT(entity != nullptr);
+    DVASSERT(entity->componentStorageArchetype == INVALID_INDEX);
+
+    uint32 index = GetOrCreateArchetype(entity);
+    Archetype& archetype = *archetypes[index];
+
+    uint32 row = static_cast<uint32>(archetype.entities.size());
+    archetype.entities.push_back(entity);
+    for (Vector<Component*>& column : archetype.columns)
+    {
+        column.push_back(nullptr);
+    }
+    FillRow(archetype, row, entity);
+
+    entity->componentStorageArchetype = index;
+    entity->componentStorageRow = row;
+}
+
+void ComponentStorage::RemoveEntity(Entity* entity)
+{
+    DVASSERT(entity != nullptr);
+
+    uint32 index = entity->componentStorageArchetype;
+    if (index == INVALID_INDEX)
+    {
+        return;
+    }
+
+    DVASSERT(index < archetypes.size());
+    Archetype& archetype = *archetypes[index];
+
+    uint32 row = entity->componentStorageRow;
+    uint32 last = static_cast<uint32>(archetype.entities.size()) - 1;
+    DVASSERT(archetype.entities[row] == entity);
+
+    // swap with the last row to keep columns dense
+    if (row != last)
+    {
+        Entity* moved = archetype.entities[last];
+        archetype.entities[row] = moved;
+        for (Vector<Component*>& column : archetype.columns)
+        {
+            column[row] = column[last];
+        }
+        moved->componentStorageRow = row;
+    }
+
+    archetype.entities.pop_back();
+    for (Vector<Component*>& column : archetype.columns)
+    {
+        column.pop_back();
+    }
+
+    entity->componentStorageArchetype = INVALID_INDEX;
+    entity->componentStorageRow = 0;
+}
+
+void ComponentStorage::UpdateEntity(Entity* entity)
+{
+    DVASSERT(entity != nullptr);
+
+    uint32 index = entity->componentStorageArchetype;
+    if (index == INVALID_INDEX)
+    {
+        return;
+    }
+
+    Archetype& archetype = *archetypes[index];
+    if (archetype.family == entity->GetFamily())
+    {
+        FillRow(archetype, entity->componentStorageRow, entity);
+    }
+    else
+    {
+        RemoveEntity(entity);
+        AddEntity(entity);
+    }
+}
+
+uint32 ComponentStorage::GetArchetypeIndex(const Entity* entity)
+{
+    return entity->componentStorageArchetype;
+}
+
+uint32 ComponentStorage::GetArchetypeRow(const Entity* entity)
+{
+    return entity->componentStorageRow;
+}
+
+uint32 ComponentStorage::GetOrCreateArchetype(Entity* entity)
+{
+    EntityFamily* family = entity->GetFamily();
+    auto found = archetypeByFamily.find(family);
+    if (found != archetypeByFamily.end())
+    {
+        return found->second;
+    }
+
+    std::unique_ptr<Archetype> archetype(new Archetype());
+
+    // storage keeps family alive, so that family pointer of archetype can't be reused by another family
+    archetype->family = EntityFamily::GetOrCreate(entity->components);
+    DVASSERT(archetype->family == family);
+
+    archetype->mask = family->GetComponentsMask();
+    archetype->columnByRuntimeId.fill(ComponentStorageDetail::INVALID_COLUMN);
+    for (uint32 runtimeId = 0; runtimeId < archetype->mask.size(); ++runtimeId)
+    {
+        if (archetype->mask.test(runtimeId))
+        {
+            // components are sorted by type, so every entity of family keeps first component of a type at the same index
+            archetype->columnByRuntimeId[runtimeId] = static_cast<uint8>(archetype->columns.size());
+            archetype->componentIndexByColumn.push_back(family->GetComponentIndex(ComponentUtils::GetType(runtimeId), 0));
+            archetype->columns.emplace_back();
+        }
+    }
+
+    uint32 index = static_cast<uint32>(archetypes.size());
+    archetypes.push_back(std::move(archetype));
+    archetypeByFamily.emplace(family, index);
+    return index;
+}
+
+void ComponentStorage::FillRow(Archetype& archetype, uint32 row, Entity* entity)
+{
+    for (size_t column = 0; column < archetype.columns.size(); ++column)
+    {
+        archetype.columns[column][row] = entity->components[archetype.componentIndexByColumn[column]];
+    }
+}
+}
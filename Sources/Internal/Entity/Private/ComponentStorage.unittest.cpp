@@ -0,0 +1,159 @@
+#include "UnitTests/UnitTests.h"
+#include "Entity/ComponentStorage.h"
+#include "Entity/Query.h"
+#include "Entity/SortedEntityContainer.h"
+#include "Scene3D/Scene.h"
+#include "Scene3D/Components/RenderComponent.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Logger/Logger.h"
+#include "Time/SystemTimer.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (ComponentStorageTest)
+{
+    DAVA_TEST (QueryTest)
+    {
+        Scene* scene = new Scene(0);
+        SCOPE_EXIT
+        {
+            SafeRelease(scene);
+        };
+
+        const int32 entitiesCount = 100;
+        Vector<Entity*> entities;
+        for (int32 i = 0; i < entitiesCount; ++i)
+        {
+            Entity* entity = new Entity();
+            if (i % 2 == 0)
+            {
+                entity->AddComponent(new RenderComponent());
+            }
+            scene->AddNode(entity);
+            entity->Release();
+            entities.push_back(entity);
+        }
+
+        Query<TransformComponent, RenderComponent> query(scene->GetComponentStorage());
+        TEST_VERIFY(CountRows(query) == entitiesCount / 2);
+
+        // component added to entity in scene moves entity to another archetype
+        entities[1]->AddComponent(new RenderComponent());
+        TEST_VERIFY(CountRows(query) == entitiesCount / 2 + 1);
+
+        entities[0]->RemoveComponent(Type::Instance<RenderComponent>());
+        entities[2]->RemoveComponent(Type::Instance<RenderComponent>());
+        TEST_VERIFY(CountRows(query) == entitiesCount / 2 - 1);
+
+        entities[4]->Retain();
+        scene->RemoveNode(entities[4]);
+        TEST_VERIFY(CountRows(query) == entitiesCount / 2 - 2);
+        TEST_VERIFY(ComponentStorage::GetArchetypeIndex(entities[4]) == ComponentStorage::INVALID_INDEX);
+        entities[4]->Release();
+        entities.erase(entities.begin() + 4);
+
+        int32 forEachCount = 0;
+        query.ForEach([&forEachCount](Entity* entity, TransformComponent* transform, RenderComponent* render) {
+            TEST_VERIFY(entity->GetComponent<TransformComponent>() == transform);
+            TEST_VERIFY(entity->GetComponent<RenderComponent>() == render);
+            ++forEachCount;
+        });
+        TEST_VERIFY(forEachCount == entitiesCount / 2 - 2);
+
+        // query over changed entities visits only matching ones
+        SortedEntityContainer changed;
+        for (int32 i = 0; i < 10; ++i)
+        {
+            changed.Push(entities[i]);
+        }
+
+        Vector<Entity*> visited;
+        query.ForEach(changed, [&visited](Entity* entity, TransformComponent*, RenderComponent* render) {
+            TEST_VERIFY(entity->GetComponent<RenderComponent>() == render);
+            visited.push_back(entity);
+        });
+        std::sort(visited.begin(), visited.end());
+        Vector<Entity*> expected = { entities[1], entities[5], entities[7] };
+        std::sort(expected.begin(), expected.end());
+        TEST_VERIFY(visited == expected);
+
+        changed.EraseEntity(entities[5]);
+        visited.clear();
+        query.ForEach(changed, [&visited](Entity* entity, TransformComponent*, RenderComponent*) {
+            visited.push_back(entity);
+        });
+        TEST_VERIFY(visited.size() == 2);
+
+        // archetype groups are kept empty after clear
+        size_t groupsCount = changed.map.size();
+        changed.Clear();
+        TEST_VERIFY(changed.map.size() == groupsCount);
+        for (const auto& pair : changed.map)
+        {
+            TEST_VERIFY(pair.second.empty());
+        }
+    }
+
+    DAVA_TEST (IterationBenchmark)
+    {
+        Scene* scene = new Scene(0);
+        SCOPE_EXIT
+        {
+            SafeRelease(scene);
+        };
+
+        const int32 entitiesCount = 100000;
+        Vector<Entity*> entities;
+        entities.reserve(entitiesCount);
+        Entity* root = new Entity();
+        for (int32 i = 0; i < entitiesCount; ++i)
+        {
+            Entity* entity = new Entity();
+            if (i % 4 != 0)
+            {
+                entity->AddComponent(new RenderComponent());
+            }
+            root->AddNode(entity);
+            entity->Release();
+            entities.push_back(entity);
+        }
+        scene->AddNode(root);
+        root->Release();
+
+        uintptr_t lookupSum = 0;
+        int64 startTime = SystemTimer::GetUs();
+        for (Entity* entity : entities)
+        {
+            RenderComponent* render = entity->GetComponent<RenderComponent>();
+            if (render != nullptr)
+            {
+                lookupSum += reinterpret_cast<uintptr_t>(render) ^ reinterpret_cast<uintptr_t>(entity->GetComponent<TransformComponent>());
+            }
+        }
+        int64 lookupTime = SystemTimer::GetUs() - startTime;
+
+        uintptr_t querySum = 0;
+        startTime = SystemTimer::GetUs();
+        Query<TransformComponent, RenderComponent> query(scene->GetComponentStorage());
+        query.ForEach([&querySum](Entity*, TransformComponent* transform, RenderComponent* render) {
+            querySum += reinterpret_cast<uintptr_t>(render) ^ reinterpret_cast<uintptr_t>(transform);
+        });
+        int64 queryTime = SystemTimer::GetUs() - startTime;
+
+        TEST_VERIFY(lookupSum == querySum);
+
+        Logger::Info("[ComponentStorageTest] %d entities: GetComponent %lld us, Query %lld us", entitiesCount, lookupTime, queryTime);
+    }
+
+    int32 CountRows(const Query<TransformComponent, RenderComponent>& query)
+    {
+        int32 count = 0;
+        for (const auto& row : query)
+        {
+            TEST_VERIFY(row.GetEntity()->GetComponent<TransformComponent>() == row.Get<TransformComponent>());
+            TEST_VERIFY(row.GetEntity()->GetComponent<RenderComponent>() == row.Get<RenderComponent>());
+            ++count;
+        }
+        return count;
+    }
+};
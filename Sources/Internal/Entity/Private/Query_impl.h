@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Debug/DVAssert.h"
+#include "Entity/ComponentUtils.h"
+#include "Entity/SortedEntityContainer.h"
+#include "Scene3D/EntityFamily.h"
+
+#include <utility>
+
+namespace DAVA
+{
+namespace QueryDetail
+{
+template <typename U, typename... T>
+struct TypeIndex;
+
+template <typename U, typename... T>
+struct TypeIndex<U, U, T...> : std::integral_constant<size_t, 0>
+{
+};
+
+template <typename U, typename V, typename... T>
+struct TypeIndex<U, V, T...> : std::integral_constant<size_t, 1 + TypeIndex<U, T...>::value>
+{
+};
+
+template <typename... T, typename F, size_t... I>
+void CallForRow(const ComponentStorage::Archetype& archetype, const Array<uint32, sizeof...(T)>& runtimeIds, uint32 row, F& f, std::index_sequence<I...>)
+{
+    f(archetype.GetEntities()[row], static_cast<T*>(archetype.GetComponents(runtimeIds[I])[row])...);
+}
+
+template <typename... T, typename F, size_t... I>
+void CallForRows(const ComponentStorage::Archetype& archetype, const Array<uint32, sizeof...(T)>& runtimeIds, F& f, std::index_sequence<I...>)
+{
+    Entity* const* entities = archetype.GetEntities();
+    Array<Component* const*, sizeof...(T)> columns = { { archetype.GetComponents(runtimeIds[I])... } };
+    for (uint32 row = 0, count = archetype.GetEntitiesCount(); row < count; ++row)
+    {
+        f(entities[row], static_cast<T*>(columns[I][row])...);
+    }
+}
+}
+
+template <typename... T>
+Query<T...>::Query(const ComponentStorage* storage_)
+    : storage(storage_)
+    , mask(ComponentUtils::MakeMask<T...>())
+    , runtimeIds({ { ComponentUtils::GetRuntimeId<T>()... } })
+{
+    DVASSERT(storage != nullptr);
+}
+
+template <typename... T>
+typename Query<T...>::Iterator Query<T...>::begin() const
+{
+    return Iterator(this, 0);
+}
+
+template <typename... T>
+typename Query<T...>::Iterator Query<T...>::end() const
+{
+    return Iterator(this, storage->GetArchetypesCount());
+}
+
+template <typename... T>
+bool Query<T...>::Matches(const ComponentMask& componentsMask) const
+{
+    return (componentsMask & mask) == mask;
+}
+
+template <typename... T>
+template <typename F>
+void Query<T...>::ForEach(F f) const
+{
+    for (uint32 i = 0, count = storage->GetArchetypesCount(); i < count; ++i)
+    {
+        const ComponentStorage::Archetype& archetype = storage->GetArchetype(i);
+        if (archetype.GetEntitiesCount() > 0 && Matches(archetype.GetComponentsMask()))
+        {
+            QueryDetail::CallForRows<T...>(archetype, runtimeIds, f, std::index_sequence_for<T...>());
+        }
+    }
+}
+
+template <typename... T>
+template <typename F>
+void Query<T...>::ForEach(const SortedEntityContainer& entities, F f) const
+{
+    for (const auto& pair : entities.map)
+    {
+        if (pair.second.empty() || !Matches(pair.first->GetComponentsMask()))
+        {
+            continue;
+        }
+
+        for (Entity* entity : pair.second)
+        {
+            uint32 index = ComponentStorage::GetArchetypeIndex(entity);
+            if (index >= storage->GetArchetypesCount())
+            {
+                DVASSERT(false, "Entity isn't added to storage of query");
+                continue;
+            }
+
+            const ComponentStorage::Archetype& archetype = storage->GetArchetype(index);
+            if (Matches(archetype.GetComponentsMask()))
+            {
+                QueryDetail::CallForRow<T...>(archetype, runtimeIds, ComponentStorage::GetArchetypeRow(entity), f, std::index_sequence_for<T...>());
+            }
+        }
+    }
+}
+
+template <typename... T>
+Query<T...>::Iterator::Iterator(const Query* query_, uint32 archetype_)
+    : query(query_)
+    , archetype(archetype_)
+{
+    SeekArchetype();
+}
+
+template <typename... T>
+void Query<T...>::Iterator::SeekArchetype()
+{
+    row = 0;
+    rowsCount = 0;
+    for (uint32 count = query->storage->GetArchetypesCount(); archetype < count; ++archetype)
+    {
+        const ComponentStorage::Archetype& current = query->storage->GetArchetype(archetype);
+        if (current.GetEntitiesCount() > 0 && query->Matches(current.GetComponentsMask()))
+        {
+            rowsCount = current.GetEntitiesCount();
+            entities = current.GetEntities();
+            for (size_t i = 0; i < COMPONENTS_COUNT; ++i)
+            {
+                columns[i] = current.GetComponents(query->runtimeIds[i]);
+            }
+            break;
+        }
+    }
+}
+
+template <typename... T>
+typename Query<T...>::Iterator& Query<T...>::Iterator::operator++()
+{
+    if (++row == rowsCount)
+    {
+        ++archetype;
+        SeekArchetype();
+    }
+    return *this;
+}
+
+template <typename... T>
+bool Query<T...>::Iterator::operator==(const Iterator& other) const
+{
+    return archetype == other.archetype && row == other.row;
+}
+
+template <typename... T>
+bool Query<T...>::Iterator::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+template <typename... T>
+const typename Query<T...>::Iterator& Query<T...>::Iterator::operator*() const
+{
+    return *this;
+}
+
+template <typename... T>
+Entity* Query<T...>::Iterator::GetEntity() const
+{
+    return entities[row];
+}
+
+template <typename... T>
+template <typename U>
+U* Query<T...>::Iterator::Get() const
+{
+    return static_cast<U*>(columns[QueryDetail::TypeIndex<U, T...>::value][row]);
+}
+}
@@ -78,6 +78,22 @@ void SceneSystem::RemoveEntity(Entity* entity)
 {
 }
 
+void SceneSystem::AddEntities(const Vector<Entity*>& entities)
+{
+    for (Entity* entity : entities)
+    {
+        AddEntity(entity);
+    }
+}
+
+void SceneSystem::RemoveEntities(const Vector<Entity*>& entities)
+{
+    for (Entity* entity : entities)
+    {
+        RemoveEntity(entity);
+    }
+}
+
 void SceneSystem::AddComponent(Entity* entity, Component* component)
 {
 }
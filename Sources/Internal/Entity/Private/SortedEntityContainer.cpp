@@ -1,4 +1,5 @@
 #include "Entity/SortedEntityContainer.h"
+#include "Entity/ComponentStorage.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/EntityFamily.h"
 #include "Debug/DVAssert.h"
@@ -8,21 +9,48 @@ namespace DAVA
 void SortedEntityContainer::Push(Entity* entity)
 {
     DVASSERT(entity);
-    map[entity->GetFamily()].push_back(entity);
+
+    Vector<Entity*>* group = FindGroup(entity);
+    if (group == nullptr)
+    {
+        EntityFamily* family = entity->GetFamily();
+        uint32 archetype = ComponentStorage::GetArchetypeIndex(entity);
+        if (archetype != ComponentStorage::INVALID_INDEX && (archetype >= groupByArchetype.size() || groupByArchetype[archetype] == ComponentStorage::INVALID_INDEX))
+        {
+            // archetype groups are kept before groups of other entities, which are dropped by Clear
+            if (archetype >= groupByArchetype.size())
+            {
+                groupByArchetype.resize(archetype + 1, ComponentStorage::INVALID_INDEX);
+            }
+            groupByArchetype[archetype] = archetypeGroupsCount;
+            group = &map.emplace(map.begin() + archetypeGroupsCount, family, Vector<Entity*>())->second;
+            ++archetypeGroupsCount;
+        }
+        else
+        {
+            map.emplace_back(family, Vector<Entity*>());
+            group = &map.back().second;
+        }
+    }
+
+    group->push_back(entity);
 }
 
 void SortedEntityContainer::Clear()
 {
-    map.clear();
+    map.resize(archetypeGroupsCount);
+    for (auto& pair : map)
+    {
+        pair.second.clear();
+    }
 }
 
 void SortedEntityContainer::EraseEntity(const Entity* entity)
 {
-    EntityFamily* family = entity->GetFamily();
-    auto iter = map.find(family);
-    if (iter != map.end())
+    Vector<Entity*>* group = FindGroup(entity);
+    if (group != nullptr)
     {
-        Vector<Entity*>& vector = iter->second;
+        Vector<Entity*>& vector = *group;
         size_t size = vector.size();
         for (size_t k = 0; k < size; ++k)
         {
@@ -35,4 +63,28 @@ void SortedEntityContainer::EraseEntity(const Entity* entity)
         }
     }
 }
+
+Vector<Entity*>* SortedEntityContainer::FindGroup(const Entity* entity)
+{
+    EntityFamily* family = entity->GetFamily();
+
+    uint32 archetype = ComponentStorage::GetArchetypeIndex(entity);
+    if (archetype < groupByArchetype.size() && groupByArchetype[archetype] != ComponentStorage::INVALID_INDEX)
+    {
+        auto& pair = map[groupByArchetype[archetype]];
+        if (pair.first == family)
+        {
+            return &pair.second;
+        }
+    }
+
+    for (size_t i = archetypeGroupsCount; i < map.size(); ++i)
+    {
+        if (map[i].first == family)
+        {
+            return &map[i].second;
+        }
+    }
+    return nullptr;
+}
 }
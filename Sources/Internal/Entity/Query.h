@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Entity/ComponentStorage.h"
+
+namespace DAVA
+{
+class Entity;
+class SortedEntityContainer;
+
+/**
+    Typed query over entities of ComponentStorage which have components of all types `T...`.
+
+    Query walks dense component columns of matching archetypes and doesn't allocate memory. For every entity only
+    the first component of each type is visited. Storage must not be modified while query is iterated:
+    adding or removing entities or their components invalidates iterators.
+
+    Example:
+    \code
+    Query<TransformComponent, RenderComponent> query(scene->GetComponentStorage());
+    for (const auto& row : query)
+    {
+        TransformComponent* transform = row.Get<TransformComponent>();
+        RenderComponent* render = row.Get<RenderComponent>();
+    }
+
+    query.ForEach([](Entity* entity, TransformComponent* transform, RenderComponent* render) {});
+    \endcode
+*/
+template <typename... T>
+class Query
+{
+    static_assert(sizeof...(T) > 0, "Query requires at least one component type");
+
+public:
+    static const size_t COMPONENTS_COUNT = sizeof...(T);
+
+    class Iterator
+    {
+    public:
+        Iterator& operator++();
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+        const Iterator& operator*() const;
+
+        Entity* GetEntity() const;
+
+        /** Return component of type `U` of current entity. `U` must be one of query types. */
+        template <typename U>
+        U* Get() const;
+
+    private:
+        friend class Query;
+
+        Iterator(const Query* query, uint32 archetype);
+        void SeekArchetype();
+
+        const Query* query = nullptr;
+        uint32 archetype = 0;
+        uint32 row = 0;
+        uint32 rowsCount = 0;
+        Entity* const* entities = nullptr;
+        Array<Component* const*, COMPONENTS_COUNT> columns = {};
+    };
+
+    explicit Query(const ComponentStorage* storage);
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    /** Call `f(Entity*, T*...)` for every entity which has components of all query types. */
+    template <typename F>
+    void ForEach(F f) const;
+
+    /**
+        Call `f(Entity*, T*...)` for every entity from `entities` which has components of all query types.
+        Groups of `entities` which family doesn't match the query are skipped as a whole.
+        All entities must be added to the storage of the query.
+    */
+    template <typename F>
+    void ForEach(const SortedEntityContainer& entities, F f) const;
+
+    bool Matches(const ComponentMask& mask) const;
+
+private:
+    const ComponentStorage* storage = nullptr;
+    ComponentMask mask;
+    Array<uint32, COMPONENTS_COUNT> runtimeIds;
+};
+}
+
+#include "Entity/Private/Query_impl.h"
@@ -25,6 +25,16 @@ public:
     inline void SetRequiredComponents(const ComponentMask& requiredComponents);
     inline const ComponentMask& GetRequiredComponents() const;
 
+    /**
+        \brief Mark system as handling registration of entities and components on its own.
+                By default scene passes to the system only entities which have all required components
+                and only components of types from required components mask. Systems which override
+                RegisterEntity, UnregisterEntity, RegisterComponent or UnregisterComponent to track
+                other entities or components should enable custom registration before being added to scene.
+     */
+    inline void SetCustomRegistration(bool customRegistration);
+    inline bool HasCustomRegistration() const;
+
     /**
         \brief  This function is called when any entity registered to scene.
                 It sorts out is entity has all necessary components and we need to call AddEntity.
@@ -73,6 +83,18 @@ public:
      */
     virtual void RemoveEntity(Entity* entity);
 
+    /**
+        \brief This function is called when several entities are registered to scene at once, only entities
+                which have all required components are passed. Default implementation calls AddEntity for each.
+     */
+    virtual void AddEntities(const Vector<Entity*>& entities);
+
+    /**
+        \brief This function is called when several entities are unregistered from scene at once, only entities
+                which have all required components are passed. Default implementation calls RemoveEntity for each.
+     */
+    virtual void RemoveEntities(const Vector<Entity*>& entities);
+
     /*
         Left these callbacks to full compatibility with old multicomponent solution. Probably will be removed later, if we decide to get rid of multicomponents.
      */
@@ -135,6 +157,7 @@ private:
     ComponentMask requiredComponents;
     Scene* scene = nullptr;
 
+    bool customRegistration = false;
     bool locked = false;
 };
 
@@ -153,4 +176,14 @@ inline const ComponentMask& SceneSystem::GetRequiredComponents() const
 {
     return requiredComponents;
 }
+
+inline void SceneSystem::SetCustomRegistration(bool customRegistration_)
+{
+    customRegistration = customRegistration_;
+}
+
+inline bool SceneSystem::HasCustomRegistration() const
+{
+    return customRegistration;
+}
 }
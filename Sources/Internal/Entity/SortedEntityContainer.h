@@ -1,18 +1,31 @@
 #pragma once
 
-#include "Base/UnordererMap.h"
-#include "Base/Vector.h"
+#include "Base/BaseTypes.h"
 
 namespace DAVA
 {
 class EntityFamily;
 class Entity;
+
+/**
+    Entities grouped by EntityFamily.
+
+    Entities added to ComponentStorage are grouped by their storage archetype without any lookups, groups
+    of archetypes are kept by Clear to avoid allocations every frame. Other entities are grouped by family.
+*/
 class SortedEntityContainer
 {
 public:
     void Push(Entity* entity);
     void Clear();
     void EraseEntity(const Entity* entity);
-    UnorderedMap<EntityFamily*, Vector<Entity*>> map;
+
+    Vector<std::pair<EntityFamily*, Vector<Entity*>>> map;
+
+private:
+    Vector<Entity*>* FindGroup(const Entity* entity);
+
+    Vector<uint32> groupByArchetype;
+    uint32 archetypeGroupsCount = 0;
 };
 }
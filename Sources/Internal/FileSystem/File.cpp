@@ -8,6 +8,7 @@
 #include "FileSystem/FileSystemDelegate.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/CheckIOError.h"
+#include "FileSystem/Private/VirtualFileIndex.h"
 #include "FileSystem/ResourceArchive.h"
 #include "Engine/Private/Android/AssetsManagerAndroid.h"
 
@@ -100,6 +101,16 @@ File* File::Create(const FilePath& filename, uint32 attributes)
         }
     }
 
+    if (!(attributes & (WRITE | CREATE | APPEND)))
+    {
+        bool resolved = false;
+        File* result = IndexedCreate(filename, attributes, resolved);
+        if (resolved)
+        {
+            return result;
+        }
+    }
+
     if (!(attributes & (WRITE | CREATE | APPEND)) && fs->filenamesTag.empty() == false)
     {
         FilePath taggedFilename = filename;
@@ -127,6 +138,10 @@ File* File::Create(const FilePath& filename, uint32 attributes)
     File* result = PureCreate(filename, attributes);
     if (result != nullptr)
     {
+        if (attributes & (CREATE | APPEND))
+        {
+            fs->fileIndex->AddFile(filename.GetAbsolutePathname());
+        }
         return result;
     }
 
@@ -147,6 +162,89 @@ File* File::Create(const FilePath& filename, uint32 attributes)
     return result; // easy debug on android(can set breakpoint on nullptr value in eclipse do not remove it)
 }
 
+File* File::IndexedCreate(const FilePath& filename, uint32 attributes, bool& resolved)
+{
+    FileSystem* fs = GetEngineContext()->fileSystem;
+
+    // same lookup order as in Create: tagged variant, plain file, compressed file
+    Vector<String> candidates;
+    candidates.reserve(3);
+    if (fs->filenamesTag.empty() == false)
+    {
+        String basename = filename.GetBasename();
+        String::size_type pointPos = basename.find(".");
+        if (pointPos == String::npos)
+        {
+            basename += fs->filenamesTag;
+        }
+        else
+        {
+            basename.insert(pointPos, fs->filenamesTag);
+        }
+        FilePath taggedFilename = filename;
+        taggedFilename.ReplaceBasename(basename);
+        candidates.push_back(taggedFilename.GetStringValue());
+    }
+    candidates.push_back(filename.GetStringValue());
+    candidates.push_back(filename.GetStringValue() + extDvpl);
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        VirtualFileIndex::Entry entry;
+        VirtualFileIndex::LookupResult lookup = fs->fileIndex->Find(candidates[i], entry);
+        if (lookup == VirtualFileIndex::LookupResult::Unknown)
+        {
+            resolved = false;
+            return nullptr;
+        }
+        else if (lookup == VirtualFileIndex::LookupResult::Missing)
+        {
+            continue;
+        }
+
+        const bool isCompressed = (i == candidates.size() - 1);
+        File* result = nullptr;
+        if (entry.location == VirtualFileIndex::Location::Archive)
+        {
+            result = LoadFileFromMountedArchive(entry.archiveName, entry.path);
+        }
+        else if (isCompressed)
+        {
+            result = CompressedCreate(FilePath(entry.path), attributes);
+            if (result == nullptr)
+            {
+                // delete bad file (can't decompress)
+                FileAPI::RemoveFile(entry.path);
+                fs->fileIndex->RemoveFile(entry.path);
+                resolved = true;
+                return nullptr;
+            }
+        }
+        else
+        {
+            result = PureCreate(FilePath(entry.path), attributes);
+        }
+
+        if (result == nullptr)
+        {
+            // file was changed outside of FileSystem, forget stale entry and probe filesystem
+            fs->fileIndex->RemoveFile(entry.path);
+            resolved = false;
+            return nullptr;
+        }
+
+        if (!isCompressed)
+        {
+            result->filename = filename;
+        }
+        resolved = true;
+        return result;
+    }
+
+    resolved = true;
+    return nullptr;
+}
+
 File* File::LoadFileFromMountedArchive(const String& packName, const String& relative)
 {
     FileSystem* fs = FileSystem::Instance();
@@ -186,6 +186,12 @@ private:
     */
     static File* PureCreate(const FilePath& filePath, uint32 attributes);
     static File* CompressedCreate(const FilePath& filename, uint32 attributes);
+    /**
+    \brief function to open file through FileSystem file index without probing filesystem.
+    \param[out] resolved false if index knows nothing about filePath and caller should probe filesystem
+    \returns file instance or nullptr if file is missing
+    */
+    static File* IndexedCreate(const FilePath& filePath, uint32 attributes, bool& resolved);
     // reads 1 byte from current line in the file and sets it in next char if it is not a line ending char. Returns true if read was successful.
     bool GetNextChar(uint8* nextChar);
 
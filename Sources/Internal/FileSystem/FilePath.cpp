@@ -1,5 +1,6 @@
 #include "FileSystem/FilePath.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/Private/VirtualFileIndex.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
 #include "Utils/UTF8Utils.h"
@@ -36,6 +37,7 @@ void FilePath::SetBundleName(const FilePath& newBundlePath)
     }
 
     ctx->fileSystem->resourceFolders.insert(begin(ctx->fileSystem->resourceFolders), virtualBundlePath);
+    ctx->fileSystem->fileIndex->Reset();
 }
 
 const FilePath& FilePath::GetBundleName()
@@ -56,6 +58,7 @@ void FilePath::AddResourcesFolder(const FilePath& folder)
 
     const EngineContext* ctx = GetEngineContext();
     ctx->fileSystem->resourceFolders.push_back(resPath);
+    ctx->fileSystem->fileIndex->Reset();
 }
 
 void FilePath::AddTopResourcesFolder(const FilePath& folder)
@@ -69,6 +72,7 @@ void FilePath::AddTopResourcesFolder(const FilePath& folder)
 
     const EngineContext* ctx = GetEngineContext();
     ctx->fileSystem->resourceFolders.insert(begin(ctx->fileSystem->resourceFolders), resPath);
+    ctx->fileSystem->fileIndex->Reset();
 }
 
 void FilePath::RemoveResourcesFolder(const FilePath& folder)
@@ -78,6 +82,7 @@ void FilePath::RemoveResourcesFolder(const FilePath& folder)
     if (it != end(ctx->fileSystem->resourceFolders))
     {
         ctx->fileSystem->resourceFolders.erase(it);
+        ctx->fileSystem->fileIndex->Reset();
     }
 }
 
@@ -440,6 +445,22 @@ String FilePath::ResolveResourcesPath() const
         FilePath path;
 
         const EngineContext* ctx = GetEngineContext();
+
+        if (!IsDirectoryPathname() && ctx->fileSystem->GetDelegate() == nullptr)
+        {
+            // disk files hide archive ones in index, so archive or missing entry means there is no file on disk
+            VirtualFileIndex::Entry entry;
+            VirtualFileIndex::LookupResult lookup = ctx->fileSystem->fileIndex->Find(absolutePathname, entry);
+            if (lookup == VirtualFileIndex::LookupResult::Found && entry.location == VirtualFileIndex::Location::Disk)
+            {
+                return entry.path;
+            }
+            else if (lookup != VirtualFileIndex::LookupResult::Unknown)
+            {
+                return relativePathname;
+            }
+        }
+
         for (auto reverseIt = ctx->fileSystem->resourceFolders.rbegin(); reverseIt != ctx->fileSystem->resourceFolders.rend(); ++reverseIt)
         {
             path = reverseIt->absolutePathname + relativePathname;
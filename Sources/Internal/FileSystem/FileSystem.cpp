@@ -9,6 +9,7 @@
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FileSystemDelegate.h"
 #include "FileSystem/FileList.h"
+#include "FileSystem/Private/VirtualFileIndex.h"
 #include "FileSystem/YamlNode.h"
 #include "Debug/DVAssert.h"
 #include "Utils/Utils.h"
@@ -52,6 +53,7 @@ namespace DAVA
 static Set<String> androidAssetsFiles;
 
 FileSystem::FileSystem()
+    : fileIndex(new VirtualFileIndex())
 {
 }
 
@@ -136,7 +138,7 @@ bool FileSystem::CopyFile(const FilePath& existingFile, const FilePath& newFile,
 #ifdef __DAVAENGINE_WIN32__
 
     BOOL ret = ::CopyFileW(existingFilePath.c_str(), newFilePath.c_str(), !overwriteExisting);
-    return ret != 0;
+    bool copied = ret != 0;
 
 #elif defined(__DAVAENGINE_WIN_UAP__)
 
@@ -145,7 +147,7 @@ bool FileSystem::CopyFile(const FilePath& existingFile, const FilePath& newFile,
       /* dwSize */ sizeof(COPYFILE2_EXTENDED_PARAMETERS),
       /* dwCopyFlags */ overwriteExisting ? DWORD(0) : COPY_FILE_FAIL_IF_EXISTS
     };
-    return ::CopyFile2(existingFilePath.c_str(), newFilePath.c_str(), &params) == S_OK;
+    bool copied = ::CopyFile2(existingFilePath.c_str(), newFilePath.c_str(), &params) == S_OK;
 
 #elif defined(__DAVAENGINE_ANDROID__) || defined(__DAVAENGINE_LINUX__)
     // TODO: try sendfile for linux
@@ -193,12 +195,16 @@ bool FileSystem::CopyFile(const FilePath& existingFile, const FilePath& newFile,
     SafeRelease(dstFile);
     SafeRelease(srcFile);
 
-    return copied;
-
 #else //iphone & macos
     int ret = copyfile(existingFile.GetAbsolutePathname().c_str(), newFile.GetAbsolutePathname().c_str(), NULL, overwriteExisting ? COPYFILE_ALL : COPYFILE_ALL | COPYFILE_EXCL);
-    return ret == 0;
+    bool copied = ret == 0;
 #endif //PLATFORMS
+
+    if (copied)
+    {
+        fileIndex->AddFile(newFile.GetAbsolutePathname());
+    }
+    return copied;
 }
 
 bool FileSystem::MoveFile(const FilePath& existingFile, const FilePath& newFile, bool overwriteExisting /* = false*/)
@@ -220,7 +226,12 @@ bool FileSystem::MoveFile(const FilePath& existingFile, const FilePath& newFile,
         }
     }
     int result = FileAPI::RenameFile(fromFile, toFile);
-    if (0 != result && EXDEV == errno)
+    if (0 == result)
+    {
+        fileIndex->RemoveFile(fromFile);
+        fileIndex->AddFile(toFile);
+    }
+    else if (EXDEV == errno)
     {
         result = CopyFile(existingFile, newFile);
         if (result)
@@ -279,6 +290,7 @@ bool FileSystem::DeleteFile(const FilePath& filePath)
     int res = FileAPI::RemoveFile(fileName);
     if (res == 0)
     {
+        fileIndex->RemoveFile(fileName);
         return true;
     }
 
@@ -918,7 +930,9 @@ void FileSystem::Mount(const FilePath& archiveName, const String& attachPath)
 
         {
             LockGuard<Mutex> lock(accessArchiveMap);
+            const ResourceArchive& archive = *item.archive;
             resArchiveMap.emplace(archiveName.GetBasename(), std::move(item));
+            fileIndex->AddArchive(archiveName.GetBasename(), archive, attachPath);
         }
     }
 }
@@ -926,6 +940,7 @@ void FileSystem::Mount(const FilePath& archiveName, const String& attachPath)
 void FileSystem::Unmount(const FilePath& arhiveName)
 {
     LockGuard<Mutex> lock(accessArchiveMap);
+    fileIndex->RemoveArchive(arhiveName.GetBasename());
     resArchiveMap.erase(arhiveName.GetBasename());
 }
 
@@ -1197,4 +1212,57 @@ FileSystemDelegate* FileSystem::GetDelegate() const
 {
     return fsDelegate;
 }
+
+bool FileSystem::BuildFileIndex()
+{
+    Vector<VirtualFileIndex::Root> roots;
+    roots.reserve(resourceFolders.size());
+    for (const FilePath& folder : resourceFolders)
+    {
+        VirtualFileIndex::Root root;
+        root.absolutePath = folder.GetAbsolutePathname();
+        root.virtualPrefix = "~res:/";
+        if (!FileAPI::IsDirectory(root.absolutePath))
+        {
+            Logger::Warning("[FileSystem::BuildFileIndex] can't index resource folder %s", root.absolutePath.c_str());
+            fileIndex->Reset();
+            return false;
+        }
+        roots.push_back(std::move(root));
+    }
+
+    // keep archives locked while index enumerates them, Unmount waits for us
+    LockGuard<Mutex> lock(accessArchiveMap);
+
+    Vector<VirtualFileIndex::MountedArchive> archives;
+    archives.reserve(resArchiveMap.size());
+    for (const auto& item : resArchiveMap)
+    {
+        VirtualFileIndex::MountedArchive archive;
+        archive.archiveName = item.first;
+        archive.archive = item.second.archive.get();
+        archive.attachPath = item.second.attachPath;
+        archives.push_back(std::move(archive));
+    }
+
+    fileIndex->Build(roots, archives);
+    Logger::Info("[FileSystem::BuildFileIndex] indexed %u entries", static_cast<uint32>(fileIndex->GetEntriesCount()));
+    return true;
+}
+
+void FileSystem::ResetFileIndex()
+{
+    fileIndex->Reset();
+}
+
+bool FileSystem::IsFileIndexBuilt() const
+{
+    return fileIndex->IsBuilt();
+}
+
+void FileSystem::InvalidateFileIndex(const FilePath& directory)
+{
+    DVASSERT(directory.IsDirectoryPathname());
+    fileIndex->InvalidateDirectory(directory.GetAbsolutePathname());
+}
 }
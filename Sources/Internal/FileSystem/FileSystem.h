@@ -26,6 +26,7 @@ namespace DAVA
 	\todo add support for pack files
 */
 class FileSystemDelegate;
+class VirtualFileIndex;
 class FileSystem : public Singleton<FileSystem>
 {
 public:
@@ -303,6 +304,28 @@ public:
     void SetDelegate(FileSystemDelegate* delegate);
     FileSystemDelegate* GetDelegate() const;
 
+    /**
+        \brief Build in-memory index of all files in resource folders and mounted archives.
+        While index is built File::Create and ~res:/ pathname resolving do not probe filesystem
+        for indexed files. Archives mounted later are added to index on Mount.
+        Index is reset on any change of resource folders list.
+        \returns false if some resource folder can't be enumerated (e.g. android assets), index stays disabled
+     */
+    bool BuildFileIndex();
+
+    /**
+        \brief Drop in-memory file index, all following opens probe filesystem as usual
+     */
+    void ResetFileIndex();
+
+    bool IsFileIndexBuilt() const;
+
+    /**
+        \brief Exclude directory written at runtime by external code from file index.
+        Files created, moved or deleted through FileSystem and File are tracked automatically.
+     */
+    void InvalidateFileIndex(const FilePath& directory);
+
 private:
     bool HasLineEnding(File* f);
 
@@ -336,6 +359,8 @@ private:
 
     FileSystemDelegate* fsDelegate = nullptr;
 
+    std::unique_ptr<VirtualFileIndex> fileIndex;
+
     friend class File;
     friend class FilePath;
     Vector<FilePath> resourceFolders;
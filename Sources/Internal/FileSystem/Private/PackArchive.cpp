@@ -158,6 +158,13 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         FillFilesInfo(packFile, fileNames, mapFileData, filesInfo);
     }
 
+    if (footerBlock.solidBlocksSize > 0)
+    {
+        // solid blocks table is placed before metadata, so meta position is the same as in archives without solid blocks
+        uint64 startSolidBlocksTable = size - (sizeof(packFile.footer) + packFile.footer.info.filesTableSize + footerBlock.metaDataSize + footerBlock.solidBlocksSize);
+        ReadSolidBlocksTable(startSolidBlocksTable);
+    }
+
     if (footerBlock.metaDataSize > 0)
     {
         // parse metadata block
@@ -212,13 +219,68 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     }
 
     const FileTableEntry& fileEntry = *mapFileData.find(relativeFilePath)->second;
-    output.resize(fileEntry.originalSize);
 
     if (!file)
     {
         DAVA_THROW(DAVA::Exception, "can't open: " + relativeFilePath + " from pack: " + archiveName.GetStringValue());
     }
 
+    const SolidFile* solidFile = nullptr;
+    if (!solidFiles.empty())
+    {
+        ptrdiff_t index = std::distance(packFile.filesTable.data.files.data(), &fileEntry);
+        if (solidFiles[index].blockOriginalSize > 0)
+        {
+            solidFile = &solidFiles[index];
+        }
+    }
+
+    if (solidFile != nullptr)
+    {
+        if (!LoadSolidFile(relativeFilePath, fileEntry, *solidFile, output))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        output.resize(fileEntry.originalSize);
+        if (!ReadAndDecompress(relativeFilePath, fileEntry, output))
+        {
+            return false;
+        }
+    }
+
+    // check crc32 for file content
+    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(output.data(), output.size()))
+    {
+        String msg = "original crc32 not match for: " + relativeFilePath + " during decompress from pack: " + archiveName.GetStringValue();
+        throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
+    }
+
+    return true;
+}
+
+bool PackArchive::LoadSolidFile(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const SolidFile& solidFile, Vector<uint8>& output) const
+{
+    if (cachedBlockPosition != fileEntry.startPosition)
+    {
+        cachedBlockPosition = std::numeric_limits<uint64>::max();
+        cachedBlock.resize(solidFile.blockOriginalSize);
+        if (!ReadAndDecompress(relativeFilePath, fileEntry, cachedBlock))
+        {
+            return false;
+        }
+        cachedBlockPosition = fileEntry.startPosition;
+    }
+
+    auto fileStart = cachedBlock.begin() + solidFile.offsetInBlock;
+    output.assign(fileStart, fileStart + fileEntry.originalSize);
+    return true;
+}
+
+bool PackArchive::ReadAndDecompress(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint8>& output) const
+{
     bool isOk = file->Seek(fileEntry.startPosition, File::SEEK_FROM_START);
     if (!isOk)
     {
@@ -230,8 +292,9 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     {
     case Compressor::Type::None:
     {
-        uint32 readOk = file->Read(output.data(), fileEntry.originalSize);
-        if (readOk != fileEntry.originalSize)
+        uint32 outputSize = static_cast<uint32>(output.size());
+        uint32 readOk = file->Read(output.data(), outputSize);
+        if (readOk != outputSize)
         {
             Logger::Error("can't load file: %s course: can't read uncompressed content", relativeFilePath.c_str());
             return false;
@@ -277,14 +340,69 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     break;
     } // end switch
 
-    // check crc32 for file content
-    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(output.data(), output.size()))
+    return true;
+}
+
+void PackArchive::ReadSolidBlocksTable(uint64 startSolidBlocksTable)
+{
+    using namespace PackFormat;
+
+    const uint32 solidBlocksSize = packFile.footer.solidBlocksSize;
+    if (solidBlocksSize % sizeof(SolidBlockEntry) != 0)
     {
-        String msg = "original crc32 not match for: " + relativeFilePath + " during decompress from pack: " + archiveName.GetStringValue();
-        throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
+        DAVA_THROW(DAVA::Exception, "incorrect solid blocks table size in file: " + archiveName.GetStringValue());
     }
 
-    return true;
+    Vector<SolidBlockEntry>& blocks = packFile.solidBlocks.blocks;
+    blocks.resize(solidBlocksSize / sizeof(SolidBlockEntry));
+
+    if (!file->Seek(startSolidBlocksTable, File::SEEK_FROM_START))
+    {
+        DAVA_THROW(DAVA::Exception, "can't seek to solid blocks table in file: " + archiveName.GetStringValue());
+    }
+
+    if (file->Read(blocks.data(), solidBlocksSize) != solidBlocksSize)
+    {
+        DAVA_THROW(DAVA::Exception, "can't read solid blocks table from file: " + archiveName.GetStringValue());
+    }
+
+    if (CRC32::ForBuffer(blocks.data(), solidBlocksSize) != packFile.footer.solidBlocksCrc32)
+    {
+        DAVA_THROW(DAVA::Exception, "crc32 not match in solid blocks table in file: " + archiveName.GetStringValue());
+    }
+
+    const Vector<FileTableEntry>& fileTable = packFile.filesTable.data.files;
+    solidFiles.resize(fileTable.size());
+
+    for (const SolidBlockEntry& block : blocks)
+    {
+        if (block.numFiles == 0 || block.firstFile >= fileTable.size() || fileTable.size() - block.firstFile < block.numFiles)
+        {
+            DAVA_THROW(DAVA::Exception, "incorrect solid block in file: " + archiveName.GetStringValue());
+        }
+
+        uint32 blockOriginalSize = 0;
+        for (uint32 i = block.firstFile; i < block.firstFile + block.numFiles; ++i)
+        {
+            solidFiles[i].offsetInBlock = blockOriginalSize;
+            blockOriginalSize += fileTable[i].originalSize;
+        }
+
+        if (blockOriginalSize == 0)
+        {
+            DAVA_THROW(DAVA::Exception, "empty solid block in file: " + archiveName.GetStringValue());
+        }
+
+        for (uint32 i = block.firstFile; i < block.firstFile + block.numFiles; ++i)
+        {
+            solidFiles[i].blockOriginalSize = blockOriginalSize;
+        }
+    }
+}
+
+bool PackArchive::IsFileInSolidBlock(uint32 fileIndex) const
+{
+    return fileIndex < solidFiles.size() && solidFiles[fileIndex].blockOriginalSize > 0;
 }
 
 uint32 PackArchive::GetFileIndex(const String& releativeFilePath) const
@@ -31,6 +31,9 @@ public:
 
     const PackFormat::PackFile& GetPackFile() const;
 
+    /** return true if file with `fileIndex` is packed together with other files into solid block */
+    bool IsFileInSolidBlock(uint32 fileIndex) const;
+
     static void ExtractFileTableData(const PackFormat::PackFile::FooterBlock& footerBlock,
                                      const Vector<uint8>& tmpBuffer,
                                      String& fileNames,
@@ -43,12 +46,26 @@ public:
                               Vector<ResourceArchive::FileInfo>& filesInfo);
 
 private:
+    struct SolidFile
+    {
+        uint32 blockOriginalSize = 0; // 0 if file is not in solid block
+        uint32 offsetInBlock = 0;
+    };
+
+    void ReadSolidBlocksTable(uint64 startSolidBlocksTable);
+    bool LoadSolidFile(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const SolidFile& solidFile, Vector<uint8>& output) const;
+    bool ReadAndDecompress(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint8>& output) const;
+
     const FilePath archiveName;
     mutable RefPtr<File> file;
     PackFormat::PackFile packFile;
     std::unique_ptr<PackMetaData> packMeta;
     UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
     Vector<ResourceArchive::FileInfo> filesInfo;
+
+    Vector<SolidFile> solidFiles; // empty if archive has no solid blocks, same order as files table
+    mutable uint64 cachedBlockPosition = std::numeric_limits<uint64>::max();
+    mutable Vector<uint8> cachedBlock; // last unpacked solid block, neighbour small files are usually loaded together
 };
 
 } // end namespace DAVA
@@ -16,6 +16,21 @@ struct PackFile
     {
     } rawBytesOfCompressedFiles;
 
+    // 0 or footer.solidBlocksSize bytes
+    // small files can be packed together into one compressed block. All files of
+    // solid block have same startPosition, compressedSize, compressedCrc32 and type
+    // in FilesData and go one by one in order of FilesData inside uncompressed block
+    struct SolidBlocksTable
+    {
+        struct Block
+        {
+            uint32 firstFile; // index of first file of block in FilesData
+            uint32 numFiles;
+        };
+
+        Vector<Block> blocks;
+    } solidBlocks;
+
     // 0 or footer.metaDataSize bytes
     struct CustomMetadataBlock
     {
@@ -51,7 +66,8 @@ struct PackFile
 
     struct FooterBlock
     {
-        Array<uint8, 8> reserved{};
+        uint32 solidBlocksSize = 0; // 0 or size of solid blocks table
+        uint32 solidBlocksCrc32 = 0; // 0 or crc32 for solid blocks table
         uint32 metaDataCrc32 = 0; // 0 or crc32 for custom user meta block
         uint32 metaDataSize = 0; // 0 or size of custom user meta data block
         uint32 infoCrc32 = 0;
@@ -68,6 +84,7 @@ struct PackFile
 }; // end PackFile struct
 
 using FileTableEntry = PackFile::FilesTableBlock::FilesData::Data;
+using SolidBlockEntry = PackFile::SolidBlocksTable::Block;
 
 /**
 	One file packed with our custom compression + 20 bytes footer
@@ -94,6 +111,7 @@ struct LitePack
 static_assert(sizeof(LitePack::Footer) == 20, "footer block size changed");
 static_assert(sizeof(PackFile::FooterBlock) == 44, "header block size changed");
 static_assert(sizeof(FileTableEntry) == 32, "file table entry size changed");
+static_assert(sizeof(SolidBlockEntry) == 8, "solid block entry size changed");
 
 } // end of PackFormat namespace
 
@@ -0,0 +1,357 @@
+#include "FileSystem/Private/VirtualFileIndex.h"
+#include "FileSystem/FileList.h"
+#include "FileSystem/ResourceArchive.h"
+#include "Base/ScopedPtr.h"
+#include "Concurrency/LockGuard.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+void VirtualFileIndex::Build(const Vector<Root>& newRoots, const Vector<MountedArchive>& newArchives)
+{
+    // enumerate without holding the lock, FileList resolves pathnames and may query index
+    EntryMap newEntries;
+    for (const MountedArchive& archive : newArchives)
+    {
+        EnumerateArchive(archive, newEntries);
+    }
+
+    for (size_t i = 0; i < newRoots.size(); ++i)
+    {
+        EnumerateRoot(newRoots[i], static_cast<uint32>(i + 1), newEntries);
+    }
+
+    LockGuard<Mutex> lock(mutex);
+    entries = std::move(newEntries);
+    roots = newRoots;
+    archives = newArchives;
+    volatilePrefixes.clear();
+    isBuilt = true;
+}
+
+void VirtualFileIndex::Reset()
+{
+    LockGuard<Mutex> lock(mutex);
+    entries.clear();
+    roots.clear();
+    archives.clear();
+    volatilePrefixes.clear();
+    isBuilt = false;
+}
+
+bool VirtualFileIndex::IsBuilt() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return isBuilt;
+}
+
+void VirtualFileIndex::AddArchive(const String& archiveName, const ResourceArchive& archive, const String& attachPath)
+{
+    MountedArchive mounted;
+    mounted.archiveName = archiveName;
+    mounted.archive = &archive;
+    mounted.attachPath = attachPath;
+
+    EntryMap archiveEntries;
+    EnumerateArchive(mounted, archiveEntries);
+
+    LockGuard<Mutex> lock(mutex);
+    if (!isBuilt)
+    {
+        return;
+    }
+
+    for (const auto& item : archiveEntries)
+    {
+        InsertEntry(entries, item.first, item.second);
+    }
+    archives.push_back(std::move(mounted));
+}
+
+void VirtualFileIndex::RemoveArchive(const String& archiveName)
+{
+    LockGuard<Mutex> lock(mutex);
+    if (!isBuilt)
+    {
+        return;
+    }
+
+    auto archiveIt = std::find_if(begin(archives), end(archives), [&archiveName](const MountedArchive& a) { return a.archiveName == archiveName; });
+    if (archiveIt == end(archives))
+    {
+        return;
+    }
+    archives.erase(archiveIt);
+
+    for (auto it = begin(entries); it != end(entries);)
+    {
+        if (it->second.location == Location::Archive && it->second.archiveName == archiveName)
+        {
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // files hidden by removed archive become visible again
+    for (const MountedArchive& archive : archives)
+    {
+        EnumerateArchive(archive, entries);
+    }
+}
+
+void VirtualFileIndex::AddFile(const String& absolutePath)
+{
+    LockGuard<Mutex> lock(mutex);
+    if (!isBuilt || IsInVolatileDirectory(absolutePath))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < roots.size(); ++i)
+    {
+        const Root& root = roots[i];
+        if (StartsWith(absolutePath, root.absolutePath))
+        {
+            Entry entry;
+            entry.location = Location::Disk;
+            entry.path = absolutePath;
+            entry.priority = static_cast<uint32>(i + 1);
+
+            InsertEntry(entries, absolutePath, entry);
+            InsertEntry(entries, root.virtualPrefix + absolutePath.substr(root.absolutePath.size()), entry);
+        }
+    }
+}
+
+void VirtualFileIndex::RemoveFile(const String& absolutePath)
+{
+    LockGuard<Mutex> lock(mutex);
+    if (!isBuilt)
+    {
+        return;
+    }
+
+    entries.erase(absolutePath);
+
+    for (const Root& root : roots)
+    {
+        if (StartsWith(absolutePath, root.absolutePath))
+        {
+            String relativePath = absolutePath.substr(root.absolutePath.size());
+            auto it = entries.find(root.virtualPrefix + relativePath);
+            if (it != end(entries) && it->second.location == Location::Disk && it->second.path == absolutePath)
+            {
+                entries.erase(it);
+                RestoreHiddenEntry(root.virtualPrefix, relativePath);
+            }
+        }
+    }
+}
+
+void VirtualFileIndex::InvalidateDirectory(const String& absoluteDirPath)
+{
+    LockGuard<Mutex> lock(mutex);
+    if (!isBuilt)
+    {
+        return;
+    }
+
+    Vector<String> prefixes;
+    prefixes.push_back(absoluteDirPath);
+    for (const Root& root : roots)
+    {
+        if (StartsWith(absoluteDirPath, root.absolutePath))
+        {
+            prefixes.push_back(root.virtualPrefix + absoluteDirPath.substr(root.absolutePath.size()));
+        }
+        else if (StartsWith(root.absolutePath, absoluteDirPath))
+        {
+            prefixes.push_back(root.virtualPrefix);
+        }
+    }
+
+    for (auto it = begin(entries); it != end(entries);)
+    {
+        if (it->second.location == Location::Disk && StartsWith(it->second.path, absoluteDirPath))
+        {
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (String& prefix : prefixes)
+    {
+        if (std::find(begin(volatilePrefixes), end(volatilePrefixes), prefix) == end(volatilePrefixes))
+        {
+            volatilePrefixes.push_back(std::move(prefix));
+        }
+    }
+}
+
+VirtualFileIndex::LookupResult VirtualFileIndex::Find(const String& pathname, Entry& entry) const
+{
+    LockGuard<Mutex> lock(mutex);
+    if (!isBuilt || IsInVolatileDirectory(pathname))
+    {
+        return LookupResult::Unknown;
+    }
+
+    auto it = entries.find(pathname);
+    if (it != end(entries))
+    {
+        entry = it->second;
+        return LookupResult::Found;
+    }
+
+    return IsInIndexedRoot(pathname) ? LookupResult::Missing : LookupResult::Unknown;
+}
+
+size_t VirtualFileIndex::GetEntriesCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return entries.size();
+}
+
+void VirtualFileIndex::EnumerateRoot(const Root& root, uint32 priority, EntryMap& entries)
+{
+    Vector<String> directories;
+    directories.push_back(root.absolutePath);
+
+    while (!directories.empty())
+    {
+        String directory = std::move(directories.back());
+        directories.pop_back();
+
+        ScopedPtr<FileList> fileList(new FileList(FilePath(directory)));
+        for (uint32 i = 0, count = fileList->GetCount(); i < count; ++i)
+        {
+            if (fileList->IsNavigationDirectory(i))
+            {
+                continue;
+            }
+
+            String absolutePath = directory + fileList->GetFilename(i);
+            if (fileList->IsDirectory(i))
+            {
+                directories.push_back(absolutePath + "/");
+            }
+            else
+            {
+                Entry entry;
+                entry.location = Location::Disk;
+                entry.path = absolutePath;
+                entry.priority = priority;
+
+                InsertEntry(entries, root.virtualPrefix + absolutePath.substr(root.absolutePath.size()), entry);
+                InsertEntry(entries, absolutePath, entry);
+            }
+        }
+    }
+}
+
+void VirtualFileIndex::EnumerateArchive(const MountedArchive& archive, EntryMap& entries)
+{
+    DVASSERT(archive.archive != nullptr);
+
+    for (const ResourceArchive::FileInfo& info : archive.archive->GetFilesInfo())
+    {
+        Entry entry;
+        entry.location = Location::Archive;
+        entry.path = info.relativeFilePath;
+        entry.archiveName = archive.archiveName;
+        entry.priority = 0;
+
+        InsertEntry(entries, archive.attachPath + info.relativeFilePath, entry);
+    }
+}
+
+void VirtualFileIndex::InsertEntry(EntryMap& entries, const String& key, const Entry& entry)
+{
+    auto it = entries.find(key);
+    if (it == end(entries))
+    {
+        entries.emplace(key, entry);
+    }
+    else if (it->second.priority <= entry.priority)
+    {
+        it->second = entry;
+    }
+}
+
+bool VirtualFileIndex::StartsWith(const String& str, const String& prefix)
+{
+    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool VirtualFileIndex::IsInVolatileDirectory(const String& pathname) const
+{
+    for (const String& prefix : volatilePrefixes)
+    {
+        if (StartsWith(pathname, prefix))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool VirtualFileIndex::IsInIndexedRoot(const String& pathname) const
+{
+    for (const Root& root : roots)
+    {
+        if (StartsWith(pathname, root.absolutePath) || StartsWith(pathname, root.virtualPrefix))
+        {
+            return true;
+        }
+    }
+
+    for (const MountedArchive& archive : archives)
+    {
+        if (StartsWith(pathname, archive.attachPath))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VirtualFileIndex::RestoreHiddenEntry(const String& virtualPrefix, const String& relativePath)
+{
+    const String virtualPath = virtualPrefix + relativePath;
+
+    for (auto root = roots.rbegin(); root != roots.rend(); ++root)
+    {
+        if (root->virtualPrefix == virtualPrefix)
+        {
+            auto it = entries.find(root->absolutePath + relativePath);
+            if (it != end(entries))
+            {
+                InsertEntry(entries, virtualPath, it->second);
+                return;
+            }
+        }
+    }
+
+    for (const MountedArchive& archive : archives)
+    {
+        if (StartsWith(virtualPath, archive.attachPath))
+        {
+            String archivePath = virtualPath.substr(archive.attachPath.size());
+            if (archive.archive->HasFile(archivePath))
+            {
+                Entry entry;
+                entry.location = Location::Archive;
+                entry.path = archivePath;
+                entry.archiveName = archive.archiveName;
+                InsertEntry(entries, virtualPath, entry);
+            }
+        }
+    }
+}
+}
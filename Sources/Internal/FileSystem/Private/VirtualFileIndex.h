@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/Mutex.h"
+
+namespace DAVA
+{
+class ResourceArchive;
+
+/**
+    In-memory index of files available through resource folders and mounted archives.
+
+    Index maps both virtual (~res:/...) and absolute pathnames to the backend which
+    holds the file, so File::Create can open it without probing the filesystem.
+    Misses inside indexed roots are authoritative, misses elsewhere are reported as
+    Unknown and caller should fall back to regular filesystem access.
+    Thread safe.
+*/
+class VirtualFileIndex final
+{
+public:
+    enum class Location : uint8
+    {
+        Disk, //!< regular file, `path` is absolute pathname
+        Archive //!< file inside mounted archive, `path` is relative pathname in archive
+    };
+
+    struct Entry
+    {
+        Location location = Location::Disk;
+        String path;
+        String archiveName;
+        uint32 priority = 0;
+    };
+
+    enum class LookupResult : uint8
+    {
+        Found,
+        Missing,
+        Unknown
+    };
+
+    struct Root
+    {
+        String absolutePath; //!< absolute directory pathname with trailing slash
+        String virtualPrefix; //!< virtual prefix files are visible with, e.g. ~res:/
+    };
+
+    struct MountedArchive
+    {
+        String archiveName;
+        const ResourceArchive* archive = nullptr;
+        String attachPath;
+    };
+
+    /** Replace whole index with files enumerated in `roots` and `archives`.
+        Roots are listed in increasing priority order, files from later roots hide files from earlier ones.
+        Disk files always hide files with the same virtual pathname from archives. */
+    void Build(const Vector<Root>& roots, const Vector<MountedArchive>& archives);
+
+    /** Drop all entries and disable index */
+    void Reset();
+
+    bool IsBuilt() const;
+
+    void AddArchive(const String& archiveName, const ResourceArchive& archive, const String& attachPath);
+    void RemoveArchive(const String& archiveName);
+
+    /** Register file created at runtime, does nothing if file is outside of indexed roots */
+    void AddFile(const String& absolutePath);
+    void RemoveFile(const String& absolutePath);
+
+    /** Drop entries of runtime-written directory and exclude it from index, lookups inside it return Unknown */
+    void InvalidateDirectory(const String& absoluteDirPath);
+
+    /** Lookup by virtual (~res:/...) or absolute pathname, O(1) and without any filesystem access */
+    LookupResult Find(const String& pathname, Entry& entry) const;
+
+    size_t GetEntriesCount() const;
+
+private:
+    using EntryMap = UnorderedMap<String, Entry>;
+
+    static void EnumerateRoot(const Root& root, uint32 priority, EntryMap& entries);
+    static void EnumerateArchive(const MountedArchive& archive, EntryMap& entries);
+    static void InsertEntry(EntryMap& entries, const String& key, const Entry& entry);
+    static bool StartsWith(const String& str, const String& prefix);
+
+    bool IsInVolatileDirectory(const String& pathname) const;
+    bool IsInIndexedRoot(const String& pathname) const;
+    void RestoreHiddenEntry(const String& virtualPrefix, const String& relativePath);
+
+    mutable Mutex mutex;
+    EntryMap entries;
+    Vector<Root> roots;
+    Vector<String> volatilePrefixes;
+    Vector<MountedArchive> archives;
+    bool isBuilt = false;
+};
+}
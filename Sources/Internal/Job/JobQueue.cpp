@@ -28,8 +28,25 @@ void JobQueueWorker::Push(const Function<void()>& fn)
             nextPushIndex = 0;
             nextPopIndex = 0;
         }
-
-        DVASSERT(nextPushIndex < jobsMaxCount);
+        else if (nextPushIndex == jobsMaxCount)
+        {
+            // jobs can be pushed while others are still running, so queue may never become idle:
+            // move not yet popped jobs to the beginning, and grow queue if all of them are not popped yet
+            if (nextPopIndex > 0)
+            {
+                std::move(jobs + nextPopIndex, jobs + nextPushIndex, jobs);
+                nextPushIndex -= nextPopIndex;
+                nextPopIndex = 0;
+            }
+            else
+            {
+                Function<void()>* grownJobs = new Function<void()>[jobsMaxCount * 2];
+                std::move(jobs, jobs + nextPushIndex, grownJobs);
+                SafeDeleteArray(jobs);
+                jobs = grownJobs;
+                jobsMaxCount *= 2;
+            }
+        }
 
         jobs[nextPushIndex++] = fn;
         processingCount++;
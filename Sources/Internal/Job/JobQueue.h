@@ -11,6 +11,7 @@ namespace DAVA
 class JobQueueWorker
 {
 public:
+    /** `maxCount` is initial capacity of queue, it grows when more jobs are pushed but not popped yet. */
     JobQueueWorker(uint32 maxCount = 1024);
     virtual ~JobQueueWorker();
 
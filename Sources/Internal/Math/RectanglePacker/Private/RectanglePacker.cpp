@@ -61,7 +61,7 @@ std::unique_ptr<RectanglePacker::PackResult> RectanglePacker::PackSprites(Vector
 
                 for (const PackingAlgorithm alg : packAlgorithms)
                 {
-                    std::unique_ptr<SpritesheetLayout> sheet = SpritesheetLayout::Create(xResolution, yResolution, useTwoSideMargin, texturesMargin, alg);
+                    std::unique_ptr<SpritesheetLayout> sheet = SpritesheetLayout::Create(xResolution, yResolution, useTwoSideMargin, texturesMargin, alg, allowRotation);
 
                     Vector<SpriteItem> tempSpritesRemaining = spritesToPack;
                     uint32 spritesWeight = TryToPack(sheet.get(), tempSpritesRemaining, wasFullyPacked);
@@ -212,7 +212,7 @@ const BasicSpritesheetLayout::SpritesheetNode* BasicSpritesheetLayout::SearchNod
 class MaxRectsSpritesheetLayout : public SpritesheetLayout
 {
 public:
-    explicit MaxRectsSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 spritesMargin);
+    explicit MaxRectsSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 spritesMargin, bool allowRotation);
 
     // SpritesheetLayout
     bool AddSprite(const Size2i& spriteSize, const void* searchPtr) override;
@@ -227,24 +227,30 @@ public:
     }
 
 protected:
-    virtual const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const = 0;
-    const SpriteBoundsRect* InsertNewSpriteRect(const SpriteBoundsRect* foundFreeRect, const Size2i& spriteSize, const void* spritePtr);
+    // score of placing sprite into free rect, lower is better
+    using Score = std::pair<int32, int32>;
+
+    virtual Score ScoreFreeRect(const SpriteBoundsRect& freeRect, int32 restWidth, int32 restHeight) const = 0;
+    const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize, Score& bestScore) const;
+    const SpriteBoundsRect* InsertNewSpriteRect(const SpriteBoundsRect* foundFreeRect, const Size2i& spriteSize, bool rotated, const void* spritePtr);
     void SplitIntersectedFreeRects(const SpriteBoundsRect* newSpriteRect);
     void RemoveRedundantFreeRects();
 
     const int32 edgePixel;
     const int32 spritesMargin;
     const int32 splitter;
+    const bool allowRotation;
 
     Rect2i sheetRect;
     List<SpriteBoundsRect> freeRects;
     UnorderedMap<const void*, SpriteBoundsRect> spriteRects;
 };
 
-MaxRectsSpritesheetLayout::MaxRectsSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 margin)
+MaxRectsSpritesheetLayout::MaxRectsSpritesheetLayout(uint32 w, uint32 h, bool duplicateEdgePixel, int32 margin, bool allowRotation_)
     : edgePixel(duplicateEdgePixel ? 1 : 0)
     , spritesMargin(margin)
     , splitter(spritesMargin + edgePixel + edgePixel)
+    , allowRotation(allowRotation_)
 {
     sheetRect = Rect2i(0, 0, w, h);
     SpriteBoundsRect firstRect;
@@ -255,16 +261,31 @@ MaxRectsSpritesheetLayout::MaxRectsSpritesheetLayout(uint32 w, uint32 h, bool du
 bool MaxRectsSpritesheetLayout::AddSprite(const Size2i& spriteSize, const void* spritePtr)
 {
     // maxrects alg in brief:
-    // step1: find best free rect
+    // step1: find best free rect, for sprite rotated by 90 degrees too if rotation is allowed
     // step2: insert new sprite rect
     // step3: split free rects intersected by new sprite rect
     // step4: remove redundant free rects
 
-    const SpriteBoundsRect* bestFreeRect = FindBestFreeRect(spriteSize);
+    Score bestScore;
+    const SpriteBoundsRect* bestFreeRect = FindBestFreeRect(spriteSize, bestScore);
+    bool rotated = false;
+
+    if (allowRotation && spriteSize.dx != spriteSize.dy)
+    {
+        Score rotatedScore;
+        const SpriteBoundsRect* rotatedFreeRect = FindBestFreeRect(Size2i(spriteSize.dy, spriteSize.dx), rotatedScore);
+        if (rotatedFreeRect != nullptr && (bestFreeRect == nullptr || rotatedScore < bestScore))
+        {
+            bestFreeRect = rotatedFreeRect;
+            rotated = true;
+        }
+    }
+
     if (bestFreeRect == nullptr)
         return false;
 
-    const SpriteBoundsRect* newSpriteRect = InsertNewSpriteRect(bestFreeRect, spriteSize, spritePtr);
+    Size2i placedSize = rotated ? Size2i(spriteSize.dy, spriteSize.dx) : spriteSize;
+    const SpriteBoundsRect* newSpriteRect = InsertNewSpriteRect(bestFreeRect, placedSize, rotated, spritePtr);
     DVASSERT(newSpriteRect != nullptr);
 
     SplitIntersectedFreeRects(newSpriteRect);
@@ -273,9 +294,30 @@ bool MaxRectsSpritesheetLayout::AddSprite(const Size2i& spriteSize, const void*
     return true;
 }
 
-const SpriteBoundsRect* MaxRectsSpritesheetLayout::InsertNewSpriteRect(const SpriteBoundsRect* foundFreeRect, const Size2i& spriteSize, const void* spritePtr)
+const SpriteBoundsRect* MaxRectsSpritesheetLayout::FindBestFreeRect(const Size2i& spriteSize, Score& bestScore) const
+{
+    const SpriteBoundsRect* rectFound = nullptr;
+    for (const SpriteBoundsRect& freeRect : freeRects)
+    {
+        int32 restWidth = freeRect.spriteRect.dx - spriteSize.dx;
+        int32 restHeight = freeRect.spriteRect.dy - spriteSize.dy;
+        if (restWidth >= 0 && restHeight >= 0)
+        {
+            Score score = ScoreFreeRect(freeRect, restWidth, restHeight);
+            if (rectFound == nullptr || score < bestScore)
+            {
+                rectFound = &freeRect;
+                bestScore = score;
+            }
+        }
+    }
+    return rectFound;
+}
+
+const SpriteBoundsRect* MaxRectsSpritesheetLayout::InsertNewSpriteRect(const SpriteBoundsRect* foundFreeRect, const Size2i& spriteSize, bool rotated, const void* spritePtr)
 {
     SpriteBoundsRect boundsRect = *foundFreeRect;
+    boundsRect.rotated = rotated;
     int32 restWidth = boundsRect.spriteRect.dx - spriteSize.dx;
     int32 restHeight = boundsRect.spriteRect.dy - spriteSize.dy;
     boundsRect.spriteRect.dx = spriteSize.dx;
@@ -440,190 +482,97 @@ const SpriteBoundsRect* MaxRectsSpritesheetLayout::GetSpriteBoundsRect(const voi
 
 struct MaxRectsSpritesheetLayout_BL : public MaxRectsSpritesheetLayout
 {
-    MaxRectsSpritesheetLayout_BL(uint32 w, uint32 h, bool dup, int32 margin)
-        : MaxRectsSpritesheetLayout(w, h, dup, margin)
+    MaxRectsSpritesheetLayout_BL(uint32 w, uint32 h, bool dup, int32 margin, bool allowRotation)
+        : MaxRectsSpritesheetLayout(w, h, dup, margin, allowRotation)
     {
     }
 
 protected:
-    const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const override
+    Score ScoreFreeRect(const SpriteBoundsRect& freeRect, int32 restWidth, int32 restHeight) const override
     {
-        int32 bestY = 0;
-        int32 bestX = 0;
-        List<SpriteBoundsRect>::const_iterator rectFound = freeRects.cend();
-
-        for (List<SpriteBoundsRect>::const_iterator freeRect = freeRects.cbegin(); freeRect != freeRects.cend(); ++freeRect)
-        {
-            int32 restWidth = freeRect->spriteRect.dx - spriteSize.dx;
-            int32 restHeight = freeRect->spriteRect.dy - spriteSize.dy;
-            if (restWidth >= 0 && restHeight >= 0)
-            {
-                if (rectFound == freeRects.cend() || freeRect->marginsRect.y < bestY || (freeRect->marginsRect.y == bestY && freeRect->marginsRect.x < bestX))
-                {
-                    rectFound = freeRect;
-                    bestY = freeRect->marginsRect.y;
-                    bestX = freeRect->marginsRect.x;
-                }
-            }
-        }
-        return (rectFound == freeRects.cend() ? nullptr : &(*rectFound));
+        return Score(freeRect.marginsRect.y, freeRect.marginsRect.x);
     }
 };
 
 struct MaxRectsSpritesheetLayout_BAF : public MaxRectsSpritesheetLayout
 {
-    MaxRectsSpritesheetLayout_BAF(uint32 w, uint32 h, bool dup, int32 margin)
-        : MaxRectsSpritesheetLayout(w, h, dup, margin)
+    MaxRectsSpritesheetLayout_BAF(uint32 w, uint32 h, bool dup, int32 margin, bool allowRotation)
+        : MaxRectsSpritesheetLayout(w, h, dup, margin, allowRotation)
     {
     }
 
 protected:
-    const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const override
+    Score ScoreFreeRect(const SpriteBoundsRect& freeRect, int32 restWidth, int32 restHeight) const override
     {
-        int32 bestArea = 0;
-        int32 bestShortSide = 0;
-        List<SpriteBoundsRect>::const_iterator rectFound = freeRects.cend();
-
-        for (List<SpriteBoundsRect>::const_iterator freeRect = freeRects.cbegin(); freeRect != freeRects.cend(); ++freeRect)
-        {
-            int32 restWidth = freeRect->spriteRect.dx - spriteSize.dx;
-            int32 restHeight = freeRect->spriteRect.dy - spriteSize.dy;
-            if (restWidth >= 0 && restHeight >= 0)
-            {
-                int32 area = freeRect->spriteRect.dx * freeRect->spriteRect.dy;
-                int32 shortSide = Min(restWidth, restHeight);
-
-                if (rectFound == freeRects.cend() || area < bestArea || (area == bestArea && shortSide < bestShortSide))
-                {
-                    rectFound = freeRect;
-                    bestArea = area;
-                    bestShortSide = shortSide;
-                }
-            }
-        }
-        return (rectFound == freeRects.cend() ? nullptr : &(*rectFound));
+        return Score(freeRect.spriteRect.dx * freeRect.spriteRect.dy, Min(restWidth, restHeight));
     }
 };
 
 struct MaxRectsSpritesheetLayout_SSF : public MaxRectsSpritesheetLayout
 {
-    MaxRectsSpritesheetLayout_SSF(uint32 w, uint32 h, bool dup, int32 margin)
-        : MaxRectsSpritesheetLayout(w, h, dup, margin)
+    MaxRectsSpritesheetLayout_SSF(uint32 w, uint32 h, bool dup, int32 margin, bool allowRotation)
+        : MaxRectsSpritesheetLayout(w, h, dup, margin, allowRotation)
     {
     }
 
 protected:
-    const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const override
+    Score ScoreFreeRect(const SpriteBoundsRect& freeRect, int32 restWidth, int32 restHeight) const override
     {
-        int32 bestShortSide = 0;
-        List<SpriteBoundsRect>::const_iterator rectFound = freeRects.cend();
-
-        for (List<SpriteBoundsRect>::const_iterator freeRect = freeRects.cbegin(); freeRect != freeRects.cend(); ++freeRect)
-        {
-            int32 restWidth = freeRect->spriteRect.dx - spriteSize.dx;
-            int32 restHeight = freeRect->spriteRect.dy - spriteSize.dy;
-            if (restWidth >= 0 && restHeight >= 0)
-            {
-                int32 shortSide = Min(restWidth, restHeight);
-                if (rectFound == freeRects.cend() || shortSide < bestShortSide)
-                {
-                    rectFound = freeRect;
-                    bestShortSide = shortSide;
-                }
-            }
-        }
-        return (rectFound == freeRects.cend() ? nullptr : &(*rectFound));
+        return Score(Min(restWidth, restHeight), 0);
     }
 };
 
 struct MaxRectsSpritesheetLayout_LSF : public MaxRectsSpritesheetLayout
 {
-    MaxRectsSpritesheetLayout_LSF(uint32 w, uint32 h, bool dup, int32 margin)
-        : MaxRectsSpritesheetLayout(w, h, dup, margin)
+    MaxRectsSpritesheetLayout_LSF(uint32 w, uint32 h, bool dup, int32 margin, bool allowRotation)
+        : MaxRectsSpritesheetLayout(w, h, dup, margin, allowRotation)
     {
     }
 
 protected:
-    const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const override
+    Score ScoreFreeRect(const SpriteBoundsRect& freeRect, int32 restWidth, int32 restHeight) const override
     {
-        int32 bestLongSide = 0;
-        List<SpriteBoundsRect>::const_iterator rectFound = freeRects.cend();
-
-        for (List<SpriteBoundsRect>::const_iterator freeRect = freeRects.cbegin(); freeRect != freeRects.cend(); ++freeRect)
-        {
-            int32 restWidth = freeRect->spriteRect.dx - spriteSize.dx;
-            int32 restHeight = freeRect->spriteRect.dy - spriteSize.dy;
-            if (restWidth >= 0 && restHeight >= 0)
-            {
-                int32 longSide = Max(restWidth, restHeight);
-                if (rectFound == freeRects.cend() || longSide < bestLongSide)
-                {
-                    rectFound = freeRect;
-                    bestLongSide = longSide;
-                }
-            }
-        }
-        return (rectFound == freeRects.cend() ? nullptr : &(*rectFound));
+        return Score(Max(restWidth, restHeight), 0);
     }
 };
 
 struct MaxRectsSpritesheetLayout_CP : public MaxRectsSpritesheetLayout
 {
-    MaxRectsSpritesheetLayout_CP(uint32 w, uint32 h, bool dup, int32 margin)
-        : MaxRectsSpritesheetLayout(w, h, dup, margin)
+    MaxRectsSpritesheetLayout_CP(uint32 w, uint32 h, bool dup, int32 margin, bool allowRotation)
+        : MaxRectsSpritesheetLayout(w, h, dup, margin, allowRotation)
     {
     }
 
 protected:
-    const SpriteBoundsRect* FindBestFreeRect(const Size2i& spriteSize) const override
+    Score ScoreFreeRect(const SpriteBoundsRect& freeRect, int32 restWidth, int32 restHeight) const override
     {
-        int32 bestContactPoint = 0;
-        int32 bestShortSide = 0;
-        List<SpriteBoundsRect>::const_iterator rectFound = freeRects.cend();
-
-        for (List<SpriteBoundsRect>::const_iterator freeRect = freeRects.cbegin(); freeRect != freeRects.cend(); ++freeRect)
-        {
-            int32 restWidth = freeRect->spriteRect.dx - spriteSize.dx;
-            int32 restHeight = freeRect->spriteRect.dy - spriteSize.dy;
-            if (restWidth >= 0 && restHeight >= 0)
-            {
-                int32 contactPoint = freeRect->spriteRect.dx + freeRect->spriteRect.dy;
-                if (restWidth == 0)
-                    contactPoint += freeRect->spriteRect.dx;
-                if (restHeight == 0)
-                    contactPoint += freeRect->spriteRect.dy;
-                int32 shortSide = Min(restWidth, restHeight);
-
-                if (rectFound == freeRects.cend() || contactPoint < bestContactPoint || (contactPoint == bestContactPoint && shortSide < bestShortSide))
-                {
-                    rectFound = freeRect;
-                    bestContactPoint = contactPoint;
-                    bestShortSide = shortSide;
-                }
-            }
-        }
-        return (rectFound == freeRects.cend() ? nullptr : &(*rectFound));
+        int32 contactPoint = freeRect.spriteRect.dx + freeRect.spriteRect.dy;
+        if (restWidth == 0)
+            contactPoint += freeRect.spriteRect.dx;
+        if (restHeight == 0)
+            contactPoint += freeRect.spriteRect.dy;
+        return Score(contactPoint, Min(restWidth, restHeight));
     }
 };
 
 //////////////////////////////////////////////////////////////////////////
 
-std::unique_ptr<SpritesheetLayout> SpritesheetLayout::Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg)
+std::unique_ptr<SpritesheetLayout> SpritesheetLayout::Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg, bool allowRotation)
 {
     switch (alg)
     {
     case PackingAlgorithm::ALG_BASIC:
         return std::unique_ptr<SpritesheetLayout>(new BasicSpritesheetLayout(w, h, duplicateEdgePixel, spritesMargin));
     case PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT:
-        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_BL(w, h, duplicateEdgePixel, spritesMargin));
+        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_BL(w, h, duplicateEdgePixel, spritesMargin, allowRotation));
     case PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT:
-        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_BAF(w, h, duplicateEdgePixel, spritesMargin));
+        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_BAF(w, h, duplicateEdgePixel, spritesMargin, allowRotation));
     case PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT:
-        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_SSF(w, h, duplicateEdgePixel, spritesMargin));
+        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_SSF(w, h, duplicateEdgePixel, spritesMargin, allowRotation));
     case PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT:
-        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_LSF(w, h, duplicateEdgePixel, spritesMargin));
+        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_LSF(w, h, duplicateEdgePixel, spritesMargin, allowRotation));
     case PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT:
-        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_CP(w, h, duplicateEdgePixel, spritesMargin));
+        return std::unique_ptr<SpritesheetLayout>(new MaxRectsSpritesheetLayout_CP(w, h, duplicateEdgePixel, spritesMargin, allowRotation));
     default:
         DVASSERT(false, Format("Unknown algorithm id: %d", alg).c_str());
         return nullptr;
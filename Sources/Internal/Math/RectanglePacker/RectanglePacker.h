@@ -66,6 +66,8 @@ public:
     // set visible 1 pixel border for each texture
     void SetTwoSideMargin(bool val = true);
     void SetTexturesMargin(uint32 margin);
+    /** Allow maxrects algorithms to rotate sprites by 90 degrees, user should check SpriteBoundsRect::rotated of packed sprites */
+    void SetAllowRotation(bool value);
 
     /** Pack sprites from packTask and return PackResult with spritesheets data */
     std::unique_ptr<PackResult> Pack(PackTask& packTask) const;
@@ -80,6 +82,7 @@ private:
     bool onlySquareTextures = false;
     bool useTwoSideMargin = false;
     uint32 texturesMargin = 1;
+    bool allowRotation = false;
 };
 
 inline void RectanglePacker::SetUseOnlySquareTextures(bool value)
@@ -101,6 +104,11 @@ inline void RectanglePacker::SetTexturesMargin(uint32 margin)
     texturesMargin = margin;
 }
 
+inline void RectanglePacker::SetAllowRotation(bool value)
+{
+    allowRotation = value;
+}
+
 inline void RectanglePacker::SetAlgorithms(const Vector<PackingAlgorithm>& algorithms)
 {
     packAlgorithms = algorithms;
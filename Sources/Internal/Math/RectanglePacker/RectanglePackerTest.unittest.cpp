@@ -5,6 +5,8 @@
 #include "Concurrency/Thread.h"
 #include "Engine/EngineContext.h"
 #include "Job/JobManager.h"
+#include "Logger/Logger.h"
+#include "Math/RectanglePacker/Spritesheet.h"
 #include "Render/2D/Systems/DynamicAtlasSystem.h"
 #include "Render/Texture.h"
 #include "Render/TextureDescriptor.h"
@@ -16,8 +18,11 @@
 #include "UI/UIPackage.h"
 #include "UI/UIPackageLoader.h"
 #include "UI/UIScreen.h"
+#include "Time/SystemTimer.h"
 #include "Utils/StringUtils.h"
 
+#include <random>
+
 using namespace DAVA;
 
 DAVA_TESTCLASS (RectanglePackerTest)
@@ -136,4 +141,123 @@ DAVA_TESTCLASS (RectanglePackerTest)
         TEST_VERIFY(packResult->resultSheets.size() == 1);
         TEST_VERIFY(packResult->resultErrors.size() == 1);
     }
+
+    DAVA_TEST (RotationTest)
+    {
+        // sprites which fit as is are placed as is
+        Vector<Size2i> sizes = { Size2i(32, 64), Size2i(32, 64) };
+
+        std::unique_ptr<SpritesheetLayout> layout = SpritesheetLayout::Create(64, 64, false, 0, PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT, true);
+        for (const Size2i& size : sizes)
+        {
+            TEST_VERIFY(layout->AddSprite(size, &size));
+        }
+        TEST_VERIFY(VerifyLayout(layout.get(), sizes, true));
+
+        // sprites wider than the sheet are placed rotated, if rotation is allowed
+        sizes = { Size2i(64, 32), Size2i(64, 32) };
+        std::unique_ptr<SpritesheetLayout> rotatedLayout = SpritesheetLayout::Create(64, 32, false, 0, PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT, true);
+        TEST_VERIFY(rotatedLayout->AddSprite(sizes[0], &sizes[0]));
+        TEST_VERIFY(rotatedLayout->AddSprite(sizes[1], &sizes[1]) == false);
+
+        std::unique_ptr<SpritesheetLayout> tallLayout = SpritesheetLayout::Create(32, 128, false, 0, PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT, true);
+        for (const Size2i& size : sizes)
+        {
+            TEST_VERIFY(tallLayout->AddSprite(size, &size));
+            TEST_VERIFY(tallLayout->GetSpriteBoundsRect(&size)->rotated);
+        }
+        TEST_VERIFY(VerifyLayout(tallLayout.get(), sizes, true));
+
+        std::unique_ptr<SpritesheetLayout> noRotationLayout = SpritesheetLayout::Create(32, 128, false, 0, PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT, false);
+        TEST_VERIFY(noRotationLayout->AddSprite(sizes[0], &sizes[0]) == false);
+    }
+
+    DAVA_TEST (OccupancyBenchmarkTest)
+    {
+        // typical UI sprite set: many small icons, some panels and a few long stripes
+        std::mt19937 random(42);
+        Vector<Size2i> sizes(400);
+        for (Size2i& size : sizes)
+        {
+            uint32 kind = random() % 10;
+            if (kind < 7)
+            {
+                size = Size2i(8 + random() % 56, 8 + random() % 56);
+            }
+            else if (kind < 9)
+            {
+                size = Size2i(64 + random() % 128, 32 + random() % 96);
+            }
+            else
+            {
+                size = Size2i(128 + random() % 256, 4 + random() % 12);
+            }
+        }
+        std::stable_sort(sizes.begin(), sizes.end(), [](const Size2i& l, const Size2i& r) { return l.dx * l.dy > r.dx * r.dy; });
+
+        const PackingAlgorithm algorithms[] = {
+            PackingAlgorithm::ALG_BASIC,
+            PackingAlgorithm::ALG_MAXRECTS_BOTTOM_LEFT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRECTS_BEST_LONG_SIDE_FIT,
+            PackingAlgorithm::ALG_MAXRRECT_BEST_CONTACT_POINT
+        };
+
+        for (PackingAlgorithm alg : algorithms)
+        {
+            for (bool allowRotation : { false, true })
+            {
+                int64 startUs = SystemTimer::GetUs();
+                std::unique_ptr<SpritesheetLayout> layout = SpritesheetLayout::Create(2048, 2048, false, 1, alg, allowRotation);
+
+                int64 usedArea = 0;
+                int32 usedHeight = 0;
+                for (const Size2i& size : sizes)
+                {
+                    TEST_VERIFY(layout->AddSprite(size, &size));
+                    usedArea += size.dx * size.dy;
+                    const Rect2i& spriteRect = layout->GetSpriteBoundsRect(&size)->spriteRect;
+                    usedHeight = std::max(usedHeight, spriteRect.y + spriteRect.dy);
+                }
+                int64 timeUs = SystemTimer::GetUs() - startUs;
+
+                TEST_VERIFY(VerifyLayout(layout.get(), sizes, allowRotation));
+                Logger::Info("[RectanglePackerTest] algorithm %d, rotation %d: occupancy %.3f, %lld us",
+                             static_cast<int32>(alg), allowRotation, static_cast<float64>(usedArea) / (2048.0 * usedHeight), timeUs);
+            }
+        }
+    }
+
+    bool VerifyLayout(SpritesheetLayout * layout, const Vector<Size2i>& sizes, bool allowRotation)
+    {
+        Vector<Rect2i> rects;
+        for (const Size2i& size : sizes)
+        {
+            const SpriteBoundsRect* bounds = layout->GetSpriteBoundsRect(&size);
+            if (bounds == nullptr || (bounds->rotated && !allowRotation))
+            {
+                return false;
+            }
+
+            Size2i placedSize = bounds->rotated ? Size2i(size.dy, size.dx) : size;
+            if (bounds->spriteRect.dx != placedSize.dx || bounds->spriteRect.dy != placedSize.dy)
+            {
+                return false;
+            }
+            if (!layout->GetRect().RectInside(bounds->spriteRect))
+            {
+                return false;
+            }
+            for (const Rect2i& rect : rects)
+            {
+                if (rect.Intersection(bounds->spriteRect).dx > 0)
+                {
+                    return false;
+                }
+            }
+            rects.push_back(bounds->spriteRect);
+        }
+        return true;
+    }
 };
@@ -26,6 +26,7 @@ struct SpriteBoundsRect
     uint32 bottomEdgePixel = 0;
     uint32 rightMargin = 0;
     uint32 bottomMargin = 0;
+    bool rotated = false; // sprite is placed rotated by 90 degrees clockwise, so spriteRect has swapped width and height
 };
 
 struct SpritesheetLayout
@@ -36,7 +37,8 @@ struct SpritesheetLayout
     virtual const Rect2i& GetRect() const = 0;
     virtual uint32 GetWeight() const = 0;
 
-    static std::unique_ptr<SpritesheetLayout> Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg);
+    // rotation of sprites is supported only by maxrects algorithms
+    static std::unique_ptr<SpritesheetLayout> Create(uint32 w, uint32 h, bool duplicateEdgePixel, uint32 spritesMargin, PackingAlgorithm alg, bool allowRotation = false);
 };
 }
 
@@ -6,6 +6,7 @@
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
 #include <cassert>
+#include <cmath>
 
 #if defined(__DAVAENGINE_WIN32__)
 #pragma warning(push)
@@ -49,8 +50,8 @@ struct MemoryManager::MemoryBlock
     MemoryBlock* prev; // Pointer to previous block
     MemoryBlock* next; // Pointer to next block
     void* realBlockStart; // Pointer to real block start
-    void* padding1; // Padding to make sure that
-    uint32 padding2; //          struct size is integral multiple of 16 bytes
+    void* padding; // Padding to make sure that struct size is integral multiple of 16 bytes
+    uint32 shard; // Index of shard block is linked into
     uint32 orderNo; // Block order number
     uint32 allocByApp; // Size requested by application
     uint32 allocTotal; // Total allocated size
@@ -162,6 +163,18 @@ void MemoryManager::EnableLightWeightMode()
     lightWeightMode = true;
 }
 
+void MemoryManager::EnableSamplingMode(uint32 sampleBytes_)
+{
+    LockAllShards();
+    sampleBytes = sampleBytes_;
+    for (uint32 i = 0; i < SHARD_COUNT; ++i)
+    {
+        shards[i].randomState = 0;
+        shards[i].bytesUntilSample = 0;
+    }
+    UnlockAllShards();
+}
+
 void MemoryManager::SetCallbacks(Function<void()> updateCallback_, Function<void(uint32, bool)> tagCallback_)
 {
     updateCallback = updateCallback_;
@@ -227,18 +240,18 @@ DAVA_NOINLINE void* MemoryManager::Allocate(size_t size, uint32 poolIndex)
             }
         }
 
+        bool sampled = false;
         {
-            LockType lock(allocMutex);
+            Shard& shard = shards[GetCurrentShardIndex()];
+            LockType lock(shard.mutex);
+            block->shard = static_cast<uint32>(&shard - shards);
             block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
+            block->orderNo = nextBlockNo.fetch_add(1, std::memory_order_relaxed);
             InsertBlock(block);
+            UpdateStatAfterAlloc(block);
+            sampled = IsBlockSampled(shard, block->allocByApp);
         }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
+        if (sampled)
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
@@ -296,18 +309,18 @@ DAVA_NOINLINE void* MemoryManager::AlignedAllocate(size_t size, size_t align, ui
             }
         }
 
+        bool sampled = false;
         {
-            LockType lock(allocMutex);
+            Shard& shard = shards[GetCurrentShardIndex()];
+            LockType lock(shard.mutex);
+            block->shard = static_cast<uint32>(&shard - shards);
             block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
+            block->orderNo = nextBlockNo.fetch_add(1, std::memory_order_relaxed);
             InsertBlock(block);
+            UpdateStatAfterAlloc(block);
+            sampled = IsBlockSampled(shard, block->allocByApp);
         }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
+        if (sampled)
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
@@ -426,15 +439,11 @@ void MemoryManager::Deallocate(void* ptr)
         if (isAccessible && BLOCK_MARK == block->mark)
         {
             {
-                LockType lock(allocMutex);
+                LockType lock(shards[block->shard].mutex);
                 RemoveBlock(block);
+                UpdateStatAfterDealloc(block);
             }
-            {
-                uint32 systemMemoryUsage = GetSystemMemoryUsage();
-                LockType lock(statMutex);
-                UpdateStatAfterDealloc(block, systemMemoryUsage);
-            }
-            if (!lightWeightMode)
+            if (block->bktraceHash != 0)
             {
                 LockType lock(bktraceMutex);
                 RemoveBacktrace(block->bktraceHash);
@@ -547,8 +556,22 @@ uint32 MemoryManager::GetTrackedMemoryUsage(uint32 poolIndex) const
 {
     assert(ALLOC_POOL_TOTAL <= poolIndex && poolIndex < MAX_ALLOC_POOL_COUNT);
 
-    LockType lock(statMutex);
-    return statAllocPool[poolIndex].allocByApp;
+    if (ALLOC_POOL_SYSTEM == poolIndex)
+    {
+        return GetSystemMemoryUsage();
+    }
+
+    uint32 allocByApp = 0;
+    {
+        LockType lock(statMutex);
+        allocByApp = statAllocPool[poolIndex].allocByApp;
+    }
+    for (const Shard& shard : shards)
+    {
+        LockType lock(shard.mutex);
+        allocByApp += shard.statAllocPool[poolIndex].allocByApp;
+    }
+    return allocByApp;
 }
 
 uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
@@ -559,8 +582,13 @@ uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
 
     DVASSERT(index < MAX_TAG_COUNT);
 
-    LockType lock(statMutex);
-    return statTag[index].allocByApp;
+    uint32 allocByApp = 0;
+    for (const Shard& shard : shards)
+    {
+        LockType lock(shard.mutex);
+        allocByApp += shard.statTag[index].allocByApp;
+    }
+    return allocByApp;
 }
 
 void MemoryManager::EnterTagScope(uint32 tag)
@@ -568,11 +596,14 @@ void MemoryManager::EnterTagScope(uint32 tag)
     DVASSERT(tag != 0 && IsPowerOf2(tag));
     DVASSERT((statGeneral.activeTags & tag) == 0); // Tag shouldn't be set earlier
 
+    // Active tags are read by allocations under shard mutex
+    LockAllShards();
     {
-        LockType lock(allocMutex);
+        LockType lock(statMutex);
         statGeneral.activeTags |= tag;
         statGeneral.activeTagCount += 1;
     }
+    UnlockAllShards();
     if (tagCallback != nullptr)
     {
         tagCallback(tag, true);
@@ -584,11 +615,13 @@ void MemoryManager::LeaveTagScope(uint32 tag)
     DVASSERT(tag != 0 && IsPowerOf2(tag));
     DVASSERT((statGeneral.activeTags & tag) == tag); // Tag should be set earlier
 
+    LockAllShards();
     {
-        LockType lock(allocMutex);
+        LockType lock(statMutex);
         statGeneral.activeTags &= ~tag;
         statGeneral.activeTagCount -= 1;
     }
+    UnlockAllShards();
     if (tagCallback != nullptr)
     {
         tagCallback(tag, false);
@@ -661,8 +694,35 @@ void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
     gpuBlockMap->erase(iter);
 }
 
+uint32 MemoryManager::GetCurrentShardIndex() const
+{
+    // Thread ids are often aligned addresses, so mix bits before taking shard index
+    uint64 id = Thread::GetCurrentIdAsUInt64();
+    id ^= id >> 33;
+    id *= 0xFF51AFD7ED558CCDULL;
+    id ^= id >> 33;
+    return static_cast<uint32>(id % SHARD_COUNT);
+}
+
+void MemoryManager::LockAllShards() const
+{
+    for (const Shard& shard : shards)
+    {
+        shard.mutex.Lock();
+    }
+}
+
+void MemoryManager::UnlockAllShards() const
+{
+    for (const Shard& shard : shards)
+    {
+        shard.mutex.Unlock();
+    }
+}
+
 void MemoryManager::InsertBlock(MemoryBlock* block)
 {
+    MemoryBlock*& head = shards[block->shard].head;
     if (head != nullptr)
     {
         block->next = head;
@@ -680,6 +740,7 @@ void MemoryManager::InsertBlock(MemoryBlock* block)
 
 void MemoryManager::RemoveBlock(MemoryBlock* block)
 {
+    MemoryBlock*& head = shards[block->shard].head;
     if (block->prev != nullptr)
         block->prev->next = block->next;
     if (block->next != nullptr)
@@ -688,67 +749,97 @@ void MemoryManager::RemoveBlock(MemoryBlock* block)
         head = head->next;
 }
 
-void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage)
+bool MemoryManager::IsBlockSampled(Shard& shard, uint32 size)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+    if (lightWeightMode)
+        return false;
+    if (0 == sampleBytes)
+        return true;
+
+    // Allocated bytes are treated as Poisson process: distance between sampled bytes is exponentially distributed,
+    // and block is sampled if it contains sampled byte
+    if (size < shard.bytesUntilSample)
+    {
+        shard.bytesUntilSample -= size;
+        return false;
     }
+    shard.bytesUntilSample = NextSampleInterval(shard);
+    return true;
+}
+
+uint64 MemoryManager::NextSampleInterval(Shard& shard)
+{
+    if (0 == shard.randomState)
+    {
+        shard.randomState = 0x9E3779B97F4A7C15ULL * (&shard - shards + 1);
+    }
+
+    // xorshift64*
+    shard.randomState ^= shard.randomState >> 12;
+    shard.randomState ^= shard.randomState << 25;
+    shard.randomState ^= shard.randomState >> 27;
+    uint64 random = shard.randomState * 0x2545F4914F6CDD1DULL;
+
+    // Uniform value in (0, 1]
+    double u = (static_cast<double>(random >> 11) + 1.0) / 9007199254740992.0;
+    return static_cast<uint64>(-std::log(u) * sampleBytes) + 1;
+}
+
+void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block)
+{
+    Shard& shard = shards[block->shard];
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount += 1;
+        shard.statAllocPool[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
+        shard.statAllocPool[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
+        shard.statAllocPool[ALLOC_POOL_TOTAL].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize)
-            statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > shard.statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize)
+            shard.statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
     }
     { // Update pool statistics
         const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp += block->allocByApp;
-        statAllocPool[poolIndex].allocTotal += block->allocTotal;
-        statAllocPool[poolIndex].blockCount += 1;
+        shard.statAllocPool[poolIndex].allocByApp += block->allocByApp;
+        shard.statAllocPool[poolIndex].allocTotal += block->allocTotal;
+        shard.statAllocPool[poolIndex].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[poolIndex].maxBlockSize)
-            statAllocPool[poolIndex].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > shard.statAllocPool[poolIndex].maxBlockSize)
+            shard.statAllocPool[poolIndex].maxBlockSize = block->allocByApp;
     }
 
     { // Update tag statistics
-        uint32 tags = statGeneral.activeTags;
+        uint32 tags = block->tags;
         if (tags != 0)
         {
             for (size_t index = 0; tags != 0; ++index, tags >>= 1)
             {
                 if (tags & 0x01)
                 {
-                    statTag[index].allocByApp += block->allocByApp;
-                    statTag[index].blockCount += 1;
+                    shard.statTag[index].allocByApp += block->allocByApp;
+                    shard.statTag[index].blockCount += 1;
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp += block->allocByApp;
-            statTag[UNTAGGED].blockCount += 1;
+            shard.statTag[UNTAGGED].allocByApp += block->allocByApp;
+            shard.statTag[UNTAGGED].blockCount += 1;
         }
     }
 }
 
-void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
-    }
+    Shard& shard = shards[block->shard];
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount -= 1;
+        shard.statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
+        shard.statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
+        shard.statAllocPool[ALLOC_POOL_TOTAL].blockCount -= 1;
     }
     { // Update pool statistics
         const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp -= block->allocByApp;
-        statAllocPool[poolIndex].allocTotal -= block->allocTotal;
-        statAllocPool[poolIndex].blockCount -= 1;
+        shard.statAllocPool[poolIndex].allocByApp -= block->allocByApp;
+        shard.statAllocPool[poolIndex].allocTotal -= block->allocTotal;
+        shard.statAllocPool[poolIndex].blockCount -= 1;
     }
     { // Update tag statistics
         uint32 tags = block->tags;
@@ -758,19 +849,50 @@ void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemo
             {
                 if (tags & 0x01)
                 {
-                    statTag[index].allocByApp -= block->allocByApp;
-                    statTag[index].blockCount -= 1;
+                    shard.statTag[index].allocByApp -= block->allocByApp;
+                    shard.statTag[index].blockCount -= 1;
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp -= block->allocByApp;
-            statTag[UNTAGGED].blockCount -= 1;
+            shard.statTag[UNTAGGED].allocByApp -= block->allocByApp;
+            shard.statTag[UNTAGGED].blockCount -= 1;
         }
     }
 }
 
+void MemoryManager::MergeStat(AllocPoolStat* pools, TagAllocStat* tags) const
+{
+    {
+        LockType lock(statMutex);
+        std::copy(statAllocPool, statAllocPool + MAX_ALLOC_POOL_COUNT, pools);
+    }
+    std::fill(tags, tags + MAX_TAG_COUNT, TagAllocStat{});
+
+    for (const Shard& shard : shards)
+    {
+        LockType lock(shard.mutex);
+        for (uint32 i = 0; i < MAX_ALLOC_POOL_COUNT; ++i)
+        {
+            pools[i].allocByApp += shard.statAllocPool[i].allocByApp;
+            pools[i].allocTotal += shard.statAllocPool[i].allocTotal;
+            pools[i].blockCount += shard.statAllocPool[i].blockCount;
+            pools[i].maxBlockSize = std::max(pools[i].maxBlockSize, shard.statAllocPool[i].maxBlockSize);
+        }
+        for (uint32 i = 0; i < MAX_TAG_COUNT; ++i)
+        {
+            tags[i].allocByApp += shard.statTag[i].allocByApp;
+            tags[i].blockCount += shard.statTag[i].blockCount;
+        }
+    }
+
+    // Memory usage reported by system
+    const uint32 systemMemoryUsage = GetSystemMemoryUsage();
+    pools[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
+    pools[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+}
+
 void MemoryManager::UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr)
 {
     { // Update total statistics
@@ -942,26 +1064,31 @@ void MemoryManager::GetCurStat(uint64 timestamp, void* buffer, uint32 bufSize) c
     const uint32 requiredSize = CalcCurStatSize();
     DVASSERT(requiredSize <= bufSize);
 
-    LockType lockAlloc(allocMutex);
-    LockType lockStat(statMutex);
+    AllocPoolStat mergedAllocPool[MAX_ALLOC_POOL_COUNT];
+    TagAllocStat mergedTag[MAX_TAG_COUNT];
+    MergeStat(mergedAllocPool, mergedTag);
 
     MMCurStat* curStat = static_cast<MMCurStat*>(buffer);
     curStat->timestamp = timestamp;
     curStat->size = static_cast<uint32>(requiredSize);
-    curStat->statGeneral = statGeneral;
+    {
+        LockType lock(statMutex);
+        curStat->statGeneral = statGeneral;
+    }
+    curStat->statGeneral.nextBlockNo = nextBlockNo.load(std::memory_order_relaxed);
 
     AllocPoolStat* pools = OffsetPointer<AllocPoolStat>(curStat, sizeof(MMCurStat));
     for (uint32 i = 0; i < registeredAllocPoolCount; ++i)
     {
-        pools[i] = statAllocPool[i];
+        pools[i] = mergedAllocPool[i];
     }
 
     TagAllocStat* tags = OffsetPointer<TagAllocStat>(pools, sizeof(AllocPoolStat) * registeredAllocPoolCount);
     for (uint32 i = 0; i < registeredTagCount; ++i)
     {
-        tags[i] = statTag[i];
+        tags[i] = mergedTag[i];
     }
-    tags[registeredTagCount] = statTag[UNTAGGED];
+    tags[registeredTagCount] = mergedTag[UNTAGGED];
 }
 
 bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snapshotSize)
@@ -989,17 +1116,19 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
     snapshot.bktraceDepth = BACKTRACE_DEPTH;
 
     // Write empty header to force file internal buffer allocation to exclude
-    // memory allocations under allocMutex (primarily for Win32 release builds)
+    // memory allocations under shard mutex (primarily for Win32 release builds)
     if (file->Write(&snapshot) != sizeof(MMSnapshot))
         return false;
 
-    { // Store memory blocks into file
-        LockType lock(allocMutex);
+    // Store memory blocks into file, shards are locked one by one to not stop allocations on all threads
+    for (Shard& shard : shards)
+    {
+        LockType lock(shard.mutex);
 
         const uint32 BLOCKS_IN_BUF = BUF_SIZE / sizeof(MMBlock);
         MMBlock* destBegin = static_cast<MMBlock*>(buffer);
 
-        MemoryBlock* curBlock = head;
+        MemoryBlock* curBlock = shard.head;
         while (curBlock != nullptr)
         {
             uint32 k = 0;
@@ -5,6 +5,7 @@
 
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
+#include <atomic>
 #include <type_traits>
 
 #include "Functional/Function.h"
@@ -34,6 +35,7 @@ class MemoryManager final
     static const uint32 DEAD_BLOCK_MARK = 0xECECECEC;
     static const size_t BLOCK_ALIGN = 16;
     static const uint32 BACKTRACE_DEPTH = 32;
+    static const uint32 SHARD_COUNT = 16;
 
 public:
     static const uint32 MAX_ALLOC_POOL_COUNT = 32;
@@ -70,6 +72,12 @@ public:
     static void RegisterTagName(uint32 tagMask, const char8* name);
 
     void EnableLightWeightMode();
+    /*
+     Collect backtraces only for sampled memory blocks, on average one block per `sampleBytes` allocated bytes
+     (Poisson sampling, so a block is sampled with probability proportional to its size). Other blocks get zero
+     backtrace hash. Zero `sampleBytes` disables sampling mode.
+    */
+    void EnableSamplingMode(uint32 sampleBytes);
     void SetCallbacks(Function<void()> updateCallback, Function<void(uint32, bool)> tagCallback);
     void Update();
     void Finish();
@@ -121,11 +129,37 @@ private:
     friend void InternalDealloc(void* ptr);
 
 private:
+    using MutexType = Spinlock;
+    using LockType = LockGuard<MutexType>;
+
+    /*
+     Shard - part of tracked memory blocks and statistics of these blocks. Threads are spread over shards by theirs ids
+     to reduce contention, statistics of shards are merged on request. Memory block is always removed from the shard
+     it was inserted into even if it is deallocated on other thread.
+    */
+    struct alignas(64) Shard
+    {
+        mutable MutexType mutex; // Mutex for managing list of memory blocks and statistics of shard
+        MemoryBlock* head = nullptr; // Linked list of memory blocks
+        AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT] = {}; // Statistics by allocation pools
+        TagAllocStat statTag[MAX_TAG_COUNT] = {}; // Statistics by tags
+        uint64 bytesUntilSample = 0; // Bytes to allocate before next sampled memory block
+        uint64 randomState = 0; // State of random generator of sampling intervals
+    };
+
+    uint32 GetCurrentShardIndex() const;
+    void LockAllShards() const;
+    void UnlockAllShards() const;
+
     void InsertBlock(MemoryBlock* block);
     void RemoveBlock(MemoryBlock* block);
 
-    void UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage);
-    void UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage);
+    bool IsBlockSampled(Shard& shard, uint32 size);
+    uint64 NextSampleInterval(Shard& shard);
+
+    void UpdateStatAfterAlloc(MemoryBlock* block);
+    void UpdateStatAfterDealloc(MemoryBlock* block);
+    void MergeStat(AllocPoolStat* pools, TagAllocStat* tags) const;
 
     void UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr);
     void UpdateStatAfterGPUDealloc(MemoryBlock* block);
@@ -141,17 +175,13 @@ private:
     void SymbolCollectorThread();
 
 private:
-    MemoryBlock* head = nullptr; // Linked list of tracked memory blocks
+    Shard shards[SHARD_COUNT]; // Tracked memory blocks and theirs statistics
+    std::atomic<uint32> nextBlockNo{ 0 }; // Order number which will be assigned to next allocated memory block
 
     GeneralAllocStat statGeneral; // General statistics
-    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT]; // Statistics by allocation pools
-    TagAllocStat statTag[MAX_TAG_COUNT]; // Statistics by tags
-
-    using MutexType = Spinlock;
-    using LockType = LockGuard<MutexType>;
+    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT]; // Statistics of GPU allocation pools, other pools are kept by shards
 
-    mutable MutexType allocMutex; // Mutex for managing list of allocated memory blocks
-    mutable MutexType statMutex; // Mutex for updating memory statistics
+    mutable MutexType statMutex; // Mutex for updating general and GPU memory statistics
     mutable MutexType gpuMutex; // Mutex for managing GPU allocations
 
     using GpuBlockMap = std::unordered_map<uint64, MemoryBlock, std::hash<uint64>, std::equal_to<uint64>, InternalAllocator<std::pair<const uint64, MemoryBlock>>>;
@@ -172,6 +202,7 @@ private:
     Mutex symbolCollectorMutex;
     size_t bktraceGrowDelta = 0;
     bool lightWeightMode = false; // Flag enabling lightweight mode: no backtrace and symbols, should increase performance
+    uint32 sampleBytes = 0; // Average number of allocated bytes per sampled memory block, zero means every block is sampled
 
     Function<void()> updateCallback;
     Function<void(uint32, bool)> tagCallback;
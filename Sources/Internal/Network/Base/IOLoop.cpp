@@ -1,6 +1,5 @@
 #include "Functional/Function.h"
 #include "Debug/DVAssert.h"
-#include "Concurrency/LockGuard.h"
 
 #include "Network/Base/IOLoop.h"
 
@@ -31,6 +30,12 @@ IOLoop::IOLoop(bool useDefaultIOLoop)
 
 IOLoop::~IOLoop()
 {
+    // Handlers posted after loop has been finished are never executed
+    while (HandlerNode* node = PopHandler())
+    {
+        delete node;
+    }
+
 #if !defined(DAVA_NETWORK_DISABLE)
     // We can close default loop too
     const int closeResult = uv_loop_close(actualLoop);
@@ -56,11 +61,9 @@ int32 IOLoop::Run(eRunMode runMode)
 void IOLoop::Post(UserHandlerType handler)
 {
 #if !defined(DAVA_NETWORK_DISABLE)
-    {
-        LockGuard<Mutex> lock(mutex);
-        // TODO: maybe do not insert duplicates
-        queuedHandlers.push_back(handler);
-    }
+    HandlerNode* node = new HandlerNode;
+    node->handler = std::move(handler);
+    PushHandler(node);
     uv_async_send(&uvasync);
 #endif
 }
@@ -79,19 +82,26 @@ void IOLoop::PostQuit()
 void IOLoop::HandleAsync()
 {
 #if !defined(DAVA_NETWORK_DISABLE)
+    // Execute handlers queued before this pass, handlers posted by executing handlers are executed on the next pass.
+    // Handler which producer has not finished pushing yet is also executed on the next pass,
+    // as the producer calls uv_async_send after pushing
+    HandlerNode* last = queueHead.load(std::memory_order_acquire);
+    while (last != &stubNode)
     {
-        // Steal queued handlers for execution and release mutex
-        // Main reason to do so is to avoid deadlocks if executed
-        // handler will want to post another handler
-        LockGuard<Mutex> lock(mutex);
-        execHandlers.swap(queuedHandlers);
-    }
+        HandlerNode* node = PopHandler();
+        if (node == nullptr)
+        {
+            break;
+        }
 
-    for (Vector<UserHandlerType>::const_iterator i = execHandlers.begin(), e = execHandlers.end(); i != e; ++i)
-    {
-        (*i)();
+        bool isLast = (node == last);
+        node->handler();
+        delete node;
+        if (isLast)
+        {
+            break;
+        }
     }
-    execHandlers.clear();
 
     if (true == quitFlag)
     {
@@ -100,6 +110,52 @@ void IOLoop::HandleAsync()
 #endif
 }
 
+void IOLoop::PushHandler(HandlerNode* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    HandlerNode* prev = queueHead.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+IOLoop::HandlerNode* IOLoop::PopHandler()
+{
+    HandlerNode* tail = queueTail;
+    HandlerNode* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stubNode)
+    {
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        // Skip stub node
+        queueTail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr)
+    {
+        queueTail = next;
+        return tail;
+    }
+
+    if (tail != queueHead.load(std::memory_order_acquire))
+    {
+        // Producer has exchanged head but has not linked its node yet
+        return nullptr;
+    }
+
+    // Tail is the last node, push stub node behind it to detach tail from queue
+    PushHandler(&stubNode);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr)
+    {
+        queueTail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
 void IOLoop::HandleAsyncThunk(uv_async_t* handle)
 {
     IOLoop* self = static_cast<IOLoop*>(handle->data);
@@ -7,7 +7,8 @@
 
 #include "Functional/Function.h"
 #include "Base/Noncopyable.h"
-#include "Concurrency/Mutex.h"
+
+#include <atomic>
 
 namespace DAVA
 {
@@ -18,7 +19,8 @@ namespace Net
  There should be at least one IOLoop instance in network application.
  Run is a core method of IOLoop, and must be called from at most one thread.
  Post is a special method to shedule user specified handler to be run in context of thread where Run
- method is running.
+ method is running. Post is lock-free: handlers are pushed into intrusive multi-producer single-consumer
+ queue, so that threads posting handlers never wait for each other or for running handlers.
  To finish running IOLoop you should finish all network operations and call PostQuit method
 */
 class IOLoop : private Noncopyable
@@ -49,6 +51,15 @@ public:
     void PostQuit();
 
 private:
+    struct HandlerNode
+    {
+        std::atomic<HandlerNode*> next{ nullptr };
+        UserHandlerType handler;
+    };
+
+    void PushHandler(HandlerNode* node);
+    HandlerNode* PopHandler();
+
     void HandleAsync();
 
     static void HandleAsyncThunk(uv_async_t* handle);
@@ -61,9 +72,10 @@ private:
     bool quitFlag = false;
     uv_async_t uvasync; // libuv handle for calling callback from different threads
 #endif
-    Vector<UserHandlerType> queuedHandlers; // List of queued user handlers
-    Vector<UserHandlerType> execHandlers; // List of executing user handlers
-    Mutex mutex;
+    // Queue of posted handlers: producers push to head, IOLoop's thread pops from tail
+    HandlerNode stubNode;
+    std::atomic<HandlerNode*> queueHead{ &stubNode };
+    HandlerNode* queueTail = &stubNode;
 };
 
 } // namespace Net
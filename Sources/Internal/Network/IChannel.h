@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Base/BaseTypes.h"
+#include "Functional/Function.h"
 #include "Network/NetworkCommon.h"
+#include "Network/Base/Buffer.h"
 
 #include <memory>
 
@@ -40,6 +42,9 @@ struct IChannel
     virtual ~IChannel();
 
     virtual bool Send(const void* data, size_t length, uint32 flags, uint32* packetId) = 0;
+    // Send packet gathered from several buffers without copying them. Buffers should stay valid until onSent
+    // is called from network thread, if onSent is empty then OnPacketSent is called with the first buffer
+    virtual bool SendGathered(const Buffer* buffers, size_t bufferCount, uint32 flags, uint32* packetId, Function<void()> onSent) = 0;
     virtual const Endpoint& RemoteEndpoint() const = 0;
 };
 
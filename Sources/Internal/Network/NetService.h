@@ -42,6 +42,7 @@ public:
 
 protected:
     bool Send(const void* data, size_t length, uint32* packetId = NULL);
+    bool SendGathered(const Buffer* buffers, size_t bufferCount, Function<void()> onSent, uint32* packetId = NULL);
     template <typename T>
     bool Send(const T* value, uint32* packetId = NULL);
 
@@ -51,5 +51,13 @@ bool NetService::Send(const void* data, size_t length, uint32* packetId)
                              false;
 }
 
+bool NetService::SendGathered(const Buffer* buffers, size_t bufferCount, Function<void()> onSent, uint32* packetId)
+{
+    DVASSERT(buffers != NULL && bufferCount > 0 && true == IsChannelOpen());
+    return IsChannelOpen() ? channel->SendGathered(buffers, bufferCount, 0, packetId, std::move(onSent))
+                             :
+                             false;
+}
+
 } // namespace Net
 } // namespace DAVA
@@ -24,7 +24,6 @@ ProtoDriver::ProtoDriver(IOLoop* aLoop, eNetworkRole aRole, const ServiceRegistr
     , pendingPong(false)
 {
     DVASSERT(loop != NULL);
-    Memset(&curPacket, 0, sizeof(curPacket));
 }
 
 ProtoDriver::~ProtoDriver()
@@ -56,17 +55,33 @@ void ProtoDriver::SendData(uint32 channelId, const void* buffer, size_t length,
     if (outPacketId != NULL)
         *outPacketId = packet.packetId;
 
-    // This method may be invoked from different threads
-    if (true == senderLock.TryLock())
-    {
-        // TODO: consider optimization when called from IOLoop's thread
-        curPacket = packet;
-        loop->Post(MakeFunction(this, &ProtoDriver::SendCurPacket));
-    }
-    else
+    PostPacket(&packet);
+}
+
+void ProtoDriver::SendGatheredData(uint32 channelId, const Buffer* buffers, size_t bufferCount, Function<void()> onSent, uint32* outPacketId)
+{
+    DVASSERT(transport != NULL && buffers != NULL && bufferCount > 0);
+
+    Packet packet;
+    packet.gathered.reserve(bufferCount);
+    size_t length = 0;
+    for (size_t i = 0; i < bufferCount; ++i)
     {
-        EnqueuePacket(&packet);
+        // Transport does not accept empty buffers
+        if (buffers[i].len > 0)
+        {
+            packet.gathered.push_back(buffers[i]);
+            length += buffers[i].len;
+        }
     }
+    DVASSERT(length > 0);
+
+    PreparePacket(&packet, channelId, packet.gathered.front().base, length);
+    packet.onSent = std::move(onSent);
+    if (outPacketId != NULL)
+        *outPacketId = packet.packetId;
+
+    PostPacket(&packet);
 }
 
 void ProtoDriver::SendControl(uint32 code, uint32 channelId, uint32 packetId)
@@ -188,9 +203,16 @@ void ProtoDriver::OnSendComplete()
         curPacket.sentLength += curPacket.chunkLength;
         if (curPacket.sentLength == curPacket.dataLength)
         {
-            std::shared_ptr<Channel> ch = GetChannel(curPacket.channelId);
-            ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
-            curPacket.data = NULL;
+            Packet sentPacket = std::move(curPacket);
+            curPacket = Packet();
+            NotifyPacketSent(&sentPacket);
+        }
+
+        Vector<Packet> sentPackets;
+        sentPackets.swap(coalescedPackets);
+        for (Packet& packet : sentPackets)
+        {
+            NotifyPacketSent(&packet);
         }
     }
 
@@ -314,16 +336,17 @@ void ProtoDriver::ClearQueues()
 {
     if (curPacket.data != NULL)
     {
-        std::shared_ptr<Channel> ch = GetChannel(curPacket.channelId);
-        ch->service->OnPacketSent(ch, curPacket.data, curPacket.dataLength);
-
-        curPacket.data = NULL;
+        NotifyPacketSent(&curPacket);
+        curPacket = Packet();
+    }
+    for (Packet& packet : coalescedPackets)
+    {
+        NotifyPacketSent(&packet);
     }
+    coalescedPackets.clear();
     for (Deque<Packet>::iterator i = dataQueue.begin(), e = dataQueue.end(); i != e; ++i)
     {
-        Packet& packet = *i;
-        std::shared_ptr<Channel> ch = GetChannel(packet.channelId);
-        ch->service->OnPacketSent(ch, packet.data, packet.dataLength);
+        NotifyPacketSent(&*i);
     }
     dataQueue.clear();
     pendingAckQueue.clear();
@@ -336,14 +359,36 @@ void ProtoDriver::SendCurPacket()
     DVASSERT(curPacket.sentLength < curPacket.dataLength);
 
     whatIsSending = SENDING_DATA_FRAME;
-    curPacket.chunkLength = proto.EncodeDataFrame(&header, curPacket.channelId, curPacket.packetId, curPacket.dataLength, curPacket.sentLength);
+    size_t bufferCount = AppendDataFrame(&curPacket, &headers[0], sendBuffers.data(), MAX_SEND_BUFFERS);
+
+    // When current packet is finished by this frame, small packets of the same channel
+    // waiting in queue are sent in the same transport operation
+    DVASSERT(coalescedPackets.empty());
+    if (curPacket.sentLength + curPacket.chunkLength == curPacket.dataLength)
+    {
+        size_t coalescedSize = curPacket.chunkLength;
+        Packet packet;
+        while (coalescedPackets.size() + 1 < headers.size() && coalescedSize < MAX_COALESCED_SIZE &&
+               true == DequeueCoalescedPacket(&packet, curPacket.channelId, MAX_COALESCED_SIZE - coalescedSize, MAX_SEND_BUFFERS - bufferCount))
+        {
+            coalescedPackets.push_back(std::move(packet));
+            Packet& coalesced = coalescedPackets.back();
+            bufferCount += AppendDataFrame(&coalesced, &headers[coalescedPackets.size()], sendBuffers.data() + bufferCount, MAX_SEND_BUFFERS - bufferCount);
+            DVASSERT(coalesced.chunkLength == coalesced.dataLength);
+            coalescedSize += coalesced.dataLength;
+        }
+    }
 
-    Buffer buffers[2];
-    buffers[0] = CreateBuffer(&header);
-    buffers[1] = CreateBuffer(curPacket.data + curPacket.sentLength, curPacket.chunkLength);
-    if (0 == transport->Send(buffers, 2) && 0 == curPacket.sentLength)
+    if (0 == transport->Send(sendBuffers.data(), bufferCount))
     {
-        pendingAckQueue.push_back(curPacket.packetId);
+        if (0 == curPacket.sentLength)
+        {
+            pendingAckQueue.push_back(curPacket.packetId);
+        }
+        for (const Packet& packet : coalescedPackets)
+        {
+            pendingAckQueue.push_back(packet.packetId);
+        }
     }
 }
 
@@ -369,13 +414,84 @@ void ProtoDriver::PreparePacket(Packet* packet, uint32 channelId, const void* bu
     packet->data = static_cast<uint8*>(const_cast<void*>(buffer));
 }
 
+void ProtoDriver::PostPacket(Packet* packet)
+{
+    // This method may be invoked from different threads
+    if (true == senderLock.TryLock())
+    {
+        curPacket = std::move(*packet);
+        loop->Post(MakeFunction(this, &ProtoDriver::SendCurPacket));
+    }
+    else
+    {
+        EnqueuePacket(packet);
+    }
+}
+
+size_t ProtoDriver::AppendDataFrame(Packet* packet, ProtoHeader* frameHeader, Buffer* buffers, size_t maxBuffers)
+{
+    DVASSERT(maxBuffers >= 2);
+
+    packet->chunkLength = proto.EncodeDataFrame(frameHeader, packet->channelId, packet->packetId, packet->dataLength, packet->sentLength);
+    buffers[0] = CreateBuffer(frameHeader);
+    if (packet->gathered.empty())
+    {
+        buffers[1] = CreateBuffer(packet->data + packet->sentLength, packet->chunkLength);
+        return 2;
+    }
+
+    // Refer to parts of gathered buffers that fall into frame, skipping data sent with previous frames
+    size_t bufferCount = 1;
+    size_t frameLength = 0;
+    size_t skipLength = packet->sentLength;
+    for (const Buffer& buffer : packet->gathered)
+    {
+        size_t bufferLength = static_cast<size_t>(buffer.len);
+        if (skipLength >= bufferLength)
+        {
+            skipLength -= bufferLength;
+            continue;
+        }
+        if (bufferCount == maxBuffers || frameLength == packet->chunkLength)
+        {
+            break;
+        }
+
+        size_t length = Min(bufferLength - skipLength, packet->chunkLength - frameLength);
+        buffers[bufferCount++] = CreateBuffer(buffer.base + skipLength, length);
+        frameLength += length;
+        skipLength = 0;
+    }
+
+    if (frameLength < packet->chunkLength)
+    {
+        // Frame is shortened as there is no room for all its buffers, the rest is sent with next frame
+        packet->chunkLength = frameLength;
+        frameHeader->frameSize = static_cast<uint16>(sizeof(ProtoHeader) + frameLength);
+    }
+    return bufferCount;
+}
+
+void ProtoDriver::NotifyPacketSent(Packet* packet)
+{
+    if (packet->onSent)
+    {
+        packet->onSent();
+    }
+    else
+    {
+        std::shared_ptr<Channel> ch = GetChannel(packet->channelId);
+        ch->service->OnPacketSent(ch, packet->data, packet->dataLength);
+    }
+}
+
 bool ProtoDriver::EnqueuePacket(Packet* packet)
 {
     bool queueWasEmpty = false;
 
     LockGuard<Mutex> lock(queueMutex);
     queueWasEmpty = dataQueue.empty();
-    dataQueue.push_back(*packet);
+    dataQueue.push_back(std::move(*packet));
     return queueWasEmpty;
 }
 
@@ -384,13 +500,31 @@ bool ProtoDriver::DequeuePacket(Packet* dest)
     LockGuard<Mutex> lock(queueMutex);
     if (false == dataQueue.empty())
     {
-        *dest = dataQueue.front();
+        *dest = std::move(dataQueue.front());
         dataQueue.pop_front();
         return true;
     }
     return false;
 }
 
+bool ProtoDriver::DequeueCoalescedPacket(Packet* dest, uint32 channelId, size_t maxLength, size_t maxBuffers)
+{
+    LockGuard<Mutex> lock(queueMutex);
+    if (false == dataQueue.empty())
+    {
+        // Only packets at the front of queue are taken to keep order of packets and their delivery notifications
+        Packet& packet = dataQueue.front();
+        size_t bufferCount = 1 + Max<size_t>(packet.gathered.size(), 1);
+        if (packet.channelId == channelId && packet.dataLength <= maxLength && bufferCount <= maxBuffers)
+        {
+            *dest = std::move(packet);
+            dataQueue.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
 bool ProtoDriver::DequeueControl(ProtoHeader* dest)
 {
     // No need for mutex locking as control packets are always dequeued from handler
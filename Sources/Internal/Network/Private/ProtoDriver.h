@@ -22,14 +22,21 @@ class ServiceRegistrar;
 class ProtoDriver
 {
 private:
+    // Max number of buffers sent in one transport operation
+    static const size_t MAX_SEND_BUFFERS = 16;
+    // Packets of the same channel up to this size are coalesced into one transport operation
+    static const size_t MAX_COALESCED_SIZE = 16 * 1024;
+
     struct Packet
     {
-        uint32 channelId;
-        uint32 packetId;
-        uint8* data = nullptr; // Data
-        size_t dataLength; //  and its length
-        size_t sentLength; // Number of bytes that have been already transfered
-        size_t chunkLength; // Number of bytes transfered during last operation
+        uint32 channelId = 0;
+        uint32 packetId = 0;
+        uint8* data = nullptr; // Data or the first of gathered buffers
+        size_t dataLength = 0; //  and total length of data
+        size_t sentLength = 0; // Number of bytes that have been already transfered
+        size_t chunkLength = 0; // Number of bytes transfered during last operation
+        Vector<Buffer> gathered; // Caller-owned buffers of gathered packet
+        Function<void()> onSent; // Called instead of IChannelListener::OnPacketSent if set
     };
 
     struct Channel : public IChannel
@@ -38,6 +45,7 @@ private:
         ~Channel() override;
 
         bool Send(const void* data, size_t length, uint32 flags, uint32* packetId) override;
+        bool SendGathered(const Buffer* buffers, size_t bufferCount, uint32 flags, uint32* packetId, Function<void()> onSent) override;
         const Endpoint& RemoteEndpoint() const override;
 
         bool confirmed; // Channel is confirmed by other side
@@ -59,6 +67,7 @@ public:
 
     void SetTransport(IClientTransport* aTransport, const uint32* sourceChannels, size_t channelCount);
     void SendData(uint32 channelId, const void* buffer, size_t length, uint32* outPacketId);
+    void SendGatheredData(uint32 channelId, const Buffer* buffers, size_t bufferCount, Function<void()> onSent, uint32* outPacketId);
 
     void ReleaseServices();
 
@@ -84,8 +93,12 @@ private:
     void SendCurControl();
 
     void PreparePacket(Packet* packet, uint32 channelId, const void* buffer, size_t length);
+    void PostPacket(Packet* packet);
+    size_t AppendDataFrame(Packet* packet, ProtoHeader* frameHeader, Buffer* buffers, size_t maxBuffers);
+    void NotifyPacketSent(Packet* packet);
     bool EnqueuePacket(Packet* packet);
     bool DequeuePacket(Packet* dest);
+    bool DequeueCoalescedPacket(Packet* dest, uint32 channelId, size_t maxLength, size_t maxBuffers);
     bool DequeueControl(ProtoHeader* dest);
 
 private:
@@ -102,6 +115,7 @@ private:
     bool pendingPong;
 
     Packet curPacket;
+    Vector<Packet> coalescedPackets; // Small packets sent in the same transport operation after curPacket
     Deque<Packet> dataQueue;
     Deque<uint32> pendingAckQueue;
 
@@ -109,7 +123,8 @@ private:
     Deque<ProtoHeader> controlQueue;
 
     ProtoDecoder proto;
-    ProtoHeader header;
+    Array<ProtoHeader, MAX_SEND_BUFFERS / 2> headers; // Headers of frames sent in current transport operation
+    Array<Buffer, MAX_SEND_BUFFERS> sendBuffers;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -130,6 +145,15 @@ inline bool ProtoDriver::Channel::Send(const void* data, size_t length, uint32 f
     return true;
 }
 
+inline bool ProtoDriver::Channel::SendGathered(const Buffer* buffers, size_t bufferCount, uint32 flags, uint32* outPacketId, Function<void()> onSent)
+{
+    if (driver != nullptr)
+    {
+        driver->SendGatheredData(channelId, buffers, bufferCount, std::move(onSent), outPacketId);
+    }
+    return true;
+}
+
 inline const Endpoint& ProtoDriver::Channel::RemoteEndpoint() const
 {
     return remoteEndpoint;
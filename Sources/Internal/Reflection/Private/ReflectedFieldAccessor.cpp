@@ -0,0 +1,208 @@
+#include "Reflection/ReflectedFieldAccessor.h"
+#include "Reflection/ReflectedTypeDB.h"
+#include "Reflection/ReflectedType.h"
+#include "Base/TypeInheritance.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
+#include "Utils/Utils.h"
+
+namespace DAVA
+{
+namespace ReflectedFieldAccessorDetail
+{
+struct AccessorsRegistry
+{
+    Mutex mutex;
+    UnorderedMap<const ReflectedType*, UnorderedMap<FastName, std::unique_ptr<ReflectedFieldAccessor>>> accessors;
+};
+
+AccessorsRegistry& GetRegistry()
+{
+    static AccessorsRegistry registry;
+    return registry;
+}
+} // namespace ReflectedFieldAccessorDetail
+
+ReflectedFieldAccessor::ReflectedFieldAccessor(const ReflectedType* reflectedType_, const FastName& fieldPath_)
+    : reflectedType(reflectedType_)
+    , fieldPath(fieldPath_)
+{
+    DVASSERT(nullptr != reflectedType);
+    DVASSERT(fieldPath.IsValid());
+
+    Vector<String> names;
+    Split(fieldPath.c_str(), ".", names);
+
+    const ReflectedType* ownerType = reflectedType;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const ReflectedStructure::Field* field = (nullptr != ownerType) ? FindField(ownerType, FastName(names[i])) : nullptr;
+        if (nullptr == field)
+        {
+            path.clear();
+            return;
+        }
+        path.push_back(field);
+
+        if (i + 1 < names.size())
+        {
+            // only nested value types can be traversed, type of class fields doesn't depend on object
+            const Type* fieldType = field->valueWrapper->GetType(ReflectedObject());
+            ownerType = (nullptr != fieldType && !fieldType->IsPointer()) ? ReflectedTypeDB::GetByType(fieldType->Decay()) : nullptr;
+        }
+    }
+}
+
+const ReflectedFieldAccessor* ReflectedFieldAccessor::Get(const ReflectedType* reflectedType, const FastName& fieldPath)
+{
+    using namespace ReflectedFieldAccessorDetail;
+
+    AccessorsRegistry& registry = GetRegistry();
+    LockGuard<Mutex> lock(registry.mutex);
+
+    std::unique_ptr<ReflectedFieldAccessor>& accessor = registry.accessors[reflectedType][fieldPath];
+    if (!accessor)
+    {
+        accessor.reset(new ReflectedFieldAccessor(reflectedType, fieldPath));
+    }
+    return accessor.get();
+}
+
+bool ReflectedFieldAccessor::IsReadonly(const ReflectedObject& object) const
+{
+    DVASSERT(IsValid());
+    return path.back()->valueWrapper->IsReadonly(GetOwner(object));
+}
+
+const Type* ReflectedFieldAccessor::GetValueType(const ReflectedObject& object) const
+{
+    DVASSERT(IsValid());
+    return path.back()->valueWrapper->GetType(GetOwner(object));
+}
+
+Any ReflectedFieldAccessor::GetValue(const ReflectedObject& object) const
+{
+    DVASSERT(IsValid());
+    return path.back()->valueWrapper->GetValue(GetOwner(object));
+}
+
+bool ReflectedFieldAccessor::SetValue(const ReflectedObject& object, const Any& value) const
+{
+    DVASSERT(IsValid());
+
+    ReflectedObject owner = GetOwner(object);
+    const ValueWrapper* vw = path.back()->valueWrapper.get();
+    if (vw->IsReadonly(owner))
+    {
+        return false;
+    }
+    return vw->SetValue(owner, value);
+}
+
+bool ReflectedFieldAccessor::SetValueWithCast(const ReflectedObject& object, const Any& value) const
+{
+    DVASSERT(IsValid());
+
+    ReflectedObject owner = GetOwner(object);
+    const ValueWrapper* vw = path.back()->valueWrapper.get();
+    if (vw->IsReadonly(owner))
+    {
+        return false;
+    }
+    return vw->SetValueWithCast(owner, value);
+}
+
+Reflection ReflectedFieldAccessor::GetReflection(const ReflectedObject& object) const
+{
+    if (!IsValid())
+    {
+        return Reflection();
+    }
+
+    const ReflectedStructure::Field* field = path.back();
+    return Reflection(GetOwner(object), field->valueWrapper.get(), nullptr, field->meta.get());
+}
+
+ReflectedObject ReflectedFieldAccessor::GetOwner(const ReflectedObject& object) const
+{
+    ReflectedObject owner = object;
+    for (size_t i = 0, count = path.size() - 1; i < count; ++i)
+    {
+        owner = path[i]->valueWrapper->GetValueObject(owner);
+    }
+    return owner;
+}
+
+void* ReflectedFieldAccessor::GetDirectPtr(const ReflectedObject& object) const
+{
+    if (!IsValid() || object.GetReflectedType() != reflectedType)
+    {
+        return nullptr;
+    }
+
+    std::call_once(offsetResolved, [this, &object]() { ResolveOffset(object); });
+
+    if (isDirect)
+    {
+        return static_cast<uint8*>(object.GetVoidPtr()) + offset;
+    }
+    return nullptr;
+}
+
+void ReflectedFieldAccessor::ResolveOffset(const ReflectedObject& object) const
+{
+    // called for non-const objects only, so read-only field means const member on the path
+    ReflectedObject owner = object;
+    void* fieldPtr = nullptr;
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        fieldPtr = path[i]->valueWrapper->GetValuePtr(owner);
+        if (nullptr == fieldPtr || i + 1 == path.size())
+        {
+            break;
+        }
+        owner = path[i]->valueWrapper->GetValueObject(owner);
+    }
+
+    if (nullptr != fieldPtr && !path.back()->valueWrapper->IsReadonly(owner))
+    {
+        offset = static_cast<uint8*>(fieldPtr) - static_cast<uint8*>(object.GetVoidPtr());
+        directValueType = path.back()->valueWrapper->GetType(owner);
+        isDirect = true;
+    }
+}
+
+const ReflectedStructure::Field* ReflectedFieldAccessor::FindField(const ReflectedType* type, const FastName& name)
+{
+    const ReflectedStructure* structure = type->GetStructure();
+    if (nullptr != structure)
+    {
+        for (const std::unique_ptr<ReflectedStructure::Field>& field : structure->fields)
+        {
+            if (field->name == name)
+            {
+                return field.get();
+            }
+        }
+    }
+
+    const TypeInheritance* inheritance = type->GetType()->GetInheritance();
+    if (nullptr != inheritance)
+    {
+        for (const TypeInheritance::Info& baseInfo : inheritance->GetBaseTypes())
+        {
+            const ReflectedType* baseType = ReflectedTypeDB::GetByType(baseInfo.type);
+            if (nullptr != baseType)
+            {
+                const ReflectedStructure::Field* field = FindField(baseType, name);
+                if (nullptr != field)
+                {
+                    return field;
+                }
+            }
+        }
+    }
+
+    return nullptr;
+}
+} // namespace DAVA
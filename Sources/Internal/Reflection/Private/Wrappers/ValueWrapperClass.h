@@ -53,6 +53,12 @@ public:
         return ReflectedObject(ptr);
     }
 
+    inline void* GetValuePtr(const ReflectedObject& object) const override
+    {
+        C* cls = object.GetPtr<C>();
+        return const_cast<typename std::remove_const<T>::type*>(&(cls->*field));
+    }
+
 protected:
     T C::*field;
 };
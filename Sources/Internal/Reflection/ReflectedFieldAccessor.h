@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "Reflection/Reflection.h"
+#include "Reflection/ReflectedStructure.h"
+
+#include <mutex>
+
+namespace DAVA
+{
+/**
+    \ingroup reflection
+    Precompiled access path to the field of reflected type.
+
+    Accessor resolves field names once on creation, so following get/set operations
+    go directly through field value wrappers without looking up fields by name and
+    without building intermediate Reflection objects. Fields that are plain class
+    members are accessed through cached byte offset and typed `GetValuePtr`/`SetValueDirect`
+    work without boxing values into Any at all.
+
+    Accessors are created once per (ReflectedType, field path) and live forever:
+    \code
+    const ReflectedFieldAccessor* accessor = ReflectedFieldAccessor::Get(ReflectedTypeDB::Get<UIControl>(), FastName("position"));
+    accessor->SetValueDirect(ReflectedObject(control), Vector2(10.f, 10.f));
+    \endcode
+
+    Field path can contain several names separated by dots, e.g. "size.x".
+*/
+class ReflectedFieldAccessor final
+{
+public:
+    ReflectedFieldAccessor(const ReflectedType* reflectedType, const FastName& fieldPath);
+    ReflectedFieldAccessor(const ReflectedFieldAccessor&) = delete;
+
+    /** Get shared accessor for `fieldPath` of `reflectedType`, created on first request. Thread safe. */
+    static const ReflectedFieldAccessor* Get(const ReflectedType* reflectedType, const FastName& fieldPath);
+
+    bool IsValid() const;
+    const ReflectedType* GetReflectedType() const;
+    const FastName& GetFieldPath() const;
+    const ReflectedStructure::Field* GetField() const;
+
+    bool IsReadonly(const ReflectedObject& object) const;
+    const Type* GetValueType(const ReflectedObject& object) const;
+
+    Any GetValue(const ReflectedObject& object) const;
+    bool SetValue(const ReflectedObject& object, const Any& value) const;
+    bool SetValueWithCast(const ReflectedObject& object, const Any& value) const;
+
+    /** Pointer to field value inside `object` or nullptr if field is not a plain writable class member of type `T` */
+    template <typename T>
+    T* GetValuePtr(const ReflectedObject& object) const;
+
+    /** Write `value` directly by cached offset, falls back to value wrapper for accessor-based and read-only fields */
+    template <typename T>
+    bool SetValueDirect(const ReflectedObject& object, const T& value) const;
+
+    /** Build full Reflection of the field for code that needs it (e.g. property animations) */
+    Reflection GetReflection(const ReflectedObject& object) const;
+
+private:
+    ReflectedObject GetOwner(const ReflectedObject& object) const;
+    void* GetDirectPtr(const ReflectedObject& object) const;
+    void ResolveOffset(const ReflectedObject& object) const;
+
+    static const ReflectedStructure::Field* FindField(const ReflectedType* reflectedType, const FastName& name);
+
+    const ReflectedType* reflectedType = nullptr;
+    FastName fieldPath;
+    Vector<const ReflectedStructure::Field*> path;
+
+    // resolved once on first access to the object of `reflectedType`, offsets are the same for all its instances.
+    // Read-only fields are never direct, so they are written only through value wrapper, which rejects them.
+    // Accessors are shared between threads, so fields below are written only under `offsetResolved`
+    mutable std::once_flag offsetResolved;
+    mutable bool isDirect = false;
+    mutable std::ptrdiff_t offset = 0;
+    mutable const Type* directValueType = nullptr;
+};
+
+inline bool ReflectedFieldAccessor::IsValid() const
+{
+    return !path.empty();
+}
+
+inline const ReflectedType* ReflectedFieldAccessor::GetReflectedType() const
+{
+    return reflectedType;
+}
+
+inline const FastName& ReflectedFieldAccessor::GetFieldPath() const
+{
+    return fieldPath;
+}
+
+inline const ReflectedStructure::Field* ReflectedFieldAccessor::GetField() const
+{
+    return path.empty() ? nullptr : path.back();
+}
+
+template <typename T>
+inline T* ReflectedFieldAccessor::GetValuePtr(const ReflectedObject& object) const
+{
+    void* ptr = object.IsConst() ? nullptr : GetDirectPtr(object);
+    if (nullptr != ptr && directValueType == Type::Instance<T>())
+    {
+        return static_cast<T*>(ptr);
+    }
+    return nullptr;
+}
+
+template <typename T>
+inline bool ReflectedFieldAccessor::SetValueDirect(const ReflectedObject& object, const T& value) const
+{
+    T* ptr = GetValuePtr<T>(object);
+    if (nullptr != ptr)
+    {
+        *ptr = value;
+        return true;
+    }
+
+    return SetValue(object, Any(value));
+}
+} // namespace DAVA
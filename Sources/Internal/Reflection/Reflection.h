@@ -240,6 +240,12 @@ public:
     virtual bool SetValueWithCast(const ReflectedObject& object, const Any& value) const = 0;
 
     virtual ReflectedObject GetValueObject(const ReflectedObject& object) const = 0;
+
+    /** Pointer to value storage inside `object` if value is a plain class member, otherwise nullptr */
+    virtual void* GetValuePtr(const ReflectedObject& object) const
+    {
+        return nullptr;
+    }
 };
 
 class EnumWrapper
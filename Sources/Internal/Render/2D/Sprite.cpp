@@ -1,4 +1,5 @@
 #include "Render/2D/Sprite.h"
+#include "Concurrency/Thread.h"
 #include "Debug/DVAssert.h"
 #include "Engine/Engine.h"
 #include "FileSystem/File.h"
@@ -6,6 +7,7 @@
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/LocalizationSystem.h"
 #include "FileSystem/UnmanagedMemoryFile.h"
+#include "Job/JobManager.h"
 #include "Render/2D/Systems/RenderSystem2D.h"
 #include "Render/2D/Systems/DynamicAtlasSystem.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
@@ -34,6 +36,41 @@ SpriteMap spriteMap;
 
 static int32 fboCounter = 0;
 
+namespace SpriteDetail
+{
+const uint32 MAX_ASYNC_LOAD_JOBS = 8;
+
+// main thread only
+uint32 asyncLoadJobsCount = 0;
+Deque<Function<void()>> pendingAsyncLoadJobs;
+
+void RunAsyncLoadJob(const Function<void()>& job)
+{
+    if (asyncLoadJobsCount < MAX_ASYNC_LOAD_JOBS)
+    {
+        ++asyncLoadJobsCount;
+        GetEngineContext()->jobManager->CreateWorkerJob(job);
+    }
+    else
+    {
+        pendingAsyncLoadJobs.push_back(job);
+    }
+}
+
+void OnAsyncLoadJobFinished()
+{
+    DVASSERT(asyncLoadJobsCount > 0);
+    --asyncLoadJobsCount;
+
+    if (!pendingAsyncLoadJobs.empty())
+    {
+        Function<void()> job = std::move(pendingAsyncLoadJobs.front());
+        pendingAsyncLoadJobs.pop_front();
+        RunAsyncLoadJob(job);
+    }
+}
+}
+
 Mutex Sprite::spriteMapMutex;
 
 SpriteDrawState::SpriteDrawState()
@@ -80,6 +117,11 @@ Sprite* Sprite::PureCreate(const FilePath& spriteName, Sprite* forPointer)
     Sprite* cachedSprite = GetSpriteFromMap(spriteName);
     if (cachedSprite)
     {
+        if (cachedSprite->IsLoading())
+        {
+            // Synchronous request can't return placeholder, result of asynchronous loading will be dropped
+            cachedSprite->CompleteLoad();
+        }
         return cachedSprite;
     }
 
@@ -184,16 +226,51 @@ File* Sprite::LoadLocalizedFile(const FilePath& spritePathname, FilePath& textur
     return fp;
 }
 
+struct Sprite::FileCandidate
+{
+    FilePath path;
+    int32 resourceSizeIndex = 0;
+};
+
+struct Sprite::FileData
+{
+    Vector<FilePath> textureNames;
+    int32 width = 0;
+    int32 height = 0;
+    Vector<Array<int32, 6>> frameRects;
+    Vector<int32> frameTextureIndices;
+    Vector<FastName> frameNames;
+};
+
+struct Sprite::AsyncLoadData
+{
+    Vector<FileCandidate> fileCandidates;
+    bool loaded = false;
+    int32 resourceSizeIndex = 0;
+    FileData fileData;
+
+    // decoded images of textures which weren't created yet, descriptor is nullptr for others
+    Vector<TextureDescriptor*> textureDescriptors;
+    Vector<eGPUFamily> textureGPUs;
+    Vector<Vector<Image*>> textureImages;
+};
+
 void Sprite::InitFromFile(File* file)
 {
-    type = SPRITE_FROM_FILE;
+    FileData data;
+    ReadFileData(file, data);
+    InitFromFileData(data, nullptr);
+}
+
+void Sprite::ReadFileData(File* file, FileData& data)
+{
     const FilePath& pathName = file->GetFilename();
 
     char tempBuf[1024];
+    int32 textureCount = 0;
     file->ReadLine(tempBuf, 1024);
     sscanf(tempBuf, "%d", &textureCount);
-    textures = new Texture*[textureCount];
-    textureNames = new FilePath[textureCount];
+    data.textureNames.resize(textureCount);
 
     char textureCharName[128];
     for (int32 k = 0; k < textureCount; ++k)
@@ -201,45 +278,67 @@ void Sprite::InitFromFile(File* file)
         file->ReadLine(tempBuf, 1024);
         sscanf(tempBuf, "%s", textureCharName);
 
-        FilePath tp = pathName.GetDirectory() + String(textureCharName);
-        textureNames[k] = tp;
-        textures[k] = nullptr;
+        data.textureNames[k] = pathName.GetDirectory() + String(textureCharName);
     }
 
-    int32 width, height;
     file->ReadLine(tempBuf, 1024);
-    sscanf(tempBuf, "%d %d", &width, &height);
-    size = GetEngineContext()->uiControlSystem->vcs->ConvertResourceToVirtual(Vector2(float32(width), float32(height)), resourceSizeIndex);
+    sscanf(tempBuf, "%d %d", &data.width, &data.height);
 
+    int32 frameCount = 0;
     file->ReadLine(tempBuf, 1024);
     sscanf(tempBuf, "%d", &frameCount);
 
+    data.frameRects.resize(frameCount);
+    data.frameTextureIndices.resize(frameCount);
+    data.frameNames.resize(frameCount);
+    for (int32 i = 0; i < frameCount; i++)
+    {
+        char frameName[128] = { 0 };
+
+        int32 x, y, dx, dy, xOff, yOff;
+
+        file->ReadLine(tempBuf, 1024);
+        sscanf(tempBuf, "%d %d %d %d %d %d %d %s", &x, &y, &dx, &dy, &xOff, &yOff, &data.frameTextureIndices[i], frameName);
+        data.frameNames[i] = (*frameName == '\0') ? FastName() : FastName(frameName);
+
+        data.frameRects[i][eRectsAndOffsets::X_POSITION_IN_TEXTURE] = x;
+        data.frameRects[i][eRectsAndOffsets::Y_POSITION_IN_TEXTURE] = y;
+        data.frameRects[i][eRectsAndOffsets::ACTIVE_WIDTH] = dx;
+        data.frameRects[i][eRectsAndOffsets::ACTIVE_HEIGHT] = dy;
+        data.frameRects[i][eRectsAndOffsets::X_OFFSET_TO_ACTIVE] = xOff;
+        data.frameRects[i][eRectsAndOffsets::Y_OFFSET_TO_ACTIVE] = yOff;
+    }
+}
+
+void Sprite::InitFromFileData(const FileData& data, Vector<Texture*>* loadedTextures)
+{
+    type = SPRITE_FROM_FILE;
+
+    textureCount = static_cast<int32>(data.textureNames.size());
+    textures = new Texture*[textureCount];
+    textureNames = new FilePath[textureCount];
+    for (int32 k = 0; k < textureCount; ++k)
+    {
+        textureNames[k] = data.textureNames[k];
+        textures[k] = nullptr;
+    }
+
+    size = GetEngineContext()->uiControlSystem->vcs->ConvertResourceToVirtual(Vector2(float32(data.width), float32(data.height)), resourceSizeIndex);
+
+    frameCount = static_cast<int32>(data.frameRects.size());
     texCoords = new float32*[frameCount];
     frameVertices = new float32*[frameCount];
     rectsAndOffsets = new float32*[frameCount];
     frameTextureIndex = new int32[frameCount];
-    rectsAndOffsetsOriginal.resize(frameCount);
+    rectsAndOffsetsOriginal = data.frameRects;
+    frameNames = data.frameNames;
 
-    frameNames.resize(frameCount);
     for (int32 i = 0; i < frameCount; i++)
     {
         frameVertices[i] = new float32[8];
         texCoords[i] = new float32[8];
         rectsAndOffsets[i] = new float32[6];
-        char frameName[128] = { 0 };
-
-        int32 x, y, dx, dy, xOff, yOff;
-
-        file->ReadLine(tempBuf, 1024);
-        sscanf(tempBuf, "%d %d %d %d %d %d %d %s", &x, &y, &dx, &dy, &xOff, &yOff, &frameTextureIndex[i], frameName);
-        frameNames[i] = (*frameName == '\0') ? FastName() : FastName(frameName);
-
-        rectsAndOffsetsOriginal[i][eRectsAndOffsets::X_POSITION_IN_TEXTURE] = x;
-        rectsAndOffsetsOriginal[i][eRectsAndOffsets::Y_POSITION_IN_TEXTURE] = y;
-        rectsAndOffsetsOriginal[i][eRectsAndOffsets::ACTIVE_WIDTH] = dx;
-        rectsAndOffsetsOriginal[i][eRectsAndOffsets::ACTIVE_HEIGHT] = dy;
-        rectsAndOffsetsOriginal[i][eRectsAndOffsets::X_OFFSET_TO_ACTIVE] = xOff;
-        rectsAndOffsetsOriginal[i][eRectsAndOffsets::Y_OFFSET_TO_ACTIVE] = yOff;
+        frameTextureIndex[i] = data.frameTextureIndices[i];
     }
     defaultPivotPoint.x = 0;
     defaultPivotPoint.y = 0;
@@ -248,13 +347,21 @@ void Sprite::InitFromFile(File* file)
     {
         // Sprite was added into system
         // Texture will created in `DynamicAtlasSystem::EndAtlas()` call.
+        if (loadedTextures != nullptr)
+        {
+            for_each(loadedTextures->begin(), loadedTextures->end(), SafeRelease<Texture>);
+        }
     }
     else
     {
-        // Load default textures
+        // Load default textures, textures loaded asynchronously are taken as is
         for (int32 k = 0; k < textureCount; ++k)
         {
-            textures[k] = Texture::CreateFromFile(textureNames[k]);
+            textures[k] = (loadedTextures != nullptr) ? (*loadedTextures)[k] : nullptr;
+            if (textures[k] == nullptr)
+            {
+                textures[k] = Texture::CreateFromFile(textureNames[k]);
+            }
             DVASSERT(textures[k], "ERROR: Texture loading failed" /* + pathName*/);
         }
     }
@@ -352,6 +459,110 @@ Sprite* Sprite::Create(const FilePath& spriteName)
     return spr;
 }
 
+Sprite* Sprite::CreateAsync(const FilePath& spriteName)
+{
+    DVASSERT(Thread::IsMainThread());
+
+    String extension = spriteName.GetExtension();
+    if (spriteName.IsEmpty() || spriteName.GetType() == FilePath::PATH_IN_MEMORY || (!extension.empty() && TextureDescriptor::IsSourceTextureExtension(extension)))
+    {
+        return Create(spriteName);
+    }
+
+    Sprite* cachedSprite = GetSpriteFromMap(spriteName);
+    if (cachedSprite)
+    {
+        return cachedSprite;
+    }
+
+    // Placeholder is registered in sprite map, so all requests for the sprite get it until it is released
+    Texture* pinkTexture = Texture::CreatePink();
+    Sprite* spr = CreateFromTexture(pinkTexture, 0, 0, 16, 16, 16.f, 16.f, spriteName);
+    spr->type = SPRITE_FROM_FILE;
+    spr->isLoading = true;
+    pinkTexture->Release();
+
+    // file paths depend on virtual coordinates and locale, so they are resolved in the main thread
+    AsyncLoadData* loadData = new AsyncLoadData();
+    GetSpriteFileCandidates(spriteName, loadData->fileCandidates);
+
+    // Sprite is retained by loading and released in the main thread only
+    spr->Retain();
+    SpriteDetail::RunAsyncLoadJob([spr, loadData]() {
+        File* spriteFile = OpenSpriteFile(loadData->fileCandidates, loadData->resourceSizeIndex);
+        if (spriteFile != nullptr)
+        {
+            ReadFileData(spriteFile, loadData->fileData);
+            SafeRelease(spriteFile);
+            loadData->loaded = true;
+
+            size_t textureCount = loadData->fileData.textureNames.size();
+            loadData->textureDescriptors.resize(textureCount);
+            loadData->textureGPUs.resize(textureCount, GPU_INVALID);
+            loadData->textureImages.resize(textureCount);
+            for (size_t k = 0; k < textureCount; ++k)
+            {
+                loadData->textureDescriptors[k] = Texture::DecodeFromFile(loadData->fileData.textureNames[k], loadData->textureGPUs[k], loadData->textureImages[k]);
+            }
+        }
+
+        GetEngineContext()->jobManager->CreateMainJob([spr, loadData]() {
+            SpriteDetail::OnAsyncLoadJobFinished();
+            spr->CompleteAsyncLoad(loadData);
+            delete loadData;
+            spr->Release();
+        },
+                                                      JobManager::JOB_MAINLAZY);
+    });
+
+    return spr;
+}
+
+void Sprite::CompleteLoad()
+{
+    isLoading = false;
+
+    int32 fileResourceSizeIndex = 0;
+    File* spriteFile = GetSpriteFile(relativePathname, fileResourceSizeIndex);
+    if (spriteFile == nullptr)
+    {
+        // Sprite can't be loaded and stays 'purple'
+        return;
+    }
+
+    Clear();
+    resourceSizeIndex = fileResourceSizeIndex;
+    InitFromFile(spriteFile);
+    SafeRelease(spriteFile);
+    Reset();
+}
+
+void Sprite::CompleteAsyncLoad(AsyncLoadData* loadData)
+{
+    Vector<Texture*> loadedTextures(loadData->textureDescriptors.size(), nullptr);
+    for (size_t k = 0; k < loadedTextures.size(); ++k)
+    {
+        if (loadData->textureDescriptors[k] != nullptr)
+        {
+            loadedTextures[k] = Texture::CreateFromDecodedImages(loadData->textureDescriptors[k], loadData->textureGPUs[k], loadData->textureImages[k]);
+        }
+    }
+
+    if (!isLoading || !loadData->loaded)
+    {
+        // Sprite was reloaded in the meantime or can't be loaded and stays 'purple'
+        for_each(loadedTextures.begin(), loadedTextures.end(), SafeRelease<Texture>);
+        isLoading = false;
+        return;
+    }
+
+    Clear();
+    resourceSizeIndex = loadData->resourceSizeIndex;
+    InitFromFileData(loadData->fileData, &loadedTextures);
+    isLoading = false;
+    Reset();
+}
+
 Sprite* Sprite::CreateFromTexture(Texture* fromTexture, int32 xOffset, int32 yOffset, float32 sprWidth, float32 sprHeight, bool contentScaleIncluded)
 {
     DVASSERT(fromTexture);
@@ -890,6 +1101,7 @@ void Sprite::Reload(eGPUFamily gpu)
 {
     if (type == SPRITE_FROM_FILE)
     {
+        isLoading = false;
         GetEngineContext()->dynamicAtlasSystem->UnregisterSprite(this);
         ReloadExistingTextures(gpu);
         Clear();
@@ -914,35 +1126,53 @@ void Sprite::Reload(eGPUFamily gpu)
 }
 
 File* Sprite::GetSpriteFile(const FilePath& spriteName, int32& resourceSizeIndex)
+{
+    Vector<FileCandidate> candidates;
+    GetSpriteFileCandidates(spriteName, candidates);
+    return OpenSpriteFile(candidates, resourceSizeIndex);
+}
+
+void Sprite::GetSpriteFileCandidates(const FilePath& spriteName, Vector<FileCandidate>& candidates)
 {
     FilePath pathName = FilePath::CreateWithNewExtension(spriteName, ".txt");
     FilePath scaledPath = GetScaledName(pathName);
 
     VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    String localeDirectory = GetEngineContext()->localizationSystem->GetCurrentLocale() + "/";
+
+    // same order as LoadLocalizedFile tries: localized path first
+    auto addCandidates = [&candidates, &localeDirectory](const FilePath& path, int32 resourceSizeIndex) {
+        FilePath localizedPath(path);
+        localizedPath.ReplaceDirectory(path.GetDirectory() + localeDirectory);
+        candidates.push_back({ localizedPath, resourceSizeIndex });
+        candidates.push_back({ path, resourceSizeIndex });
+    };
+
+    candidates.clear();
+    addCandidates(scaledPath, vcs->GetDesirableResourceIndex());
+    if (vcs->GetResourceFoldersCount() > 1)
+    { // try to load default path in case of several resource folders
+        addCandidates(pathName, vcs->GetBaseResourceIndex());
+    }
+}
 
-    FilePath texturePath;
-    File* fp = LoadLocalizedFile(scaledPath, texturePath);
-    if (!fp)
+File* Sprite::OpenSpriteFile(const Vector<FileCandidate>& candidates, int32& resourceSizeIndex)
+{
+    for (const FileCandidate& candidate : candidates)
     {
-        if (vcs->GetResourceFoldersCount() > 1)
-        { // try to load default path in case of several resource folders
-            fp = LoadLocalizedFile(pathName, texturePath);
-        }
-
-        if (!fp)
+        File* fp = File::Create(candidate.path, File::READ | File::OPEN);
+        if (fp)
         {
-            Logger::Warning("Failed to open sprite file: %s", pathName.GetAbsolutePathname().c_str());
-            return NULL;
+            resourceSizeIndex = candidate.resourceSizeIndex;
+            return fp;
         }
-
-        resourceSizeIndex = vcs->GetBaseResourceIndex();
     }
-    else
+
+    if (!candidates.empty())
     {
-        resourceSizeIndex = vcs->GetDesirableResourceIndex();
+        Logger::Warning("Failed to open sprite file: %s", candidates.back().path.GetAbsolutePathname().c_str());
     }
-
-    return fp;
+    return NULL;
 }
 
 void Sprite::ReloadExistingTextures(eGPUFamily gpu)
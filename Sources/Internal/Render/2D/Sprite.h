@@ -110,6 +110,24 @@ public:
     static Sprite* PureCreate(const FilePath& spriteName, Sprite* forPointer = NULL);
     void InitFromFile(File* file);
 
+    /**
+	 \brief Function to create sprite asynchronously. Should be called from the main thread.
+	 Returns placeholder sprite immediately, it is 'purple' rect sprite until loading is complete.
+	 Sprite file is parsed and texture images are decoded by worker jobs, then textures are created and
+	 sprite is initialized in the main thread. Number of sprites loading at once is limited, other requests wait in queue. `CreateAsync` requests for the same sprite while it is loading
+	 return the same placeholder, `Create` requests complete its loading synchronously.
+	 Sprites from source image files are created synchronously.
+
+	 \param spriteName path to sprite name relative to application bundle
+	 \return sprite pointer in any case will be returned
+	 */
+    static Sprite* CreateAsync(const FilePath& spriteName);
+
+    /**
+	 \brief Returns true if sprite was created by `CreateAsync` and its loading isn't complete yet.
+	 */
+    bool IsLoading() const;
+
     /**
 	 \brief Function to create sprite from the already created texture.
 
@@ -233,6 +251,17 @@ protected:
 
     static File* GetSpriteFile(const FilePath& spriteName, int32& resourceSizeIndex);
 
+    struct FileCandidate;
+    static void GetSpriteFileCandidates(const FilePath& spriteName, Vector<FileCandidate>& candidates);
+    static File* OpenSpriteFile(const Vector<FileCandidate>& candidates, int32& resourceSizeIndex);
+
+    struct FileData;
+    struct AsyncLoadData;
+    static void ReadFileData(File* file, FileData& data);
+    void InitFromFileData(const FileData& data, Vector<Texture*>* loadedTextures);
+    void CompleteLoad();
+    void CompleteAsyncLoad(AsyncLoadData* loadData);
+
     void ReloadExistingTextures(eGPUFamily gpu);
 
     void SetRelativePathname(const FilePath& path);
@@ -287,6 +316,8 @@ protected:
     Vector<Array<int32, 6>> rectsAndOffsetsOriginal;
     /** Is sprite registered in DynamicAtlasSystem? */
     volatile bool inDynamicAtlas = false;
+    /** Is sprite loading by CreateAsync? */
+    bool isLoading = false;
 
     friend class RenderSystem2D;
     friend class DynamicAtlasSystem;
@@ -365,6 +396,11 @@ inline int32 Sprite::GetResourceSizeIndex() const
     return resourceSizeIndex;
 }
 
+inline bool Sprite::IsLoading() const
+{
+    return isLoading;
+}
+
 inline NMaterial* SpriteDrawState::GetMaterial() const
 {
     return material;
@@ -0,0 +1,104 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/RefPtr.h"
+#include "Concurrency/Thread.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Render/2D/Sprite.h"
+#include "Render/Texture.h"
+#include "Utils/StringFormat.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (SpriteTest)
+{
+    const String SPRITE_MULTIFRAME = "~res:/TestData/DynamicAtlasSystemTest/WhiteList/Inner/sprite45_multiframe.txt";
+    const String SPRITE_NO_FILE = "~res:/TestData/DynamicAtlasSystemTest/InvalidSprites/NO_FILE.txt";
+
+    DAVA_TEST (CreateAsyncTest)
+    {
+        RefPtr<Sprite> sprite(Sprite::CreateAsync(SPRITE_MULTIFRAME));
+        TEST_VERIFY(sprite->IsLoading());
+        TEST_VERIFY(sprite->GetTexture(0) != nullptr);
+
+        // requests for the loading sprite are deduplicated
+        RefPtr<Sprite> sameSprite(Sprite::CreateAsync(SPRITE_MULTIFRAME));
+        TEST_VERIFY(sprite == sameSprite);
+
+        WaitLoading(sprite.Get());
+        TEST_VERIFY(!sprite->IsLoading());
+        TEST_VERIFY(sprite->GetFrameCount() == 2);
+        TEST_VERIFY(sprite->GetTexture(0) != nullptr);
+        TEST_VERIFY(!sprite->GetTexture(0)->IsPinkPlaceholder());
+
+        RefPtr<Sprite> syncSprite(Sprite::Create(SPRITE_MULTIFRAME));
+        TEST_VERIFY(sprite == syncSprite);
+    }
+
+    DAVA_TEST (CreateWhileAsyncLoadingTest)
+    {
+        RefPtr<Sprite> sprite(Sprite::CreateAsync(SPRITE_MULTIFRAME));
+        TEST_VERIFY(sprite->IsLoading());
+
+        // synchronous request completes loading instead of returning placeholder
+        RefPtr<Sprite> syncSprite(Sprite::Create(SPRITE_MULTIFRAME));
+        TEST_VERIFY(sprite == syncSprite);
+        TEST_VERIFY(!sprite->IsLoading());
+        TEST_VERIFY(sprite->GetFrameCount() == 2);
+        TEST_VERIFY(!sprite->GetTexture(0)->IsPinkPlaceholder());
+
+        // finished asynchronous loading doesn't change sprite
+        Texture* texture = sprite->GetTexture(0);
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        jobManager->WaitWorkerJobs();
+        jobManager->WaitMainJobs();
+        TEST_VERIFY(sprite->GetTexture(0) == texture);
+        TEST_VERIFY(sprite->GetFrameCount() == 2);
+    }
+
+    DAVA_TEST (CreateAsyncFailTest)
+    {
+        RefPtr<Sprite> sprite(Sprite::CreateAsync(SPRITE_NO_FILE));
+        WaitLoading(sprite.Get());
+        TEST_VERIFY(!sprite->IsLoading());
+        TEST_VERIFY(sprite->GetFrameCount() == 1);
+        TEST_VERIFY(sprite->GetTexture(0)->IsPinkPlaceholder());
+    }
+
+    DAVA_TEST (CreateManyAsyncTest)
+    {
+        // more requests than loaded at once, the rest wait in queue
+        Vector<RefPtr<Sprite>> sprites;
+        for (int32 i = 0; i < 20; ++i)
+        {
+            sprites.emplace_back(Sprite::CreateAsync(Format("~res:/TestData/DynamicAtlasSystemTest/InvalidSprites/NO_FILE_%d.txt", i)));
+        }
+        sprites.emplace_back(Sprite::CreateAsync(SPRITE_MULTIFRAME));
+
+        for (const RefPtr<Sprite>& sprite : sprites)
+        {
+            TEST_VERIFY(sprite->IsLoading());
+        }
+
+        for (const RefPtr<Sprite>& sprite : sprites)
+        {
+            WaitLoading(sprite.Get());
+            TEST_VERIFY(!sprite->IsLoading());
+        }
+
+        TEST_VERIFY(sprites.back()->GetFrameCount() == 2);
+        TEST_VERIFY(!sprites.back()->GetTexture(0)->IsPinkPlaceholder());
+    }
+
+    void WaitLoading(Sprite * sprite)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        for (int32 i = 0; i < 1000 && sprite->IsLoading(); ++i)
+        {
+            jobManager->WaitWorkerJobs();
+            jobManager->WaitMainJobs();
+            Thread::Sleep(1);
+        }
+    }
+};
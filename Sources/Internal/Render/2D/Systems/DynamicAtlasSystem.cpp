@@ -115,8 +115,8 @@ DynamicAtlasSystem::DynamicAtlasSystem()
     rectanglePacker.SetMaxTextureSize(RectanglePacker::DEFAULT_TEXTURE_SIZE);
     rectanglePacker.SetTwoSideMargin(true);
     rectanglePacker.SetTexturesMargin(2);
-    // "maxrect_fast"
-    rectanglePacker.SetAlgorithms({ PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT });
+    // best of two maxrects heuristics, sprite frames can't be rotated so rotation stays disabled
+    rectanglePacker.SetAlgorithms({ PackingAlgorithm::ALG_MAXRECTS_BEST_SHORT_SIDE_FIT, PackingAlgorithm::ALG_MAXRECTS_BEST_AREA_FIT });
 
     Renderer::GetSignals().needRestoreResources.Connect(this, &DynamicAtlasSystem::RebuildAll);
 }
@@ -6,6 +6,7 @@
 #include "Render/Material/NMaterial.h"
 #include "Render/Highlevel/ShadowVolume.h"
 #include "Render/Highlevel/SkinnedMesh.h"
+#include "Render/Highlevel/GeometryOctTree.h"
 #include "Scene3D/Components/RenderComponent.h"
 #include "Utils/StringFormat.h"
 #include "Logger/Logger.h"
@@ -1118,6 +1119,305 @@ Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
     return indexBufferData;
 }
 
+namespace MeshUtilsDetails
+{
+const uint32 NO_VERTEX = std::numeric_limits<uint32>::max();
+
+struct TipsifyState
+{
+    Vector<uint32> liveTriangles;
+    Vector<uint32> deadEnd;
+    uint32 cursor = 0;
+};
+
+uint32 SkipDeadEnd(TipsifyState& state)
+{
+    while (!state.deadEnd.empty())
+    {
+        uint32 v = state.deadEnd.back();
+        state.deadEnd.pop_back();
+        if (state.liveTriangles[v] > 0)
+        {
+            return v;
+        }
+    }
+
+    uint32 vertexCount = static_cast<uint32>(state.liveTriangles.size());
+    for (; state.cursor < vertexCount; ++state.cursor)
+    {
+        if (state.liveTriangles[state.cursor] > 0)
+        {
+            return state.cursor;
+        }
+    }
+
+    return NO_VERTEX;
+}
+
+/*
+    Tipsify from "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander et al. 2007).
+    Fills new order of triangles and first triangle of every cluster. Clusters start where
+    the fan reaches dead-end, so reordering of clusters doesn't change cache efficiency much.
+*/
+void TipsifyTriangles(const Vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize, Vector<uint32>& outTriangles, Vector<uint32>& outClusters)
+{
+    uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+
+    // triangles adjacent to every vertex
+    Vector<uint32> adjacencyOffset(vertexCount + 1, 0);
+    for (uint32 v : indices)
+    {
+        ++adjacencyOffset[v + 1];
+    }
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffset[v + 1] += adjacencyOffset[v];
+    }
+
+    Vector<uint32> adjacency(indices.size());
+    Vector<uint32> fillOffset(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (uint32 i = 0; i < static_cast<uint32>(indices.size()); ++i)
+    {
+        adjacency[fillOffset[indices[i]]++] = i / 3;
+    }
+
+    TipsifyState state;
+    state.liveTriangles.resize(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        state.liveTriangles[v] = adjacencyOffset[v + 1] - adjacencyOffset[v];
+    }
+
+    Vector<uint32> cacheTime(vertexCount, 0);
+    Vector<bool> emitted(triangleCount, false);
+    Vector<uint32> candidates;
+    uint32 time = cacheSize + 1;
+
+    outTriangles.clear();
+    outTriangles.reserve(triangleCount);
+    outClusters.assign(1, 0);
+
+    uint32 fanning = SkipDeadEnd(state);
+    while (fanning != NO_VERTEX)
+    {
+        candidates.clear();
+        for (uint32 a = adjacencyOffset[fanning]; a < adjacencyOffset[fanning + 1]; ++a)
+        {
+            uint32 t = adjacency[a];
+            if (emitted[t])
+            {
+                continue;
+            }
+
+            emitted[t] = true;
+            outTriangles.push_back(t);
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                uint32 v = indices[t * 3 + c];
+                state.deadEnd.push_back(v);
+                candidates.push_back(v);
+                --state.liveTriangles[v];
+                if (time - cacheTime[v] > cacheSize)
+                {
+                    cacheTime[v] = time++;
+                }
+            }
+        }
+
+        // prefer the oldest candidate which stays in cache while all its triangles are emitted
+        uint32 next = NO_VERTEX;
+        int32 bestPriority = -1;
+        for (uint32 v : candidates)
+        {
+            if (state.liveTriangles[v] > 0)
+            {
+                int32 priority = 0;
+                if (time - cacheTime[v] + 2 * state.liveTriangles[v] <= cacheSize)
+                {
+                    priority = static_cast<int32>(time - cacheTime[v]);
+                }
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    next = v;
+                }
+            }
+        }
+
+        if (next == NO_VERTEX)
+        {
+            next = SkipDeadEnd(state);
+            if (next != NO_VERTEX)
+            {
+                outClusters.push_back(static_cast<uint32>(outTriangles.size()));
+            }
+        }
+        fanning = next;
+    }
+}
+
+/*
+    Linear-speed overdraw ordering from the same paper: clusters facing away from
+    the mesh center are likely to occlude the others, so they go first.
+*/
+Vector<uint32> SortClustersForOverdraw(PolygonGroup* pg, const Vector<uint32>& indices, const Vector<uint32>& triangles, const Vector<uint32>& clusters)
+{
+    struct Cluster
+    {
+        uint32 begin;
+        uint32 end;
+        float32 sortKey;
+    };
+
+    Vector<Vector3> triangleCenters(triangles.size());
+    Vector<Vector3> triangleNormals(triangles.size());
+    Vector3 meshCenter;
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        Vector3 p[3];
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            pg->GetCoord(indices[triangles[i] * 3 + c], p[c]);
+        }
+        triangleCenters[i] = (p[0] + p[1] + p[2]) / 3.f;
+        triangleNormals[i] = (p[1] - p[0]).CrossProduct(p[2] - p[0]); // length is proportional to area
+        meshCenter += triangleCenters[i];
+    }
+    meshCenter /= static_cast<float32>(triangles.size());
+
+    Vector<Cluster> sortedClusters(clusters.size());
+    for (size_t ci = 0; ci < clusters.size(); ++ci)
+    {
+        Cluster& cluster = sortedClusters[ci];
+        cluster.begin = clusters[ci];
+        cluster.end = (ci + 1 < clusters.size()) ? clusters[ci + 1] : static_cast<uint32>(triangles.size());
+
+        Vector3 center;
+        Vector3 normal;
+        for (uint32 i = cluster.begin; i < cluster.end; ++i)
+        {
+            center += triangleCenters[i];
+            normal += triangleNormals[i];
+        }
+        center /= static_cast<float32>(cluster.end - cluster.begin);
+
+        // normals of closed or degenerate clusters cancel out, such clusters have no facing and go between the others
+        float32 normalLength = normal.Length();
+        cluster.sortKey = (normalLength > EPSILON) ? (center - meshCenter).DotProduct(normal / normalLength) : 0.f;
+    }
+
+    std::stable_sort(sortedClusters.begin(), sortedClusters.end(), [](const Cluster& l, const Cluster& r) {
+        return l.sortKey > r.sortKey;
+    });
+
+    Vector<uint32> result;
+    result.reserve(triangles.size());
+    for (const Cluster& cluster : sortedClusters)
+    {
+        result.insert(result.end(), triangles.begin() + cluster.begin, triangles.begin() + cluster.end);
+    }
+    return result;
+}
+}
+
+MeshOptimizationStats OptimizeMesh(PolygonGroup* pg)
+{
+    DVASSERT(pg);
+
+    MeshOptimizationStats stats;
+    stats.vertexCount = static_cast<uint32>(pg->GetVertexCount());
+    stats.triangleCount = static_cast<uint32>(pg->GetIndexCount() / 3);
+    stats.vertexSize = static_cast<uint32>(pg->vertexStride);
+    stats.acmrBefore = CalculateACMR(pg->indexArray, pg->GetIndexCount(), stats.vertexCount);
+    stats.acmrAfter = stats.acmrBefore;
+
+    if (pg->GetPrimitiveType() != rhi::PRIMITIVE_TRIANGLELIST || pg->indexFormat != EIF_16 || pg->meshData == nullptr || stats.triangleCount == 0)
+    {
+        return stats;
+    }
+
+    uint32 indexCount = stats.triangleCount * 3;
+    Vector<uint32> indices(indexCount);
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        indices[i] = static_cast<uint16>(pg->indexArray[i]);
+    }
+
+    Vector<uint32> triangles;
+    Vector<uint32> clusters;
+    MeshUtilsDetails::TipsifyTriangles(indices, stats.vertexCount, MESH_OPTIMIZATION_CACHE_SIZE, triangles, clusters);
+    triangles = MeshUtilsDetails::SortClustersForOverdraw(pg, indices, triangles, clusters);
+
+    // vertices go in order of first use, unused ones are kept at the end
+    Vector<uint32> remap(stats.vertexCount, MeshUtilsDetails::NO_VERTEX);
+    uint32 nextVertex = 0;
+    for (uint32 t : triangles)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            uint32 v = indices[t * 3 + c];
+            if (remap[v] == MeshUtilsDetails::NO_VERTEX)
+            {
+                remap[v] = nextVertex++;
+            }
+        }
+    }
+    for (uint32& v : remap)
+    {
+        if (v == MeshUtilsDetails::NO_VERTEX)
+        {
+            v = nextVertex++;
+        }
+    }
+
+    uint32 stride = stats.vertexSize;
+    Vector<uint8> vertices(pg->meshData, pg->meshData + stats.vertexCount * stride);
+    for (uint32 v = 0; v < stats.vertexCount; ++v)
+    {
+        Memcpy(pg->meshData + remap[v] * stride, vertices.data() + v * stride, stride);
+    }
+
+    for (uint32 i = 0; i < stats.triangleCount; ++i)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            pg->indexArray[i * 3 + c] = static_cast<int16>(remap[indices[triangles[i] * 3 + c]]);
+        }
+    }
+
+    if (pg->octTree != nullptr)
+    {
+        SafeDelete(pg->octTree);
+        pg->GenerateGeometryOctTree();
+    }
+
+    stats.acmrAfter = CalculateACMR(pg->indexArray, indexCount, stats.vertexCount);
+    return stats;
+}
+
+float32 CalculateACMR(const int16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+    if (indexCount < 3)
+    {
+        return 0.f;
+    }
+
+    Vector<uint32> cacheTime(vertexCount, 0);
+    uint32 time = cacheSize + 1;
+    uint32 misses = 0;
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        uint32 v = static_cast<uint16>(indices[i]);
+        if (time - cacheTime[v] > cacheSize)
+        {
+            cacheTime[v] = time++;
+            ++misses;
+        }
+    }
+
+    return static_cast<float32>(misses) / static_cast<float32>(indexCount / 3);
+}
+
 uint32 ReleaseGeometryDataRecursive(Entity* forEntity)
 {
     if (!forEntity)
@@ -31,6 +31,32 @@ PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* source);
 
 Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction);
 
+/**
+    Vertex cache and size statistics of optimized mesh.
+    ACMR is average cache miss ratio - count of vertex shader invocations per triangle
+    with FIFO post-transform cache of `MESH_OPTIMIZATION_CACHE_SIZE` vertices.
+*/
+struct MeshOptimizationStats
+{
+    uint32 vertexCount = 0;
+    uint32 triangleCount = 0;
+    uint32 vertexSize = 0;
+    float32 acmrBefore = 0.f;
+    float32 acmrAfter = 0.f;
+};
+
+static const uint32 MESH_OPTIMIZATION_CACHE_SIZE = 16;
+
+/**
+    Reorder triangles for post-transform vertex cache (Tipsify), then order resulting clusters
+    of triangles outer first to reduce overdraw, and reorder vertices in order of first use
+    for vertex fetch locality. Only indexed triangle lists are processed.
+    Call PolygonGroup::BuildBuffers to refresh GPU buffers of already rendered group.
+*/
+MeshOptimizationStats OptimizeMesh(PolygonGroup* pg);
+
+float32 CalculateACMR(const int16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize = MESH_OPTIMIZATION_CACHE_SIZE);
+
 uint32 ReleaseGeometryDataRecursive(Entity* forEntity);
 };
 };
@@ -4,7 +4,13 @@
 #include "Render/Highlevel/RenderObject.h"
 #include "Render/Highlevel/RenderPassNames.h"
 #include "Reflection/Reflection.h"
+#include "Concurrency/Semaphore.h"
 #include "FileSystem/FileSystem.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Time/SystemTimer.h"
+#include "Debug/ProfilerCPU.h"
+#include "Debug/ProfilerMarkerNames.h"
 
 namespace DAVA
 {
@@ -15,6 +21,7 @@ struct GeoDecalManager::DecalBuildInfo
     RenderBatch* sourceBatch = nullptr;
     PolygonGroup* polygonGroup = nullptr;
     NMaterial* material = nullptr;
+    SkinnedMesh::JointTargetsData jointTargetsData;
     Vector3 projectionAxis;
     Matrix4 projectionSpaceTransform;
     int32 lodIndex = -1;
@@ -60,6 +67,23 @@ struct GeoDecalManager::DecalVertex
     }
 };
 
+struct GeoDecalManager::PendingDecal
+{
+    Decal decal = InvalidDecal;
+    DecalConfig config;
+    RenderObject* sourceObject = nullptr;
+    Vector<DecalBuildInfo> infos;
+    Vector<Vector<uint8>> buffers; // clipped geometry for every info, filled by worker job
+    std::atomic<bool> built{ false };
+    Semaphore jobFinished; // posted by worker job of the decal after its last access to build data
+
+    ~PendingDecal()
+    {
+        DVASSERT(sourceObject == nullptr, "Render object of pending decal should be released on the main thread");
+        DVASSERT(infos.empty(), "Geometry and materials of pending decal should be released on the main thread");
+    }
+};
+
 GeoDecalManager::BuiltDecal::BuiltDecal(BuiltDecal&& r)
     : sourceObject(r.sourceObject)
     , batchProvider(r.batchProvider)
@@ -116,6 +140,18 @@ const GeoDecalManager::Decal GeoDecalManager::InvalidDecal = nullptr;
 
 GeoDecalManager::~GeoDecalManager()
 {
+    // wait for own jobs only, so that unrelated worker jobs don't stall destruction
+    for (const std::shared_ptr<PendingDecal>& p : pendingDecals)
+    {
+        ReleasePendingDecal(*p);
+    }
+    for (const std::shared_ptr<PendingDecal>& p : cancelledDecals)
+    {
+        ReleasePendingDecal(*p);
+    }
+    pendingDecals.clear();
+    cancelledDecals.clear();
+
     for (auto& d : builtDecals)
     {
         UnregisterDecal(d.first);
@@ -124,13 +160,158 @@ GeoDecalManager::~GeoDecalManager()
 }
 
 GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro)
+{
+    Decal decal = CreateDecalHandle();
+
+    Vector<DecalBuildInfo> infos;
+    PrepareDecalBuild(config, decalWorldTransform, ro, infos);
+
+    BuiltDecal& builtDecal = builtDecals[decal];
+    {
+        GeoDecalRenderBatchProvider* decalBatchProvider = new GeoDecalRenderBatchProvider();
+        builtDecal.sourceObject = SafeRetain(ro);
+        builtDecal.batchProvider = decalBatchProvider;
+
+        Vector<uint8> buffer;
+        for (const DecalBuildInfo& info : infos)
+        {
+            buffer.clear();
+            BuildDecalGeometry(info, config, buffer);
+            CreateDecalBatch(info, config, buffer, decalBatchProvider);
+        }
+    }
+    RegisterDecal(decal);
+
+    return decal;
+}
+
+GeoDecalManager::Decal GeoDecalManager::BuildDecalAsync(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro)
+{
+    std::shared_ptr<PendingDecal> pending = std::make_shared<PendingDecal>();
+    pending->decal = CreateDecalHandle();
+    pending->config = config;
+    pending->sourceObject = SafeRetain(ro);
+    PrepareDecalBuild(config, decalWorldTransform, ro, pending->infos);
+    pending->buffers.resize(pending->infos.size());
+    pendingDecals.push_back(pending);
+
+    // geometry and materials are retained, so that source batches can be changed while job is running
+    for (DecalBuildInfo& info : pending->infos)
+    {
+        SafeRetain(info.polygonGroup);
+        SafeRetain(info.material);
+    }
+
+    // job owns its copy of build data, so decal can be deleted while job is running
+    GetEngineContext()->jobManager->CreateWorkerJob([this, pending]() {
+        for (size_t i = 0; i < pending->infos.size(); ++i)
+        {
+            BuildDecalGeometry(pending->infos[i], pending->config, pending->buffers[i]);
+        }
+        pending->built = true;
+        pending->jobFinished.Post();
+    });
+
+    return pending->decal;
+}
+
+bool GeoDecalManager::IsDecalBuilt(Decal decal) const
+{
+    return builtDecals.count(decal) > 0;
+}
+
+void GeoDecalManager::Update()
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_GEODECAL_MANAGER_UPDATE);
+
+    // worker job may hold the last reference, so render object is released here on the main thread
+    cancelledDecals.erase(std::remove_if(cancelledDecals.begin(), cancelledDecals.end(), [this](const std::shared_ptr<PendingDecal>& p) {
+                              if (p->built)
+                              {
+                                  ReleasePendingDecal(*p);
+                                  return true;
+                              }
+                              return false;
+                          }),
+                          cancelledDecals.end());
+
+    int64 startTime = SystemTimer::GetUs();
+    for (size_t i = 0; i < pendingDecals.size();)
+    {
+        if (pendingDecals[i]->built)
+        {
+            std::shared_ptr<PendingDecal> pending = pendingDecals[i];
+            pendingDecals.erase(pendingDecals.begin() + i);
+            PublishDecal(*pending);
+
+            if (SystemTimer::GetUs() - startTime >= buildBudgetUs)
+                break;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void GeoDecalManager::PublishDecal(PendingDecal& pending)
+{
+    BuiltDecal& builtDecal = builtDecals[pending.decal];
+
+    GeoDecalRenderBatchProvider* decalBatchProvider = new GeoDecalRenderBatchProvider();
+    builtDecal.sourceObject = pending.sourceObject;
+    builtDecal.batchProvider = decalBatchProvider;
+    pending.sourceObject = nullptr;
+
+    for (size_t i = 0; i < pending.infos.size(); ++i)
+    {
+        CreateDecalBatch(pending.infos[i], pending.config, pending.buffers[i], decalBatchProvider);
+    }
+    ReleasePendingDecal(pending);
+
+    RegisterDecal(pending.decal);
+}
+
+void GeoDecalManager::CancelPendingDecal(size_t index)
+{
+    std::shared_ptr<PendingDecal> pending = pendingDecals[index];
+    pendingDecals.erase(pendingDecals.begin() + index);
+    if (pending->built)
+    {
+        ReleasePendingDecal(*pending);
+    }
+    else
+    {
+        cancelledDecals.push_back(pending);
+    }
+}
+
+void GeoDecalManager::ReleasePendingDecal(PendingDecal& pending)
+{
+    // it doesn't block for a built decal, otherwise it waits until the decal's job finishes
+    pending.jobFinished.Wait();
+
+    for (DecalBuildInfo& info : pending.infos)
+    {
+        SafeRelease(info.polygonGroup);
+        SafeRelease(info.material);
+    }
+    pending.infos.clear();
+    pending.buffers.clear();
+    SafeRelease(pending.sourceObject);
+}
+
+GeoDecalManager::Decal GeoDecalManager::CreateDecalHandle()
 {
     ++decalCounter;
 
     uintptr_t thisId = reinterpret_cast<uintptr_t>(this);
-    Decal decal = reinterpret_cast<Decal>(decalCounter ^ thisId);
+    return reinterpret_cast<Decal>(decalCounter ^ thisId);
     // todo : use something better for decal id
+}
 
+void GeoDecalManager::PrepareDecalBuild(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro, Vector<DecalBuildInfo>& infos)
+{
     AABBox3 decalBox = config.GetBoundingBox();
 
     AABBox3 worldSpaceBox;
@@ -188,33 +369,54 @@ GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, co
 
     worldSpaceBox.GetTransformedBox(ro->GetInverseWorldTransform(), info.boundingBox);
 
-    BuiltDecal& builtDecal = builtDecals[decal];
+    for (uint32 i = 0, e = ro->GetRenderBatchCount(); i < e; ++i)
     {
-        GeoDecalRenderBatchProvider* decalBatchProvider = new GeoDecalRenderBatchProvider();
-        builtDecal.sourceObject = SafeRetain(ro);
-        builtDecal.batchProvider = decalBatchProvider;
-
-        for (uint32 i = 0, e = ro->GetRenderBatchCount(); i < e; ++i)
+        int32 lodIndex = -1;
+        int32 switchIndex = -1;
+        info.sourceBatch = ro->GetRenderBatch(i, lodIndex, switchIndex);
+        info.polygonGroup = info.sourceBatch->GetPolygonGroup();
+        info.material = info.sourceBatch->GetMaterial();
+        info.lodIndex = lodIndex;
+        info.switchIndex = switchIndex;
+
+        if (info.polygonGroup == nullptr)
+            continue;
+
+        const FastName& effectiveFxName = info.material->GetEffectiveFXName();
+        if ((effectiveFxName == NMaterialName::SILHOUETTE) || (effectiveFxName == NMaterialName::SHADOW_VOLUME))
+            continue;
+
+        // octree is built lazily and skinning data changes every frame, so both are taken here on the calling thread
+        if (info.useSkinning)
         {
-            int32 lodIndex = -1;
-            int32 switchIndex = -1;
-            info.sourceBatch = ro->GetRenderBatch(i, lodIndex, switchIndex);
-            info.polygonGroup = info.sourceBatch->GetPolygonGroup();
-            info.material = info.sourceBatch->GetMaterial();
-            info.lodIndex = lodIndex;
-            info.switchIndex = switchIndex;
-            BuildDecal(info, config, decalBatchProvider);
+            info.jointTargetsData = static_cast<SkinnedMesh*>(ro)->GetJointTargetsData(info.sourceBatch);
+        }
+        else
+        {
+            info.polygonGroup->GetGeometryOctTree();
         }
-    }
-    RegisterDecal(decal);
 
-    return decal;
+        infos.push_back(info);
+    }
 }
 
 void GeoDecalManager::DeleteDecal(Decal decal)
 {
-    UnregisterDecal(decal);
-    builtDecals.erase(decal);
+    for (size_t i = 0; i < pendingDecals.size(); ++i)
+    {
+        if (pendingDecals[i]->decal == decal)
+        {
+            CancelPendingDecal(i);
+            return;
+        }
+    }
+
+    // decal may be already dropped along with its pending build in RemoveRenderObject
+    if (builtDecals.count(decal) > 0)
+    {
+        UnregisterDecal(decal);
+        builtDecals.erase(decal);
+    }
 }
 
 void GeoDecalManager::RegisterDecal(Decal decal)
@@ -242,6 +444,18 @@ void GeoDecalManager::RemoveRenderObject(RenderObject* ro)
             UnregisterDecal(b.first);
         }
     }
+
+    for (size_t i = 0; i < pendingDecals.size();)
+    {
+        if (pendingDecals[i]->sourceObject == ro)
+        {
+            CancelPendingDecal(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
 }
 
 #define MAX_CLIPPED_POLYGON_CAPACITY 9
@@ -256,6 +470,26 @@ void GeoDecalManager::AddVerticesToGeometry(const DecalBuildInfo& info, const De
     points[1].actualPoint = points[1].actualPoint * info.projectionSpaceTransform;
     points[2].actualPoint = points[2].actualPoint * info.projectionSpaceTransform;
 
+    // outcodes of clip space box planes: triangle fully outside of one plane is dropped,
+    // triangle fully inside of all planes doesn't need clipping
+    uint32 outside[3] = {};
+    uint32 notInside[3] = {};
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            float32 c = points[i].actualPoint.data[axis];
+            outside[i] |= (static_cast<uint32>(c < clipSpaceBox.min.data[axis] - PLANE_THICKNESS_EPSILON) << (2 * axis)) |
+            (static_cast<uint32>(c > clipSpaceBox.max.data[axis] + PLANE_THICKNESS_EPSILON) << (2 * axis + 1));
+            notInside[i] |= (static_cast<uint32>(c <= clipSpaceBox.min.data[axis] + PLANE_THICKNESS_EPSILON) << (2 * axis)) |
+            (static_cast<uint32>(c >= clipSpaceBox.max.data[axis] - PLANE_THICKNESS_EPSILON) << (2 * axis + 1));
+        }
+    }
+    if ((outside[0] & outside[1] & outside[2]) != 0)
+        return;
+
+    bool needClipping = (notInside[0] | notInside[1] | notInside[2]) != 0;
+
     float minU = 1.0f;
     float maxU = 0.0f;
     for (uint32 i = 0; i < numPoints; ++i)
@@ -293,7 +527,10 @@ void GeoDecalManager::AddVerticesToGeometry(const DecalBuildInfo& info, const De
         }
     }
 
-    ClipToBoundingBox(points, points_tmp, &numPoints, clipSpaceBox);
+    if (needClipping)
+    {
+        ClipToBoundingBox(points, points_tmp, &numPoints, clipSpaceBox);
+    }
 
     if (numPoints >= 3)
     {
@@ -385,8 +622,7 @@ void GeoDecalManager::GetStaticMeshGeometry(const DecalBuildInfo& info, const De
 
 void GeoDecalManager::GetSkinnedMeshGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer)
 {
-    SkinnedMesh* mesh = static_cast<SkinnedMesh*>(info.renderObject);
-    const SkinnedMesh::JointTargetsData& jointTargetsData = mesh->GetJointTargetsData(info.sourceBatch);
+    const SkinnedMesh::JointTargetsData& jointTargetsData = info.jointTargetsData;
 
     const AABBox3 clipSpaceBox = AABBox3(Vector3(0.0f, 0.0f, 0.0f), 2.0f);
 
@@ -439,42 +675,33 @@ void GeoDecalManager::GetSkinnedMeshGeometry(const DecalBuildInfo& info, const D
     }
 }
 
-bool GeoDecalManager::BuildDecal(const DecalBuildInfo& info, const DecalConfig& config, RenderBatchProvider* batchProvider)
+void GeoDecalManager::BuildDecalGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer)
 {
-    if (info.polygonGroup == nullptr)
-        return false;
-
-    const FastName& effectiveFxName = info.material->GetEffectiveFXName();
-
-    if ((effectiveFxName == NMaterialName::SILHOUETTE) || (effectiveFxName == NMaterialName::SHADOW_VOLUME))
-        return false;
-
     int32 geometryFormat = info.polygonGroup->GetFormat();
 
-    Vector<uint8_t> buffer;
-    buffer.reserve(3 * sizeof(DecalVertex) * info.polygonGroup->GetIndexCount());
     if (info.useSkinning)
     {
         if ((geometryFormat & EVF_JOINTINDEX) || (geometryFormat & EVF_HARD_JOINTINDEX))
         {
             GetSkinnedMeshGeometry(info, config, buffer);
         }
-        else
-        {
-            // we are no supporting soft skinning yet
-            return false;
-        }
+        // we are no supporting soft skinning yet
     }
     else
     {
         GetStaticMeshGeometry(info, config, buffer);
     }
+}
 
+bool GeoDecalManager::CreateDecalBatch(const DecalBuildInfo& info, const DecalConfig& config, const Vector<uint8>& buffer, RenderBatchProvider* batchProvider)
+{
     if (buffer.empty())
         return false;
 
+    int32 geometryFormat = info.polygonGroup->GetFormat();
+
     uint32 decalVertexCount = static_cast<uint32>(buffer.size() / sizeof(DecalVertex));
-    const DecalVertex* decalVertexPtr = reinterpret_cast<DecalVertex*>(buffer.data());
+    const DecalVertex* decalVertexPtr = reinterpret_cast<const DecalVertex*>(buffer.data());
 
     ScopedPtr<PolygonGroup> newPolygonGroup(new PolygonGroup());
     newPolygonGroup->AllocateData(geometryFormat | EVF_TEXCOORD3, decalVertexCount, decalVertexCount);
@@ -4,6 +4,7 @@
 #include "FileSystem/FilePath.h"
 #include "Math/AABBox3.h"
 #include <atomic>
+#include <memory>
 
 namespace DAVA
 {
@@ -62,6 +63,21 @@ public:
     Decal BuildDecal(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* object);
     void DeleteDecal(Decal decal);
 
+    /*
+     * Gathers and clips geometry of decal on worker jobs, decal appears on a later frame in Update.
+     * Returned decal can be deleted at any moment, even before it is built.
+     */
+    Decal BuildDecalAsync(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* object);
+    bool IsDecalBuilt(Decal decal) const;
+
+    /*
+     * Creates render batches of asynchronously built decals, spending not much more than build budget per call.
+     * Called by RenderSystem every frame.
+     */
+    void Update();
+    void SetBuildBudget(int64 budgetUs);
+    int64 GetBuildBudget() const;
+
     /*
      * Removes all decals associated with provided RenderObject
      */
@@ -70,6 +86,7 @@ public:
 private:
     struct DecalVertex;
     struct DecalBuildInfo;
+    struct PendingDecal;
 
     struct BuiltDecal
     {
@@ -88,7 +105,14 @@ private:
     void RegisterDecal(Decal decal);
     void UnregisterDecal(Decal decal);
 
-    bool BuildDecal(const DecalBuildInfo& info, const DecalConfig& config, RenderBatchProvider* provider);
+    Decal CreateDecalHandle();
+    void PrepareDecalBuild(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* object, Vector<DecalBuildInfo>& infos);
+    void BuildDecalGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer);
+    bool CreateDecalBatch(const DecalBuildInfo& info, const DecalConfig& config, const Vector<uint8>& buffer, RenderBatchProvider* provider);
+    void PublishDecal(PendingDecal& pending);
+    void CancelPendingDecal(size_t index);
+    void ReleasePendingDecal(PendingDecal& pending);
+
     void ClipToPlane(DecalVertex* p_vs, DecalVertex* p_vs_out, uint32* nb_p_vs, int32 sign, Vector3::eAxis axis, const Vector3& c_v);
     void ClipToBoundingBox(DecalVertex* p_vs, DecalVertex* p_out, uint32* nb_p_vs, const AABBox3& clipper);
     int32 Classify(int32 sign, Vector3::eAxis axis, const Vector3& c_v, const DecalVertex& p_v);
@@ -100,9 +124,22 @@ private:
 
 private:
     Map<Decal, BuiltDecal> builtDecals;
+    Vector<std::shared_ptr<PendingDecal>> pendingDecals; // in order of BuildDecalAsync calls
+    Vector<std::shared_ptr<PendingDecal>> cancelledDecals; // deleted while worker job was running
     std::atomic<uintptr_t> decalCounter{ 0 };
+    int64 buildBudgetUs = 1000;
 };
 
+inline void GeoDecalManager::SetBuildBudget(int64 budgetUs)
+{
+    buildBudgetUs = budgetUs;
+}
+
+inline int64 GeoDecalManager::GetBuildBudget() const
+{
+    return buildBudgetUs;
+}
+
 inline bool GeoDecalManager::DecalConfig::operator==(const GeoDecalManager::DecalConfig& r) const
 {
     return (dimensions == r.dimensions) && (albedo == r.albedo) && (normal == r.normal) && (specular == r.specular) &&
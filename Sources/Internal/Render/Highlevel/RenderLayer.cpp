@@ -1,8 +1,16 @@
 #include "Render/Highlevel/RenderLayer.h"
 #include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/Camera.h"
 #include "Render/VisibilityQueryResults.h"
+#include "Render/Renderer.h"
+#include "Render/DynamicBufferAllocator.h"
+#include "Render/DynamicBindings.h"
+#include "Render/Material/NMaterial.h"
+#include "Concurrency/Semaphore.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 #include "Base/Radix/Radix.h"
 #include "Debug/ProfilerGPU.h"
 #include "Debug/ProfilerMarkerNames.h"
@@ -32,6 +40,53 @@ const FastName LAYER_NAMES[RenderLayer::RENDER_LAYER_ID_COUNT] =
   LAYER_NAME_DEBUG_DRAW
 };
 
+namespace RenderLayerDetail
+{
+// batches count per worker job in parallel packet preparation
+const uint32 PARALLEL_CHUNK_SIZE = 256;
+
+// three columns of world matrix per instance, see AUTO_INSTANCING in materials-vp.sl
+const uint32 INSTANCE_DATA_SIZE = 3 * sizeof(Vector4);
+
+// objects of other types bind own per-object parameters (joints, lods, etc.), which can't be shared by a group
+bool IsInstanceable(RenderObject* object)
+{
+    return object->GetType() == RenderObject::TYPE_RENDEROBJECT || object->GetType() == RenderObject::TYPE_MESH;
+}
+
+bool CanInstanceWith(RenderBatch* first, RenderBatch* batch)
+{
+    return batch->GetMaterial() == first->GetMaterial()
+    && batch->GetPolygonGroup() == first->GetPolygonGroup()
+    && batch->startIndex == first->startIndex
+    && batch->indexCount == first->indexCount
+    && batch->GetRenderObject()->GetType() == first->GetRenderObject()->GetType();
+}
+
+// values of dynamic parameters bound by RenderObject::BindDynamicParameters, except world transform which goes to instance data
+struct SharedDynamicBindings
+{
+    Vector4 lightPosition;
+    Color lightColor;
+    Color lightAmbientColor;
+    AABBox3 boundingBox;
+
+    void CaptureBound()
+    {
+        DynamicBindings& bindings = Renderer::GetDynamicBindings();
+        lightPosition = *static_cast<const Vector4*>(bindings.GetDynamicParam(DynamicBindings::PARAM_LIGHT0_POSITION));
+        lightColor = *static_cast<const Color*>(bindings.GetDynamicParam(DynamicBindings::PARAM_LIGHT0_COLOR));
+        lightAmbientColor = *static_cast<const Color*>(bindings.GetDynamicParam(DynamicBindings::PARAM_LIGHT0_AMBIENT_COLOR));
+        boundingBox = *static_cast<const AABBox3*>(bindings.GetDynamicParam(DynamicBindings::PARAM_LOCAL_BOUNDING_BOX));
+    }
+
+    bool operator==(const SharedDynamicBindings& r) const
+    {
+        return lightPosition == r.lightPosition && lightColor == r.lightColor && lightAmbientColor == r.lightAmbientColor && boundingBox == r.boundingBox;
+    }
+};
+}
+
 const uint32 RenderLayer::LAYER_SORTING_FLAGS_OPAQUE = RenderBatchArray::SORT_ENABLED | RenderBatchArray::SORT_BY_MATERIAL;
 const uint32 RenderLayer::LAYER_SORTING_FLAGS_AFTER_OPAQUE = RenderBatchArray::SORT_ENABLED | RenderBatchArray::SORT_BY_MATERIAL;
 const uint32 RenderLayer::LAYER_SORTING_FLAGS_ALPHA_TEST_LAYER = RenderBatchArray::SORT_ENABLED | RenderBatchArray::SORT_BY_MATERIAL;
@@ -74,36 +129,234 @@ void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::
 {
     uint32 size = static_cast<uint32>(batchArray.GetRenderBatchCount());
 
+    if (size > RenderLayerDetail::PARALLEL_CHUNK_SIZE && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::PARALLEL_PACKET_PREPARATION))
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        if (jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+        {
+            DrawParallel(camera, batchArray, packetList);
+            return;
+        }
+    }
+
     rhi::Packet packet;
-    for (uint32 k = 0; k < size; ++k)
+    for (uint32 k = 0; k < size;)
     {
         RenderBatch* batch = batchArray.Get(k);
+        NMaterial* mat = batch->GetMaterial();
+        if (mat && mat->IsAutoInstancingEnabled())
+        {
+            k += DrawInstanced(camera, batchArray, k, packetList);
+            continue;
+        }
+
         RenderObject* renderObject = batch->GetRenderObject();
         renderObject->BindDynamicParameters(camera, batch);
+        if (mat)
+        {
+            SetupPacket(batch, mat, packet);
+            mat->UpdateConstBuffers();
+            rhi::AddPacket(packetList, packet);
+        }
+        ++k;
+    }
+}
+
+void RenderLayer::DrawParallel(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList)
+{
+    uint32 size = static_cast<uint32>(batchArray.GetRenderBatchCount());
+    preparedPackets.resize(size);
+
+    // Geometry and material states of packets are filled on workers by chunks of sorted batches.
+    // Dynamic bindings and const buffers are shared between batches, so they are updated
+    // on the calling thread right before each packet is added in sorted order.
+    // Only own jobs are waited for, so that unrelated worker jobs don't stall the frame.
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    Semaphore prepared;
+    uint32 jobsCount = 0;
+    uint32 begin = 0;
+    for (; begin + RenderLayerDetail::PARALLEL_CHUNK_SIZE < size; begin += RenderLayerDetail::PARALLEL_CHUNK_SIZE)
+    {
+        uint32 end = begin + RenderLayerDetail::PARALLEL_CHUNK_SIZE;
+        jobManager->CreateWorkerJob([this, &batchArray, begin, end, &prepared]() {
+            PreparePackets(batchArray, begin, end);
+            prepared.Post();
+        });
+        ++jobsCount;
+    }
+    PreparePackets(batchArray, begin, size);
+    for (uint32 i = 0; i < jobsCount; ++i)
+    {
+        prepared.Wait();
+    }
+
+    for (uint32 k = 0; k < size;)
+    {
+        RenderBatch* batch = batchArray.Get(k);
+        NMaterial* mat = batch->GetMaterial();
+        if (mat && mat->IsAutoInstancingEnabled())
+        {
+            k += DrawInstanced(camera, batchArray, k, packetList);
+            continue;
+        }
+
+        RenderObject* renderObject = batch->GetRenderObject();
+        renderObject->BindDynamicParameters(camera, batch);
+        if (mat)
+        {
+            mat->UpdateConstBuffers();
+            rhi::AddPacket(packetList, preparedPackets[k]);
+        }
+        ++k;
+    }
+}
+
+uint32 RenderLayer::DrawInstanced(Camera* camera, const RenderBatchArray& batchArray, uint32 first, rhi::HPacketList packetList)
+{
+    using namespace RenderLayerDetail;
+
+    // batches are sorted by material, so equal geometry of one material usually goes in a row
+    RenderBatch* firstBatch = batchArray.Get(first);
+    NMaterial* mat = firstBatch->GetMaterial();
+    rhi::Packet packet;
+    SetupPacket(firstBatch, mat, packet);
+
+    // instance stream can't be added to batch with own instance data, which would need the same base instance,
+    // or to batch without vertex layout
+    if (packet.instanceCount != 0 || packet.vertexLayoutUID == rhi::VertexLayout::InvalidUID)
+    {
+        DVASSERT(false, "Material with AUTO_INSTANCING is used for batch which can't get instance data");
+        firstBatch->GetRenderObject()->BindDynamicParameters(camera, firstBatch);
+        mat->UpdateConstBuffers();
+        rhi::AddPacket(packetList, packet);
+        return 1;
+    }
+
+    // batches which can't be grouped are drawn as single instance, since instanced shader takes world transform from instance data
+    uint32 count = GetInstancedGroupSize(camera, batchArray, first);
+
+    DynamicBufferAllocator::AllocResultVB instanceData = DynamicBufferAllocator::AllocateVertexBuffer(INSTANCE_DATA_SIZE, count);
+    count = instanceData.allocatedVertices; // rest of the group goes to the next packet
+
+    Vector4* columns = reinterpret_cast<Vector4*>(instanceData.data);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const Matrix4& world = *batchArray.Get(first + i)->GetRenderObject()->GetWorldTransformPtr();
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            columns[i * 3 + c] = Vector4(world._data[0][c], world._data[1][c], world._data[2][c], world._data[3][c]);
+        }
+    }
+
+    // lights and other dynamic bindings are taken from the first batch of the group
+    firstBatch->GetRenderObject()->BindDynamicParameters(camera, firstBatch);
+
+    packet.vertexStreamCount = 2;
+    packet.vertexStream[1] = instanceData.buffer;
+    packet.instanceCount = count;
+    packet.baseInstance = instanceData.baseVertex;
+    packet.vertexLayoutUID = GetInstancedLayout(packet.vertexLayoutUID);
+
+    mat->UpdateConstBuffers();
+    rhi::AddPacket(packetList, packet);
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+    Renderer::GetRenderStats().instancedBatches += count;
+    Renderer::GetRenderStats().instancedPackets++;
+#endif
+
+    return count;
+}
+
+uint32 RenderLayer::GetInstancedGroupSize(Camera* camera, const RenderBatchArray& batchArray, uint32 first)
+{
+    using namespace RenderLayerDetail;
+
+    RenderBatch* firstBatch = batchArray.Get(first);
+    if (firstBatch->GetPolygonGroup() == nullptr || !IsInstanceable(firstBatch->GetRenderObject()))
+    {
+        return 1;
+    }
+
+    // dynamic parameters of the first object are bound for the whole group, so bound values have to match
+    firstBatch->GetRenderObject()->BindDynamicParameters(camera, firstBatch);
+    SharedDynamicBindings firstBindings;
+    firstBindings.CaptureBound();
+
+    uint32 size = static_cast<uint32>(batchArray.GetRenderBatchCount());
+    uint32 count = 1;
+    for (; first + count < size; ++count)
+    {
+        RenderBatch* batch = batchArray.Get(first + count);
+        if (!CanInstanceWith(firstBatch, batch))
+        {
+            break;
+        }
+
+        batch->GetRenderObject()->BindDynamicParameters(camera, batch);
+        SharedDynamicBindings bindings;
+        bindings.CaptureBound();
+        if (!(bindings == firstBindings))
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+uint32 RenderLayer::GetInstancedLayout(uint32 layoutUID)
+{
+    auto it = instancedLayouts.find(layoutUID);
+    if (it != instancedLayouts.end())
+    {
+        return it->second;
+    }
+
+    rhi::VertexLayout layout = *rhi::VertexLayout::Get(layoutUID);
+    layout.AddStream(rhi::VDF_PER_INSTANCE);
+    for (uint32 i = 5; i < 8; ++i)
+    {
+        layout.AddElement(rhi::VS_TEXCOORD, i, rhi::VDT_FLOAT, 4);
+    }
+
+    uint32 instancedUID = rhi::VertexLayout::UniqueId(layout);
+    instancedLayouts[layoutUID] = instancedUID;
+    return instancedUID;
+}
+
+void RenderLayer::PreparePackets(const RenderBatchArray& batchArray, uint32 begin, uint32 end)
+{
+    for (uint32 k = begin; k < end; ++k)
+    {
+        RenderBatch* batch = batchArray.Get(k);
         NMaterial* mat = batch->GetMaterial();
         if (mat)
         {
-            batch->BindGeometryData(packet);
-            DVASSERT(packet.primitiveCount);
-            mat->BindParams(packet);
-            packet.debugMarker = mat->GetEffectiveFXName().c_str();
-            packet.perfQueryStart = batch->perfQueryStart;
-            packet.perfQueryEnd = batch->perfQueryEnd;
+            SetupPacket(batch, mat, preparedPackets[k]);
+        }
+    }
+}
+
+void RenderLayer::SetupPacket(RenderBatch* batch, NMaterial* material, rhi::Packet& packet) const
+{
+    batch->BindGeometryData(packet);
+    DVASSERT(packet.primitiveCount);
+    material->BindPacketState(packet);
+    packet.debugMarker = material->GetEffectiveFXName().c_str();
+    packet.perfQueryStart = batch->perfQueryStart;
+    packet.perfQueryEnd = batch->perfQueryEnd;
 
 #ifdef __DAVAENGINE_RENDERSTATS__
 #ifdef __DAVAENGINE_RENDERSTATS_ALPHABLEND__
-            if (packet.userFlags & NMaterial::USER_FLAG_ALPHABLEND)
-                packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_ALPHABLEND;
-            else if (layerID == RENDER_LAYER_SHADOW_VOLUME_ID)
-                packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_LAYER_SHADOW_VOLUME;
-            else
-                packet.queryIndex = DAVA::InvalidIndex;
+    if (packet.userFlags & NMaterial::USER_FLAG_ALPHABLEND)
+        packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_ALPHABLEND;
+    else if (layerID == RENDER_LAYER_SHADOW_VOLUME_ID)
+        packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_LAYER_SHADOW_VOLUME;
+    else
+        packet.queryIndex = DAVA::InvalidIndex;
 #else
-            packet.queryIndex = layerID;
+    packet.queryIndex = layerID;
 #endif
 #endif
-            rhi::AddPacket(packetList, packet);
-        }
-    }
 }
 };
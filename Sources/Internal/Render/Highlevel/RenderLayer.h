@@ -48,9 +48,25 @@ public:
 
     virtual void Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList);
 
+    /**
+        Return number of batches starting from `first` which are drawn by one instanced packet of auto instancing material.
+        Batches of a group share geometry, material and values of dynamic parameters except world transform.
+        Changes dynamic bindings.
+     */
+    static uint32 GetInstancedGroupSize(Camera* camera, const RenderBatchArray& batchArray, uint32 first);
+
 protected:
+    void DrawParallel(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList);
+    void PreparePackets(const RenderBatchArray& batchArray, uint32 begin, uint32 end);
+    void SetupPacket(RenderBatch* batch, NMaterial* material, rhi::Packet& packet) const;
+    uint32 DrawInstanced(Camera* camera, const RenderBatchArray& batchArray, uint32 first, rhi::HPacketList packetList);
+    uint32 GetInstancedLayout(uint32 layoutUID);
+
     eRenderLayerID layerID;
     uint32 sortFlags;
+
+    Vector<rhi::Packet> preparedPackets; // used by DrawParallel
+    UnorderedMap<uint32, uint32> instancedLayouts; // geometry layout -> layout with instance stream of world matrices
 };
 
 inline RenderLayer::eRenderLayerID RenderLayer::GetRenderLayerID() const
@@ -295,6 +295,8 @@ void RenderSystem::Update(float32 timeElapsed)
         hierarchyInitialized = true;
     }
 
+    geoDecalManager->Update();
+
     for (RenderObject* obj : markedObjects)
     {
         obj->RecalculateWorldBoundingBox();
@@ -2,9 +2,20 @@
 #include "Render/Image/ImageConverter.h"
 #include "Render/Image/Image.h"
 #include "Engine/Engine.h"
+#include "Concurrency/Semaphore.h"
+#include "Concurrency/Thread.h"
 #include "Functional/Function.h"
+#include "Job/JobManager.h"
 #include "Math/HalfFloat.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DAVA_IMAGE_CONVERT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DAVA_IMAGE_CONVERT_NEON
+#include <arm_neon.h>
+#endif
+
 namespace DAVA
 {
 uint32 ChannelFloatToInt(float32 ch)
@@ -18,100 +29,165 @@ float32 ChannelIntToFloat(uint32 ch)
     return (static_cast<float32>(ch) / std::numeric_limits<uint8>::max());
 }
 
-namespace ImageConvert
+namespace ImageConvertDetail
 {
-bool Normalize(PixelFormat format, const void* inData, uint32 width, uint32 height, uint32 pitch, void* outData)
+// Images with at least this number of pixels are processed by row bands on worker jobs
+const uint32 PARALLEL_MIN_PIXELS = 256 * 256;
+const uint32 PARALLEL_MIN_BAND_ROWS = 16;
+
+void ProcessRowBands(uint32 rowCount, uint32 rowPixels, const Function<void(uint32, uint32)>& processRows)
 {
-    bool processed = true;
-    switch (format)
+    // workers waiting for band jobs could occupy all workers, so images decoded on workers are processed in place
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 bandCount = 1;
+    if (jobManager != nullptr && Thread::IsMainThread() && rowCount * rowPixels >= PARALLEL_MIN_PIXELS)
     {
-    case FORMAT_RGBA8888:
+        bandCount = Min(jobManager->GetWorkersCount() + 1, rowCount / PARALLEL_MIN_BAND_ROWS);
+    }
+
+    if (bandCount <= 1)
     {
-        ConvertDirect<uint32, uint32, NormalizeRGBA8888> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
-        break;
+        processRows(0, rowCount);
+        return;
     }
-    case FORMAT_RGB16F:
+
+    // wait for own jobs only, so that unrelated worker jobs don't stall the conversion
+    Semaphore processed;
+    uint32 jobsCount = 0;
+    uint32 bandRows = (rowCount + bandCount - 1) / bandCount;
+    for (uint32 begin = bandRows; begin < rowCount; begin += bandRows)
     {
-        ConvertDirect<RGB16F, RGB16F, NormalizeRGB16F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
-        break;
+        uint32 end = Min(begin + bandRows, rowCount);
+        jobManager->CreateWorkerJob([&processRows, &processed, begin, end]() {
+            processRows(begin, end);
+            processed.Post();
+        });
+        ++jobsCount;
     }
-    case FORMAT_RGB32F:
+    processRows(0, bandRows);
+
+    for (uint32 i = 0; i < jobsCount; ++i)
     {
-        ConvertDirect<RGB32F, RGB32F, NormalizeRGB32F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
-        break;
+        processed.Wait();
     }
-    case FORMAT_RGBA16F:
+}
+
+// Swaps red and blue channels of `count` 32-bit pixels, `input` and `output` may point to the same row
+void SwapRedBlue8888(const uint8* input, uint8* output, uint32 count)
+{
+    uint32 i = 0;
+#if defined(DAVA_IMAGE_CONVERT_SSE2)
+    const __m128i maskGA = _mm_set1_epi32(0xFF00FF00);
+    const __m128i maskChannel = _mm_set1_epi32(0xFF);
+    for (; i + 4 <= count; i += 4)
     {
-        ConvertDirect<RGBA16F, RGBA16F, NormalizeRGBA16F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
-        break;
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4));
+        __m128i rb = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(p, maskChannel), 16), _mm_and_si128(_mm_srli_epi32(p, 16), maskChannel));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 4), _mm_or_si128(_mm_and_si128(p, maskGA), rb));
     }
-    case FORMAT_RGBA32F:
+#elif defined(DAVA_IMAGE_CONVERT_NEON)
+    for (; i + 16 <= count; i += 16)
     {
-        ConvertDirect<RGBA32F, RGBA32F, NormalizeRGBA32F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
-        break;
+        uint8x16x4_t p = vld4q_u8(input + i * 4);
+        uint8x16_t r = p.val[0];
+        p.val[0] = p.val[2];
+        p.val[2] = r;
+        vst4q_u8(output + i * 4, p);
     }
-    default:
-        Logger::Error("Normalize function not implemented for %s", PixelFormatDescriptor::GetPixelFormatString(format));
-        processed = false;
+#endif
+
+    ConvertBGRA8888toRGBA8888 func;
+    for (; i < count; ++i)
+    {
+        func(reinterpret_cast<const BGRA8888*>(input) + i, reinterpret_cast<RGBA8888*>(output) + i);
     }
-    return processed;
 }
 
-bool ConvertImage(const Image* srcImage, Image* dstImage)
+#if defined(DAVA_IMAGE_CONVERT_SSE2)
+inline __m128i PackRGBA4444x4(__m128i p)
 {
-    DVASSERT(srcImage);
-    DVASSERT(dstImage);
-    DVASSERT(srcImage->format != dstImage->format);
-    DVASSERT(srcImage->width == dstImage->width);
-    DVASSERT(srcImage->height == dstImage->height);
+    __m128i r = _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF0)), 8);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(p, 4), _mm_set1_epi32(0xF00));
+    __m128i b = _mm_and_si128(_mm_srli_epi32(p, 16), _mm_set1_epi32(0xF0));
+    __m128i a = _mm_srli_epi32(p, 28);
+    __m128i packed = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+    // sign extend 16-bit values, so that signed saturation in _mm_packs_epi32 keeps them as is
+    return _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+}
+#endif
 
-    PixelFormat srcFormat = srcImage->format;
-    PixelFormat dstFormat = dstImage->format;
+void ConvertRGBA8888toRGBA4444Row(const uint8* input, uint8* output, uint32 count)
+{
+    uint32 i = 0;
+#if defined(DAVA_IMAGE_CONVERT_SSE2)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = PackRGBA4444x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4)));
+        __m128i hi = PackRGBA4444x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4 + 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2), _mm_packs_epi32(lo, hi));
+    }
+#elif defined(DAVA_IMAGE_CONVERT_NEON)
+    const uint8x16_t highNibble = vdupq_n_u8(0xF0);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t p = vld4q_u8(input + i * 4);
+        uint8x16x2_t packed;
+        packed.val[0] = vorrq_u8(vandq_u8(p.val[2], highNibble), vshrq_n_u8(p.val[3], 4));
+        packed.val[1] = vorrq_u8(vandq_u8(p.val[0], highNibble), vshrq_n_u8(p.val[1], 4));
+        vst2q_u8(output + i * 2, packed);
+    }
+#endif
 
-    ImageConverter* imageConverter = GetEngineContext()->imageConverter;
-    if (imageConverter != nullptr)
+    ConvertRGBA8888toRGBA4444 func;
+    for (; i < count; ++i)
     {
-        if (imageConverter->CanConvert(srcFormat, dstFormat))
-        {
-            return imageConverter->Convert(srcImage, dstImage);
-        }
-        else if (imageConverter->CanConvert(srcFormat, PixelFormat::FORMAT_RGBA8888) && imageConverter->CanConvert(PixelFormat::FORMAT_RGBA8888, dstFormat))
-        {
-            ScopedPtr<Image> intermediateImage(Image::Create(srcImage->width, srcImage->height, FORMAT_RGBA8888));
-            return imageConverter->Convert(srcImage, intermediateImage) && imageConverter->Convert(intermediateImage, dstImage);
-        }
-        else if (imageConverter->CanConvert(srcFormat, PixelFormat::FORMAT_RGBA8888) && (dstFormat != FORMAT_RGBA8888))
+        func(reinterpret_cast<const uint32*>(input) + i, reinterpret_cast<uint16*>(output) + i);
+    }
+}
+
+// Averages 2x2 blocks of RGBA8888 pixels of `row0` and `row1` into `count` output pixels
+void DownscaleTwiceRGBA8888Row(const uint8* row0, const uint8* row1, uint8* output, uint32 count)
+{
+    uint32 i = 0;
+#if defined(DAVA_IMAGE_CONVERT_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i * 8));
+        __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i * 8));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(p0, zero), _mm_unpacklo_epi8(p1, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(p0, zero), _mm_unpackhi_epi8(p1, zero));
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        __m128i average = _mm_srli_epi16(_mm_unpacklo_epi64(lo, hi), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i * 4), _mm_packus_epi16(average, average));
+    }
+#elif defined(DAVA_IMAGE_CONVERT_NEON)
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x16x4_t p0 = vld4q_u8(row0 + i * 8);
+        uint8x16x4_t p1 = vld4q_u8(row1 + i * 8);
+        uint8x8x4_t average;
+        for (int32 c = 0; c < 4; ++c)
         {
-            ScopedPtr<Image> intermediateImage(Image::Create(srcImage->width, srcImage->height, FORMAT_RGBA8888));
-            return imageConverter->Convert(srcImage, intermediateImage) && ConvertImageDirect(intermediateImage, dstImage);
+            average.val[c] = vshrn_n_u16(vaddq_u16(vpaddlq_u8(p0.val[c]), vpaddlq_u8(p1.val[c])), 2);
         }
-        else if (imageConverter->CanConvert(PixelFormat::FORMAT_RGBA8888, dstFormat) && (srcFormat != FORMAT_RGBA8888))
+        vst4_u8(output + i * 4, average);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        for (uint32 c = 0; c < 4; ++c)
         {
-            ScopedPtr<Image> intermediateImage(Image::Create(srcImage->width, srcImage->height, FORMAT_RGBA8888));
-            return ConvertImageDirect(srcImage, intermediateImage) && imageConverter->Convert(intermediateImage, dstImage);
+            output[i * 4 + c] = static_cast<uint8>((row0[i * 8 + c] + row0[i * 8 + 4 + c] + row1[i * 8 + c] + row1[i * 8 + 4 + c]) / 4);
         }
     }
-
-    return ConvertImageDirect(srcImage, dstImage);
-}
-
-bool ConvertImageDirect(const Image* srcImage, Image* dstImage)
-{
-    return ConvertImageDirect(srcImage->format, dstImage->format,
-                              srcImage->data, srcImage->width, srcImage->height,
-                              ImageUtils::GetPitchInBytes(srcImage->width, srcImage->format),
-                              dstImage->data, dstImage->width, dstImage->height,
-                              ImageUtils::GetPitchInBytes(dstImage->width, dstImage->format));
 }
 
-bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
-                        const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
-                        void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+bool ConvertRows(PixelFormat inFormat, PixelFormat outFormat,
+                 const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                 void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
 {
     if (inFormat == FORMAT_RGBA5551 && outFormat == FORMAT_RGBA8888)
     {
@@ -163,8 +239,18 @@ bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
     }
     else if (inFormat == FORMAT_BGRA8888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        for (uint32 y = 0; y < inHeight; ++y)
+        {
+            SwapRedBlue8888(static_cast<const uint8*>(inData) + y * inPitch, static_cast<uint8*>(outData) + y * outPitch, inWidth);
+        }
+        return true;
+    }
+    else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGBA4444)
+    {
+        for (uint32 y = 0; y < inHeight; ++y)
+        {
+            ConvertRGBA8888toRGBA4444Row(static_cast<const uint8*>(inData) + y * inPitch, static_cast<uint8*>(outData) + y * outPitch, inWidth);
+        }
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGB888)
@@ -216,6 +302,197 @@ bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
     }
 }
 
+bool DownscaleRows(PixelFormat inFormat, PixelFormat outFormat,
+                   const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                   void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize)
+{
+    if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888))
+    {
+        if (normalize)
+        {
+            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888> convert;
+            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        }
+        else if (inWidth > outWidth && inHeight > outHeight)
+        {
+            for (uint32 y = 0; y < outHeight; ++y)
+            {
+                const uint8* row0 = static_cast<const uint8*>(inData) + y * 2 * inPitch;
+                DownscaleTwiceRGBA8888Row(row0, row0 + inWidth * 4, static_cast<uint8*>(outData) + y * outPitch, outWidth);
+            }
+        }
+        else
+        {
+            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
+            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        }
+    }
+    else if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA4444))
+    {
+        ConvertDownscaleTwiceBillinear<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA4444) && (outFormat == FORMAT_RGBA8888))
+    {
+        ConvertDownscaleTwiceBillinear<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_A8) && (outFormat == FORMAT_A8))
+    {
+        ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGB888) && (outFormat == FORMAT_RGB888))
+    {
+        ConvertDownscaleTwiceBillinear<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA5551) && (outFormat == FORMAT_RGBA5551))
+    {
+        ConvertDownscaleTwiceBillinear<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA16161616) && (outFormat == FORMAT_RGBA16161616))
+    {
+        ConvertDownscaleTwiceBillinear<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA32323232) && (outFormat == FORMAT_RGBA32323232))
+    {
+        ConvertDownscaleTwiceBillinear<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA16F) && (outFormat == FORMAT_RGBA16F))
+    {
+        ConvertDownscaleTwiceBillinear<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else if ((inFormat == FORMAT_RGBA32F) && (outFormat == FORMAT_RGBA32F))
+    {
+        ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
+        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+    }
+    else
+    {
+        Logger::Error("Downscale from %s to %s is not implemented", PixelFormatDescriptor::GetPixelFormatString(inFormat), PixelFormatDescriptor::GetPixelFormatString(outFormat));
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace ImageConvertDetail
+
+namespace ImageConvert
+{
+bool Normalize(PixelFormat format, const void* inData, uint32 width, uint32 height, uint32 pitch, void* outData)
+{
+    bool processed = true;
+    switch (format)
+    {
+    case FORMAT_RGBA8888:
+    {
+        ConvertDirect<uint32, uint32, NormalizeRGBA8888> convert;
+        convert(inData, width, height, pitch, outData, width, height, pitch);
+        break;
+    }
+    case FORMAT_RGB16F:
+    {
+        ConvertDirect<RGB16F, RGB16F, NormalizeRGB16F> convert;
+        convert(inData, width, height, pitch, outData, width, height, pitch);
+        break;
+    }
+    case FORMAT_RGB32F:
+    {
+        ConvertDirect<RGB32F, RGB32F, NormalizeRGB32F> convert;
+        convert(inData, width, height, pitch, outData, width, height, pitch);
+        break;
+    }
+    case FORMAT_RGBA16F:
+    {
+        ConvertDirect<RGBA16F, RGBA16F, NormalizeRGBA16F> convert;
+        convert(inData, width, height, pitch, outData, width, height, pitch);
+        break;
+    }
+    case FORMAT_RGBA32F:
+    {
+        ConvertDirect<RGBA32F, RGBA32F, NormalizeRGBA32F> convert;
+        convert(inData, width, height, pitch, outData, width, height, pitch);
+        break;
+    }
+    default:
+        Logger::Error("Normalize function not implemented for %s", PixelFormatDescriptor::GetPixelFormatString(format));
+        processed = false;
+    }
+    return processed;
+}
+
+bool ConvertImage(const Image* srcImage, Image* dstImage)
+{
+    DVASSERT(srcImage);
+    DVASSERT(dstImage);
+    DVASSERT(srcImage->format != dstImage->format);
+    DVASSERT(srcImage->width == dstImage->width);
+    DVASSERT(srcImage->height == dstImage->height);
+
+    PixelFormat srcFormat = srcImage->format;
+    PixelFormat dstFormat = dstImage->format;
+
+    ImageConverter* imageConverter = GetEngineContext()->imageConverter;
+    if (imageConverter != nullptr)
+    {
+        if (imageConverter->CanConvert(srcFormat, dstFormat))
+        {
+            return imageConverter->Convert(srcImage, dstImage);
+        }
+        else if (imageConverter->CanConvert(srcFormat, PixelFormat::FORMAT_RGBA8888) && imageConverter->CanConvert(PixelFormat::FORMAT_RGBA8888, dstFormat))
+        {
+            ScopedPtr<Image> intermediateImage(Image::Create(srcImage->width, srcImage->height, FORMAT_RGBA8888));
+            return imageConverter->Convert(srcImage, intermediateImage) && imageConverter->Convert(intermediateImage, dstImage);
+        }
+        else if (imageConverter->CanConvert(srcFormat, PixelFormat::FORMAT_RGBA8888) && (dstFormat != FORMAT_RGBA8888))
+        {
+            ScopedPtr<Image> intermediateImage(Image::Create(srcImage->width, srcImage->height, FORMAT_RGBA8888));
+            return imageConverter->Convert(srcImage, intermediateImage) && ConvertImageDirect(intermediateImage, dstImage);
+        }
+        else if (imageConverter->CanConvert(PixelFormat::FORMAT_RGBA8888, dstFormat) && (srcFormat != FORMAT_RGBA8888))
+        {
+            ScopedPtr<Image> intermediateImage(Image::Create(srcImage->width, srcImage->height, FORMAT_RGBA8888));
+            return ConvertImageDirect(srcImage, intermediateImage) && imageConverter->Convert(intermediateImage, dstImage);
+        }
+    }
+
+    return ConvertImageDirect(srcImage, dstImage);
+}
+
+bool ConvertImageDirect(const Image* srcImage, Image* dstImage)
+{
+    return ConvertImageDirect(srcImage->format, dstImage->format,
+                              srcImage->data, srcImage->width, srcImage->height,
+                              ImageUtils::GetPitchInBytes(srcImage->width, srcImage->format),
+                              dstImage->data, dstImage->width, dstImage->height,
+                              ImageUtils::GetPitchInBytes(dstImage->width, dstImage->format));
+}
+
+bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
+                        const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                        void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    using namespace ImageConvertDetail;
+
+    if (!ConvertRows(inFormat, outFormat, nullptr, 0, 0, 0, nullptr, 0, 0, 0))
+    {
+        return false;
+    }
+
+    const uint8* inBytes = static_cast<const uint8*>(inData);
+    uint8* outBytes = static_cast<uint8*>(outData);
+    ProcessRowBands(inHeight, inWidth, [&](uint32 begin, uint32 end) {
+        ConvertRows(inFormat, outFormat, inBytes + begin * inPitch, inWidth, end - begin, inPitch, outBytes + begin * outPitch, outWidth, end - begin, outPitch);
+    });
+    return true;
+}
+
 bool CanConvertDirect(PixelFormat inFormat, PixelFormat outFormat)
 {
     return ConvertImageDirect(inFormat, outFormat, nullptr, 0, 0, 0, nullptr, 0, 0, 0);
@@ -278,8 +555,14 @@ void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32
     }
     case FORMAT_RGBA8888:
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> swap;
-        swap(srcData, width, height, pitch, dstData);
+        const uint8* srcBytes = static_cast<const uint8*>(srcData);
+        uint8* dstBytes = static_cast<uint8*>(dstData);
+        ImageConvertDetail::ProcessRowBands(height, width, [&](uint32 begin, uint32 end) {
+            for (uint32 y = begin; y < end; ++y)
+            {
+                ImageConvertDetail::SwapRedBlue8888(srcBytes + y * pitch, dstBytes + y * pitch, width);
+            }
+        });
         return;
     }
     case FORMAT_RGBA4444:
@@ -324,70 +607,21 @@ bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
                              const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
                              void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize)
 {
-    if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888))
-    {
-        if (normalize)
-        {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-        }
-        else
-        {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-        }
-    }
-    else if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA4444))
-    {
-        ConvertDownscaleTwiceBillinear<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGBA4444) && (outFormat == FORMAT_RGBA8888))
-    {
-        ConvertDownscaleTwiceBillinear<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_A8) && (outFormat == FORMAT_A8))
-    {
-        ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGB888) && (outFormat == FORMAT_RGB888))
-    {
-        ConvertDownscaleTwiceBillinear<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGBA5551) && (outFormat == FORMAT_RGBA5551))
-    {
-        ConvertDownscaleTwiceBillinear<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGBA16161616) && (outFormat == FORMAT_RGBA16161616))
-    {
-        ConvertDownscaleTwiceBillinear<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGBA32323232) && (outFormat == FORMAT_RGBA32323232))
-    {
-        ConvertDownscaleTwiceBillinear<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGBA16F) && (outFormat == FORMAT_RGBA16F))
-    {
-        ConvertDownscaleTwiceBillinear<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else if ((inFormat == FORMAT_RGBA32F) && (outFormat == FORMAT_RGBA32F))
-    {
-        ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
-    }
-    else
+    using namespace ImageConvertDetail;
+
+    if (!DownscaleRows(inFormat, outFormat, nullptr, 0, 0, 0, nullptr, 0, 0, 0, normalize))
     {
-        Logger::Error("Downscale from %s to %s is not implemented", PixelFormatDescriptor::GetPixelFormatString(inFormat), PixelFormatDescriptor::GetPixelFormatString(outFormat));
         return false;
     }
 
+    // every output row is made of two input rows, unless there is only one input row
+    const bool halveRows = inHeight > outHeight;
+    const uint8* inBytes = static_cast<const uint8*>(inData);
+    uint8* outBytes = static_cast<uint8*>(outData);
+    ProcessRowBands(outHeight, outWidth, [&](uint32 begin, uint32 end) {
+        uint32 rows = end - begin;
+        DownscaleRows(inFormat, outFormat, inBytes + begin * 2 * inPitch, inWidth, halveRows ? rows * 2 : rows, inPitch, outBytes + begin * outPitch, outWidth, rows, outPitch, normalize);
+    });
     return true;
 }
 
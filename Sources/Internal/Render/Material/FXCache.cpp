@@ -27,6 +27,8 @@ Mutex fxCacheMutex;
 namespace FXCache
 {
 const FXDescriptor& LoadFXFromOldTemplate(const FastName& fxName, UnorderedMap<FastName, int32>& defines, const Vector<size_t>& key, const FastName& quality);
+const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& quality);
+UnorderedMap<FastName, int32> BuildShaderDefines(const RenderPassDescriptor& pass, const UnorderedMap<FastName, int32>& defines);
 
 void Initialize()
 {
@@ -85,6 +87,23 @@ const FXDescriptor& GetFXDescriptor(const FastName& fxName, UnorderedMap<FastNam
     return LoadFXFromOldTemplate(fxName, defines, key, quality);
 }
 
+void CollectShaderVariants(const FastName& fxName, const UnorderedMap<FastName, int32>& defines, const FastName& quality, Vector<ShaderDescriptorCache::ShaderVariant>& variants)
+{
+    using namespace FXCacheDetails;
+
+    DVASSERT(initialized);
+
+    LockGuard<Mutex> guard(FXCacheDetails::fxCacheMutex);
+    const FXDescriptor& fx = fxName.IsValid() ? LoadOldTempalte(fxName, quality) : FXCacheDetails::defaultFX;
+    for (const RenderPassDescriptor& pass : fx.renderPassDescriptors)
+    {
+        ShaderDescriptorCache::ShaderVariant variant;
+        variant.name = pass.shaderFileName;
+        variant.defines = fxName.IsValid() ? BuildShaderDefines(pass, defines) : pass.templateDefines;
+        variants.push_back(std::move(variant));
+    }
+}
+
 const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& quality)
 {
     using namespace FXCacheDetails;
@@ -369,24 +388,29 @@ const FXDescriptor& LoadFXFromOldTemplate(const FastName& fxName, UnorderedMap<F
     target.defines = defines; //combine
     for (auto& pass : target.renderPassDescriptors)
     {
-        UnorderedMap<FastName, int32> shaderDefines = defines;
-        for (auto& templateDefine : pass.templateDefines)
-            shaderDefines[templateDefine.first] = templateDefine.second;
-        if (pass.hasBlend)
-        {
-            if (shaderDefines.find(NMaterialFlagName::FLAG_BLENDING) == shaderDefines.end())
-                shaderDefines[NMaterialFlagName::FLAG_BLENDING] = BLENDING_ALPHABLEND;
-        }
-        else
-        {
-            shaderDefines.erase(NMaterialFlagName::FLAG_BLENDING);
-        }
-
+        UnorderedMap<FastName, int32> shaderDefines = BuildShaderDefines(pass, defines);
         pass.shader = ShaderDescriptorCache::GetShaderDescriptor(pass.shaderFileName, shaderDefines);
         pass.depthStencilState = rhi::AcquireDepthStencilState(pass.depthStateDescriptor);
     }
 
     return FXCacheDetails::fxDescriptors[key] = target;
 }
+
+UnorderedMap<FastName, int32> BuildShaderDefines(const RenderPassDescriptor& pass, const UnorderedMap<FastName, int32>& defines)
+{
+    UnorderedMap<FastName, int32> shaderDefines = defines;
+    for (auto& templateDefine : pass.templateDefines)
+        shaderDefines[templateDefine.first] = templateDefine.second;
+    if (pass.hasBlend)
+    {
+        if (shaderDefines.find(NMaterialFlagName::FLAG_BLENDING) == shaderDefines.end())
+            shaderDefines[NMaterialFlagName::FLAG_BLENDING] = BLENDING_ALPHABLEND;
+    }
+    else
+    {
+        shaderDefines.erase(NMaterialFlagName::FLAG_BLENDING);
+    }
+    return shaderDefines;
+}
 }
 }
@@ -2,6 +2,7 @@
 #define __DAVAENGINE_FXCACHE_H__
 
 #include "Render/Shader.h"
+#include "Render/ShaderCache.h"
 #include "Render/RHI/rhi_Type.h"
 #include "Render/Highlevel/RenderLayer.h"
 
@@ -36,6 +37,9 @@ void Initialize();
 void Uninitialize();
 void Clear();
 const FXDescriptor& GetFXDescriptor(const FastName& fxName, UnorderedMap<FastName, int32>& defines, const FastName& quality = NMaterialQualityName::DEFAULT_QUALITY_NAME);
+
+// adds shader variants of every pass of fx without creating shaders and render states
+void CollectShaderVariants(const FastName& fxName, const UnorderedMap<FastName, int32>& defines, const FastName& quality, Vector<ShaderDescriptorCache::ShaderVariant>& variants);
 }
 }
 
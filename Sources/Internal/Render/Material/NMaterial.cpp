@@ -154,9 +154,12 @@ NMaterial::~NMaterial()
 
 void NMaterial::BindParams(rhi::Packet& target)
 {
-    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+    BindPacketState(target);
+    UpdateConstBuffers();
+}
 
-    //Logger::Info( "bind-params" );
+void NMaterial::BindPacketState(rhi::Packet& target) const
+{
     DVASSERT(activeVariantInstance); //trying to bind material that was not staged to render
     DVASSERT(activeVariantInstance->shader); //should have returned false on PreBuild!
     DVASSERT(activeVariantInstance->shader->IsValid()); //should have returned false on PreBuild!
@@ -182,6 +185,21 @@ void NMaterial::BindParams(rhi::Packet& target)
     else
         target.userFlags &= ~USER_FLAG_ALPHATEST;
 
+    target.vertexConstCount = static_cast<uint32>(activeVariantInstance->vertexConstBuffers.size());
+    target.fragmentConstCount = static_cast<uint32>(activeVariantInstance->fragmentConstBuffers.size());
+    /*bind material const buffers*/
+    for (size_t i = 0, sz = activeVariantInstance->vertexConstBuffers.size(); i < sz; ++i)
+        target.vertexConst[i] = activeVariantInstance->vertexConstBuffers[i];
+    for (size_t i = 0, sz = activeVariantInstance->fragmentConstBuffers.size(); i < sz; ++i)
+        target.fragmentConst[i] = activeVariantInstance->fragmentConstBuffers[i];
+}
+
+void NMaterial::UpdateConstBuffers()
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    DVASSERT(activeVariantInstance); //trying to bind material that was not staged to render
+
     activeVariantInstance->shader->UpdateDynamicParams();
     /*update values in material const buffers*/
     for (auto& materialBufferBinding : activeVariantInstance->materialBufferBindings)
@@ -214,14 +232,6 @@ void NMaterial::BindParams(rhi::Packet& target)
         }
         materialBufferBinding->lastValidPropertySemantic = NMaterialProperty::GetCurrentUpdateSemantic();
     }
-
-    target.vertexConstCount = static_cast<uint32>(activeVariantInstance->vertexConstBuffers.size());
-    target.fragmentConstCount = static_cast<uint32>(activeVariantInstance->fragmentConstBuffers.size());
-    /*bind material const buffers*/
-    for (size_t i = 0, sz = activeVariantInstance->vertexConstBuffers.size(); i < sz; ++i)
-        target.vertexConst[i] = activeVariantInstance->vertexConstBuffers[i];
-    for (size_t i = 0, sz = activeVariantInstance->fragmentConstBuffers.size(); i < sz; ++i)
-        target.fragmentConst[i] = activeVariantInstance->fragmentConstBuffers[i];
 }
 
 uint32 NMaterial::GetRequiredVertexFormat()
@@ -813,6 +823,20 @@ void NMaterial::PreCacheFXVariations(const Vector<FastName>& fxNames, const Vect
     }
 }
 
+void NMaterial::CollectShaderVariants(Vector<ShaderDescriptorCache::ShaderVariant>& variants)
+{
+    UnorderedMap<FastName, int32> flags(16);
+    CollectMaterialFlags(flags);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    if (!rhi::DeviceCaps().isInstancingSupported)
+    {
+        flags.erase(NMaterialFlagName::FLAG_AUTO_INSTANCING);
+    }
+    FXCache::CollectShaderVariants(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()), variants);
+}
+
 void NMaterial::RebuildRenderVariants()
 {
     InvalidateBufferBindings();
@@ -822,6 +846,11 @@ void NMaterial::RebuildRenderVariants()
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    // without instancing support material is drawn through the regular path with regular shader
+    if (!rhi::DeviceCaps().isInstancingSupported)
+    {
+        flags.erase(NMaterialFlagName::FLAG_AUTO_INSTANCING);
+    }
     const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
 
     if (fxDescr.renderPassDescriptors.size() == 0)
@@ -849,6 +878,7 @@ void NMaterial::RebuildRenderVariants()
         variant->wireFrame = variantDescr.wireframe;
         variant->alphablend = variantDescr.hasBlend;
         variant->alphatest = (variantDescr.templateDefines.count(FastName("ALPHATEST")) != 0);
+        variant->autoInstancing = (flags.count(NMaterialFlagName::FLAG_AUTO_INSTANCING) != 0);
         renderVariants[variantDescr.passName] = variant;
     }
 
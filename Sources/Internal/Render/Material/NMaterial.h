@@ -7,6 +7,7 @@
 #include "NMaterialStateDynamicPropertiesInsp.h"
 #include "NMaterialStateDynamicTexturesInsp.h"
 #include "Render/Shader.h"
+#include "Render/ShaderCache.h"
 #include "Scene3D/DataNode.h"
 
 #include "MemoryManager/MemoryProfiler.h"
@@ -75,6 +76,7 @@ class RenderVariantInstance
     bool wireFrame = false;
     bool alphablend = false;
     bool alphatest = false;
+    bool autoInstancing = false;
 
     RenderVariantInstance() = default;
     RenderVariantInstance(const RenderVariantInstance&) = delete;
@@ -157,6 +159,7 @@ public:
     const Vector<NMaterial*>& GetChildren() const;
 
     inline uint32 GetRenderLayerID() const;
+    inline bool IsAutoInstancingEnabled() const;
     inline uint32 GetSortingKey() const;
 
     //Configs managment
@@ -178,6 +181,12 @@ public:
 
     void BindParams(rhi::Packet& target);
 
+    // BindParams split in two parts:
+    // BindPacketState fills pipeline, render states and const buffer handles, only reads material and can be called from any thread
+    // UpdateConstBuffers uploads changed dynamic and material properties, should be called on render thread right before adding packet
+    void BindPacketState(rhi::Packet& target) const;
+    void UpdateConstBuffers();
+
     // returns true if has variant for this pass, false otherwise
     // if material doesn't support pass active variant will be not changed
     // later add engine flags here
@@ -187,6 +196,8 @@ public:
     void PreCacheFX();
     void PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName = FastName());
     void PreCacheFXVariations(const Vector<FastName>& fxNames, const Vector<FastName>& flags);
+    // adds shader variants used by material passes without building them, see ShaderDescriptorCache::BuildShaderSources
+    void CollectShaderVariants(Vector<ShaderDescriptorCache::ShaderVariant>& variants);
 
     static const float32 DEFAULT_LIGHTMAP_SIZE;
 
@@ -282,6 +293,10 @@ uint32 NMaterial::GetRenderLayerID() const
     else
         return static_cast<uint32>(-1);
 }
+bool NMaterial::IsAutoInstancingEnabled() const
+{
+    return (activeVariantInstance != nullptr) && activeVariantInstance->autoInstancing;
+}
 uint32 NMaterial::GetSortingKey() const
 {
     return sortingKey;
@@ -221,6 +221,8 @@ const FastName NMaterialFlagName::FLAG_PARTICLES_DEBUG_SHOW_HEATMAP = FastName("
 const FastName NMaterialFlagName::FLAG_GEO_DECAL = FastName("GEO_DECAL");
 const FastName NMaterialFlagName::FLAG_GEO_DECAL_SPECULAR = FastName("GEO_DECAL_SPECULAR");
 
+const FastName NMaterialFlagName::FLAG_AUTO_INSTANCING = FastName("AUTO_INSTANCING");
+
 //quality
 const FastName NMaterialQualityName::QUALITY_FLAG_NAME = FastName("Quality");
 const FastName NMaterialQualityName::QUALITY_GROUP_FLAG_NAME = FastName("QualityGroup");
@@ -236,6 +236,8 @@ public:
     static const FastName FLAG_GEO_DECAL;
     static const FastName FLAG_GEO_DECAL_SPECULAR;
 
+    static const FastName FLAG_AUTO_INSTANCING;
+
     static const FastName FLAG_FORCED_SHADOW_DIRECTION;
 
     static bool IsRuntimeFlag(const FastName& flag);
@@ -9,6 +9,9 @@ using DAVA::Logger;
 #include "FileSystem/DynamicMemoryFile.h"
 #include "FileSystem/FileSystem.h"
 using DAVA::DynamicMemoryFile;
+#include "Compression/LZ4Compressor.h"
+#include "Utils/CRC32.h"
+#include "Time/SystemTimer.h"
 #include "Utils/Utils.h"
 #include "Utils/StringFormat.h"
 #include "Debug/ProfilerCPU.h"
@@ -29,117 +32,96 @@ namespace rhi
 {
 //==============================================================================
 
-class ShaderFileCallback : public DAVA::PreProc::FileCallback
+// include files are read once and shared by all shaders being constructed, possibly on different threads
+class ShaderIncludeCache
 {
 public:
-    ShaderFileCallback(const char* base_dir)
-    {
-        inclDir.emplace_back(base_dir);
-    }
+    using FileData = std::shared_ptr<const std::vector<char>>;
 
-    ~ShaderFileCallback()
+    ShaderIncludeCache(const char* base_dir)
     {
-        ClearCache();
+        inclDir.emplace_back(base_dir);
     }
 
-    bool Open(const char* file_name) override
+    FileData Get(const char* file_name)
     {
-        bool success = false;
+        LockGuard<Mutex> guard(mutex);
 
-        for (size_t k = 0; k != _file.size(); ++k)
-        {
-            if (_file[k].name == file_name)
-            {
-                _cur_data = _file[k].data;
-                _cur_data_sz = _file[k].data_sz;
-                success = true;
-                break;
-            }
-        }
+        auto f = file.find(file_name);
+        if (f != file.end())
+            return f->second;
 
-        if (!success)
+        for (const std::string& d : inclDir)
         {
-            DAVA::File* in = nullptr;
-
-            for (const std::string& d : inclDir)
-            {
-                in = DAVA::File::Create(d + "/" + file_name, DAVA::File::READ | DAVA::File::OPEN);
-
-                if (in)
-                    break;
-            }
+            DAVA::ScopedPtr<DAVA::File> in(DAVA::File::Create(d + "/" + file_name, DAVA::File::READ | DAVA::File::OPEN));
 
             if (in)
             {
-                file_t f;
+                std::shared_ptr<std::vector<char>> data = std::make_shared<std::vector<char>>(size_t(in->GetSize()));
+                in->Read(data->data(), unsigned(data->size()));
 
-                f.name = file_name;
-                f.data_sz = unsigned(in->GetSize());
-                f.data = ::malloc(f.data_sz);
-
-                in->Read(f.data, f.data_sz);
-                in->Release();
-
-                _file.push_back(f);
-                _cur_data = f.data;
-                _cur_data_sz = f.data_sz;
-
-                success = true;
+                file[file_name] = data;
+                return data;
             }
         }
 
-        return success;
+        return FileData();
     }
 
-    void Close() override
+    void AddIncludeDirectory(const char* dir)
     {
-        _cur_data = nullptr;
-        _cur_data_sz = 0;
+        LockGuard<Mutex> guard(mutex);
+        inclDir.emplace_back(dir);
     }
 
-    unsigned Size() const override
+    void Clear()
     {
-        return _cur_data_sz;
+        // data still used by pre-processors is kept alive by them
+        LockGuard<Mutex> guard(mutex);
+        file.clear();
     }
 
-    unsigned Read(unsigned max_sz, void* dst) override
+private:
+    Mutex mutex;
+    std::vector<std::string> inclDir;
+    DAVA::UnorderedMap<std::string, FileData> file;
+};
+
+static ShaderIncludeCache ShaderIncludes("~res:/Materials/Shaders");
+
+//------------------------------------------------------------------------------
+
+class ShaderFileCallback : public DAVA::PreProc::FileCallback
+{
+public:
+    bool Open(const char* file_name) override
     {
-        DVASSERT(_cur_data);
-        DVASSERT(max_sz <= _cur_data_sz);
-        memcpy(dst, _cur_data, max_sz);
-        return max_sz;
+        _cur_file = ShaderIncludes.Get(file_name);
+        return (_cur_file != nullptr);
     }
 
-    void AddIncludeDirectory(const char* dir)
+    void Close() override
     {
-        inclDir.emplace_back(dir);
+        _cur_file.reset();
     }
 
-    void ClearCache()
+    unsigned Size() const override
     {
-        for (size_t k = 0; k != _file.size(); ++k)
-        {
-            ::free(_file[k].data);
-        }
-        _file.clear();
+        return (_cur_file) ? unsigned(_cur_file->size()) : 0;
     }
 
-private:
-    struct file_t
+    unsigned Read(unsigned max_sz, void* dst) override
     {
-        std::string name;
-        unsigned data_sz;
-        void* data;
-    };
-    std::vector<file_t> _file;
-    const void* _cur_data;
-    unsigned _cur_data_sz;
+        DVASSERT(_cur_file);
+        DVASSERT(max_sz <= _cur_file->size());
+        memcpy(dst, _cur_file->data(), max_sz);
+        return max_sz;
+    }
 
-    std::vector<std::string> inclDir;
+private:
+    ShaderIncludeCache::FileData _cur_file;
 };
 
-static ShaderFileCallback ShaderSourceFileCallback("~res:/Materials/Shaders");
-
 //==============================================================================
 
 ShaderSource::ShaderSource(const char* filename)
@@ -169,9 +151,17 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText)
 //------------------------------------------------------------------------------
 
 bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines)
+{
+    return ShaderSource::Construct(progType, srcText, defines, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api targetApi)
 {
     bool success = false;
-    DAVA::PreProc pre_proc(&ShaderSourceFileCallback);
+    ShaderFileCallback fileCallback;
+    DAVA::PreProc pre_proc(&fileCallback);
     std::vector<char> src;
 
     DVASSERT(defines.size() % 2 == 0);
@@ -217,7 +207,8 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
         }
         #endif
 
-        static sl::Allocator alloc;
+        // tree refers to allocator, so it is deleted before leaving this scope
+        sl::Allocator alloc;
         sl::HLSLParser parser(&alloc, "<shader>", src.data(), src.size());
         ast = new sl::HLSLTree(&alloc);
 
@@ -241,12 +232,16 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
             else
             {
                 DAVA::Logger::Error("missing entry-point function '%s'", entryName);
+                delete ast;
+                ast = nullptr;
                 return false;
             }
 
             if (!hasReturn)
             {
                 DAVA::Logger::Error("entry-point function '%s' has no return statement", entryName);
+                delete ast;
+                ast = nullptr;
                 return false;
             }
 
@@ -257,7 +252,7 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
                 InlineFunctions();
 
             // ugly workaround to save some memory
-            GetSourceCode(HostApi());
+            GetSourceCode(targetApi);
             delete ast;
             ast = nullptr;
         }
@@ -1742,10 +1737,11 @@ const DAVA::String& ShaderSource::GetSourceCode(Api targetApi) const
 
     if (code[targetApi].empty() && (ast != nullptr))
     {
-        static sl::Allocator alloc;
-        static sl::HLSLGenerator hlsl_gen(&alloc);
-        static sl::GLESGenerator gles_gen(&alloc);
-        static sl::MSLGenerator mtl_gen(&alloc);
+        // generators keep state, so they are created per call to allow translation on several threads
+        sl::Allocator alloc;
+        sl::HLSLGenerator hlsl_gen(&alloc);
+        sl::GLESGenerator gles_gen(&alloc);
+        sl::MSLGenerator mtl_gen(&alloc);
 
         bool codeGenerated = false;
         const char* main = (type == PROG_VERTEX) ? "vp_main" : "fp_main";
@@ -1898,12 +1894,12 @@ void ShaderSource::Reset()
 
 void ShaderSource::AddIncludeDirectory(const char* dir)
 {
-    ShaderSourceFileCallback.AddIncludeDirectory(dir);
+    ShaderIncludes.AddIncludeDirectory(dir);
 }
 
 void ShaderSource::PurgeIncludesCache()
 {
-    ShaderSourceFileCallback.ClearCache();
+    ShaderIncludes.Clear();
 }
 
 //------------------------------------------------------------------------------
@@ -2018,68 +2014,170 @@ void ShaderSource::Dump() const
 //6 is after fixing Add/Update problem
 //7 is after MCPP replaced with in-house pre-processor
 //8 blend-state
-const uint32 ShaderSourceCache::FormatVersion = 8;
+//9 sorted index, lz4-compressed entries, api and shader compiler hash in header
+const uint32 ShaderSourceCache::FormatVersion = 9;
+
+namespace ShaderSourceCacheDetails
+{
+// increase corresponding number after changing output of pre-processor, parser or any of generators,
+// so that sources built by previous compiler are not taken from cache
+const char* const CompilerId = "preproc-1 parser-1 hlsl-1 gles-1 msl-1";
+
+bool EntryLess(const FastName& lUid, uint32 lApi, const FastName& rUid, uint32 rApi)
+{
+    int cmp = strcmp(lUid.c_str(), rUid.c_str());
+    return (cmp < 0) || (cmp == 0 && lApi < rApi);
+}
+}
 
 Mutex shaderSourceEntryMutex;
+Mutex shaderSourceCacheFileMutex; // guards CacheFile and CacheDataOffset, locked after shaderSourceEntryMutex if both are needed
 std::vector<ShaderSourceCache::entry_t> ShaderSourceCache::Entry;
+DAVA::File* ShaderSourceCache::CacheFile = nullptr;
+uint32 ShaderSourceCache::CacheDataOffset = 0;
+
+uint32 ShaderSourceCache::CompilerHash()
+{
+    return DAVA::HashValue_N(ShaderSourceCacheDetails::CompilerId, unsigned(strlen(ShaderSourceCacheDetails::CompilerId)));
+}
+
+//------------------------------------------------------------------------------
+
+std::vector<ShaderSourceCache::entry_t>::iterator ShaderSourceCache::LowerBound(FastName uid, uint32 api)
+{
+    return std::lower_bound(Entry.begin(), Entry.end(), uid, [api](const entry_t& e, const FastName& uid) {
+        return ShaderSourceCacheDetails::EntryLess(e.uid, e.api, uid, api);
+    });
+}
+
+//------------------------------------------------------------------------------
+
+ShaderSource* ShaderSourceCache::LoadData(const entry_t& e)
+{
+    using namespace DAVA;
+
+    Vector<uint8> packed(e.packedSize);
+    Vector<uint8> unpacked(e.unpackedSize);
+
+    bool success = false;
+    {
+        LockGuard<Mutex> guard(shaderSourceCacheFileMutex);
+        success = (CacheFile != nullptr)
+        && CacheFile->Seek(CacheDataOffset + e.dataOffset, File::SEEK_FROM_START)
+        && (CacheFile->Read(packed.data(), e.packedSize) == e.packedSize);
+    }
+
+    success = success
+    && (CRC32::ForBuffer(packed) == e.dataCRC)
+    && LZ4Compressor().Decompress(packed, unpacked);
+
+    ShaderSource* src = nullptr;
+    if (success)
+    {
+        ScopedPtr<DynamicMemoryFile> data(DynamicMemoryFile::Create(unpacked.data(), int32(unpacked.size()), File::OPEN | File::READ));
+        src = new ShaderSource();
+        success = src->Load(Api(e.api), data);
+    }
+
+    if (!success)
+    {
+        Logger::Warning("ShaderSource-Cache entry \"%s\" is corrupted, ignoring it\n", e.uid.c_str());
+        SafeDelete(src);
+    }
+
+    return src;
+}
+
+//------------------------------------------------------------------------------
 
 const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 {
-    LockGuard<Mutex> guard(shaderSourceEntryMutex);
+    return Get(uid, srcHash, HostApi());
+}
+
+//------------------------------------------------------------------------------
 
+const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash, Api api)
+{
     //    Logger::Info("get-shader-src (host-api = %i)",HostApi());
     //    Logger::Info("  uid= \"%s\"",uid.c_str());
-    const ShaderSource* src = nullptr;
-    Api api = HostApi();
+    entry_t packedEntry;
+    {
+        LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
-    for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        std::vector<entry_t>::iterator e = LowerBound(uid, api);
+        if (e == Entry.end() || e->uid != uid || e->api != uint32(api) || e->srcHash != srcHash)
+            return nullptr;
+
+        if (e->src != nullptr || e->packedSize == 0)
+            return e->src;
+
+        packedEntry = *e;
+    }
+
+    // read and unpack outside of entry lock, so that other sources can be got or added meanwhile
+    ShaderSource* src = LoadData(packedEntry);
+
+    LockGuard<Mutex> guard(shaderSourceEntryMutex);
+
+    std::vector<entry_t>::iterator e = LowerBound(uid, api);
+    if (e != Entry.end() && e->uid == uid && e->api == uint32(api) && e->srcHash == srcHash)
     {
-        if (e->uid == uid && e->api == api && e->srcHash == srcHash)
+        if (e->src == nullptr && src != nullptr)
         {
-            src = e->src;
-            break;
+            e->src = src;
+            return src;
+        }
+
+        if (e->src == nullptr && e->dataOffset == packedEntry.dataOffset && e->packedSize == packedEntry.packedSize)
+        {
+            // entry will be rebuilt from source text
+            e->packedSize = 0;
         }
+
+        // entry may be unpacked by other thread or added meanwhile
+        DAVA::SafeDelete(src);
+        return e->src;
     }
-    //    Logger::Info("  %s",(src)?"found":"not found");
 
-    return src;
+    DAVA::SafeDelete(src);
+    return nullptr;
 }
 
 //------------------------------------------------------------------------------
 const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines)
+{
+    return Add(filename, uid, progType, srcText, defines, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api api)
 {
     ShaderSource* src = new ShaderSource(filename);
 
-    if (src->Construct(progType, srcText, defines))
+    // construct outside of lock, so that several sources can be translated at once
+    if (src->Construct(progType, srcText, defines, api))
     {
         LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
-        uint32 api = HostApi();
         uint32 srcHash = DAVA::HashValue_N(srcText, unsigned(strlen(srcText)));
 
-        bool doAdd = true;
-        for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        std::vector<entry_t>::iterator e = LowerBound(uid, api);
+        if (e != Entry.end() && e->uid == uid && e->api == uint32(api))
         {
-            if ((e->uid == uid) && (e->api == api))
-            {
-                DAVA::SafeDelete(e->src);
-                e->src = src;
-                e->srcHash = srcHash;
-                doAdd = false;
-                break;
-            }
+            DAVA::SafeDelete(e->src);
         }
-
-        if (doAdd)
+        else
         {
-            entry_t e;
-            e.uid = uid;
-            e.api = api;
-            e.srcHash = srcHash;
-            e.src = src;
-
-            Entry.push_back(e);
+            e = Entry.insert(e, entry_t());
+            e->uid = uid;
         }
+
+        e->api = api;
+        e->srcHash = srcHash;
+        e->src = src;
+        e->packedSize = 0;
     }
     else
     {
@@ -2099,11 +2197,22 @@ void ShaderSourceCache::Clear()
     for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
         delete e->src;
     Entry.clear();
+
+    LockGuard<Mutex> fileGuard(shaderSourceCacheFileMutex);
+    DAVA::SafeRelease(CacheFile);
+    CacheDataOffset = 0;
 }
 
 //------------------------------------------------------------------------------
 
 void ShaderSourceCache::Save(const char* fileName)
+{
+    Save(fileName, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+void ShaderSourceCache::Save(const char* fileName, Api api)
 {
     using namespace DAVA;
 
@@ -2112,9 +2221,21 @@ void ShaderSourceCache::Save(const char* fileName)
     File* file = File::Create(cacheTempFile, File::WRITE | File::CREATE);
     if (file)
     {
-        Logger::Info("saving cached-shaders (%u): ", Entry.size());
-
         LockGuard<Mutex> guard(shaderSourceEntryMutex);
+
+        uint32 unpackedCount = 0;
+        for (const entry_t& e : Entry)
+        {
+            if (e.src != nullptr)
+                ++unpackedCount;
+        }
+        Logger::Info("saving cached-shaders (%u, %u unpacked): ", Entry.size(), unpackedCount);
+
+        // new locations are applied to entries only after cache file is successfully replaced
+        std::vector<entry_t> saved(Entry);
+        ScopedPtr<DynamicMemoryFile> index(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+        ScopedPtr<DynamicMemoryFile> data(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+        uint32 savedCount = 0;
         bool success = true;
 
         SCOPE_EXIT
@@ -2123,7 +2244,20 @@ void ShaderSourceCache::Save(const char* fileName)
 
             if (success)
             {
+                LockGuard<Mutex> fileGuard(shaderSourceCacheFileMutex);
+
+                // data of entries not unpacked yet is copied from previous cache file, so it has to be closed after writing
+                SafeRelease(CacheFile);
                 FileSystem::Instance()->MoveFile(cacheTempFile, fileName, true);
+
+                CacheFile = File::Create(fileName, File::READ | File::OPEN);
+                CacheDataOffset = uint32(4 * sizeof(uint32) + index->GetSize());
+                if (CacheFile == nullptr)
+                {
+                    for (entry_t& e : saved)
+                        e.packedSize = 0;
+                }
+                Entry.swap(saved);
             }
             else
             {
@@ -2133,15 +2267,60 @@ void ShaderSourceCache::Save(const char* fileName)
         
 #define WRITE_CHECK(exp) if (!exp) { success = false; return; }
 
-        WRITE_CHECK(WriteUI4(file, FormatVersion));
-        WRITE_CHECK(WriteUI4(file, static_cast<uint32>(Entry.size())));
-        for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        Vector<uint8> packed;
+        for (entry_t& e : saved)
         {
-            WRITE_CHECK(WriteS0(file, e->uid.c_str()));
-            WRITE_CHECK(WriteUI4(file, e->api));
-            WRITE_CHECK(WriteUI4(file, e->srcHash));
-            WRITE_CHECK(e->src->Save(Api(e->api), file));
+            if (e.api != uint32(api))
+            {
+                e.packedSize = 0;
+                continue;
+            }
+
+            // entries not changed since loading are stored as is
+            bool hasData = false;
+            if (e.packedSize != 0)
+            {
+                LockGuard<Mutex> fileGuard(shaderSourceCacheFileMutex);
+                if (CacheFile != nullptr)
+                {
+                    packed.resize(e.packedSize);
+                    hasData = CacheFile->Seek(CacheDataOffset + e.dataOffset, File::SEEK_FROM_START) && (CacheFile->Read(packed.data(), e.packedSize) == e.packedSize);
+                }
+            }
+            if (!hasData && e.src != nullptr)
+            {
+                ScopedPtr<DynamicMemoryFile> unpacked(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+                WRITE_CHECK(e.src->Save(Api(e.api), unpacked));
+                WRITE_CHECK(LZ4HCCompressor().Compress(unpacked->GetDataVector(), packed));
+                e.unpackedSize = uint32(unpacked->GetSize());
+                e.dataCRC = CRC32::ForBuffer(packed);
+                hasData = true;
+            }
+            if (!hasData)
+            {
+                e.packedSize = 0;
+                continue;
+            }
+
+            e.dataOffset = uint32(data->GetSize());
+            e.packedSize = uint32(packed.size());
+            WRITE_CHECK((data->Write(packed.data(), e.packedSize) == e.packedSize));
+
+            WRITE_CHECK(WriteS0(index, e.uid.c_str()));
+            WRITE_CHECK(WriteUI4(index, e.srcHash));
+            WRITE_CHECK(WriteUI4(index, e.dataOffset));
+            WRITE_CHECK(WriteUI4(index, e.packedSize));
+            WRITE_CHECK(WriteUI4(index, e.unpackedSize));
+            WRITE_CHECK(WriteUI4(index, e.dataCRC));
+            ++savedCount;
         }
+
+        WRITE_CHECK(WriteUI4(file, FormatVersion));
+        WRITE_CHECK(WriteUI4(file, api));
+        WRITE_CHECK(WriteUI4(file, CompilerHash()));
+        WRITE_CHECK(WriteUI4(file, savedCount));
+        WRITE_CHECK((file->Write(index->GetData(), uint32(index->GetSize())) == index->GetSize()));
+        WRITE_CHECK((file->Write(data->GetData(), uint32(data->GetSize())) == data->GetSize()));
         
 #undef WRITE_CHECK
     }
@@ -2150,18 +2329,28 @@ void ShaderSourceCache::Save(const char* fileName)
 //------------------------------------------------------------------------------
 
 void ShaderSourceCache::Load(const char* fileName)
+{
+    Load(fileName, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+void ShaderSourceCache::Load(const char* fileName, Api api)
 {
     using namespace DAVA;
 
-    ScopedPtr<File> file(File::Create(fileName, File::READ | File::OPEN));
+    File* file = File::Create(fileName, File::READ | File::OPEN);
 
     if (file)
     {
         Clear();
 
+        int64 startTime = SystemTimer::GetMs();
         bool success = true;
         SCOPE_EXIT
         {
+            SafeRelease(file);
+
             if (!success)
             {
                 Clear();
@@ -2172,28 +2361,49 @@ void ShaderSourceCache::Load(const char* fileName)
 #define READ_CHECK(exp) if (!exp) { success = false; return; }
 
         uint32 formatVersion = 0;
+        uint32 fileApi = 0;
+        uint32 compilerHash = 0;
         READ_CHECK(ReadUI4(file, &formatVersion));
 
         if (formatVersion == FormatVersion)
+        {
+            READ_CHECK(ReadUI4(file, &fileApi));
+            READ_CHECK(ReadUI4(file, &compilerHash));
+        }
+
+        if (formatVersion == FormatVersion && fileApi == uint32(api) && compilerHash == CompilerHash())
         {
             LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
             uint32 entryCount = 0;
             READ_CHECK(ReadUI4(file, &entryCount));
             Entry.resize(entryCount);
-            Logger::Info("loading cached-shaders (%u): ", Entry.size());
 
+            // only index is read here, entry data is unpacked on first request
             for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
             {
                 std::string str;
                 READ_CHECK(ReadS0(file, &str));
                 e->uid = FastName(str.c_str());
-                READ_CHECK(ReadUI4(file, &e->api));
+                e->api = api;
                 READ_CHECK(ReadUI4(file, &e->srcHash));
-                e->src = new ShaderSource();
-
-                READ_CHECK(e->src->Load(Api(e->api), file));
+                READ_CHECK(ReadUI4(file, &e->dataOffset));
+                READ_CHECK(ReadUI4(file, &e->packedSize));
+                READ_CHECK(ReadUI4(file, &e->unpackedSize));
+                READ_CHECK(ReadUI4(file, &e->dataCRC));
             }
+
+            bool sorted = std::is_sorted(Entry.begin(), Entry.end(), [](const entry_t& l, const entry_t& r) {
+                return ShaderSourceCacheDetails::EntryLess(l.uid, l.api, r.uid, r.api);
+            });
+            READ_CHECK(sorted);
+
+            LockGuard<Mutex> fileGuard(shaderSourceCacheFileMutex);
+            CacheDataOffset = uint32(file->GetPos());
+            CacheFile = file;
+            file = nullptr;
+
+            Logger::Info("loaded cached-shaders index (%u) in %lld ms", Entry.size(), SystemTimer::GetMs() - startTime);
         }
         else
         {
@@ -72,6 +72,8 @@ public:
     ~ShaderSource();
 
     bool Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines);
+    // can be called from any thread, code is generated for `targetApi` only
+    bool Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api targetApi);
     void InlineFunctions();
     bool Construct(ProgType progType, const char* srcText);
     bool Load(Api api, DAVA::File* in);
@@ -116,16 +118,31 @@ private:
     BlendState blending;
 };
 
+/*
+    Cache file layout :
+      header - format version, api, shader compiler hash, entry count
+      index  - entries sorted by uid : uid, source hash, data offset, packed size, unpacked size, crc32 of packed data
+      data   - lz4 compressed ShaderSource::Save output of every entry, offsets are relative to the end of index
+
+    Load reads only header and index and keeps the file opened, data of particular entry is
+    read, verified and unpacked on first Get. Cache built for other api or by other shader compiler is ignored.
+    Functions without `api` argument work with entries of host api, Get and Add can be called from several threads at once,
+    both build or unpack sources outside of lock and lock entries only to publish the result.
+*/
 class
 ShaderSourceCache
 {
 public:
     static const ShaderSource* Get(FastName uid, uint32 srcHash);
+    static const ShaderSource* Get(FastName uid, uint32 srcHash, Api api);
     static const ShaderSource* Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines);
+    static const ShaderSource* Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api api);
 
     static void Clear();
     static void Save(const char* fileName);
+    static void Save(const char* fileName, Api api);
     static void Load(const char* fileName);
+    static void Load(const char* fileName, Api api);
 
 private:
     struct
@@ -135,9 +152,21 @@ private:
         uint32 api;
         uint32 srcHash;
         ShaderSource* src = nullptr;
+
+        // location of not yet loaded data in cache file
+        uint32 dataOffset = 0;
+        uint32 packedSize = 0;
+        uint32 unpackedSize = 0;
+        uint32 dataCRC = 0;
     };
 
+    static std::vector<entry_t>::iterator LowerBound(FastName uid, uint32 api);
+    static ShaderSource* LoadData(const entry_t& e);
+    static uint32 CompilerHash();
+
     static std::vector<entry_t> Entry;
+    static DAVA::File* CacheFile;
+    static uint32 CacheDataOffset;
     static const uint32 FormatVersion;
 };
 
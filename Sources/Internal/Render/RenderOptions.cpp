@@ -45,7 +45,8 @@ FastName optionsNames[RenderOptions::OPTIONS_COUNT] =
   FastName("Draw Nondef Glyph"),
   FastName("Highlight Hard Controls"),
   FastName("Debug Draw Rich Items"),
-  FastName("Debug Draw Particles")
+  FastName("Debug Draw Particles"),
+  FastName("Parallel Packet Preparation")
 };
 
 RenderOptions::RenderOptions()
@@ -69,6 +70,7 @@ RenderOptions::RenderOptions()
     options[DEBUG_DRAW_RICH_ITEMS] = false;
 
     options[DEBUG_DRAW_PARTICLES] = false;
+    options[PARALLEL_PACKET_PREPARATION] = false;
 }
 
 bool RenderOptions::IsOptionEnabled(RenderOption option)
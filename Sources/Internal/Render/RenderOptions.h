@@ -56,6 +56,8 @@ public:
 
         DEBUG_DRAW_PARTICLES,
 
+        PARALLEL_PACKET_PREPARATION,
+
         OPTIONS_COUNT
     };
 
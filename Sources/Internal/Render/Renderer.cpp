@@ -300,6 +300,9 @@ void RenderStats::Reset()
     batches2d = 0U;
     packets2d = 0U;
 
+    instancedBatches = 0U;
+    instancedPackets = 0U;
+
     visibleRenderObjects = 0U;
     occludedRenderObjects = 0U;
 
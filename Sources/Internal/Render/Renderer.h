@@ -91,6 +91,9 @@ struct RenderStats
     uint32 batches2d = 0U;
     uint32 packets2d = 0U;
 
+    uint32 instancedBatches = 0U;
+    uint32 instancedPackets = 0U;
+
     uint32 visibleRenderObjects = 0U;
     uint32 occludedRenderObjects = 0U;
 
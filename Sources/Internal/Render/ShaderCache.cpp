@@ -2,10 +2,16 @@
 #include "Render/RHI/rhi_ShaderCache.h"
 #include "FileSystem/FileSystem.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/Semaphore.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 #include "Logger/Logger.h"
+#include "Time/SystemTimer.h"
 #include "Utils/StringFormat.h"
 #include "Render/RHI/rhi_ShaderSource.h"
 
+#include <atomic>
+
 #define RHI_TRACE_CACHE_USAGE 0
 
 namespace DAVA
@@ -179,30 +185,9 @@ void SetLoadingNotifyEnabled(bool enable)
     loadingNotifyEnabled = enable;
 }
 
-
-#define DUMP_SOURCES 0
-#define TRACE_CACHE_USAGE 0
-
-#if TRACE_CACHE_USAGE
-#define LOG_TRACE_USAGE(usage, ...) Logger::Info(usage, __VA_ARGS__)
-#else
-#define LOG_TRACE_USAGE(...)
-#endif
-
-ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+// fills pairs of define name and value sorted by name, returns resource name used to build program uids
+String BuildProgDefines(const FastName& name, const UnorderedMap<FastName, int32>& defines, Vector<String>& progDefines)
 {
-    DVASSERT(initialized);
-
-    LockGuard<Mutex> guard(shaderCacheMutex);
-
-    Vector<size_t> key = BuildFlagsKey(name, defines);
-
-    auto descriptorIt = shaderDescriptors.find(key);
-    if (descriptorIt != shaderDescriptors.end())
-        return descriptorIt->second;
-
-    //not found - create new shader
-    Vector<String> progDefines;
     progDefines.reserve(defines.size() * 2);
     String resName(name.c_str());
     resName += "  defines: ";
@@ -231,6 +216,116 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     for (size_t i = 0; i != progDefines.size(); i += 2)
         resName += Format("%s = %s, ", progDefines[i + 0].c_str(), progDefines[i + 1].c_str());
 
+    return resName;
+}
+
+uint32 BuildShaderSources(const Vector<ShaderVariant>& variants, rhi::Api api)
+{
+    DVASSERT(initialized);
+
+    struct BuildTask
+    {
+        FastName vProgUid;
+        FastName fProgUid;
+        Vector<String> progDefines;
+        const ShaderSourceCode* sourceCode = nullptr;
+    };
+
+    int64 startTime = SystemTimer::GetMs();
+
+    // source texts are copied, so that shader cache isn't locked while translating
+    Map<FastName, ShaderSourceCode> sourceCodes;
+    Vector<BuildTask> tasks;
+    Set<FastName> taskUids;
+    {
+        LockGuard<Mutex> guard(shaderCacheMutex);
+
+        for (const ShaderVariant& variant : variants)
+        {
+            BuildTask task;
+            String resName = BuildProgDefines(variant.name, variant.defines, task.progDefines);
+            task.vProgUid = FastName(String("vSource: ") + resName);
+            task.fProgUid = FastName(String("fSource: ") + resName);
+
+            if (taskUids.insert(task.vProgUid).second == false)
+                continue;
+
+            auto sourceIt = sourceCodes.find(variant.name);
+            if (sourceIt == sourceCodes.end())
+                sourceIt = sourceCodes.emplace(variant.name, GetSourceCode(variant.name)).first;
+            task.sourceCode = &sourceIt->second;
+
+            if (rhi::ShaderSourceCache::Get(task.vProgUid, task.sourceCode->vSrcHash, api) == nullptr
+                || rhi::ShaderSourceCache::Get(task.fProgUid, task.sourceCode->fSrcHash, api) == nullptr)
+            {
+                tasks.push_back(std::move(task));
+            }
+        }
+    }
+
+    // wait for own jobs only, so that unrelated worker jobs don't stall the build;
+    // jobs are queued by batches, so that big material sets don't flood worker queue
+    const size_t maxQueuedJobs = 1000;
+    std::atomic<uint32> builtCount(0);
+    Semaphore built;
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    for (size_t first = 0; first < tasks.size(); first += maxQueuedJobs)
+    {
+        size_t last = std::min(first + maxQueuedJobs, tasks.size());
+        for (size_t i = first; i < last; ++i)
+        {
+            const BuildTask& task = tasks[i];
+            jobManager->CreateWorkerJob([&task, &builtCount, &built, api]() {
+                const ShaderSourceCode& sourceCode = *task.sourceCode;
+                const rhi::ShaderSource* vSource = rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), task.vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), task.progDefines, api);
+                const rhi::ShaderSource* fSource = rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), task.fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), task.progDefines, api);
+                if (vSource != nullptr && fSource != nullptr)
+                {
+                    ++builtCount;
+                }
+                else
+                {
+                    Logger::Error("failed to build shader sources for \"%s\"", task.vProgUid.c_str());
+                }
+                built.Post();
+            });
+        }
+        for (size_t i = first; i < last; ++i)
+        {
+            built.Wait();
+        }
+    }
+
+    Logger::Info("built %u of %u shader variants in %lld ms using %u workers", builtCount.load(), uint32(tasks.size()), SystemTimer::GetMs() - startTime, jobManager->GetWorkersCount());
+    return builtCount;
+}
+
+
+#define DUMP_SOURCES 0
+#define TRACE_CACHE_USAGE 0
+
+#if TRACE_CACHE_USAGE
+#define LOG_TRACE_USAGE(usage, ...) Logger::Info(usage, __VA_ARGS__)
+#else
+#define LOG_TRACE_USAGE(...)
+#endif
+
+ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+{
+    DVASSERT(initialized);
+
+    LockGuard<Mutex> guard(shaderCacheMutex);
+
+    Vector<size_t> key = BuildFlagsKey(name, defines);
+
+    auto descriptorIt = shaderDescriptors.find(key);
+    if (descriptorIt != shaderDescriptors.end())
+        return descriptorIt->second;
+
+    //not found - create new shader
+    Vector<String> progDefines;
+    String resName = BuildProgDefines(name, defines, progDefines);
+
     if (loadingNotifyEnabled)
     {
         Logger::Error("Forbidden call to GetShaderDescriptor %s", resName.c_str());
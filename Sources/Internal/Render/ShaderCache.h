@@ -3,11 +3,19 @@
 #include "Base/Singleton.h"
 #include "Base/FastName.h"
 #include "Render/Shader.h"
+#include "Render/RHI/rhi_Type.h"
 
 namespace DAVA
 {
 namespace ShaderDescriptorCache
 {
+/** Shader source name with values of defines, identifies one translated variant of shader */
+struct ShaderVariant
+{
+    FastName name;
+    UnorderedMap<FastName, int32> defines;
+};
+
 void Initialize();
 void Uninitialize();
 void Clear();
@@ -18,6 +26,14 @@ void ReloadShaders();
 void SetLoadingNotifyEnabled(bool enable);
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 Vector<size_t> BuildFlagsKey(const FastName& name, const UnorderedMap<FastName, int32>& defines);
+
+/**
+    Translate sources of `variants` for `api` on worker jobs and put them into rhi::ShaderSourceCache,
+    so that GetShaderDescriptor only has to create pipeline states for them.
+    Variants already present in cache are skipped. Blocks until all variants are translated,
+    returns number of translated variants.
+*/
+uint32 BuildShaderSources(const Vector<ShaderVariant>& variants, rhi::Api api);
 size_t GetUniqueFlagKey(FastName flagName);
 };
 };
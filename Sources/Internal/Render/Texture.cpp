@@ -455,29 +455,29 @@ Texture* Texture::CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu)
     return texture;
 }
 
-bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
+bool Texture::LoadImages(const TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>* images)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
     DVASSERT(gpu != GPU_INVALID);
 
-    if (!IsLoadAvailable(gpu))
+    if (!IsLoadAvailable(descriptor, gpu))
     {
         Logger::Error("[Texture::LoadImages] Load not available: invalid requested GPU family (%s)", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu));
         return false;
     }
 
-    uint32 baseMipMap = GetBaseMipMap();
+    uint32 baseMipMap = GetBaseMipMap(descriptor);
     ImageSystem::LoadingParams params;
     params.baseMipmap = baseMipMap;
     params.firstMipmapIndex = 0;
     params.minimalWidth = Texture::MINIMAL_WIDTH;
     params.minimalHeight = Texture::MINIMAL_HEIGHT;
 
-    if (texDescriptor->IsCubeMap() && (!GPUFamilyDescriptor::IsGPUForDevice(gpu)))
+    if (descriptor->IsCubeMap() && (!GPUFamilyDescriptor::IsGPUForDevice(gpu)))
     {
         Vector<FilePath> facePathes;
-        texDescriptor->GetFacePathnames(facePathes);
+        descriptor->GetFacePathnames(facePathes);
 
         PixelFormat imagesFormat = FORMAT_INVALID;
         for (uint32 i = 0; i < CUBE_FACE_COUNT; ++i)
@@ -515,7 +515,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
             }
             //end of cubemap formats validation
 
-            if (texDescriptor->GetGenerateMipMaps())
+            if (descriptor->GetGenerateMipMaps())
             {
                 Vector<Image*> mipmapsImages = faceImage[0]->CreateMipMapsImages();
                 images->insert(images->end(), mipmapsImages.begin(), mipmapsImages.end());
@@ -530,7 +530,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
     else
     {
         Vector<FilePath> singleMipFiles;
-        bool hasSingleMipFiles = texDescriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
+        bool hasSingleMipFiles = descriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
         if (hasSingleMipFiles)
         {
             uint32 singleMipFilesCount = static_cast<uint32>(singleMipFiles.size());
@@ -547,7 +547,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
             params.baseMipmap = Max(static_cast<int32>(baseMipMap) - static_cast<int32>(singleMipFilesCount), 0);
         }
 
-        FilePath multipleMipPathname = texDescriptor->CreateMultiMipPathnameForGPU(gpu);
+        FilePath multipleMipPathname = descriptor->CreateMultiMipPathnameForGPU(gpu);
         ImageSystem::Load(multipleMipPathname, *images, params);
 
         ImageSystem::EnsurePowerOf2Images(*images);
@@ -567,19 +567,29 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
         return false;
     }
 
-    if (images->size() == 1 && texDescriptor->GetGenerateMipMaps())
+    if (images->size() == 1 && descriptor->GetGenerateMipMaps())
     {
         Image* img = *images->begin();
-        *images = img->CreateMipMapsImages(texDescriptor->dataSettings.GetIsNormalMap());
+        *images = img->CreateMipMapsImages(descriptor->dataSettings.GetIsNormalMap());
         SafeRelease(img);
 
         if (images->empty())
         {
-            Logger::Error("[Texture::LoadImages] Can't create mipmaps for GPU (%s) for %s", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu), texDescriptor->pathname.GetStringValue().c_str());
+            Logger::Error("[Texture::LoadImages] Can't create mipmaps for GPU (%s) for %s", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu), descriptor->pathname.GetStringValue().c_str());
             return false;
         }
     }
 
+    return true;
+}
+
+bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
+{
+    if (!LoadImages(texDescriptor, gpu, images))
+    {
+        return false;
+    }
+
     isPink = false;
     state = STATE_DATA_LOADED;
 
@@ -786,6 +796,86 @@ Texture* Texture::PureCreate(const FilePath& pathName, const FastName& group)
     return texture;
 }
 
+TextureDescriptor* Texture::DecodeFromFile(const FilePath& pathName, eGPUFamily& gpu, Vector<Image*>& images, const FastName& group)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+#if (DAVA_DEBUG_TEXTURE_DISABLE_LOADING)
+    return nullptr;
+#endif
+
+    if (pathName.IsEmpty() || (pathName.GetType() == FilePath::PATH_IN_MEMORY))
+        return nullptr;
+
+    if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::TEXTURE_LOAD_ENABLED))
+        return nullptr;
+
+    FilePath descriptorPathname = TextureDescriptor::GetDescriptorPathname(pathName);
+    {
+        LockGuard<Mutex> guard(textureMapMutex);
+        if (textureMap.find(FILEPATH_MAP_KEY(descriptorPathname)) != textureMap.end())
+            return nullptr;
+    }
+
+    TextureDescriptor* descriptor(TextureDescriptor::CreateFromFile(descriptorPathname));
+    if (nullptr == descriptor)
+        return nullptr;
+
+    descriptor->SetQualityGroup(group);
+    for (eGPUFamily gpuFromOrder : gpuLoadingOrder)
+    {
+        eGPUFamily gpuForLoading = GetGPUForLoading(gpuFromOrder, descriptor);
+        if (LoadImages(descriptor, gpuForLoading, &images))
+        {
+            gpu = gpuForLoading;
+            return descriptor;
+        }
+    }
+
+    ReleaseImages(&images);
+    delete descriptor;
+    return nullptr;
+}
+
+Texture* Texture::CreateFromDecodedImages(TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>& images)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    DVASSERT(!images.empty());
+
+    Texture* texture = Get(descriptor->pathname);
+    if (texture != nullptr)
+    {
+        ReleaseImages(&images);
+        delete descriptor;
+        return texture;
+    }
+
+    texture = new Texture();
+    texture->texDescriptor->Initialize(descriptor);
+    texture->isPink = false;
+
+    Vector<Image*>* textureImages = new Vector<Image*>();
+    textureImages->swap(images);
+    texture->SetParamsFromImages(textureImages);
+    texture->FlushDataToRenderer(textureImages);
+
+    if (!texture->singleTextureSet.IsValid())
+    {
+        Logger::Error("[Texture::CreateFromDecodedImages] Cannot create rhi.texture from image. Descriptor: %s, GPU: %s",
+                      descriptor->pathname.GetAbsolutePathname().c_str(), GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu));
+        SafeRelease(texture);
+    }
+    else
+    {
+        texture->loadedAsFile = gpu;
+        AddToMap(texture);
+    }
+
+    delete descriptor;
+    return texture;
+}
+
 void Texture::ReloadFromData(PixelFormat format, uint8* data, uint32 _width, uint32 _height)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
@@ -849,12 +939,17 @@ void Texture::ReloadAs(eGPUFamily gpuFamily)
 
 bool Texture::IsLoadAvailable(const eGPUFamily gpuFamily) const
 {
-    if (texDescriptor->IsCompressedFile())
+    return IsLoadAvailable(texDescriptor, gpuFamily);
+}
+
+bool Texture::IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily)
+{
+    if (descriptor->IsCompressedFile())
     {
         return true;
     }
 
-    if (GPUFamilyDescriptor::IsGPUForDevice(gpuFamily) && texDescriptor->compression[gpuFamily].format == FORMAT_INVALID)
+    if (GPUFamilyDescriptor::IsGPUForDevice(gpuFamily) && descriptor->compression[gpuFamily].format == FORMAT_INVALID)
     {
         return false;
     }
@@ -1212,10 +1307,15 @@ void Texture::SetPixelization(bool value)
 }
 
 uint32 Texture::GetBaseMipMap() const
+{
+    return GetBaseMipMap(texDescriptor);
+}
+
+uint32 Texture::GetBaseMipMap(const TextureDescriptor* descriptor)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
-    if (texDescriptor->GetQualityGroup().IsValid())
+    if (descriptor->GetQualityGroup().IsValid())
     {
         const TextureQuality* curTxQuality = QualitySettingsSystem::Instance()->GetTxQuality(QualitySettingsSystem::Instance()->GetCurTextureQuality());
         if (nullptr != curTxQuality)
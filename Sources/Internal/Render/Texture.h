@@ -114,6 +114,21 @@ public:
      */
     static Texture* PureCreate(const FilePath& pathName, const FastName& group = FastName());
 
+    /**
+        \brief Read descriptor and decode images of the texture file, can be called from any thread.
+        Returns nullptr if texture is already created or can't be loaded, otherwise
+        `images` are filled and `gpu` is set to the GPU family they are decoded for.
+        \param[in] pathName path to the png or pvr file
+     */
+    static TextureDescriptor* DecodeFromFile(const FilePath& pathName, eGPUFamily& gpu, Vector<Image*>& images, const FastName& group = FastName());
+
+    /**
+        \brief Create texture from data decoded by `DecodeFromFile`, should be called from the main thread.
+        Takes ownership of `descriptor` and `images`. If texture with the same path was created in the meantime, returns it.
+        If texture cannot be created, returns 0
+     */
+    static Texture* CreateFromDecodedImages(TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>& images);
+
     static Texture* CreatePink(rhi::TextureType requestedType = rhi::TEXTURE_TYPE_2D, bool checkers = true);
 
     static Texture* CreateFBO(uint32 width, uint32 height, PixelFormat format, bool needDepth = false,
@@ -183,6 +198,7 @@ public:
     static void SetPixelization(bool value);
 
     uint32 GetBaseMipMap() const;
+    static uint32 GetBaseMipMap(const TextureDescriptor* descriptor);
 
     static rhi::HSamplerState CreateSamplerStateHandle(const rhi::SamplerState::Descriptor::Sampler& samplerState);
 
@@ -198,12 +214,13 @@ protected:
     static Texture* CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu);
 
     bool LoadImages(eGPUFamily gpu, Vector<Image*>* images);
+    static bool LoadImages(const TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>* images);
 
     void SetParamsFromImages(const Vector<Image*>* images);
 
     void FlushDataToRenderer(Vector<Image*>* images);
 
-    void ReleaseImages(Vector<Image*>* images);
+    static void ReleaseImages(Vector<Image*>* images);
 
     void MakePink(bool checkers = true);
 
@@ -211,6 +228,7 @@ protected:
     virtual ~Texture();
 
     bool IsLoadAvailable(const eGPUFamily gpuFamily) const;
+    static bool IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily);
 
 public: // properties for fast access
     rhi::HTexture handle;
@@ -8,6 +8,7 @@
 #include "Utils/Random.h"
 #include "Utils/StringFormat.h"
 #include "Entity/ComponentManager.h"
+#include "Entity/ComponentStorage.h"
 #include "Entity/ComponentUtils.h"
 #include "Scene3D/Scene.h"
 #include "Scene3D/SceneFileV2.h"
@@ -94,6 +95,10 @@ void Entity::DetachComponent(Vector<Component*>::iterator& it)
 
     components.erase(it);
     UpdateFamily();
+    if (scene && scene->GetComponentStorage())
+    {
+        scene->GetComponentStorage()->UpdateEntity(this);
+    }
     c->SetEntity(nullptr);
 }
 
@@ -128,25 +133,53 @@ void Entity::SetScene(Scene* _scene)
         return;
     }
 
+    // whole hierarchy is moved with batched registration, children which belong
+    // to some other scene are moved afterwards one by one
+    Vector<Entity*> entities;
+    Vector<Entity*> otherSceneEntities;
+    CollectEntitiesForScene(scene, _scene, entities, otherSceneEntities);
+
     if (scene)
     {
-        scene->UnregisterEntity(this);
+        scene->UnregisterEntities(entities);
     }
 
-    scene = _scene;
+    for (Entity* entity : entities)
+    {
+        entity->scene = _scene;
+    }
 
-    if (scene)
+    if (_scene)
     {
-        scene->RegisterEntity(this);
-        for (auto component : components)
+        _scene->RegisterEntities(entities);
+        for (Entity* entity : entities)
         {
-            GlobalEventSystem::Instance()->PerformAllEventsFromCache(component);
+            for (auto component : entity->components)
+            {
+                GlobalEventSystem::Instance()->PerformAllEventsFromCache(component);
+            }
         }
     }
 
-    for (auto child : children)
+    for (Entity* entity : otherSceneEntities)
     {
-        child->SetScene(scene);
+        entity->SetScene(_scene);
+    }
+}
+
+void Entity::CollectEntitiesForScene(Scene* fromScene, Scene* toScene, Vector<Entity*>& entities, Vector<Entity*>& otherSceneEntities)
+{
+    entities.push_back(this);
+    for (Entity* child : children)
+    {
+        if (child->scene == fromScene)
+        {
+            child->CollectEntitiesForScene(fromScene, toScene, entities, otherSceneEntities);
+        }
+        else if (child->scene != toScene)
+        {
+            otherSceneEntities.push_back(child);
+        }
     }
 }
 
@@ -327,11 +327,15 @@ protected:
 private:
     Vector<Component*> components;
     EntityFamily* family = nullptr;
+    uint32 componentStorageArchetype = static_cast<uint32>(-1);
+    uint32 componentStorageRow = 0;
     void DetachComponent(Vector<Component*>::iterator& it);
     void RemoveComponent(Vector<Component*>::iterator& it);
+    void CollectEntitiesForScene(Scene* fromScene, Scene* toScene, Vector<Entity*>& entities, Vector<Entity*>& otherSceneEntities);
 
     friend class Scene;
     friend class SceneFileV2;
+    friend class ComponentStorage;
 };
 
 inline uint32 Entity::GetID() const
@@ -1,5 +1,6 @@
 #include "Scene3D/Lod/LodSystem.h"
 #include "Debug/DVAssert.h"
+#include "Entity/Query.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/RenderComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -17,6 +18,8 @@ namespace DAVA
 LodSystem::LodSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
+
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::START_PARTICLE_EFFECT);
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::STOP_PARTICLE_EFFECT);
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::LOD_DISTANCE_CHANGED);
@@ -29,22 +32,16 @@ void LodSystem::Process(float32 timeElapsed)
 
     TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
 
-    for (auto& pair : tsc->worldTransformChanged.map)
-    {
-        if (pair.first->GetComponentsCount(Type::Instance<LodComponent>()) > 0)
+    Query<LodComponent, TransformComponent> query(GetScene()->GetComponentStorage());
+    query.ForEach(tsc->worldTransformChanged, [this](Entity* entity, LodComponent*, TransformComponent* transform) {
+        auto iter = fastMap.find(entity);
+        if (iter != fastMap.end())
         {
-            for (Entity* entity : pair.second)
-            {
-                auto iter = fastMap.find(entity);
-                if (iter != fastMap.end())
-                {
-                    int32 index = iter->second;
-                    FastStruct* fast = &fastVector[index];
-                    fast->position = entity->GetComponent<TransformComponent>()->GetWorldTransform().GetTranslationVector();
-                }
-            }
+            int32 index = iter->second;
+            FastStruct* fast = &fastVector[index];
+            fast->position = transform->GetWorldTransform().GetTranslationVector();
         }
-    }
+    });
 
     Camera* camera = GetScene()->GetCurrentCamera();
     if (!camera)
@@ -2,6 +2,11 @@
 #include "Scene3D/Scene.h"
 #include "Entity/SceneSystem.h"
 #include "Entity/SingletonComponent.h"
+#include "Entity/ComponentUtils.h"
+#include "Scene3D/Components/RenderComponent.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Logger/Logger.h"
+#include "Time/SystemTimer.h"
 
 using namespace DAVA;
 
@@ -22,6 +27,44 @@ class MyComponent : public SingletonComponent
 {
 };
 
+class EntityCountSystem : public SceneSystem
+{
+public:
+    EntityCountSystem(Scene* scene)
+        : SceneSystem(scene)
+    {
+    }
+
+    void AddEntity(Entity* entity) override
+    {
+        ++entitiesCount;
+    }
+
+    void RemoveEntity(Entity* entity) override
+    {
+        --entitiesCount;
+    }
+
+    void AddEntities(const Vector<Entity*>& entities) override
+    {
+        ++batchesCount;
+        entitiesCount += static_cast<int32>(entities.size());
+    }
+
+    void RemoveEntities(const Vector<Entity*>& entities) override
+    {
+        ++batchesCount;
+        entitiesCount -= static_cast<int32>(entities.size());
+    }
+
+    void PrepareForRemove() override
+    {
+    }
+
+    int32 entitiesCount = 0;
+    int32 batchesCount = 0;
+};
+
 DAVA_TESTCLASS (SceneTest)
 {
     DAVA_TEST (GetSystem)
@@ -69,4 +112,56 @@ DAVA_TESTCLASS (SceneTest)
         scene->RemoveSingletonComponent(myComponent);
         TEST_VERIFY(scene->GetSingletonComponent<MyComponent>() == nullptr);
     }
+
+    DAVA_TEST (RegisterEntities)
+    {
+        Scene* scene = new Scene(0);
+        SCOPE_EXIT
+        {
+            SafeRelease(scene);
+        };
+
+        EntityCountSystem renderSystem(scene);
+        EntityCountSystem transformSystem(scene);
+        scene->AddSystem(&renderSystem, ComponentUtils::MakeMask<RenderComponent>());
+        scene->AddSystem(&transformSystem, ComponentUtils::MakeMask<TransformComponent>());
+        SCOPE_EXIT
+        {
+            scene->RemoveSystem(&renderSystem);
+            scene->RemoveSystem(&transformSystem);
+        };
+
+        const int32 entitiesCount = 50000;
+        Entity* root = new Entity();
+        for (int32 i = 0; i < entitiesCount; ++i)
+        {
+            Entity* entity = new Entity();
+            if (i % 2 == 0)
+            {
+                entity->AddComponent(new RenderComponent());
+            }
+            root->AddNode(entity);
+            entity->Release();
+        }
+
+        int64 startTime = SystemTimer::GetUs();
+        scene->AddNode(root);
+        int64 addTime = SystemTimer::GetUs() - startTime;
+
+        // every entity has transform component, whole hierarchy comes in one batch
+        TEST_VERIFY(transformSystem.entitiesCount == entitiesCount + 1);
+        TEST_VERIFY(transformSystem.batchesCount == 1);
+        TEST_VERIFY(renderSystem.entitiesCount == entitiesCount / 2);
+        TEST_VERIFY(renderSystem.batchesCount == 1);
+
+        startTime = SystemTimer::GetUs();
+        scene->RemoveNode(root);
+        int64 removeTime = SystemTimer::GetUs() - startTime;
+
+        TEST_VERIFY(transformSystem.entitiesCount == 0);
+        TEST_VERIFY(renderSystem.entitiesCount == 0);
+        root->Release();
+
+        Logger::Info("[SceneTest] %d entities: add %lld us, remove %lld us", entitiesCount + 1, addTime, removeTime);
+    }
 };
\ No newline at end of file
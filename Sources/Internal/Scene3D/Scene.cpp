@@ -3,6 +3,7 @@
 #include "Concurrency/Thread.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Entity/ComponentStorage.h"
 #include "Entity/ComponentUtils.h"
 #include "FileSystem/FileSystem.h"
 #include "Render/3D/StaticMesh.h"
@@ -198,14 +199,20 @@ Scene::Scene(uint32 _systemsMask /* = SCENE_SYSTEM_ALL_MASK */)
     static uint32 idCounter = 0;
     sceneId = ++idCounter;
 
+    componentStorage = new ComponentStorage();
+
+    UpdateSystemsByComponent();
     CreateComponents();
     CreateSystems();
 
     // this will force scene to create hidden global material
     SetGlobalMaterial(nullptr);
 
-    RenderOptions* options = Renderer::GetOptions();
-    options->AddObserver(this);
+    if (SCENE_SYSTEM_RENDER_UPDATE_FLAG & systemsMask)
+    {
+        RenderOptions* options = Renderer::GetOptions();
+        options->AddObserver(this);
+    }
 }
 
 void Scene::CreateComponents()
@@ -282,7 +289,10 @@ void Scene::CreateSystems()
 #endif
 
 #if defined(__DAVAENGINE_PHYSICS_DEBUG_DRAW_ENABLED__)
-    AddSystem(new PhysicsDebugDrawSystem(this), 0, SCENE_SYSTEM_REQUIRE_PROCESS);
+    if (SCENE_SYSTEM_RENDER_UPDATE_FLAG & systemsMask)
+    {
+        AddSystem(new PhysicsDebugDrawSystem(this), 0, SCENE_SYSTEM_REQUIRE_PROCESS);
+    }
 #endif
 
     if (SCENE_SYSTEM_SKELETON_FLAG & systemsMask)
@@ -396,16 +406,20 @@ void Scene::CreateSystems()
         AddSystem(geoDecalSystem, ComponentUtils::MakeMask<GeoDecalComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
     }
 
-    if (DAVA::Renderer::GetOptions()->IsOptionEnabled(DAVA::RenderOptions::DEBUG_DRAW_STATIC_OCCLUSION) && !staticOcclusionDebugDrawSystem)
+    // Debug draw systems are useless for scene which is not rendered
+    if (SCENE_SYSTEM_RENDER_UPDATE_FLAG & systemsMask)
     {
-        staticOcclusionDebugDrawSystem = new DAVA::StaticOcclusionDebugDrawSystem(this);
-        AddSystem(staticOcclusionDebugDrawSystem, ComponentUtils::MakeMask<StaticOcclusionComponent>(), 0, renderUpdateSystem);
-    }
+        if (DAVA::Renderer::GetOptions()->IsOptionEnabled(DAVA::RenderOptions::DEBUG_DRAW_STATIC_OCCLUSION) && !staticOcclusionDebugDrawSystem)
+        {
+            staticOcclusionDebugDrawSystem = new DAVA::StaticOcclusionDebugDrawSystem(this);
+            AddSystem(staticOcclusionDebugDrawSystem, ComponentUtils::MakeMask<StaticOcclusionComponent>(), 0, renderUpdateSystem);
+        }
 
-    if (DAVA::Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DEBUG_DRAW_PARTICLES) && particleEffectDebugDrawSystem == nullptr)
-    {
-        particleEffectDebugDrawSystem = new ParticleEffectDebugDrawSystem(this);
-        AddSystem(particleEffectDebugDrawSystem, 0);
+        if (DAVA::Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DEBUG_DRAW_PARTICLES) && particleEffectDebugDrawSystem == nullptr)
+        {
+            particleEffectDebugDrawSystem = new ParticleEffectDebugDrawSystem(this);
+            AddSystem(particleEffectDebugDrawSystem, 0);
+        }
     }
 }
 
@@ -477,6 +491,7 @@ Scene::~Scene()
 
     SafeDelete(eventSystem);
     SafeDelete(renderSystem);
+    SafeDelete(componentStorage);
 }
 
 void Scene::RegisterEntity(Entity* entity)
@@ -489,9 +504,58 @@ void Scene::RegisterEntity(Entity* entity)
         entity->SetSceneID(sceneId);
     }
 
-    for (auto& system : systems)
+    componentStorage->AddEntity(entity);
+
+    for (SceneSystem* system : systems)
     {
-        system->RegisterEntity(entity);
+        if (IsRegistrationRequired(system, entity))
+        {
+            system->RegisterEntity(entity);
+        }
+    }
+}
+
+void Scene::RegisterEntities(const Vector<Entity*>& entities)
+{
+    for (Entity* entity : entities)
+    {
+        if (entity->GetID() == 0 ||
+            entity->GetSceneID() == 0 ||
+            entity->GetSceneID() != sceneId)
+        {
+            entity->SetID(++maxEntityIDCounter);
+            entity->SetSceneID(sceneId);
+        }
+        componentStorage->AddEntity(entity);
+    }
+
+    Vector<Entity*> systemEntities;
+    systemEntities.reserve(entities.size());
+    for (SceneSystem* system : systems)
+    {
+        if (system->HasCustomRegistration())
+        {
+            for (Entity* entity : entities)
+            {
+                system->RegisterEntity(entity);
+            }
+        }
+        else
+        {
+            systemEntities.clear();
+            for (Entity* entity : entities)
+            {
+                if (IsRegistrationRequired(system, entity))
+                {
+                    systemEntities.push_back(entity);
+                }
+            }
+
+            if (!systemEntities.empty())
+            {
+                system->AddEntities(systemEntities);
+            }
+        }
     }
 }
 
@@ -505,6 +569,10 @@ void Scene::UnregisterEntity(Entity* entity)
     {
         motionSingleComponent->EntityRemoved(entity);
     }
+    if (componentStorage)
+    {
+        componentStorage->RemoveEntity(entity);
+    }
 
 #if defined(__DAVAENGINE_PHYSICS_ENABLED__)
     if (collisionSingleComponent)
@@ -513,9 +581,89 @@ void Scene::UnregisterEntity(Entity* entity)
     }
 #endif
 
-    for (auto& system : systems)
+    for (SceneSystem* system : systems)
     {
-        system->UnregisterEntity(entity);
+        if (IsRegistrationRequired(system, entity))
+        {
+            system->UnregisterEntity(entity);
+        }
+    }
+}
+
+void Scene::UnregisterEntities(const Vector<Entity*>& entities)
+{
+    for (Entity* entity : entities)
+    {
+        if (transformSingleComponent)
+        {
+            transformSingleComponent->EraseEntity(entity);
+        }
+        if (motionSingleComponent)
+        {
+            motionSingleComponent->EntityRemoved(entity);
+        }
+        if (componentStorage)
+        {
+            componentStorage->RemoveEntity(entity);
+        }
+
+#if defined(__DAVAENGINE_PHYSICS_ENABLED__)
+        if (collisionSingleComponent)
+        {
+            collisionSingleComponent->RemoveCollisionsWithEntity(entity);
+        }
+#endif
+    }
+
+    Vector<Entity*> systemEntities;
+    systemEntities.reserve(entities.size());
+    for (SceneSystem* system : systems)
+    {
+        if (system->HasCustomRegistration())
+        {
+            for (Entity* entity : entities)
+            {
+                system->UnregisterEntity(entity);
+            }
+        }
+        else
+        {
+            systemEntities.clear();
+            for (Entity* entity : entities)
+            {
+                if (IsRegistrationRequired(system, entity))
+                {
+                    systemEntities.push_back(entity);
+                }
+            }
+
+            if (!systemEntities.empty())
+            {
+                system->RemoveEntities(systemEntities);
+            }
+        }
+    }
+}
+
+bool Scene::IsRegistrationRequired(SceneSystem* system, Entity* entity) const
+{
+    const ComponentMask& requiredComponents = system->GetRequiredComponents();
+    return system->HasCustomRegistration() || (requiredComponents & entity->GetAvailableComponentMask()) == requiredComponents;
+}
+
+void Scene::UpdateSystemsByComponent()
+{
+    systemsByComponent.assign(ComponentMask().size(), Vector<SceneSystem*>());
+    for (SceneSystem* system : systems)
+    {
+        const ComponentMask& requiredComponents = system->GetRequiredComponents();
+        for (size_t i = 0; i < systemsByComponent.size(); ++i)
+        {
+            if (system->HasCustomRegistration() || requiredComponents.test(i))
+            {
+                systemsByComponent[i].push_back(system);
+            }
+        }
     }
 }
 
@@ -529,20 +677,25 @@ void Scene::RegisterEntitiesInSystemRecursively(SceneSystem* system, Entity* ent
 void Scene::RegisterComponent(Entity* entity, Component* component)
 {
     DVASSERT(entity && component);
-    uint32 systemsCount = static_cast<uint32>(systems.size());
-    for (uint32 k = 0; k < systemsCount; ++k)
+    if (componentStorage)
+    {
+        componentStorage->UpdateEntity(entity);
+    }
+
+    uint32 runtimeId = ComponentUtils::GetRuntimeId(component->GetType());
+    for (SceneSystem* system : systemsByComponent[runtimeId])
     {
-        systems[k]->RegisterComponent(entity, component);
+        system->RegisterComponent(entity, component);
     }
 }
 
 void Scene::UnregisterComponent(Entity* entity, Component* component)
 {
     DVASSERT(entity && component);
-    uint32 systemsCount = static_cast<uint32>(systems.size());
-    for (uint32 k = 0; k < systemsCount; ++k)
+    uint32 runtimeId = ComponentUtils::GetRuntimeId(component->GetType());
+    for (SceneSystem* system : systemsByComponent[runtimeId])
     {
-        systems[k]->UnregisterComponent(entity, component);
+        system->UnregisterComponent(entity, component);
     }
 }
 
@@ -550,6 +703,7 @@ void Scene::AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMa
 {
     sceneSystem->SetRequiredComponents(componentMask);
     systems.push_back(sceneSystem);
+    UpdateSystemsByComponent();
 
     auto insertSystemBefore = [sceneSystem](Vector<SceneSystem*>& container, SceneSystem* beforeThisSystem)
     {
@@ -607,6 +761,7 @@ void Scene::RemoveSystem(SceneSystem* sceneSystem)
     bool removed = RemoveSystem(systems, sceneSystem);
     if (removed)
     {
+        UpdateSystemsByComponent();
         sceneSystem->SetScene(nullptr);
     }
     else
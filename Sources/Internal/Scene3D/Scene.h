@@ -57,6 +57,7 @@ class TransformSingleComponent;
 class MotionSingleComponent;
 class PhysicsSystem;
 class CollisionSingleComponent;
+class ComponentStorage;
 
 class UIEvent;
 class RenderPass;
@@ -117,7 +118,17 @@ public:
 #if defined(__DAVAENGINE_PHYSICS_ENABLED__)
         SCENE_SYSTEM_PHYSICS_FLAG = 1 << 19,
 #endif
-        SCENE_SYSTEM_ALL_MASK = 0xFFFFFFFF
+        SCENE_SYSTEM_ALL_MASK = 0xFFFFFFFF,
+
+        /**
+            Profile for scenes simulated without rendering, e.g. on dedicated server: render, particle, sound and other
+            visual-only systems are not created, scene does not follow render options.
+        */
+        SCENE_SYSTEM_HEADLESS_MASK = SCENE_SYSTEM_ALL_MASK & ~(SCENE_SYSTEM_RENDER_UPDATE_FLAG | SCENE_SYSTEM_DEBUG_RENDER_FLAG |
+                                                               SCENE_SYSTEM_PARTICLE_EFFECT_FLAG | SCENE_SYSTEM_LIGHT_UPDATE_FLAG |
+                                                               SCENE_SYSTEM_SOUND_UPDATE_FLAG | SCENE_SYSTEM_STATIC_OCCLUSION_FLAG |
+                                                               SCENE_SYSTEM_LANDSCAPE_FLAG | SCENE_SYSTEM_FOLIAGE_FLAG |
+                                                               SCENE_SYSTEM_SPEEDTREE_UPDATE_FLAG | SCENE_SYSTEM_GEO_DECAL_FLAG)
     };
 
     enum eSceneProcessFlags : uint32
@@ -137,6 +148,15 @@ public:
         \brief Function to unregister entity from scene. This function is called when you remove entity from scene.
      */
     void UnregisterEntity(Entity* entity);
+    /**
+        \brief Register several entities at once, each system receives all entities it is interested in with one call.
+                Entities are registered in the given order.
+     */
+    void RegisterEntities(const Vector<Entity*>& entities);
+    /**
+        \brief Unregister several entities at once, each system receives all entities it is interested in with one call.
+     */
+    void UnregisterEntities(const Vector<Entity*>& entities);
 
     /**
         \brief Function to register component in scene. This function is called when you add any component to any entity in scene.
@@ -147,6 +167,11 @@ public:
      */
     void UnregisterComponent(Entity* entity, Component* component);
 
+    /**
+        \brief Return storage of components of entities registered in scene. Use `Query` to iterate over it.
+     */
+    ComponentStorage* GetComponentStorage() const;
+
     virtual void AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMask, uint32 processFlags = 0, SceneSystem* insertBeforeSceneForProcess = nullptr, SceneSystem* insertBeforeSceneForInput = nullptr, SceneSystem* insertBeforeSceneForFixedProcess = nullptr);
     virtual void RemoveSystem(SceneSystem* sceneSystem);
     template <class T>
@@ -263,11 +288,19 @@ protected:
 
     bool RemoveSystem(Vector<SceneSystem*>& storage, SceneSystem* system);
 
+    void UpdateSystemsByComponent();
+    bool IsRegistrationRequired(SceneSystem* system, Entity* entity) const;
+
     uint32 systemsMask;
     uint32 maxEntityIDCounter;
 
     float32 sceneGlobalTime = 0.f;
 
+    // systems interested in components of each runtime type id, in order of `systems`
+    Vector<Vector<SceneSystem*>> systemsByComponent;
+
+    ComponentStorage* componentStorage = nullptr;
+
     Vector<Camera*> cameras;
 
     NMaterial* sceneGlobalMaterial;
@@ -303,6 +336,11 @@ T* Scene::GetSystem()
     return res;
 }
 
+inline ComponentStorage* Scene::GetComponentStorage() const
+{
+    return componentStorage;
+}
+
 template <class T>
 T* Scene::GetSingletonComponent()
 {
@@ -332,6 +332,7 @@ SlotSystem::SlotSystem(Scene* scene)
     , externalEntityLoader(new AsyncSlotExternalLoader())
     , sharedCache(new ItemsCache())
 {
+    SetCustomRegistration(true);
 }
 
 SlotSystem::~SlotSystem()
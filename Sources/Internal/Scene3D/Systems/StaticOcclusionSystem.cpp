@@ -80,6 +80,8 @@ void StaticOcclusionSystem::ProcessStaticOcclusionForOneDataSet(uint32 blockInde
 StaticOcclusionSystem::StaticOcclusionSystem(Scene* scene)
     : SceneSystem(scene)
 {
+    SetCustomRegistration(true);
+
     indexedRenderObjects.reserve(2000);
     for (uint32 k = 0; k < indexedRenderObjects.size(); ++k)
         indexedRenderObjects[k] = nullptr;
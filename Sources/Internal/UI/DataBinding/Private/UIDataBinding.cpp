@@ -8,10 +8,10 @@
 #include "UI/DataBinding/Private/UIDataBindingDependenciesManager.h"
 #include "UI/DataBinding/Private/UIDataModel.h"
 
-#include "UI/Formula/Private/FormulaExpression.h"
-#include "UI/Formula/Private/FormulaParser.h"
-#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaException.h"
 #include "UI/Formula/Private/FormulaFormatter.h"
+#include "UI/Formula/Private/FormulaProgramCache.h"
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
 
 #include "UI/Styles/UIStyleSheetPropertyDataBase.h"
 
@@ -20,9 +20,10 @@
 
 namespace DAVA
 {
-UIDataBinding::UIDataBinding(UIDataBindingComponent* component_, bool editorMode)
+UIDataBinding::UIDataBinding(UIDataBindingComponent* component_, FormulaProgramCache* formulaCache_, bool editorMode)
     : UIDataNode(editorMode)
     , component(component_)
+    , formulaCache(formulaCache_)
 {
 }
 
@@ -43,7 +44,8 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
     if (component->IsDirty())
     {
         component->SetDirty(false);
-        expression = nullptr;
+        program = nullptr;
+        resolvedData.Reset();
         hasToResetError = true;
         expChanged = true;
 
@@ -76,31 +78,39 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
             component->GetControl()->SetPropertyLocalFlag(propertyIndex, true);
         }
 
-        controlReflection = Reflection::Create(ReflectedObject(obj)).GetField(key);
-        DVASSERT(controlReflection.IsValid(), Format("Can't find control field: %s", component->GetControlFieldName().c_str()).c_str());
+        controlObject = ReflectedObject(obj);
+        controlField = ReflectedFieldAccessor::Get(controlObject.GetReflectedType(), FastName(key));
+        controlFieldType = controlField->IsValid() ? controlField->GetValueType(controlObject) : nullptr;
+        DVASSERT(controlField->IsValid(), Format("Can't find control field: %s", component->GetControlFieldName().c_str()).c_str());
 
-        FormulaParser parser(component->GetBindingExpression());
         try
         {
-            expression = parser.ParseExpression();
+            program = formulaCache->Get(component->GetBindingExpression());
         }
         catch (const FormulaException& error)
         {
-            expression = nullptr;
+            program = nullptr;
             hasToResetError = false;
             NotifyError(error.GetFormattedMessage(), component->GetControlFieldName());
         }
     }
 
-    if (expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (parent->IsDirty() || expChanged || dependenciesManager->IsDirty(dependencyId)))
+    if (program && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (parent->IsDirty() || expChanged || dependenciesManager->IsDirty(dependencyId)))
     {
         FormulaContext* context = parent->GetFormulaContext().get();
         hasToResetError = true;
+
+        // data source of model may be changed without changing its context
+        if (parent->IsDirty())
+        {
+            resolvedData.Reset();
+        }
+
         try
         {
-            FormulaExecutor executor(context);
-            Any val = executor.Calculate(expression.get());
-            const Vector<void*>& dependencies = executor.GetDependencies();
+            FormulaVirtualMachine vm(context, &resolvedData);
+            Any val = vm.Calculate(program.get());
+            const Vector<void*>& dependencies = vm.GetDependencies();
 
             if (!dependencies.empty())
             {
@@ -111,25 +121,25 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
                 dependenciesManager->ReleaseDepencency(dependencyId);
             }
 
-            if (controlReflection.IsValid())
+            if (controlField != nullptr && controlField->IsValid())
             {
-                if (controlReflection.GetValueType() == val.GetType())
+                if (controlFieldType == val.GetType())
                 {
-                    controlReflection.SetValue(val);
+                    controlField->SetValue(controlObject, val);
                 }
-                else if (controlReflection.GetValueType() == Type::Instance<String>())
+                else if (controlFieldType == Type::Instance<String>())
                 {
-                    controlReflection.SetValue(FormulaFormatter::AnyToString(val));
+                    controlField->SetValueDirect(controlObject, FormulaFormatter::AnyToString(val));
                 }
-                else if (controlReflection.GetValueType() == Type::Instance<FilePath>())
+                else if (controlFieldType == Type::Instance<FilePath>())
                 {
-                    controlReflection.SetValue(FilePath(FormulaFormatter::AnyToString(val)));
+                    controlField->SetValueDirect(controlObject, FilePath(FormulaFormatter::AnyToString(val)));
                 }
                 else
                 {
                     if (!val.IsEmpty())
                     {
-                        controlReflection.SetValue(val);
+                        controlField->SetValue(controlObject, val);
                     }
                     else
                     {
@@ -162,14 +172,20 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
 bool UIDataBinding::ProcessWriteToModel(UIDataBindingDependenciesManager* dependenciesManager)
 {
     bool result = false;
-    if (expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_READ && !dependenciesManager->IsDirty(dependencyId))
+    if (program && controlField != nullptr && controlField->IsValid() && component->GetUpdateMode() != UIDataBindingComponent::MODE_READ && !dependenciesManager->IsDirty(dependencyId))
     {
         FormulaContext* context = parent->GetFormulaContext().get();
-        Any uiValue = controlReflection.GetValue();
+        Any uiValue = controlField->GetValue(controlObject);
         bool hasToResetError = true;
+
+        if (parent->IsDirty())
+        {
+            resolvedData.Reset();
+        }
+
         try
         {
-            Reflection ref = FormulaExecutor(context).GetDataReference(expression.get());
+            Reflection ref = FormulaVirtualMachine(context, &resolvedData).GetDataReference(program.get());
             if (ref.GetValue() != uiValue)
             {
                 ref.SetValue(uiValue);
@@ -2,18 +2,21 @@
 
 #include "UI/DataBinding/Private/UIDataNode.h"
 #include "Reflection/Reflection.h"
+#include "Reflection/ReflectedFieldAccessor.h"
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
 
 namespace DAVA
 {
 class UIDataBindingComponent;
-class FormulaExpression;
+class FormulaProgram;
+class FormulaProgramCache;
 class UIDataBindingIssueDelegate;
 class UIDataBindingDependenciesManager;
 
 class UIDataBinding : public UIDataNode
 {
 public:
-    UIDataBinding(UIDataBindingComponent* component, bool editorMode);
+    UIDataBinding(UIDataBindingComponent* component, FormulaProgramCache* formulaCache, bool editorMode);
     ~UIDataBinding();
 
     UIComponent* GetComponent() const override;
@@ -23,8 +26,12 @@ public:
 
 private:
     UIDataBindingComponent* component = nullptr;
-    std::shared_ptr<FormulaExpression> expression;
+    FormulaProgramCache* formulaCache = nullptr;
+    std::shared_ptr<FormulaProgram> program;
+    FormulaResolvedData resolvedData;
 
-    Reflection controlReflection;
+    ReflectedObject controlObject;
+    const ReflectedFieldAccessor* controlField = nullptr;
+    const Type* controlFieldType = nullptr;
 };
 }
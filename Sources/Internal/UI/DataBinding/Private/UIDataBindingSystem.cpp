@@ -15,6 +15,7 @@
 #include "UI/DataBinding/Private/UIDataBindingDependenciesManager.h"
 
 #include "UI/Formula/FormulaContext.h"
+#include "UI/Formula/Private/FormulaProgramCache.h"
 
 #include "Logger/Logger.h"
 
@@ -24,6 +25,7 @@ UIDataBindingSystem::UIDataBindingSystem()
 {
     rootModel = std::make_shared<UIDataRootModel>(false);
     dependenciesManager = std::make_unique<UIDataBindingDependenciesManager>();
+    formulaCache = std::make_unique<FormulaProgramCache>();
 }
 
 UIDataBindingSystem::~UIDataBindingSystem()
@@ -217,7 +219,7 @@ void UIDataBindingSystem::RegisterDataBinding(UIDataBindingComponent* component)
 {
     component->SetDirty(true);
 
-    std::shared_ptr<UIDataBinding> node = std::make_shared<UIDataBinding>(component, editorMode);
+    std::shared_ptr<UIDataBinding> node = std::make_shared<UIDataBinding>(component, formulaCache.get(), editorMode);
     node->SetIssueDelegate(issueDelegate);
     node->SetParent(FindParentModel(component->GetControl()));
     dataBindings.push_back(node);
@@ -15,6 +15,7 @@ class UIDataBindingComponent;
 class UIDataBindingDependenciesManager;
 
 class FormulaContext;
+class FormulaProgramCache;
 
 class UIDataNode;
 class UIDataModel;
@@ -70,6 +71,7 @@ private:
     bool hasUnprocessedModels = false;
 
     std::unique_ptr<UIDataBindingDependenciesManager> dependenciesManager;
+    std::unique_ptr<FormulaProgramCache> formulaCache;
 
     UIDataBindingIssueDelegate* issueDelegate = nullptr;
     std::shared_ptr<UIDataModel> rootModel;
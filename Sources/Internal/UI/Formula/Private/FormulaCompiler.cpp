@@ -0,0 +1,428 @@
+#include "UI/Formula/Private/FormulaCompiler.h"
+
+#include "UI/Formula/Private/FormulaData.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+
+namespace DAVA
+{
+namespace FormulaCompilerDetail
+{
+template <typename T>
+bool IsZero(const Any& value)
+{
+    return value.CanGet<T>() && value.Get<T>() == 0;
+}
+
+bool IsIntegerZero(const Any& value)
+{
+    return IsZero<int32>(value) || IsZero<uint32>(value) || IsZero<int64>(value) || IsZero<uint64>(value) ||
+    IsZero<int16>(value) || IsZero<uint16>(value) || IsZero<int8>(value) || IsZero<uint8>(value);
+}
+
+/**
+ Calculates expressions which don't depend on context.
+ */
+class ConstantCalculator : private FormulaExpressionVisitor
+{
+public:
+    bool TryCalculate(FormulaExpression* exp, Any& result)
+    {
+        if (Calculate(exp))
+        {
+            result = value;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    bool Calculate(FormulaExpression* exp)
+    {
+        isConstant = true;
+        exp->Accept(this);
+        return isConstant;
+    }
+
+    void Visit(FormulaValueExpression* exp) override
+    {
+        value = exp->GetValue();
+    }
+
+    void Visit(FormulaNegExpression* exp) override
+    {
+        if (Calculate(exp->GetExp()))
+        {
+            try
+            {
+                value = FormulaExecutor::CalculateNeg(value, exp);
+            }
+            catch (const FormulaException&)
+            {
+                isConstant = false;
+            }
+        }
+    }
+
+    void Visit(FormulaNotExpression* exp) override
+    {
+        if (Calculate(exp->GetExp()))
+        {
+            try
+            {
+                value = FormulaExecutor::CalculateNot(value, exp);
+            }
+            catch (const FormulaException&)
+            {
+                isConstant = false;
+            }
+        }
+    }
+
+    void Visit(FormulaWhenExpression* exp) override
+    {
+        for (const auto& branch : exp->GetBranches())
+        {
+            if (!Calculate(branch.first.get()) || !value.CanGet<bool>())
+            {
+                isConstant = false;
+                return;
+            }
+
+            if (value.Get<bool>())
+            {
+                Calculate(branch.second.get());
+                return;
+            }
+        }
+        Calculate(exp->GetElseBranch());
+    }
+
+    void Visit(FormulaBinaryOperatorExpression* exp) override
+    {
+        if (Calculate(exp->GetLhs()))
+        {
+            Any lhs = value;
+            if (Calculate(exp->GetRhs()))
+            {
+                // integer division by zero is left for runtime, it can be in a branch which is never taken
+                FormulaBinaryOperatorExpression::Operator op = exp->GetOperator();
+                if ((op == FormulaBinaryOperatorExpression::OP_DIV || op == FormulaBinaryOperatorExpression::OP_MOD) && IsIntegerZero(value))
+                {
+                    isConstant = false;
+                    return;
+                }
+
+                try
+                {
+                    value = FormulaExecutor::CalculateBinaryOperator(op, lhs, value, exp);
+                    isConstant = !value.IsEmpty();
+                }
+                catch (const FormulaException&)
+                {
+                    isConstant = false;
+                }
+            }
+        }
+    }
+
+    void Visit(FormulaFunctionExpression* exp) override
+    {
+        isConstant = false;
+    }
+
+    void Visit(FormulaFieldAccessExpression* exp) override
+    {
+        isConstant = false;
+    }
+
+    void Visit(FormulaIndexExpression* exp) override
+    {
+        isConstant = false;
+    }
+
+    Any value;
+    bool isConstant = true;
+};
+}
+
+FormulaCompiler::FormulaCompiler()
+{
+}
+
+FormulaCompiler::~FormulaCompiler()
+{
+}
+
+std::shared_ptr<FormulaProgram> FormulaCompiler::Compile(const std::shared_ptr<FormulaExpression>& exp)
+{
+    DVASSERT(exp);
+
+    std::shared_ptr<FormulaProgram> result = std::make_shared<FormulaProgram>(exp);
+    program = result.get();
+    program->registersCount = 1;
+
+    code = &program->valueCode;
+    registersTop = 1;
+    CompileValue(exp.get(), 0);
+
+    code = &program->referenceCode;
+    registersTop = 1;
+    CompileReference(exp.get(), 0);
+
+    code = nullptr;
+    program = nullptr;
+    return result;
+}
+
+void FormulaCompiler::Visit(FormulaValueExpression* exp)
+{
+    const Any& value = exp->GetValue();
+    if (referenceMode)
+    {
+        if (value.CanGet<std::shared_ptr<FormulaDataMap>>() || value.CanGet<std::shared_ptr<FormulaDataVector>>())
+        {
+            FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::LoadConstReference, exp);
+            instruction.operand = AddConstant(value);
+            referenceProduced = true;
+        }
+    }
+    else
+    {
+        FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::LoadConst, exp);
+        instruction.operand = AddConstant(value);
+    }
+}
+
+void FormulaCompiler::Visit(FormulaNegExpression* exp)
+{
+    uint16 dst = targetRegister;
+    CompileValue(exp->GetExp(), dst);
+
+    FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::Neg, exp);
+    instruction.a = dst;
+}
+
+void FormulaCompiler::Visit(FormulaNotExpression* exp)
+{
+    uint16 dst = targetRegister;
+    CompileValue(exp->GetExp(), dst);
+
+    FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::Not, exp);
+    instruction.a = dst;
+}
+
+void FormulaCompiler::Visit(FormulaWhenExpression* exp)
+{
+    uint16 dst = targetRegister;
+    Vector<size_t> jumpsToEnd;
+
+    for (const auto& branch : exp->GetBranches())
+    {
+        Any condition;
+        if (FormulaCompilerDetail::ConstantCalculator().TryCalculate(branch.first.get(), condition) && condition.CanGet<bool>())
+        {
+            if (condition.Get<bool>())
+            {
+                // following branches are unreachable
+                CompileValue(branch.second.get(), dst);
+                for (size_t jump : jumpsToEnd)
+                {
+                    (*code)[jump].operand = static_cast<uint32>(code->size());
+                }
+                return;
+            }
+            continue;
+        }
+
+        uint16 conditionRegister = AllocateRegister();
+        CompileValue(branch.first.get(), conditionRegister);
+
+        size_t jumpToNext = code->size();
+        FormulaProgram::Instruction& jumpIfFalse = Emit(FormulaProgram::OpCode::JumpIfFalse, branch.first.get());
+        jumpIfFalse.a = conditionRegister;
+        registersTop = conditionRegister;
+
+        CompileValue(branch.second.get(), dst);
+
+        jumpsToEnd.push_back(code->size());
+        Emit(FormulaProgram::OpCode::Jump, exp);
+
+        (*code)[jumpToNext].operand = static_cast<uint32>(code->size());
+    }
+
+    CompileValue(exp->GetElseBranch(), dst);
+    for (size_t jump : jumpsToEnd)
+    {
+        (*code)[jump].operand = static_cast<uint32>(code->size());
+    }
+}
+
+void FormulaCompiler::Visit(FormulaBinaryOperatorExpression* exp)
+{
+    uint16 dst = targetRegister;
+    uint16 rhs = AllocateRegister();
+    CompileValue(exp->GetLhs(), dst);
+    CompileValue(exp->GetRhs(), rhs);
+
+    FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::Binary, exp);
+    instruction.binaryOp = exp->GetOperator();
+    instruction.a = dst;
+    instruction.b = rhs;
+}
+
+void FormulaCompiler::Visit(FormulaFunctionExpression* exp)
+{
+    const Vector<std::shared_ptr<FormulaExpression>>& params = exp->GetParms();
+
+    uint16 first = registersTop;
+    for (const std::shared_ptr<FormulaExpression>& param : params)
+    {
+        CompileValue(param.get(), AllocateRegister());
+    }
+
+    FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::Call, exp);
+    instruction.a = first;
+    instruction.b = static_cast<uint16>(params.size());
+    instruction.operand = AddName(exp->GetName());
+}
+
+void FormulaCompiler::Visit(FormulaFieldAccessExpression* exp)
+{
+    uint16 dst = targetRegister;
+    if (exp->GetExp())
+    {
+        CompileReference(exp->GetExp(), dst);
+
+        FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::GetField, exp);
+        instruction.a = dst;
+        instruction.operand = AddName(exp->GetFieldName());
+    }
+    else
+    {
+        FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::FindData, exp);
+        instruction.operand = AddName(exp->GetFieldName());
+    }
+
+    if (referenceMode)
+    {
+        referenceProduced = true;
+    }
+    else
+    {
+        FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::LoadValue, exp);
+        instruction.a = dst;
+    }
+}
+
+void FormulaCompiler::Visit(FormulaIndexExpression* exp)
+{
+    uint16 dst = targetRegister;
+    uint16 index = AllocateRegister();
+
+    // index is calculated before data reference as in FormulaExecutor
+    CompileValue(exp->GetIndexExp(), index);
+    CompileReference(exp->GetExp(), dst);
+
+    FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::GetIndex, exp);
+    instruction.a = dst;
+    instruction.b = index;
+
+    if (referenceMode)
+    {
+        referenceProduced = true;
+    }
+    else
+    {
+        FormulaProgram::Instruction& loadValue = Emit(FormulaProgram::OpCode::LoadValue, exp);
+        loadValue.a = dst;
+    }
+}
+
+void FormulaCompiler::CompileValue(FormulaExpression* exp, uint16 dst)
+{
+    Any constant;
+    if (!exp->IsValue() && FormulaCompilerDetail::ConstantCalculator().TryCalculate(exp, constant))
+    {
+        FormulaProgram::Instruction& instruction = Emit(FormulaProgram::OpCode::LoadConst, exp);
+        instruction.dst = dst;
+        instruction.operand = AddConstant(constant);
+        return;
+    }
+
+    uint16 prevTarget = targetRegister;
+    uint16 prevTop = registersTop;
+    bool prevReferenceMode = referenceMode;
+    bool prevReferenceProduced = referenceProduced;
+
+    targetRegister = dst;
+    referenceMode = false;
+    exp->Accept(this);
+
+    targetRegister = prevTarget;
+    registersTop = prevTop;
+    referenceMode = prevReferenceMode;
+    referenceProduced = prevReferenceProduced;
+}
+
+void FormulaCompiler::CompileReference(FormulaExpression* exp, uint16 dst)
+{
+    uint16 prevTarget = targetRegister;
+    uint16 prevTop = registersTop;
+    bool prevReferenceMode = referenceMode;
+    bool prevReferenceProduced = referenceProduced;
+
+    targetRegister = dst;
+    referenceMode = true;
+    referenceProduced = false;
+    exp->Accept(this);
+
+    if (!referenceProduced)
+    {
+        Emit(FormulaProgram::OpCode::NoReference, exp);
+    }
+
+    targetRegister = prevTarget;
+    registersTop = prevTop;
+    referenceMode = prevReferenceMode;
+    referenceProduced = prevReferenceProduced;
+}
+
+FormulaProgram::Instruction& FormulaCompiler::Emit(FormulaProgram::OpCode op, FormulaExpression* source)
+{
+    FormulaProgram::Instruction instruction;
+    instruction.op = op;
+    instruction.dst = targetRegister;
+    instruction.source = source;
+
+    code->push_back(instruction);
+    return code->back();
+}
+
+uint16 FormulaCompiler::AllocateRegister()
+{
+    DVASSERT(registersTop < std::numeric_limits<uint16>::max());
+
+    uint16 reg = registersTop++;
+    program->registersCount = std::max(program->registersCount, static_cast<uint32>(registersTop));
+    return reg;
+}
+
+uint32 FormulaCompiler::AddConstant(const Any& value)
+{
+    program->constants.push_back(value);
+    return static_cast<uint32>(program->constants.size() - 1);
+}
+
+uint32 FormulaCompiler::AddName(const String& name)
+{
+    auto it = std::find(program->names.begin(), program->names.end(), name);
+    if (it != program->names.end())
+    {
+        return static_cast<uint32>(std::distance(program->names.begin(), it));
+    }
+
+    program->names.push_back(name);
+    return static_cast<uint32>(program->names.size() - 1);
+}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "UI/Formula/Private/FormulaExpression.h"
+#include "UI/Formula/Private/FormulaProgram.h"
+
+namespace DAVA
+{
+/**
+ \ingroup formula
+
+ Compiler translates expression tree to FormulaProgram.
+
+ Subexpressions which don't depend on data and functions of context are folded
+ to constants, `when` branches with constant conditions are resolved at compile time.
+ Operations which can fail on constants (e.g. `5 + 5L`) are left for runtime to
+ report errors the same way as FormulaExecutor does.
+ */
+class FormulaCompiler : private FormulaExpressionVisitor
+{
+public:
+    FormulaCompiler();
+    ~FormulaCompiler() override;
+
+    std::shared_ptr<FormulaProgram> Compile(const std::shared_ptr<FormulaExpression>& exp);
+
+private:
+    void Visit(FormulaValueExpression* exp) override;
+    void Visit(FormulaNegExpression* exp) override;
+    void Visit(FormulaNotExpression* exp) override;
+    void Visit(FormulaWhenExpression* exp) override;
+    void Visit(FormulaBinaryOperatorExpression* exp) override;
+    void Visit(FormulaFunctionExpression* exp) override;
+    void Visit(FormulaFieldAccessExpression* exp) override;
+    void Visit(FormulaIndexExpression* exp) override;
+
+    void CompileValue(FormulaExpression* exp, uint16 dst);
+    void CompileReference(FormulaExpression* exp, uint16 dst);
+
+    FormulaProgram::Instruction& Emit(FormulaProgram::OpCode op, FormulaExpression* source);
+    uint16 AllocateRegister();
+    uint32 AddConstant(const Any& value);
+    uint32 AddName(const String& name);
+
+    FormulaProgram* program = nullptr;
+    Vector<FormulaProgram::Instruction>* code = nullptr;
+
+    uint16 targetRegister = 0;
+    uint16 registersTop = 0;
+    bool referenceMode = false;
+    bool referenceProduced = false;
+};
+}
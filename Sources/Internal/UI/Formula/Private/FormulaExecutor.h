@@ -45,6 +45,16 @@ public:
      */
     const Vector<void*>& GetDependencies() const;
 
+    /**
+     \ingroup formula
+
+     Operations shared with FormulaVirtualMachine, `exp` is used only for error reporting.
+     */
+    static Any CalculateNeg(const Any& val, const FormulaExpression* exp);
+    static Any CalculateNot(const Any& val, const FormulaExpression* exp);
+    static Any CalculateBinaryOperator(FormulaBinaryOperatorExpression::Operator op, const Any& l, const Any& r, const FormulaExpression* exp);
+    static Any InvokeFunction(FormulaContext* context, const String& name, Vector<Any>& values, const FormulaExpression* exp);
+
 private:
     void Visit(FormulaValueExpression* exp) override;
     void Visit(FormulaNegExpression* exp) override;
@@ -59,18 +69,18 @@ private:
     const Reflection& GetDataReferenceImpl(FormulaExpression* exp);
 
     template <typename T>
-    Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal) const;
+    static Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& lVal, const Any& rVal);
 
     template <typename T>
-    Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal) const;
+    static Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& lVal, const Any& rVal);
 
     template <typename T>
-    Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const;
+    static Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal);
 
     template <typename T>
-    Any CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const;
+    static Any CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal);
 
-    bool CastToInt32(const Any& val, int32* res) const;
+    static bool CastToInt32(const Any& val, int32* res);
 
     FormulaContext* context = nullptr;
     Any calculationResult;
@@ -0,0 +1,13 @@
+#include "UI/Formula/Private/FormulaProgram.h"
+
+namespace DAVA
+{
+FormulaProgram::FormulaProgram(const std::shared_ptr<FormulaExpression>& expression_)
+    : expression(expression_)
+{
+}
+
+FormulaProgram::~FormulaProgram()
+{
+}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/Any.h"
+#include "UI/Formula/Private/FormulaExpression.h"
+
+namespace DAVA
+{
+class ReflectedType;
+class ReflectedFieldAccessor;
+
+/**
+ \ingroup formula
+
+ FormulaProgram is compiled form of formula expression. It contains flat list
+ of register based instructions which is executed by FormulaVirtualMachine
+ without visiting of AST nodes.
+
+ Program has two entry points: code which calculates value of expression and
+ code which calculates reference to data (see FormulaExecutor::GetDataReference).
+ Result of both is stored in register 0.
+
+ Program keeps expression alive, instructions refer to its nodes for error reporting.
+ */
+class FormulaProgram final
+{
+public:
+    enum class OpCode : uint8
+    {
+        LoadConst, //!< r[dst].value = constants[operand]
+        LoadConstReference, //!< r[dst].ref = reflection of data container constants[operand]
+        FindData, //!< r[dst].ref = context data with name names[operand]
+        GetField, //!< r[dst].ref = field names[operand] of r[a].ref
+        GetIndex, //!< r[dst].ref = field of r[a].ref with key r[b].value
+        LoadValue, //!< r[dst].value = value of r[a].ref
+        Neg, //!< r[dst].value = -r[a].value
+        Not, //!< r[dst].value = not r[a].value
+        Binary, //!< r[dst].value = r[a].value `binaryOp` r[b].value
+        Call, //!< r[dst].value = function names[operand] with b arguments in registers starting from r[a]
+        JumpIfFalse, //!< jump to operand if r[a].value is false
+        Jump, //!< jump to operand
+        NoReference //!< fail, expression isn't a reference to data
+    };
+
+    struct Instruction
+    {
+        OpCode op = OpCode::LoadConst;
+        FormulaBinaryOperatorExpression::Operator binaryOp = FormulaBinaryOperatorExpression::OP_PLUS;
+        uint16 dst = 0;
+        uint16 a = 0;
+        uint16 b = 0;
+        uint32 operand = 0;
+        FormulaExpression* source = nullptr;
+
+        // GetField resolves field of plain reflected classes once per owner type
+        mutable const ReflectedType* cachedOwnerType = nullptr;
+        mutable const ReflectedFieldAccessor* cachedField = nullptr;
+    };
+
+    FormulaProgram(const std::shared_ptr<FormulaExpression>& expression);
+    ~FormulaProgram();
+
+    const std::shared_ptr<FormulaExpression>& GetExpression() const;
+
+    const Vector<Instruction>& GetValueCode() const;
+    const Vector<Instruction>& GetReferenceCode() const;
+
+    const Any& GetConstant(uint32 index) const;
+    const String& GetName(uint32 index) const;
+    uint32 GetNamesCount() const;
+    uint32 GetRegistersCount() const;
+
+private:
+    friend class FormulaCompiler;
+
+    std::shared_ptr<FormulaExpression> expression;
+    Vector<Instruction> valueCode;
+    Vector<Instruction> referenceCode;
+    Vector<Any> constants;
+    Vector<String> names;
+    uint32 registersCount = 0;
+};
+
+inline const std::shared_ptr<FormulaExpression>& FormulaProgram::GetExpression() const
+{
+    return expression;
+}
+
+inline const Vector<FormulaProgram::Instruction>& FormulaProgram::GetValueCode() const
+{
+    return valueCode;
+}
+
+inline const Vector<FormulaProgram::Instruction>& FormulaProgram::GetReferenceCode() const
+{
+    return referenceCode;
+}
+
+inline const Any& FormulaProgram::GetConstant(uint32 index) const
+{
+    return constants[index];
+}
+
+inline const String& FormulaProgram::GetName(uint32 index) const
+{
+    return names[index];
+}
+
+inline uint32 FormulaProgram::GetNamesCount() const
+{
+    return static_cast<uint32>(names.size());
+}
+
+inline uint32 FormulaProgram::GetRegistersCount() const
+{
+    return registersCount;
+}
+}
@@ -0,0 +1,68 @@
+#include "UI/Formula/Private/FormulaProgramCache.h"
+
+#include "UI/Formula/Private/FormulaCompiler.h"
+#include "UI/Formula/Private/FormulaParser.h"
+
+namespace DAVA
+{
+namespace FormulaProgramCacheDetail
+{
+const size_t MIN_CLEANUP_SIZE = 64;
+}
+
+FormulaProgramCache::FormulaProgramCache()
+    : nextCleanupSize(FormulaProgramCacheDetail::MIN_CLEANUP_SIZE)
+{
+}
+
+FormulaProgramCache::~FormulaProgramCache()
+{
+}
+
+std::shared_ptr<FormulaProgram> FormulaProgramCache::Get(const String& source)
+{
+    auto it = programs.find(source);
+    if (it != programs.end())
+    {
+        return it->second;
+    }
+
+    FormulaParser parser(source);
+    std::shared_ptr<FormulaProgram> program = FormulaCompiler().Compile(parser.ParseExpression());
+
+    if (programs.size() >= nextCleanupSize)
+    {
+        RemoveUnused();
+        nextCleanupSize = std::max(FormulaProgramCacheDetail::MIN_CLEANUP_SIZE, programs.size() * 2);
+    }
+
+    programs.emplace(source, program);
+    return program;
+}
+
+void FormulaProgramCache::Clear()
+{
+    programs.clear();
+    nextCleanupSize = FormulaProgramCacheDetail::MIN_CLEANUP_SIZE;
+}
+
+size_t FormulaProgramCache::GetSize() const
+{
+    return programs.size();
+}
+
+void FormulaProgramCache::RemoveUnused()
+{
+    for (auto it = programs.begin(); it != programs.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            it = programs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+}
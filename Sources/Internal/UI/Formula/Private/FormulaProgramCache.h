@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "UI/Formula/Private/FormulaProgram.h"
+
+namespace DAVA
+{
+/**
+ \ingroup formula
+
+ Cache of compiled programs by source string. Controls with the same binding
+ expression (e.g. cells of the list) share one compiled program.
+ Programs which are not used outside the cache are released periodically.
+ */
+class FormulaProgramCache final
+{
+public:
+    FormulaProgramCache();
+    ~FormulaProgramCache();
+
+    /**
+     \ingroup formula
+
+     Returns compiled program for `source`. Parses and compiles it on first request.
+     Throws FormulaException if `source` can't be parsed, errors are not cached.
+     */
+    std::shared_ptr<FormulaProgram> Get(const String& source);
+
+    void Clear();
+    size_t GetSize() const;
+
+private:
+    void RemoveUnused();
+
+    UnorderedMap<String, std::shared_ptr<FormulaProgram>> programs;
+    size_t nextCleanupSize = 0;
+};
+}
@@ -0,0 +1,263 @@
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
+
+#include "UI/Formula/Private/FormulaData.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaFormatter.h"
+#include "Reflection/ReflectedFieldAccessor.h"
+#include "Reflection/ReflectedType.h"
+#include "Reflection/Private/Wrappers/StructureWrapperClass.h"
+#include "Utils/StringFormat.h"
+
+namespace DAVA
+{
+namespace FormulaVirtualMachineDetail
+{
+// unsupported operations produce empty values, reported the same way as by FormulaExecutor
+void CheckCalculated(const Any& value, FormulaExpression* source)
+{
+    if (value.IsEmpty())
+    {
+        DAVA_THROW(FormulaException,
+                   Format("Can't calculate expression '%s'",
+                          FormulaFormatter().Format(source).c_str()),
+                   source);
+    }
+}
+}
+
+void FormulaResolvedData::Reset()
+{
+    program = nullptr;
+    context = nullptr;
+    data.clear();
+}
+
+FormulaVirtualMachine::FormulaVirtualMachine(FormulaContext* context_, FormulaResolvedData* resolvedData_)
+    : context(context_)
+    , resolvedData(resolvedData_)
+{
+}
+
+FormulaVirtualMachine::~FormulaVirtualMachine()
+{
+}
+
+Any FormulaVirtualMachine::Calculate(const FormulaProgram* program)
+{
+    Execute(program, program->GetValueCode());
+    return std::move(registers[0].value);
+}
+
+Reflection FormulaVirtualMachine::GetDataReference(const FormulaProgram* program)
+{
+    Execute(program, program->GetReferenceCode());
+    return registers[0].ref;
+}
+
+const Vector<void*>& FormulaVirtualMachine::GetDependencies() const
+{
+    return dependencies;
+}
+
+void FormulaVirtualMachine::Execute(const FormulaProgram* program, const Vector<FormulaProgram::Instruction>& code)
+{
+    using OpCode = FormulaProgram::OpCode;
+
+    registers.clear();
+    registers.resize(program->GetRegistersCount());
+
+    size_t pc = 0;
+    const size_t codeSize = code.size();
+    while (pc < codeSize)
+    {
+        const FormulaProgram::Instruction& instruction = code[pc++];
+        Register& dst = registers[instruction.dst];
+
+        switch (instruction.op)
+        {
+        case OpCode::LoadConst:
+            dst.value = program->GetConstant(instruction.operand);
+            break;
+
+        case OpCode::LoadConstReference:
+        {
+            const Any& value = program->GetConstant(instruction.operand);
+            if (value.CanGet<std::shared_ptr<FormulaDataMap>>())
+            {
+                dst.ref = Reflection::Create(ReflectedObject(value.Get<std::shared_ptr<FormulaDataMap>>().get()));
+            }
+            else
+            {
+                dst.ref = Reflection::Create(ReflectedObject(value.Get<std::shared_ptr<FormulaDataVector>>().get()));
+            }
+            break;
+        }
+
+        case OpCode::FindData:
+        {
+            dst.ref = FindData(program, instruction);
+            if (!dst.ref.IsValid())
+            {
+                DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", program->GetName(instruction.operand).c_str()), instruction.source);
+            }
+            dependencies.push_back(dst.ref.GetValueObject().GetVoidPtr());
+            break;
+        }
+
+        case OpCode::GetField:
+        {
+            Reflection field = GetField(program, instruction, registers[instruction.a].ref);
+            if (!field.IsValid())
+            {
+                DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", program->GetName(instruction.operand).c_str()), instruction.source);
+            }
+            dependencies.push_back(field.GetValueObject().GetVoidPtr());
+            dst.ref = std::move(field);
+            break;
+        }
+
+        case OpCode::GetIndex:
+        {
+            const Any& index = registers[instruction.b].value;
+            Reflection field = registers[instruction.a].ref.GetField(index);
+            if (!field.IsValid())
+            {
+                DAVA_THROW(FormulaException, Format("Can't get data '%s' by index '%s' with type '%s'",
+                                                    FormulaFormatter().Format(instruction.source).c_str(),
+                                                    FormulaFormatter::AnyToString(index).c_str(),
+                                                    FormulaFormatter::AnyTypeToString(index).c_str()),
+                           instruction.source);
+            }
+            dependencies.push_back(field.GetValueObject().GetVoidPtr());
+            dst.ref = std::move(field);
+            break;
+        }
+
+        case OpCode::LoadValue:
+            dst.value = registers[instruction.a].ref.GetValue();
+            CalculateNestedExpression(dst.value);
+            break;
+
+        case OpCode::Neg:
+            dst.value = FormulaExecutor::CalculateNeg(registers[instruction.a].value, instruction.source);
+            FormulaVirtualMachineDetail::CheckCalculated(dst.value, instruction.source);
+            break;
+
+        case OpCode::Not:
+            dst.value = FormulaExecutor::CalculateNot(registers[instruction.a].value, instruction.source);
+            FormulaVirtualMachineDetail::CheckCalculated(dst.value, instruction.source);
+            break;
+
+        case OpCode::Binary:
+            dst.value = FormulaExecutor::CalculateBinaryOperator(instruction.binaryOp, registers[instruction.a].value, registers[instruction.b].value, instruction.source);
+            FormulaVirtualMachineDetail::CheckCalculated(dst.value, instruction.source);
+            break;
+
+        case OpCode::Call:
+        {
+            arguments.clear();
+            for (uint16 i = 0; i < instruction.b; ++i)
+            {
+                arguments.push_back(registers[instruction.a + i].value);
+            }
+
+            dst.value = FormulaExecutor::InvokeFunction(context, program->GetName(instruction.operand), arguments, instruction.source);
+            FormulaVirtualMachineDetail::CheckCalculated(dst.value, instruction.source);
+            CalculateNestedExpression(dst.value);
+            break;
+        }
+
+        case OpCode::JumpIfFalse:
+        {
+            const Any& condition = registers[instruction.a].value;
+            if (!condition.CanGet<bool>())
+            {
+                DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to when selector expression", FormulaFormatter::AnyTypeToString(condition).c_str()), instruction.source);
+            }
+            if (!condition.Get<bool>())
+            {
+                pc = instruction.operand;
+            }
+            break;
+        }
+
+        case OpCode::Jump:
+            pc = instruction.operand;
+            break;
+
+        case OpCode::NoReference:
+            DAVA_THROW(FormulaException,
+                       Format("Can't get data reference '%s'",
+                              FormulaFormatter().Format(instruction.source).c_str()),
+                       instruction.source);
+
+        default:
+            DVASSERT(false, "Invalid formula instruction");
+            break;
+        }
+    }
+}
+
+Reflection FormulaVirtualMachine::FindData(const FormulaProgram* program, const FormulaProgram::Instruction& instruction)
+{
+    if (nullptr == resolvedData)
+    {
+        return context->FindReflection(program->GetName(instruction.operand));
+    }
+
+    if (resolvedData->program != program || resolvedData->context != context)
+    {
+        resolvedData->Reset();
+        resolvedData->program = program;
+        resolvedData->context = context;
+        resolvedData->data.resize(program->GetNamesCount());
+    }
+
+    Reflection& data = resolvedData->data[instruction.operand];
+    if (!data.IsValid())
+    {
+        data = context->FindReflection(program->GetName(instruction.operand));
+    }
+    return data;
+}
+
+Reflection FormulaVirtualMachine::GetField(const FormulaProgram* program, const FormulaProgram::Instruction& instruction, const Reflection& owner) const
+{
+    ReflectedObject ownerObject = owner.GetValueObject();
+    const ReflectedType* ownerType = ownerObject.GetReflectedType();
+
+    if (ownerType != instruction.cachedOwnerType)
+    {
+        instruction.cachedOwnerType = ownerType;
+        instruction.cachedField = nullptr;
+
+        // only fields of plain classes can be resolved by type, containers and
+        // formula data have their own structure wrappers with dynamic content
+        if (nullptr != ownerType && nullptr != dynamic_cast<const StructureWrapperClass*>(ownerType->GetStrucutreWrapper()))
+        {
+            const ReflectedFieldAccessor* accessor = ReflectedFieldAccessor::Get(ownerType, FastName(program->GetName(instruction.operand)));
+            if (accessor->IsValid())
+            {
+                instruction.cachedField = accessor;
+            }
+        }
+    }
+
+    if (nullptr != instruction.cachedField)
+    {
+        return instruction.cachedField->GetReflection(ownerObject);
+    }
+    return owner.GetField(program->GetName(instruction.operand));
+}
+
+void FormulaVirtualMachine::CalculateNestedExpression(Any& value) const
+{
+    if (value.CanCast<std::shared_ptr<FormulaExpression>>())
+    {
+        std::shared_ptr<FormulaExpression> internalExpr = value.Cast<std::shared_ptr<FormulaExpression>>();
+        FormulaExecutor executor(context->GetParent() ? context->GetParent() : context);
+        value = executor.Calculate(internalExpr.get());
+    }
+}
+}
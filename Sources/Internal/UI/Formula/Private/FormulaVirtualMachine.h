@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Reflection/Reflection.h"
+#include "UI/Formula/FormulaContext.h"
+#include "UI/Formula/Private/FormulaProgram.h"
+
+namespace DAVA
+{
+/**
+ \ingroup formula
+
+ Context data resolved by names of FindData instructions of particular program.
+ Owner of program (e.g. data binding) keeps it between calculations, so data isn't
+ looked up by name on every calculation. Data is resolved again if program or context
+ is changed, owner has to call `Reset` if data source of the same context is changed.
+ */
+class FormulaResolvedData final
+{
+public:
+    void Reset();
+
+private:
+    friend class FormulaVirtualMachine;
+
+    const FormulaProgram* program = nullptr;
+    const FormulaContext* context = nullptr;
+    Vector<Reflection> data; // indexed by name
+};
+
+/**
+ \ingroup formula
+
+ Virtual machine executes compiled FormulaProgram with data from context.
+ Results and errors are the same as FormulaExecutor gives for the source expression.
+
+ Programs cache resolved fields of reflected classes inside instructions, so
+ the same program shouldn't be executed from different threads simultaneously.
+ */
+class FormulaVirtualMachine final
+{
+public:
+    FormulaVirtualMachine(FormulaContext* context, FormulaResolvedData* resolvedData = nullptr);
+    ~FormulaVirtualMachine();
+
+    /**
+     \ingroup formula
+
+     Method calculates program and returns result.
+     */
+    Any Calculate(const FormulaProgram* program);
+
+    /**
+     \ingroup formula
+
+     Method calculates program and returns reference to data instead of value.
+     */
+    Reflection GetDataReference(const FormulaProgram* program);
+
+    /**
+     \ingroup formula
+
+     Pointers to data which was accessed during calculations, see FormulaExecutor::GetDependencies.
+     */
+    const Vector<void*>& GetDependencies() const;
+
+private:
+    struct Register
+    {
+        Any value;
+        Reflection ref;
+    };
+
+    void Execute(const FormulaProgram* program, const Vector<FormulaProgram::Instruction>& code);
+    Reflection FindData(const FormulaProgram* program, const FormulaProgram::Instruction& instruction);
+    Reflection GetField(const FormulaProgram* program, const FormulaProgram::Instruction& instruction, const Reflection& owner) const;
+    void CalculateNestedExpression(Any& value) const;
+
+    FormulaContext* context = nullptr;
+    FormulaResolvedData* resolvedData = nullptr;
+    Vector<Register> registers;
+    Vector<Any> arguments;
+    Vector<void*> dependencies;
+};
+}
@@ -0,0 +1,243 @@
+#include "UI/Styles/UIStyleSheetIndex.h"
+#include "UI/Styles/UIStyleSheet.h"
+#include "UI/UIControl.h"
+
+namespace DAVA
+{
+namespace UIStyleSheetIndexDetail
+{
+// cache is dropped as a whole when it grows over the limit
+const size_t MAX_CACHED_MATCHES = 4096;
+
+enum KeyKind : uint64
+{
+    KEY_NAME = 1,
+    KEY_CLASS = 2,
+    KEY_CONTROL_CLASS_NAME = 3
+};
+
+uint32 MakeKey(uint64 value, KeyKind kind)
+{
+    value ^= kind * 0x9E3779B97F4A7C15ULL;
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return static_cast<uint32>(value);
+}
+
+void AppendBucket(const Vector<uint32>& bucket, Vector<uint32>& candidates)
+{
+    candidates.insert(candidates.end(), bucket.begin(), bucket.end());
+}
+
+template <typename Key>
+void AppendBucket(const UnorderedMap<Key, Vector<uint32>>& buckets, const Key& key, Vector<uint32>& candidates)
+{
+    auto it = buckets.find(key);
+    if (it != buckets.end())
+    {
+        AppendBucket(it->second, candidates);
+    }
+}
+}
+
+uint32 UIStyleSheetAncestorFilter::GetNameKey(const FastName& name)
+{
+    return UIStyleSheetIndexDetail::MakeKey(reinterpret_cast<uintptr_t>(name.c_str()), UIStyleSheetIndexDetail::KEY_NAME);
+}
+
+uint32 UIStyleSheetAncestorFilter::GetClassKey(const FastName& clazz)
+{
+    return UIStyleSheetIndexDetail::MakeKey(reinterpret_cast<uintptr_t>(clazz.c_str()), UIStyleSheetIndexDetail::KEY_CLASS);
+}
+
+uint32 UIStyleSheetAncestorFilter::GetControlClassNameKey(const String& className)
+{
+    return UIStyleSheetIndexDetail::MakeKey(std::hash<String>()(className), UIStyleSheetIndexDetail::KEY_CONTROL_CLASS_NAME);
+}
+
+void UIStyleSheetAncestorFilter::AddControl(const UIControl* control)
+{
+    if (control->GetName().IsValid())
+    {
+        AddKey(GetNameKey(control->GetName()));
+    }
+    AddKey(GetControlClassNameKey(control->GetClassName()));
+    AddClasses(control->GetClassSet());
+}
+
+void UIStyleSheetAncestorFilter::AddClasses(const UIStyleSheetClassSet& classes)
+{
+    for (const UIStyleSheetClass& clazz : classes.GetClasses())
+    {
+        AddKey(GetClassKey(clazz.clazz));
+    }
+}
+
+bool UIStyleSheetAncestorFilter::MayContainAll(const Vector<uint32>& keys) const
+{
+    for (uint32 key : keys)
+    {
+        uint32 bit0 = key & 255;
+        uint32 bit1 = (key >> 8) & 255;
+        if ((bits[bit0 >> 6] & (1ULL << (bit0 & 63))) == 0 || (bits[bit1 >> 6] & (1ULL << (bit1 & 63))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UIStyleSheetAncestorFilter::AddKey(uint32 key)
+{
+    uint32 bit0 = key & 255;
+    uint32 bit1 = (key >> 8) & 255;
+    bits[bit0 >> 6] |= 1ULL << (bit0 & 63);
+    bits[bit1 >> 6] |= 1ULL << (bit1 & 63);
+}
+
+size_t UIStyleSheetIndex::SignatureHash::operator()(const Vector<uintptr_t>& signature) const
+{
+    size_t hash = signature.size();
+    for (uintptr_t value : signature)
+    {
+        hash ^= std::hash<uintptr_t>()(value) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+void UIStyleSheetIndex::Build(const Vector<UIPriorityStyleSheet>& styleSheets, int32 maxHierarchyDepth_)
+{
+    nameBuckets.clear();
+    classBuckets.clear();
+    controlClassNameBuckets.clear();
+    universalBucket.clear();
+    ancestorKeys.clear();
+    matchesCache.clear();
+    maxHierarchyDepth = maxHierarchyDepth_;
+
+    ancestorKeys.resize(styleSheets.size());
+    for (uint32 index = 0; index < static_cast<uint32>(styleSheets.size()); ++index)
+    {
+        const UIStyleSheetSelectorChain& chain = styleSheets[index].GetStyleSheet()->GetSelectorChain();
+        if (chain.GetSize() == 0)
+        {
+            universalBucket.push_back(index);
+            continue;
+        }
+
+        const UIStyleSheetSelector& rightmost = *chain.rbegin();
+        if (rightmost.name.IsValid())
+        {
+            nameBuckets[rightmost.name].push_back(index);
+        }
+        else if (!rightmost.classes.empty())
+        {
+            classBuckets[rightmost.classes.front()].push_back(index);
+        }
+        else if (!rightmost.className.empty())
+        {
+            controlClassNameBuckets[rightmost.className].push_back(index);
+        }
+        else
+        {
+            universalBucket.push_back(index);
+        }
+
+        Vector<uint32>& keys = ancestorKeys[index];
+        for (auto it = std::next(chain.rbegin()); it != chain.rend(); ++it)
+        {
+            if (it->name.IsValid())
+            {
+                keys.push_back(UIStyleSheetAncestorFilter::GetNameKey(it->name));
+            }
+            if (!it->className.empty())
+            {
+                keys.push_back(UIStyleSheetAncestorFilter::GetControlClassNameKey(it->className));
+            }
+            for (const FastName& clazz : it->classes)
+            {
+                keys.push_back(UIStyleSheetAncestorFilter::GetClassKey(clazz));
+            }
+        }
+    }
+}
+
+void UIStyleSheetIndex::CollectCandidates(const UIControl* control, const UIStyleSheetClassSet& globalClasses, Vector<uint32>& candidates) const
+{
+    using namespace UIStyleSheetIndexDetail;
+
+    size_t start = candidates.size();
+
+    AppendBucket(universalBucket, candidates);
+    if (control->GetName().IsValid())
+    {
+        AppendBucket(nameBuckets, control->GetName(), candidates);
+    }
+    if (!controlClassNameBuckets.empty())
+    {
+        AppendBucket(controlClassNameBuckets, control->GetClassName(), candidates);
+    }
+    if (!classBuckets.empty())
+    {
+        for (const UIStyleSheetClass& clazz : control->GetClassSet().GetClasses())
+        {
+            AppendBucket(classBuckets, clazz.clazz, candidates);
+        }
+        for (const UIStyleSheetClass& clazz : globalClasses.GetClasses())
+        {
+            AppendBucket(classBuckets, clazz.clazz, candidates);
+        }
+    }
+
+    std::sort(candidates.begin() + start, candidates.end());
+    candidates.erase(std::unique(candidates.begin() + start, candidates.end()), candidates.end());
+}
+
+void UIStyleSheetIndex::BuildMatchSignature(const UIControl* control, Vector<uintptr_t>& signature) const
+{
+    signature.clear();
+
+    const UIControl* current = control;
+    for (int32 depth = 0; depth < maxHierarchyDepth && current != nullptr; ++depth)
+    {
+        // every level is prefixed with its classes count, so that signatures of different hierarchies never coincide
+        const Vector<UIStyleSheetClass>& classes = current->GetClassSet().GetClasses();
+        signature.push_back(classes.size());
+        signature.push_back(static_cast<uintptr_t>(current->GetState()));
+        signature.push_back(reinterpret_cast<uintptr_t>(current->GetName().c_str()));
+        signature.push_back(reinterpret_cast<uintptr_t>(&current->GetClassName()));
+        for (const UIStyleSheetClass& clazz : classes)
+        {
+            signature.push_back(reinterpret_cast<uintptr_t>(clazz.clazz.c_str()));
+        }
+
+        current = current->GetParent();
+    }
+}
+
+const Vector<uint32>* UIStyleSheetIndex::FindMatches(const Vector<uintptr_t>& signature, uint32 globalClassesVersion)
+{
+    if (matchesCacheGlobalClassesVersion != globalClassesVersion)
+    {
+        matchesCache.clear();
+        matchesCacheGlobalClassesVersion = globalClassesVersion;
+        return nullptr;
+    }
+
+    auto it = matchesCache.find(signature);
+    return it != matchesCache.end() ? &it->second : nullptr;
+}
+
+const Vector<uint32>& UIStyleSheetIndex::AddMatches(const Vector<uintptr_t>& signature, const Vector<uint32>& matches)
+{
+    if (matchesCache.size() >= UIStyleSheetIndexDetail::MAX_CACHED_MATCHES)
+    {
+        matchesCache.clear();
+    }
+
+    return matchesCache[signature] = matches;
+}
+}
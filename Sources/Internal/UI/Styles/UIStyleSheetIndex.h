@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "UI/Styles/UIPriorityStyleSheet.h"
+
+namespace DAVA
+{
+class UIControl;
+class UIStyleSheetClassSet;
+
+/**
+    Probabilistic set of names, classes and control class names of control ancestors.
+    Style sheet which selector chain requires a key absent in the set can't match the control.
+*/
+class UIStyleSheetAncestorFilter
+{
+public:
+    void AddControl(const UIControl* control);
+    void AddClasses(const UIStyleSheetClassSet& classes);
+
+    bool MayContainAll(const Vector<uint32>& keys) const;
+
+    static uint32 GetNameKey(const FastName& name);
+    static uint32 GetClassKey(const FastName& clazz);
+    static uint32 GetControlClassNameKey(const String& className);
+
+private:
+    void AddKey(uint32 key);
+
+    Array<uint64, 4> bits = {};
+};
+
+/**
+    Index of style sheets of one package context.
+
+    Style sheets are bucketed by name, first class or control class name of their rightmost selector,
+    so that matching of a control checks only style sheets which can match it. Results of matching are
+    cached by signature of control and its ancestors up to the max selector chain depth.
+*/
+class UIStyleSheetIndex
+{
+public:
+    /** Rebuild index for `styleSheets` sorted by priority, clears cache of matching results. */
+    void Build(const Vector<UIPriorityStyleSheet>& styleSheets, int32 maxHierarchyDepth);
+
+    /**
+        Append to `candidates` indices of style sheets which rightmost selector may match `control`.
+        Indices are sorted in ascending order.
+    */
+    void CollectCandidates(const UIControl* control, const UIStyleSheetClassSet& globalClasses, Vector<uint32>& candidates) const;
+
+    /** Return ancestor filter keys required by selector chain of style sheet with `index`. */
+    const Vector<uint32>& GetAncestorKeys(uint32 index) const;
+
+    /**
+        Write to `signature` everything that matching depends on: state, name, control class name
+        and classes of `control` and its ancestors within max selector chain depth.
+    */
+    void BuildMatchSignature(const UIControl* control, Vector<uintptr_t>& signature) const;
+
+    /**
+        Return cached indices of style sheets matched by control with `signature`, or nullptr.
+        Cache is dropped if `globalClassesVersion` differs from the version of cached results.
+    */
+    const Vector<uint32>* FindMatches(const Vector<uintptr_t>& signature, uint32 globalClassesVersion);
+    const Vector<uint32>& AddMatches(const Vector<uintptr_t>& signature, const Vector<uint32>& matches);
+
+    uint32 GetCachedMatchesCount() const;
+
+private:
+    struct SignatureHash
+    {
+        size_t operator()(const Vector<uintptr_t>& signature) const;
+    };
+
+    UnorderedMap<FastName, Vector<uint32>> nameBuckets;
+    UnorderedMap<FastName, Vector<uint32>> classBuckets;
+    UnorderedMap<String, Vector<uint32>> controlClassNameBuckets;
+    Vector<uint32> universalBucket;
+    Vector<Vector<uint32>> ancestorKeys;
+    int32 maxHierarchyDepth = 0;
+
+    UnorderedMap<Vector<uintptr_t>, Vector<uint32>, SignatureHash> matchesCache;
+    uint32 matchesCacheGlobalClassesVersion = 0;
+};
+
+inline const Vector<uint32>& UIStyleSheetIndex::GetAncestorKeys(uint32 index) const
+{
+    return ancestorKeys[index];
+}
+
+inline uint32 UIStyleSheetIndex::GetCachedMatchesCount() const
+{
+    return static_cast<uint32>(matchesCache.size());
+}
+}
@@ -123,10 +123,17 @@ public:
     String GetClassesAsString() const;
     void SetClassesFromString(const String& classes);
 
+    const Vector<UIStyleSheetClass>& GetClasses() const;
+
 private:
     Vector<UIStyleSheetClass> classes;
 };
 
+inline const Vector<UIStyleSheetClass>& UIStyleSheetClassSet::GetClasses() const
+{
+    return classes;
+}
+
 struct UIStyleSheetSourceInfo
 {
     UIStyleSheetSourceInfo() = default;
@@ -7,6 +7,7 @@
 #include "Animation/LinearPropertyAnimation.h"
 #include "Animation/AnimationManager.h"
 #include "Logger/Logger.h"
+#include "Reflection/ReflectedFieldAccessor.h"
 #include "Reflection/ReflectedTypeDB.h"
 #include "Render/Renderer.h"
 #include "UI/UIScreen.h"
@@ -23,10 +24,10 @@ const int32 PROPERTY_ANIMATION_GROUP_OFFSET = 100000;
 
 struct ImmediatePropertySetter
 {
-    void operator()(UIControl* control, const Reflection& ref) const
+    void operator()(UIControl* control, const ReflectedFieldAccessor& field, const ReflectedObject& object) const
     {
         control->StopAnimations(PROPERTY_ANIMATION_GROUP_OFFSET + propertyIndex);
-        ref.SetValueWithCast(value);
+        field.SetValueWithCast(object, value);
     }
 
     uint32 propertyIndex;
@@ -36,7 +37,7 @@ struct ImmediatePropertySetter
 struct AnimatedPropertySetter
 {
     template <typename T>
-    void Animate(UIControl* control, const Reflection& ref, const T& startValue, const T& endValue) const
+    void Animate(UIControl* control, const ReflectedFieldAccessor& field, const ReflectedObject& object, const T& startValue, const T& endValue) const
     {
         const int32 track = PROPERTY_ANIMATION_GROUP_OFFSET + propertyIndex;
         LinearPropertyAnimation<T>* currentAnimation = DynamicTypeCheck<LinearPropertyAnimation<T>*>(GetEngineContext()->animationManager->FindPlayingAnimation(control, track));
@@ -46,38 +47,38 @@ struct AnimatedPropertySetter
             if (currentAnimation)
                 control->StopAnimations(track);
 
-            if (ref.GetValue() != value)
+            if (field.GetValue(object) != value)
             {
-                (new LinearPropertyAnimation<T>(control, ref, startValue, endValue, time, transitionFunction))->Start(track);
+                (new LinearPropertyAnimation<T>(control, field.GetReflection(object), startValue, endValue, time, transitionFunction))->Start(track);
             }
         }
     }
 
-    void operator()(UIControl* control, const Reflection& ref) const
+    void operator()(UIControl* control, const ReflectedFieldAccessor& field, const ReflectedObject& object) const
     {
-        const Any& refValue = ref.GetValue();
+        const Any& refValue = field.GetValue(object);
         const Type* valueType = value.GetType()->Decay();
         if (valueType == refValue.GetType()->Decay())
         {
             if (valueType == Type::Instance<Vector2>())
             {
-                Animate<Vector2>(control, ref, refValue.Get<Vector2>(), value.Get<Vector2>());
+                Animate<Vector2>(control, field, object, refValue.Get<Vector2>(), value.Get<Vector2>());
             }
             else if (valueType == Type::Instance<Vector3>())
             {
-                Animate<Vector3>(control, ref, refValue.Get<Vector3>(), value.Get<Vector3>());
+                Animate<Vector3>(control, field, object, refValue.Get<Vector3>(), value.Get<Vector3>());
             }
             else if (valueType == Type::Instance<Vector4>())
             {
-                Animate<Vector4>(control, ref, refValue.Get<Vector4>(), value.Get<Vector4>());
+                Animate<Vector4>(control, field, object, refValue.Get<Vector4>(), value.Get<Vector4>());
             }
             else if (valueType == Type::Instance<float32>())
             {
-                Animate<float32>(control, ref, refValue.Get<float32>(), value.Get<float32>());
+                Animate<float32>(control, field, object, refValue.Get<float32>(), value.Get<float32>());
             }
             else if (valueType == Type::Instance<Color>())
             {
-                Animate<Color>(control, ref, refValue.Get<Color>(), value.Get<Color>());
+                Animate<Color>(control, field, object, refValue.Get<Color>(), value.Get<Color>());
             }
             else
             {
@@ -155,7 +156,7 @@ void UIStyleSheetSystem::ProcessControl(UIControl* control, bool styleSheetListC
 #if STYLESHEET_STATS
     uint64 startTime = SystemTimer::GetUs();
 #endif
-    ProcessControlImpl(control, 0, styleSheetListChanged, true, false, nullptr);
+    ProcessControlImpl(control, 0, styleSheetListChanged, true, false, nullptr, MakeAncestorFilter(control));
 #if STYLESHEET_STATS
     statsTime += SystemTimer::GetUs() - startTime;
 #endif
@@ -163,10 +164,64 @@ void UIStyleSheetSystem::ProcessControl(UIControl* control, bool styleSheetListC
 
 void UIStyleSheetSystem::DebugControl(UIControl* control, UIStyleSheetProcessDebugData* debugData)
 {
-    ProcessControlImpl(control, 0, true, false, true, debugData);
+    ProcessControlImpl(control, 0, true, false, true, debugData, MakeAncestorFilter(control));
 }
 
-void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData)
+UIStyleSheetAncestorFilter UIStyleSheetSystem::MakeAncestorFilter(const UIControl* control) const
+{
+    // global classes satisfy class selectors of any ancestor
+    UIStyleSheetAncestorFilter ancestors;
+    ancestors.AddClasses(globalClasses);
+    for (const UIControl* parent = control->GetParent(); parent != nullptr; parent = parent->GetParent())
+    {
+        ancestors.AddControl(parent);
+    }
+    return ancestors;
+}
+
+const Vector<uint32>& UIStyleSheetSystem::MatchStyleSheets(const UIControl* control, UIControlPackageContext* packageContext, const UIStyleSheetAncestorFilter& ancestors)
+{
+    UIStyleSheetIndex& index = packageContext->GetStyleSheetIndex();
+
+    index.BuildMatchSignature(control, matchSignature);
+    const Vector<uint32>* cachedMatches = index.FindMatches(matchSignature, globalClassesVersion);
+    if (cachedMatches != nullptr)
+    {
+#if STYLESHEET_STATS
+        ++statsCacheHits;
+#endif
+        return *cachedMatches;
+    }
+
+    candidates.clear();
+    index.CollectCandidates(control, globalClasses, candidates);
+
+#if STYLESHEET_STATS
+    statsCandidates += static_cast<int32>(candidates.size());
+#endif
+
+    const Vector<UIPriorityStyleSheet>& styleSheets = packageContext->GetSortedStyleSheets();
+    matchedStyleSheets.clear();
+    for (auto candidateIter = candidates.rbegin(); candidateIter != candidates.rend(); ++candidateIter)
+    {
+        if (!ancestors.MayContainAll(index.GetAncestorKeys(*candidateIter)))
+        {
+#if STYLESHEET_STATS
+            ++statsAncestorRejects;
+#endif
+            continue;
+        }
+
+        if (StyleSheetMatchesControl(styleSheets[*candidateIter].GetStyleSheet(), control))
+        {
+            matchedStyleSheets.push_back(*candidateIter);
+        }
+    }
+
+    return index.AddMatches(matchSignature, matchedStyleSheets);
+}
+
+void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData, const UIStyleSheetAncestorFilter& ancestors)
 {
     UIControlPackageContext* packageContext = control->GetPackageContext();
     const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
@@ -193,30 +248,27 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
 
         Array<const UIStyleSheetProperty*, UIStyleSheetPropertyDataBase::STYLE_SHEET_PROPERTY_COUNT> propertySources = {};
 
-        for (auto styleSheetIter = styleSheets.rbegin(); styleSheetIter != styleSheets.rend(); ++styleSheetIter)
+        for (uint32 styleSheetIndex : MatchStyleSheets(control, packageContext, ancestors))
         {
-            const UIStyleSheet* styleSheet = styleSheetIter->GetStyleSheet();
+            const UIStyleSheet* styleSheet = styleSheets[styleSheetIndex].GetStyleSheet();
 
-            if (StyleSheetMatchesControl(styleSheet, control))
-            {
-                cascadeProperties |= styleSheet->GetPropertyTable()->GetPropertySet();
+            cascadeProperties |= styleSheet->GetPropertyTable()->GetPropertySet();
 
-                const Vector<UIStyleSheetProperty>& propertyTable = styleSheet->GetPropertyTable()->GetProperties();
-                for (const UIStyleSheetProperty& prop : propertyTable)
-                {
-                    propertySources[prop.propertyIndex] = &prop;
-
-                    if (debugData != nullptr)
-                    {
-                        debugData->propertySources[prop.propertyIndex] = styleSheet;
-                    }
-                }
+            const Vector<UIStyleSheetProperty>& propertyTable = styleSheet->GetPropertyTable()->GetProperties();
+            for (const UIStyleSheetProperty& prop : propertyTable)
+            {
+                propertySources[prop.propertyIndex] = &prop;
 
                 if (debugData != nullptr)
                 {
-                    debugData->styleSheets.push_back(*styleSheetIter);
+                    debugData->propertySources[prop.propertyIndex] = styleSheet;
                 }
             }
+
+            if (debugData != nullptr)
+            {
+                debugData->styleSheets.push_back(styleSheets[styleSheetIndex]);
+            }
         }
 
         const UIStyleSheetPropertySet propertiesToApply = cascadeProperties & (~localControlProperties);
@@ -266,11 +318,13 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
         control->SetStyleSheetInitialized();
     }
 
-    if (recursively)
+    if (recursively && !control->GetChildren().empty())
     {
+        UIStyleSheetAncestorFilter childAncestors = ancestors;
+        childAncestors.AddControl(control);
         for (UIControl* child : control->GetChildren())
         {
-            ProcessControlImpl(child, distanceFromDirty + 1, styleSheetListChanged, true, dryRun, debugData);
+            ProcessControlImpl(child, distanceFromDirty + 1, styleSheetListChanged, true, dryRun, debugData, childAncestors);
         }
     }
 }
@@ -279,6 +333,7 @@ void UIStyleSheetSystem::AddGlobalClass(const FastName& clazz)
 {
     if (globalClasses.AddClass(clazz))
     {
+        ++globalClassesVersion;
         SetGlobalStyleSheetDirty();
     }
 }
@@ -287,6 +342,7 @@ void UIStyleSheetSystem::RemoveGlobalClass(const FastName& clazz)
 {
     if (globalClasses.RemoveClass(clazz))
     {
+        ++globalClassesVersion;
         SetGlobalStyleSheetDirty();
     }
 }
@@ -298,7 +354,10 @@ bool UIStyleSheetSystem::HasGlobalClass(const FastName& clazz) const
 
 void UIStyleSheetSystem::SetGlobalTaggedClass(const FastName& tag, const FastName& clazz)
 {
-    globalClasses.SetTaggedClass(tag, clazz);
+    if (globalClasses.SetTaggedClass(tag, clazz))
+    {
+        ++globalClassesVersion;
+    }
 }
 
 FastName UIStyleSheetSystem::GetGlobalTaggedClass(const FastName& tag) const
@@ -308,12 +367,18 @@ FastName UIStyleSheetSystem::GetGlobalTaggedClass(const FastName& tag) const
 
 void UIStyleSheetSystem::ResetGlobalTaggedClass(const FastName& tag)
 {
-    globalClasses.ResetTaggedClass(tag);
+    if (globalClasses.ResetTaggedClass(tag))
+    {
+        ++globalClassesVersion;
+    }
 }
 
 void UIStyleSheetSystem::ClearGlobalClasses()
 {
-    globalClasses.RemoveAllClasses();
+    if (globalClasses.RemoveAllClasses())
+    {
+        ++globalClassesVersion;
+    }
 }
 
 void UIStyleSheetSystem::ClearStats()
@@ -322,6 +387,9 @@ void UIStyleSheetSystem::ClearStats()
     statsProcessedControls = 0;
     statsMatches = 0;
     statsStyleSheetCount = 0;
+    statsCandidates = 0;
+    statsAncestorRejects = 0;
+    statsCacheHits = 0;
 }
 
 void UIStyleSheetSystem::DumpStats()
@@ -331,6 +399,8 @@ void UIStyleSheetSystem::DumpStats()
         Logger::Debug("%s %i %f %i %f", __FUNCTION__, statsProcessedControls,
                       static_cast<float>(statsTime / 1000000.0f), statsMatches,
                       static_cast<float>(statsStyleSheetCount / statsProcessedControls));
+        Logger::Debug("%s candidates: %i, rejected by ancestors: %i, cache hits: %i", __FUNCTION__,
+                      statsCandidates, statsAncestorRejects, statsCacheHits);
     }
 }
 
@@ -396,11 +466,10 @@ void UIStyleSheetSystem::DoForAllPropertyInstances(UIControl* control, uint32 pr
         ReflectedObject refObject(control);
         if (TypeInheritance::CanDownCast(refObject.GetReflectedType()->GetType(), descr.group->refType->GetType()))
         {
-            Reflection ref = Reflection::Create(refObject);
-            ref = ref.GetField(descr.field->name);
-            if (ref.IsValid())
+            const ReflectedFieldAccessor* field = GetPropertyAccessor(propertyIndex, refObject.GetReflectedType());
+            if (field->IsValid())
             {
-                action(control, ref);
+                action(control, *field, refObject);
 
                 if (listener != nullptr)
                 {
@@ -413,11 +482,11 @@ void UIStyleSheetSystem::DoForAllPropertyInstances(UIControl* control, uint32 pr
     {
         if (UIComponent* component = control->GetComponent(descr.group->componentType))
         {
-            Reflection ref = Reflection::Create(ReflectedObject(component));
-            ref = ref.GetField(descr.field->name);
-            if (ref.IsValid())
+            ReflectedObject refObject(component);
+            const ReflectedFieldAccessor* field = GetPropertyAccessor(propertyIndex, refObject.GetReflectedType());
+            if (field->IsValid())
             {
-                action(control, ref);
+                action(control, *field, refObject);
 
                 if (listener != nullptr)
                 {
@@ -435,6 +504,24 @@ void UIStyleSheetSystem::DoForAllPropertyInstances(UIControl* control, uint32 pr
     }
 }
 
+const ReflectedFieldAccessor* UIStyleSheetSystem::GetPropertyAccessor(uint32 propertyIndex, const ReflectedType* reflectedType)
+{
+    // few types share property, so linear search is cheaper than locked accessors registry
+    Vector<const ReflectedFieldAccessor*>& accessors = propertyAccessors[propertyIndex];
+    for (const ReflectedFieldAccessor* accessor : accessors)
+    {
+        if (accessor->GetReflectedType() == reflectedType)
+        {
+            return accessor;
+        }
+    }
+
+    const UIStyleSheetPropertyDescriptor& descr = UIStyleSheetPropertyDataBase::Instance()->GetStyleSheetPropertyByIndex(propertyIndex);
+    const ReflectedFieldAccessor* accessor = ReflectedFieldAccessor::Get(reflectedType, descr.field->name);
+    accessors.push_back(accessor);
+    return accessor;
+}
+
 void UIStyleSheetSystem::SetGlobalStyleSheetDirty()
 {
     globalStyleSheetDirty = true;
@@ -4,6 +4,7 @@
 #include "Base/BaseTypes.h"
 #include "Base/FastName.h"
 #include "UI/Styles/UIPriorityStyleSheet.h"
+#include "UI/Styles/UIStyleSheetIndex.h"
 #include "UI/Styles/UIStyleSheetPropertyDataBase.h"
 #include "UI/Styles/UIStyleSheetStructs.h"
 #include "UI/UISystem.h"
@@ -11,7 +12,10 @@
 
 namespace DAVA
 {
+class ReflectedFieldAccessor;
+class ReflectedType;
 class UIControl;
+class UIControlPackageContext;
 class UIScreen;
 class UIScreenTransition;
 class UIStyleSheet;
@@ -75,23 +79,39 @@ private:
     void Process(float32 elapsedTime) override;
     void ForceProcessControl(float32 elapsedTime, UIControl* control) override;
 
-    void ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData);
+    void ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData, const UIStyleSheetAncestorFilter& ancestors);
     void ProcessControlHierarhy(UIControl* root);
 
+    UIStyleSheetAncestorFilter MakeAncestorFilter(const UIControl* control) const;
+    /** Return indices of matched style sheets of `packageContext` in order of application. */
+    const Vector<uint32>& MatchStyleSheets(const UIControl* control, UIControlPackageContext* packageContext, const UIStyleSheetAncestorFilter& ancestors);
+
     bool StyleSheetMatchesControl(const UIStyleSheet* styleSheet, const UIControl* control);
     bool SelectorMatchesControl(const UIStyleSheetSelector& selector, const UIControl* control);
 
     template <typename CallbackType>
     void DoForAllPropertyInstances(UIControl* control, uint32 propertyIndex, const CallbackType& action);
+    const ReflectedFieldAccessor* GetPropertyAccessor(uint32 propertyIndex, const ReflectedType* reflectedType);
     /** Sets 'globalStyleSheetDirty' flag for next 'Process()' call. Flag will reset automatically. */
     void SetGlobalStyleSheetDirty();
 
     UIStyleSheetClassSet globalClasses;
+    uint32 globalClassesVersion = 0;
+
+    Vector<uint32> candidates;
+    Vector<uint32> matchedStyleSheets;
+    Vector<uintptr_t> matchSignature;
+
+    // accessors of every property for concrete types of controls and components it was applied to
+    Array<Vector<const ReflectedFieldAccessor*>, UIStyleSheetPropertyDataBase::STYLE_SHEET_PROPERTY_COUNT> propertyAccessors;
 
     uint64 statsTime = 0;
     int32 statsProcessedControls = 0;
     int32 statsMatches = 0;
     int32 statsStyleSheetCount = 0;
+    int32 statsCandidates = 0;
+    int32 statsAncestorRejects = 0;
+    int32 statsCacheHits = 0;
     bool dirty = false;
     bool needUpdate = false;
     bool globalStyleSheetDirty = false;
@@ -2305,6 +2305,11 @@ void UIControl::SetClassesFromString(const String& classesStr)
     SetStyleSheetDirty();
 }
 
+const UIStyleSheetClassSet& UIControl::GetClassSet() const
+{
+    return classes;
+}
+
 const UIStyleSheetPropertySet& UIControl::GetLocalPropertySet() const
 {
     return localProperties;
@@ -1107,6 +1107,7 @@ public:
 
     String GetClassesAsString() const;
     void SetClassesFromString(const String& classes);
+    const UIStyleSheetClassSet& GetClassSet() const;
 
     const UIStyleSheetPropertySet& GetLocalPropertySet() const;
     void SetLocalPropertySet(const UIStyleSheetPropertySet& set);
@@ -10,6 +10,7 @@ UIControlPackageContext::~UIControlPackageContext()
 void UIControlPackageContext::AddStyleSheet(const UIPriorityStyleSheet& styleSheet)
 {
     styleSheetsSorted = false;
+    styleSheetIndexBuilt = false;
 
     auto it = std::find_if(styleSheets.begin(), styleSheets.end(), [&styleSheet](UIPriorityStyleSheet& ss) {
         return ss.GetStyleSheet() == styleSheet.GetStyleSheet();
@@ -32,6 +33,7 @@ void UIControlPackageContext::RemoveAllStyleSheets()
 {
     styleSheets.clear();
     maxStyleSheetHierarchyDepth = 0;
+    styleSheetIndexBuilt = false;
 }
 
 const Vector<UIPriorityStyleSheet>& UIControlPackageContext::GetSortedStyleSheets()
@@ -45,6 +47,17 @@ const Vector<UIPriorityStyleSheet>& UIControlPackageContext::GetSortedStyleSheet
     return styleSheets;
 }
 
+UIStyleSheetIndex& UIControlPackageContext::GetStyleSheetIndex()
+{
+    if (!styleSheetIndexBuilt)
+    {
+        styleSheetIndex.Build(GetSortedStyleSheets(), maxStyleSheetHierarchyDepth);
+        styleSheetIndexBuilt = true;
+    }
+
+    return styleSheetIndex;
+}
+
 int32 UIControlPackageContext::GetMaxStyleSheetHierarchyDepth() const
 {
     return maxStyleSheetHierarchyDepth;
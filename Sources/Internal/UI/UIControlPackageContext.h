@@ -4,6 +4,7 @@
 #include "Base/BaseObject.h"
 #include "Base/BaseTypes.h"
 #include "UI/Styles/UIPriorityStyleSheet.h"
+#include "UI/Styles/UIStyleSheetIndex.h"
 
 namespace DAVA
 {
@@ -20,12 +21,16 @@ public:
     void RemoveAllStyleSheets();
 
     const Vector<UIPriorityStyleSheet>& GetSortedStyleSheets();
+    /** Return index of style sheets, indices in it refer to the list returned by `GetSortedStyleSheets`. */
+    UIStyleSheetIndex& GetStyleSheetIndex();
 
     int32 GetMaxStyleSheetHierarchyDepth() const;
 
 private:
     Vector<UIPriorityStyleSheet> styleSheets;
     bool styleSheetsSorted = false;
+    UIStyleSheetIndex styleSheetIndex;
+    bool styleSheetIndexBuilt = false;
     int32 maxStyleSheetHierarchyDepth = 0;
 };
 };